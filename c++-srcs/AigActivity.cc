@@ -0,0 +1,225 @@
+
+/// @file AigActivity.cc
+/// @brief AigActivity の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigActivity.h"
+#include "ModelImpl.h"
+#include "BitSim.h"
+#include <cmath>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+BEGIN_NONAMESPACE
+
+// 1回のタスクで処理する変数の数
+const SizeType CHUNK_SIZE = 4096;
+
+// 確率の精度(ビット数)
+const SizeType PROB_BITS = 16;
+
+#if defined(__AVX2__)
+// 64ビットごとのビット数を数える．
+//
+// 4ビットごとに表引きしてバイト単位の和を求めたあと
+// _mm256_sad_epu8 で64ビットごとにまとめる．
+inline
+__m256i
+popcount256(
+  __m256i v
+)
+{
+  const auto lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3,
+				       1, 2, 2, 3, 2, 3, 3, 4,
+				       0, 1, 1, 2, 1, 2, 2, 3,
+				       1, 2, 2, 3, 2, 3, 3, 4);
+  const auto low_mask = _mm256_set1_epi8(0x0f);
+  auto lo = _mm256_and_si256(v, low_mask);
+  auto hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+  auto cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo),
+			     _mm256_shuffle_epi8(lookup, hi));
+  return _mm256_sad_epu8(cnt, _mm256_setzero_si256());
+}
+
+// 4つの64ビットの和を求める．
+inline
+std::uint64_t
+hsum256(
+  __m256i v
+)
+{
+  return _mm256_extract_epi64(v, 0) + _mm256_extract_epi64(v, 1)
+    + _mm256_extract_epi64(v, 2) + _mm256_extract_epi64(v, 3);
+}
+#endif
+
+// cur の 1 のビット数と cur ^ prev の 1 のビット数を数えて，
+// cur を prev にコピーする．
+inline
+void
+count_bits(
+  const std::uint64_t* cur,
+  std::uint64_t* prev,
+  SizeType nw,
+  std::uint64_t& ones,
+  std::uint64_t& toggles
+)
+{
+  SizeType w = 0;
+#if defined(__AVX2__)
+  auto acc1 = _mm256_setzero_si256();
+  auto acc2 = _mm256_setzero_si256();
+  for ( ; w + 4 <= nw; w += 4 ) {
+    auto x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cur + w));
+    auto y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(prev + w));
+    acc1 = _mm256_add_epi64(acc1, popcount256(x));
+    acc2 = _mm256_add_epi64(acc2, popcount256(_mm256_xor_si256(x, y)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(prev + w), x);
+  }
+  ones += hsum256(acc1);
+  toggles += hsum256(acc2);
+#endif
+  for ( ; w < nw; ++ w ) {
+    ones += __builtin_popcountll(cur[w]);
+    toggles += __builtin_popcountll(cur[w] ^ prev[w]);
+    prev[w] = cur[w];
+  }
+}
+
+// 1 となる確率が q / 2^PROB_BITS の乱数のワードを作る．
+//
+// 下位のビットから順に，ビットが 1 なら乱数との OR を，
+// 0 なら乱数との AND をとると確率が 2進展開どおりとなる．
+inline
+std::uint64_t
+weighted_word(
+  std::uint64_t q,
+  std::uint64_t seed,
+  std::uint64_t index
+)
+{
+  if ( q == 0 ) {
+    return 0ULL;
+  }
+  if ( q >= (1ULL << PROB_BITS) ) {
+    return ~0ULL;
+  }
+  // 末尾の 0 のビットは結果に影響しないので飛ばす．
+  std::uint64_t w = 0ULL;
+  for ( SizeType k = __builtin_ctzll(q); k < PROB_BITS; ++ k ) {
+    auto r = BitSim::random_word(seed, index * PROB_BITS + k);
+    w = ((q >> k) & 1) ? (w | r) : (w & r);
+  }
+  return w;
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス AigActivity
+//////////////////////////////////////////////////////////////////////
+
+// @brief シミュレーションを行って統計を求める．
+void
+AigActivity::compute(
+  const ModelImpl& model,
+  const AigActivityOpt& opt
+)
+{
+  auto I = model.I();
+  auto L = model.L();
+  vector<std::uint64_t> q_list(I, 1ULL << (PROB_BITS - 1));
+  if ( !opt.input_prob.empty() ) {
+    if ( opt.input_prob.size() != I ) {
+      ostringstream buf;
+      buf << "estimate_activity: input_prob size mismatch ("
+	  << opt.input_prob.size() << " vs " << I << ").";
+      throw std::invalid_argument{buf.str()};
+    }
+    for ( SizeType i = 0; i < I; ++ i ) {
+      auto p = opt.input_prob[i];
+      if ( !(0.0 <= p && p <= 1.0) ) {
+	ostringstream buf;
+	buf << "estimate_activity: input_prob[" << i << "](" << p
+	    << ") out of range.";
+	throw std::invalid_argument{buf.str()};
+      }
+      q_list[i] = static_cast<std::uint64_t>(std::lround(p * (1 << PROB_BITS)));
+    }
+  }
+
+  BitSim sim{model, opt.word_num, opt.thread_num};
+  auto var_num = sim.var_num();
+  auto nw = sim.word_num();
+  mPatNum = nw * 64;
+  mCycleNum = opt.cycle_num;
+
+  vector<std::uint64_t> one_count(var_num, 0);
+  vector<std::uint64_t> toggle_count(var_num, 0);
+  vector<std::uint64_t> prev_val(var_num * nw, 0ULL);
+  vector<std::uint64_t> next_state(L * nw);
+
+  // ラッチの初期値は 0
+  for ( SizeType i = 0; i < L; ++ i ) {
+    auto v = sim.value(model.latch(i) / 2);
+    std::fill(v, v + nw, 0ULL);
+  }
+
+  auto total = opt.warmup_num + mCycleNum;
+  auto chunk_num = (var_num + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  for ( SizeType c = 0; c < total; ++ c ) {
+    for ( SizeType i = 0; i < I; ++ i ) {
+      auto v = sim.value(model.input(i) / 2);
+      for ( SizeType w = 0; w < nw; ++ w ) {
+	v[w] = weighted_word(q_list[i], opt.seed, (c * I + i) * nw + w);
+      }
+    }
+    sim.simulate();
+
+    if ( c >= opt.warmup_num ) {
+      // 最初の時刻のスイッチング数は数えない．
+      bool first = c == opt.warmup_num;
+      sim.pool().run(chunk_num, [&](SizeType id, SizeType) {
+	auto end = std::min(var_num, (id + 1) * CHUNK_SIZE);
+	for ( auto var = id * CHUNK_SIZE; var < end; ++ var ) {
+	  std::uint64_t toggles = 0;
+	  count_bits(sim.value(var), &prev_val[var * nw], nw,
+		     one_count[var], toggles);
+	  if ( !first ) {
+	    toggle_count[var] += toggles;
+	  }
+	}
+      });
+    }
+
+    // 次状態をラッチに移す．
+    for ( SizeType i = 0; i < L; ++ i ) {
+      for ( SizeType w = 0; w < nw; ++ w ) {
+	next_state[i * nw + w] = sim.lit_value(model.latch_src(i), w);
+      }
+    }
+    for ( SizeType i = 0; i < L; ++ i ) {
+      auto v = sim.value(model.latch(i) / 2);
+      std::copy(&next_state[i * nw], &next_state[(i + 1) * nw], v);
+    }
+  }
+
+  mOneProb.resize(var_num);
+  mToggleRate.resize(var_num);
+  double one_den = static_cast<double>(mPatNum) * mCycleNum;
+  double toggle_den = static_cast<double>(mPatNum) * (mCycleNum > 0 ? mCycleNum - 1 : 0);
+  for ( SizeType var = 0; var < var_num; ++ var ) {
+    mOneProb[var] = one_den > 0 ? one_count[var] / one_den : 0.0;
+    mToggleRate[var] = toggle_den > 0 ? toggle_count[var] / toggle_den : 0.0;
+  }
+}
+
+END_NAMESPACE_YM_AIG
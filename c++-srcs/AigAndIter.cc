@@ -0,0 +1,73 @@
+
+/// @file AigAndIter.cc
+/// @brief AigAndIter の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigAndIter.h"
+#include "ModelImpl.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+// クラス AigAndIter
+//////////////////////////////////////////////////////////////////////
+
+// @brief 内容を指定したコンストラクタ
+AigAndIter::AigAndIter(
+  const std::shared_ptr<ModelImpl>& impl,
+  SizeType pos
+) : mImpl{impl},
+    mPos{pos}
+{
+  auto packed = mImpl->packed_and_list();
+  if ( packed != nullptr ) {
+    // 圧縮表現の場合は先頭か末尾からしか始められない．
+    ASSERT_COND( mPos == 0 || mPos == mImpl->A() );
+    auto cursor = packed->begin();
+    mOffset = cursor.mOffset;
+    mLit = cursor.mLit;
+  }
+  load();
+}
+
+// @brief 次のノードに進む．
+AigAndIter&
+AigAndIter::operator++()
+{
+  ++ mPos;
+  load();
+  return *this;
+}
+
+// @brief 現在位置のノードの内容を読み込む．
+void
+AigAndIter::load()
+{
+  if ( mPos >= mImpl->A() ) {
+    return;
+  }
+  auto packed = mImpl->packed_and_list();
+  if ( packed != nullptr ) {
+    // 直前の状態から一つ分だけ復号する．
+    PackedAndList::Cursor cursor;
+    cursor.mNext = mPos;
+    cursor.mOffset = mOffset;
+    cursor.mLit = mLit;
+    packed->decode(cursor);
+    mOffset = cursor.mOffset;
+    mLit = cursor.mLit;
+    mSrc1 = cursor.mSrc1;
+    mSrc2 = cursor.mSrc2;
+  }
+  else {
+    mLit = mImpl->and_node(mPos);
+    mSrc1 = mImpl->and_src1(mPos);
+    mSrc2 = mImpl->and_src2(mPos);
+  }
+}
+
+END_NAMESPACE_YM_AIG
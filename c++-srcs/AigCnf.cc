@@ -0,0 +1,60 @@
+
+/// @file AigCnf.cc
+/// @brief AigCnf の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigCnf.h"
+#include "CnfEncoder.h"
+#include "DimacsWriter.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+// クラス AigCnf
+//////////////////////////////////////////////////////////////////////
+
+// @brief DIMACS 形式で出力する．
+void
+AigCnf::write_dimacs(
+  ostream& s
+) const
+{
+  DimacsWriter writer{s};
+  writer.write_header(mVarNum, mClauseNum);
+  SizeType begin = 0;
+  for ( SizeType i = 0; i < mLitBuffer.size(); ++ i ) {
+    if ( mLitBuffer[i] == 0 ) {
+      writer.write_clause(&mLitBuffer[begin], i - begin);
+      begin = i + 1;
+    }
+  }
+  writer.flush();
+}
+
+// @brief CNF を作る．
+void
+AigCnf::encode(
+  const ModelImpl& model,
+  const AigCnfOpt& opt
+)
+{
+  CnfEncoder encoder{model, opt};
+  mVarNum = encoder.var_num();
+  mClauseNum = encoder.clause_num();
+  mLitBuffer.clear();
+  // 節はほとんどが 2 リテラルなので終端を含めて 3 ワードで見積もる．
+  mLitBuffer.reserve(mClauseNum * 3 + mClauseNum / 4);
+  encoder.encode([&](const int* lits, SizeType n) {
+    mLitBuffer.insert(mLitBuffer.end(), lits, lits + n);
+    mLitBuffer.push_back(0);
+  });
+  mVarMap = encoder.var_map();
+  mOutputLitList = encoder.output_lit_list();
+  mLatchLitList = encoder.latch_lit_list();
+}
+
+END_NAMESPACE_YM_AIG
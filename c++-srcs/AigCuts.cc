@@ -0,0 +1,471 @@
+
+/// @file AigCuts.cc
+/// @brief AigCuts の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigCuts.h"
+#include "ModelImpl.h"
+#include "VarMap.h"
+#include "WorkPool.h"
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+BEGIN_NONAMESPACE
+
+// カットの葉の数の上限の最大値
+const SizeType MAX_CUT_SIZE = 8;
+
+// 真理値表のワード数の最大値
+const SizeType MAX_WORD_NUM = 4;
+
+// 1回のタスクで処理するノード数
+const SizeType CHUNK_SIZE = 64;
+
+// ワード内の変数の真理値表
+const std::uint64_t VAR_MASK[6] = {
+  0xAAAAAAAAAAAAAAAAULL,
+  0xCCCCCCCCCCCCCCCCULL,
+  0xF0F0F0F0F0F0F0F0ULL,
+  0xFF00FF00FF00FF00ULL,
+  0xFFFF0000FFFF0000ULL,
+  0xFFFFFFFF00000000ULL
+};
+
+// 変数 v の真理値表を作る．
+void
+tt_var(
+  std::uint64_t* t,
+  SizeType nw,
+  SizeType v
+)
+{
+  for ( SizeType w = 0; w < nw; ++ w ) {
+    if ( v < 6 ) {
+      t[w] = VAR_MASK[v];
+    }
+    else {
+      t[w] = ((w >> (v - 6)) & 1) ? ~0ULL : 0ULL;
+    }
+  }
+}
+
+// 隣り合った変数 v と v + 1 を入れ替える．
+void
+tt_swap(
+  std::uint64_t* t,
+  SizeType nw,
+  SizeType v
+)
+{
+  if ( v + 1 < 6 ) {
+    auto m1 = VAR_MASK[v] & ~VAR_MASK[v + 1];
+    auto m2 = ~VAR_MASK[v] & VAR_MASK[v + 1];
+    SizeType s = 1 << v;
+    for ( SizeType w = 0; w < nw; ++ w ) {
+      auto x = t[w];
+      t[w] = (x & ~(m1 | m2)) | ((x & m1) << s) | ((x & m2) >> s);
+    }
+  }
+  else if ( v == 5 ) {
+    for ( SizeType w = 0; w < nw; w += 2 ) {
+      auto x0 = t[w];
+      auto x1 = t[w + 1];
+      t[w] = (x0 & 0x00000000FFFFFFFFULL) | (x1 << 32);
+      t[w + 1] = (x0 >> 32) | (x1 & 0xFFFFFFFF00000000ULL);
+    }
+  }
+  else {
+    SizeType a = 1 << (v - 6);
+    SizeType b = a << 1;
+    for ( SizeType w = 0; w < nw; ++ w ) {
+      if ( (w & a) != 0 && (w & b) == 0 ) {
+	std::swap(t[w], t[w + a]);
+      }
+    }
+  }
+}
+
+// 葉のリスト from 上の真理値表を葉のリスト to 上の真理値表に変換する．
+// from は to の部分集合でなければならない．
+void
+tt_expand(
+  std::uint64_t* t,
+  SizeType nw,
+  const std::uint32_t* from,
+  SizeType from_n,
+  const std::uint32_t* to,
+  SizeType to_n
+)
+{
+  SizeType pos_list[MAX_CUT_SIZE];
+  SizeType j = 0;
+  for ( SizeType i = 0; i < from_n; ++ i ) {
+    while ( to[j] != from[i] ) {
+      ++ j;
+    }
+    pos_list[i] = j;
+  }
+  ASSERT_COND( j < to_n || from_n == 0 );
+  // 上の変数から順に移動させる．
+  for ( SizeType i = from_n; i -- > 0; ) {
+    for ( SizeType v = i; v < pos_list[i]; ++ v ) {
+      tt_swap(t, nw, v);
+    }
+  }
+}
+
+// 作業用のカット
+struct TmpCut
+{
+  std::uint64_t mSign;
+  SizeType mSize;
+  std::uint32_t mLeaves[MAX_CUT_SIZE];
+  SizeType mCut1; // 元になったファンイン1のカット番号
+  SizeType mCut2; // 元になったファンイン2のカット番号
+  bool mRemoved;
+};
+
+// a が b の部分集合の時 true を返す．
+bool
+is_subset(
+  const TmpCut& a,
+  const TmpCut& b
+)
+{
+  if ( a.mSize > b.mSize || (a.mSign & ~b.mSign) != 0 ) {
+    return false;
+  }
+  SizeType j = 0;
+  for ( SizeType i = 0; i < a.mSize; ++ i ) {
+    while ( j < b.mSize && b.mLeaves[j] < a.mLeaves[i] ) {
+      ++ j;
+    }
+    if ( j == b.mSize || b.mLeaves[j] != a.mLeaves[i] ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// スレッドごとの作業領域
+struct ThreadBuf
+{
+  vector<std::uint64_t> mSignList;
+  vector<std::uint32_t> mSizeList;
+  vector<SizeType> mLeafBeginList;
+  vector<std::uint32_t> mLeafList;
+  vector<std::uint64_t> mTruthList;
+  vector<TmpCut> mCandList;
+
+  void
+  clear()
+  {
+    mSignList.clear();
+    mSizeList.clear();
+    mLeafBeginList.clear();
+    mLeafList.clear();
+    mTruthList.clear();
+  }
+};
+
+END_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// クラス AigCuts
+//////////////////////////////////////////////////////////////////////
+
+// @brief カットの葉のリストを返す．
+vector<SizeType>
+AigCuts::leaf_list(
+  SizeType var,
+  SizeType k
+) const
+{
+  auto& cut = _cut(var, k);
+  vector<SizeType> ans_list(mLeafArray.begin() + cut.mLeafBegin,
+			    mLeafArray.begin() + cut.mLeafBegin + cut.mSize);
+  return ans_list;
+}
+
+// @brief カットの真理値表を返す．
+vector<std::uint64_t>
+AigCuts::truth_table(
+  SizeType var,
+  SizeType k
+) const
+{
+  auto ptr = truth_ptr(var, k);
+  if ( ptr == nullptr ) {
+    return {};
+  }
+  return vector<std::uint64_t>(ptr, ptr + mTruthWordNum);
+}
+
+// @brief カットを列挙する．
+void
+AigCuts::enumerate(
+  const ModelImpl& model,
+  const AigCutOpt& opt
+)
+{
+  if ( opt.cut_size < 1 || opt.cut_size > MAX_CUT_SIZE ) {
+    ostringstream buf;
+    buf << "enumerate_cuts: cut_size(" << opt.cut_size
+	<< ") must be between 1 and " << MAX_CUT_SIZE << ".";
+    throw std::invalid_argument{buf.str()};
+  }
+
+  auto order_list = model.and_topo_order();
+  VarMap var_map{model};
+
+  auto K = opt.cut_size;
+  auto limit = std::max<SizeType>(opt.cut_limit, 1);
+  SizeType nw = 0;
+  if ( opt.truth_table ) {
+    nw = K <= 6 ? 1 : (1 << (K - 6));
+  }
+  mCutSize = K;
+  mTruthWordNum = nw;
+  mNodeList.clear();
+  mNodeList.resize(var_map.var_num());
+  mCutArray.clear();
+  mLeafArray.clear();
+  mTruthArray.clear();
+  mCutArray.reserve(model.A() * 4);
+  mLeafArray.reserve(model.A() * 8);
+
+  // 自明なカットを追加する．
+  auto add_trivial = [&](SizeType var) {
+    auto& node = mNodeList[var];
+    node.mCutBegin = mCutArray.size();
+    node.mCutNum = 1;
+    if ( var == 0 ) {
+      // 定数ノードは葉を持たない．
+      mCutArray.push_back(Cut{0, mLeafArray.size(), 0});
+      mTruthArray.resize(mTruthArray.size() + nw, 0ULL);
+    }
+    else {
+      mCutArray.push_back(Cut{1ULL << (var % 64), mLeafArray.size(), 1});
+      mLeafArray.push_back(var);
+      auto n0 = mTruthArray.size();
+      mTruthArray.resize(n0 + nw);
+      if ( nw > 0 ) {
+	tt_var(&mTruthArray[n0], nw, 0);
+      }
+    }
+  };
+  add_trivial(0);
+  for ( SizeType i = 0; i < model.I(); ++ i ) {
+    add_trivial(model.input(i) / 2);
+  }
+  for ( SizeType i = 0; i < model.L(); ++ i ) {
+    add_trivial(model.latch(i) / 2);
+  }
+
+  // レベルごとに分ける．
+  vector<vector<SizeType>> level_list;
+  for ( auto pos: order_list ) {
+    auto var = model.and_node(pos) / 2;
+    std::uint32_t lv = 0;
+    for ( auto lit: {model.and_src1(pos), model.and_src2(pos)} ) {
+      lv = std::max(lv, mNodeList[lit / 2].mLevel);
+    }
+    ++ lv;
+    mNodeList[var].mLevel = lv;
+    if ( level_list.size() < lv ) {
+      level_list.resize(lv);
+    }
+    level_list[lv - 1].push_back(pos);
+  }
+
+  WorkPool pool{opt.thread_num};
+  vector<ThreadBuf> buf_list(pool.thread_num());
+  // ノードごとの (スレッド番号, 先頭位置, カット数)
+  struct Loc {
+    SizeType mTid;
+    SizeType mBegin;
+    SizeType mNum;
+  };
+  vector<Loc> loc_list;
+
+  // ノードのカットを作る．
+  auto make_cuts = [&](SizeType pos, ThreadBuf& buf) {
+    auto lit1 = model.and_src1(pos);
+    auto lit2 = model.and_src2(pos);
+    auto& node1 = mNodeList[lit1 / 2];
+    auto& node2 = mNodeList[lit2 / 2];
+    auto& cand_list = buf.mCandList;
+    cand_list.clear();
+    for ( SizeType k1 = 0; k1 < node1.mCutNum; ++ k1 ) {
+      auto& cut1 = mCutArray[node1.mCutBegin + k1];
+      for ( SizeType k2 = 0; k2 < node2.mCutNum; ++ k2 ) {
+	auto& cut2 = mCutArray[node2.mCutBegin + k2];
+	TmpCut cut;
+	cut.mSign = cut1.mSign | cut2.mSign;
+	if ( static_cast<SizeType>(__builtin_popcountll(cut.mSign)) > K ) {
+	  continue;
+	}
+	// 葉のリストをマージする．
+	auto leaves1 = &mLeafArray[cut1.mLeafBegin];
+	auto leaves2 = &mLeafArray[cut2.mLeafBegin];
+	SizeType i1 = 0;
+	SizeType i2 = 0;
+	SizeType n = 0;
+	bool over = false;
+	while ( i1 < cut1.mSize || i2 < cut2.mSize ) {
+	  if ( n == K ) {
+	    over = true;
+	    break;
+	  }
+	  if ( i2 == cut2.mSize ||
+	       (i1 < cut1.mSize && leaves1[i1] < leaves2[i2]) ) {
+	    cut.mLeaves[n] = leaves1[i1];
+	    ++ i1;
+	  }
+	  else if ( i1 == cut1.mSize || leaves2[i2] < leaves1[i1] ) {
+	    cut.mLeaves[n] = leaves2[i2];
+	    ++ i2;
+	  }
+	  else {
+	    cut.mLeaves[n] = leaves1[i1];
+	    ++ i1;
+	    ++ i2;
+	  }
+	  ++ n;
+	}
+	if ( over ) {
+	  continue;
+	}
+	cut.mSize = n;
+	cut.mCut1 = node1.mCutBegin + k1;
+	cut.mCut2 = node2.mCutBegin + k2;
+	cut.mRemoved = false;
+
+	// 候補は葉の数の昇順に高々 limit 個保持する．
+	// 満杯で最大のものより小さくなければ調べるまでもない．
+	if ( cand_list.size() >= limit && cut.mSize >= cand_list.back().mSize ) {
+	  continue;
+	}
+
+	// 支配関係による削除
+	bool dominated = false;
+	for ( auto& cut0: cand_list ) {
+	  if ( cut0.mSize <= cut.mSize ) {
+	    if ( is_subset(cut0, cut) ) {
+	      dominated = true;
+	      break;
+	    }
+	  }
+	  else if ( is_subset(cut, cut0) ) {
+	    cut0.mRemoved = true;
+	  }
+	}
+	if ( dominated ) {
+	  continue;
+	}
+	cand_list.erase(std::remove_if(cand_list.begin(), cand_list.end(),
+				       [](const TmpCut& cut) {
+					 return cut.mRemoved;
+				       }),
+			cand_list.end());
+	// 同じ大きさのものの後ろに挿入する．
+	auto p = std::upper_bound(cand_list.begin(), cand_list.end(), cut,
+				  [](const TmpCut& a, const TmpCut& b) {
+				    return a.mSize < b.mSize;
+				  });
+	cand_list.insert(p, cut);
+	if ( cand_list.size() > limit ) {
+	  cand_list.pop_back();
+	}
+      }
+    }
+
+    // 自明なカットを先頭に置く．
+    auto var = model.and_node(pos) / 2;
+    auto begin = buf.mSizeList.size();
+    buf.mSignList.push_back(1ULL << (var % 64));
+    buf.mSizeList.push_back(1);
+    buf.mLeafBeginList.push_back(buf.mLeafList.size());
+    buf.mLeafList.push_back(var);
+    if ( nw > 0 ) {
+      auto n0 = buf.mTruthList.size();
+      buf.mTruthList.resize(n0 + nw);
+      tt_var(&buf.mTruthList[n0], nw, 0);
+    }
+    for ( auto& cut: cand_list ) {
+      buf.mSignList.push_back(cut.mSign);
+      buf.mSizeList.push_back(cut.mSize);
+      buf.mLeafBeginList.push_back(buf.mLeafList.size());
+      for ( SizeType i = 0; i < cut.mSize; ++ i ) {
+	buf.mLeafList.push_back(cut.mLeaves[i]);
+      }
+      if ( nw > 0 ) {
+	std::uint64_t t1[MAX_WORD_NUM];
+	std::uint64_t t2[MAX_WORD_NUM];
+	auto& cut1 = mCutArray[cut.mCut1];
+	auto& cut2 = mCutArray[cut.mCut2];
+	for ( SizeType w = 0; w < nw; ++ w ) {
+	  t1[w] = mTruthArray[cut.mCut1 * nw + w];
+	  t2[w] = mTruthArray[cut.mCut2 * nw + w];
+	}
+	tt_expand(t1, nw, &mLeafArray[cut1.mLeafBegin], cut1.mSize,
+		  cut.mLeaves, cut.mSize);
+	tt_expand(t2, nw, &mLeafArray[cut2.mLeafBegin], cut2.mSize,
+		  cut.mLeaves, cut.mSize);
+	std::uint64_t inv1 = (lit1 % 2) ? ~0ULL : 0ULL;
+	std::uint64_t inv2 = (lit2 % 2) ? ~0ULL : 0ULL;
+	for ( SizeType w = 0; w < nw; ++ w ) {
+	  buf.mTruthList.push_back((t1[w] ^ inv1) & (t2[w] ^ inv2));
+	}
+      }
+    }
+    return Loc{0, begin, buf.mSizeList.size() - begin};
+  };
+
+  for ( auto& node_list: level_list ) {
+    auto n = node_list.size();
+    loc_list.resize(n);
+    for ( auto& buf: buf_list ) {
+      buf.clear();
+    }
+    // 同じレベルのノードは互いに独立なので並列に処理できる．
+    auto chunk_num = (n + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    pool.run(chunk_num, [&](SizeType c, SizeType tid) {
+      auto& buf = buf_list[tid];
+      auto end = std::min(n, (c + 1) * CHUNK_SIZE);
+      for ( auto i = c * CHUNK_SIZE; i < end; ++ i ) {
+	loc_list[i] = make_cuts(node_list[i], buf);
+	loc_list[i].mTid = tid;
+      }
+    });
+
+    // スレッドごとの結果をノードの順にまとめる．
+    for ( SizeType i = 0; i < n; ++ i ) {
+      auto& loc = loc_list[i];
+      auto& buf = buf_list[loc.mTid];
+      auto var = model.and_node(node_list[i]) / 2;
+      auto& node = mNodeList[var];
+      node.mCutBegin = mCutArray.size();
+      node.mCutNum = loc.mNum;
+      for ( SizeType k = 0; k < loc.mNum; ++ k ) {
+	auto id = loc.mBegin + k;
+	auto size = buf.mSizeList[id];
+	auto lb = buf.mLeafBeginList[id];
+	mCutArray.push_back(Cut{buf.mSignList[id], mLeafArray.size(), size});
+	mLeafArray.insert(mLeafArray.end(),
+			  buf.mLeafList.begin() + lb,
+			  buf.mLeafList.begin() + lb + size);
+	mTruthArray.insert(mTruthArray.end(),
+			   buf.mTruthList.begin() + id * nw,
+			   buf.mTruthList.begin() + (id + 1) * nw);
+      }
+    }
+  }
+}
+
+END_NAMESPACE_YM_AIG
@@ -0,0 +1,140 @@
+
+/// @file AigDominators.cc
+/// @brief AigDominators の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigDominators.h"
+#include "ModelImpl.h"
+#include "VarMap.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+BEGIN_NONAMESPACE
+
+// 未定義を表す値
+const SizeType UNDEF = static_cast<SizeType>(-1);
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス AigDominators
+//////////////////////////////////////////////////////////////////////
+
+// @brief 支配木と MFFC の大きさを求める．
+void
+AigDominators::compute(
+  const ModelImpl& model
+)
+{
+  auto order_list = model.and_topo_order();
+  VarMap var_map{model};
+  auto var_num = var_map.var_num();
+  // 仮想的な根
+  auto root = var_num;
+
+  // 根に近い方から直接支配ノードを求める．
+  // 変数 v のファンアウトは全て処理済みなので，ファンアウトの
+  // 支配ノードの共通祖先を順次求めれば直接支配ノードとなる．
+  // 共通祖先は深さを比べながら支配木をたどって求める．
+  mIdom.assign(var_num, UNDEF);
+  vector<SizeType> depth_list(var_num + 1, 0);
+  for ( SizeType i = 0; i < model.O(); ++ i ) {
+    mIdom[model.output_src(i) / 2] = root;
+  }
+  for ( SizeType i = 0; i < model.L(); ++ i ) {
+    mIdom[model.latch_src(i) / 2] = root;
+  }
+  auto intersect = [&](SizeType var1, SizeType var2) {
+    while ( var1 != var2 ) {
+      auto d1 = depth_list[var1];
+      auto d2 = depth_list[var2];
+      if ( d1 >= d2 ) {
+	var1 = mIdom[var1];
+      }
+      if ( d2 >= d1 ) {
+	var2 = mIdom[var2];
+      }
+    }
+    return var1;
+  };
+  auto finalize = [&](SizeType var) {
+    // どこにもつながっていない変数は根に直接つなぐ．
+    if ( mIdom[var] == UNDEF ) {
+      mIdom[var] = root;
+    }
+    depth_list[var] = depth_list[mIdom[var]] + 1;
+  };
+  auto meet = [&](SizeType var, SizeType fanout) {
+    if ( mIdom[var] == UNDEF ) {
+      mIdom[var] = fanout;
+    }
+    else {
+      mIdom[var] = intersect(mIdom[var], fanout);
+    }
+  };
+  for ( auto p = order_list.rbegin(); p != order_list.rend(); ++ p ) {
+    auto pos = *p;
+    auto var = model.and_node(pos) / 2;
+    finalize(var);
+    meet(model.and_src1(pos) / 2, var);
+    meet(model.and_src2(pos) / 2, var);
+  }
+  for ( SizeType var = 0; var < var_num; ++ var ) {
+    if ( var_map.kind(var) != VarMap::AND ) {
+      finalize(var);
+    }
+  }
+  depth_list.resize(var_num);
+  mDepth.swap(depth_list);
+
+  // 入力側から部分木の大きさと MFFC の大きさを集計する．
+  // ANDノード以外は支配木の葉となる．
+  mTreeSize.assign(var_num, 0);
+  mMffcSize.assign(var_num, 0);
+  for ( SizeType var = 0; var < var_num; ++ var ) {
+    if ( var_map.kind(var) != VarMap::AND ) {
+      mTreeSize[var] = 1;
+      auto parent = mIdom[var];
+      if ( parent != root ) {
+	++ mTreeSize[parent];
+      }
+    }
+  }
+  for ( auto pos: order_list ) {
+    auto var = model.and_node(pos) / 2;
+    ++ mTreeSize[var];
+    ++ mMffcSize[var];
+    auto parent = mIdom[var];
+    if ( parent != root ) {
+      mTreeSize[parent] += mTreeSize[var];
+      mMffcSize[parent] += mMffcSize[var];
+    }
+  }
+
+  // 根に近い方から先行順の番号を割り当てる．
+  // next_list[v] は v の次の子供に割り当てる番号を表す．
+  mPreOrder.assign(var_num, 0);
+  vector<SizeType> next_list(var_num + 1, 0);
+  auto assign = [&](SizeType var) {
+    auto parent = mIdom[var];
+    auto id = next_list[parent];
+    mPreOrder[var] = id;
+    next_list[parent] += mTreeSize[var];
+    next_list[var] = id + 1;
+  };
+  for ( auto p = order_list.rbegin(); p != order_list.rend(); ++ p ) {
+    assign(model.and_node(*p) / 2);
+  }
+  for ( SizeType var = 0; var < var_num; ++ var ) {
+    if ( var_map.kind(var) != VarMap::AND ) {
+      assign(var);
+    }
+  }
+}
+
+END_NAMESPACE_YM_AIG
@@ -0,0 +1,249 @@
+
+/// @file AigEquivClasses.cc
+/// @brief AigEquivClasses の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigEquivClasses.h"
+#include "ModelImpl.h"
+#include "BitSim.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+BEGIN_NONAMESPACE
+
+// クラスに属さないことを表す値
+const std::uint32_t NO_CLASS = 0xFFFFFFFFU;
+
+// ハッシュ値に x を混ぜる．
+inline
+std::uint64_t
+hash_mix(
+  std::uint64_t h,
+  std::uint64_t x
+)
+{
+  h = (h ^ x) * 0x9E3779B97F4A7C15ULL;
+  return h ^ (h >> 32);
+}
+
+// ハッシュ表の要素
+struct Slot
+{
+  std::uint64_t mHash;
+  std::uint32_t mRep;      // 最初に登録された変数
+  std::uint32_t mNewClass; // 新しいクラス番号
+};
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス AigEquivClasses
+//////////////////////////////////////////////////////////////////////
+
+// @brief クラスの要素のリストを返す．
+vector<SizeType>
+AigEquivClasses::class_lit_list(
+  SizeType id
+) const
+{
+  ASSERT_COND( 0 <= id && id < class_num() );
+  vector<SizeType> ans_list(mLitArray.begin() + mClassBegin[id],
+			    mLitArray.begin() + mClassBegin[id + 1]);
+  return ans_list;
+}
+
+// @brief 内容を出力する．
+void
+AigEquivClasses::print(
+  ostream& s
+) const
+{
+  for ( SizeType id = 0; id < class_num(); ++ id ) {
+    s << "#" << id << ":";
+    for ( SizeType i = 0; i < class_size(id); ++ i ) {
+      s << " " << class_lit(id, i);
+    }
+    s << endl;
+  }
+}
+
+// @brief 等価候補のクラスを求める．
+void
+AigEquivClasses::compute(
+  const ModelImpl& model,
+  const AigEquivOpt& opt
+)
+{
+  BitSim sim{model, opt.word_num, opt.thread_num};
+  auto var_num = sim.var_num();
+  auto nw = sim.word_num();
+
+  // 代表を選ぶ順番に並べた変数のリスト
+  vector<SizeType> var_list;
+  var_list.reserve(model.I() + model.L() + model.A() + 1);
+  var_list.push_back(0);
+  for ( SizeType i = 0; i < model.I(); ++ i ) {
+    var_list.push_back(model.input(i) / 2);
+  }
+  for ( SizeType i = 0; i < model.L(); ++ i ) {
+    var_list.push_back(model.latch(i) / 2);
+  }
+  for ( auto pos: model.and_topo_order() ) {
+    var_list.push_back(model.and_node(pos) / 2);
+  }
+
+  // 全ての変数が同じクラスから始める．
+  vector<std::uint32_t> class_list(var_num, NO_CLASS);
+  for ( auto var: var_list ) {
+    class_list[var] = 0;
+  }
+  vector<std::uint32_t> new_class_list(var_num, NO_CLASS);
+  // 最初のラウンドでの極性
+  // 値の先頭のビットが 1 のものを反転させて比較する．
+  vector<std::uint8_t> phase0(var_num, 0);
+  vector<Slot> table;
+  vector<std::uint32_t> count_list;
+  auto cand_num = var_list.size();
+
+  auto round_num = std::max<SizeType>(opt.round_num, 1);
+  for ( SizeType r = 0; r < round_num && cand_num > 0; ++ r ) {
+    // 入力とラッチに乱数を与える．
+    for ( SizeType i = 1; i < model.I() + model.L() + 1; ++ i ) {
+      auto var = var_list[i];
+      auto v = sim.value(var);
+      for ( SizeType w = 0; w < nw; ++ w ) {
+	v[w] = BitSim::random_word(opt.seed, (r * var_num + var) * nw + w);
+      }
+    }
+    sim.simulate();
+
+    // (旧クラス，極性，正規化した値) が等しいものを新しいクラスにする．
+    SizeType size = 1;
+    while ( size < cand_num * 2 ) {
+      size <<= 1;
+    }
+    auto mask = size - 1;
+    table.assign(size, Slot{0, NO_CLASS, 0});
+    std::uint32_t new_class_num = 0;
+    for ( auto var: var_list ) {
+      auto c = class_list[var];
+      if ( c == NO_CLASS ) {
+	continue;
+      }
+      auto v = sim.value(var);
+      auto p = static_cast<std::uint8_t>(v[0] & 1);
+      if ( r == 0 ) {
+	phase0[var] = p;
+      }
+      auto d = p ^ phase0[var];
+      std::uint64_t inv = p ? ~0ULL : 0ULL;
+      std::uint64_t h = hash_mix(c, d);
+      for ( SizeType w = 0; w < nw; ++ w ) {
+	h = hash_mix(h, v[w] ^ inv);
+      }
+      auto equal = [&](SizeType rep) {
+	if ( class_list[rep] != c ) {
+	  return false;
+	}
+	auto v1 = sim.value(rep);
+	auto p1 = static_cast<std::uint8_t>(v1[0] & 1);
+	if ( (p1 ^ phase0[rep]) != d ) {
+	  return false;
+	}
+	std::uint64_t inv1 = p1 ? ~0ULL : 0ULL;
+	for ( SizeType w = 0; w < nw; ++ w ) {
+	  if ( (v[w] ^ inv) != (v1[w] ^ inv1) ) {
+	    return false;
+	  }
+	}
+	return true;
+      };
+      for ( auto idx = h & mask; ; idx = (idx + 1) & mask ) {
+	auto& slot = table[idx];
+	if ( slot.mRep == NO_CLASS ) {
+	  slot.mHash = h;
+	  slot.mRep = var;
+	  slot.mNewClass = new_class_num;
+	  new_class_list[var] = new_class_num;
+	  ++ new_class_num;
+	  break;
+	}
+	if ( slot.mHash == h && equal(slot.mRep) ) {
+	  new_class_list[var] = slot.mNewClass;
+	  break;
+	}
+      }
+    }
+
+    // 要素が1つのクラスは以降の対象から外す．
+    count_list.assign(new_class_num, 0);
+    for ( auto var: var_list ) {
+      if ( class_list[var] != NO_CLASS ) {
+	++ count_list[new_class_list[var]];
+      }
+    }
+    cand_num = 0;
+    for ( auto var: var_list ) {
+      if ( class_list[var] == NO_CLASS ) {
+	continue;
+      }
+      auto c = new_class_list[var];
+      if ( count_list[c] == 1 ) {
+	class_list[var] = NO_CLASS;
+      }
+      else {
+	class_list[var] = c;
+	++ cand_num;
+      }
+    }
+  }
+
+  // クラスごとにまとめる．
+  // 最初に現れた変数が代表となる．
+  vector<std::uint32_t> rep_list(count_list.size(), NO_CLASS);
+  vector<std::uint32_t> id_list(count_list.size(), NO_CLASS);
+  mMergeMap.resize(var_num);
+  for ( SizeType var = 0; var < var_num; ++ var ) {
+    mMergeMap[var] = var * 2;
+  }
+  mClassBegin.assign(1, 0);
+  SizeType class_num = 0;
+  for ( auto var: var_list ) {
+    auto c = class_list[var];
+    if ( c == NO_CLASS ) {
+      continue;
+    }
+    if ( rep_list[c] == NO_CLASS ) {
+      rep_list[c] = var;
+      id_list[c] = class_num;
+      ++ class_num;
+      mClassBegin.push_back(count_list[c]);
+    }
+    else {
+      auto rep = rep_list[c];
+      mMergeMap[var] = rep * 2 + (phase0[var] ^ phase0[rep]);
+    }
+  }
+  for ( SizeType id = 0; id < class_num; ++ id ) {
+    mClassBegin[id + 1] += mClassBegin[id];
+  }
+  mLitArray.resize(mClassBegin[class_num]);
+  auto next_list = mClassBegin;
+  for ( auto var: var_list ) {
+    auto c = class_list[var];
+    if ( c == NO_CLASS ) {
+      continue;
+    }
+    auto id = id_list[c];
+    auto rep = rep_list[c];
+    mLitArray[next_list[id]] = var * 2 + (phase0[var] ^ phase0[rep]);
+    ++ next_list[id];
+  }
+}
+
+END_NAMESPACE_YM_AIG
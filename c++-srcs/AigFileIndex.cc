@@ -0,0 +1,356 @@
+
+/// @file AigFileIndex.cc
+/// @brief AigFileIndex の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigFileIndex.h"
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+BEGIN_NONAMESPACE
+
+// 索引ファイルのマジックナンバー
+const char IDX_MAGIC[8] = { 'Y', 'M', 'A', 'I', 'G', 'I', 'D', 'X' };
+
+// 索引ファイルのバージョン番号
+const std::uint64_t IDX_VERSION = 1;
+
+// 読み込み用のバッファサイズ
+const SizeType BUFF_SIZE = 1024 * 1024;
+
+// ファイルのサイズと更新時刻を得る．
+bool
+get_stat(
+  const string& filename,
+  SizeType& size,
+  SizeType& mtime
+)
+{
+  struct stat st;
+  if ( stat(filename.c_str(), &st) < 0 ) {
+    return false;
+  }
+  size = st.st_size;
+  mtime = static_cast<SizeType>(st.st_mtim.tv_sec) * 1000000000
+    + st.st_mtim.tv_nsec;
+  return true;
+}
+
+// エラーを送出する．
+void
+index_error(
+  const string& filename,
+  const string& msg
+)
+{
+  ostringstream buf;
+  buf << "AigFileIndex: " << filename << ": " << msg;
+  throw std::invalid_argument{buf.str()};
+}
+
+END_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// クラス AigFileIndex
+//////////////////////////////////////////////////////////////////////
+
+// @brief ファイルを走査して索引を作る．
+AigFileIndex
+AigFileIndex::build(
+  const string& filename,
+  SizeType interval
+)
+{
+  if ( interval == 0 ) {
+    index_error(filename, "interval must be positive");
+  }
+
+  AigFileIndex index;
+  index.mFilename = filename;
+  index.mInterval = interval;
+  if ( !get_stat(filename, index.mFileSize, index.mMTime) ) {
+    index_error(filename, "Could not open file");
+  }
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if ( fd < 0 ) {
+    index_error(filename, "Could not open file");
+  }
+
+  // 先頭から1バイトずつ状態遷移しながら走査する．
+  // - ヘッダ行を読む．
+  // - L + O 行を読み飛ばす．
+  // - 可変長整数の終端(最上位ビットが 0 のバイト)を数える．
+  //   ANDノード1つにつき2つの整数がある．
+  vector<char> buff(BUFF_SIZE);
+  string header;
+  bool in_header = true;
+  SizeType line_rest = 0;
+  SizeType num_rest = 0;
+  SizeType and_pos = 0;
+  bool num_start = true;
+  bool done = false;
+  SizeType offset = 0;
+  index.mOffsetList.clear();
+  while ( !done ) {
+    auto n = ::read(fd, buff.data(), buff.size());
+    if ( n < 0 ) {
+      if ( errno == EINTR ) {
+	continue;
+      }
+      ::close(fd);
+      index_error(filename, strerror(errno));
+    }
+    if ( n == 0 ) {
+      break;
+    }
+    for ( SizeType i = 0; i < static_cast<SizeType>(n); ++ i, ++ offset ) {
+      auto c = buff[i];
+      if ( in_header ) {
+	if ( c != '\n' ) {
+	  header += c;
+	  continue;
+	}
+	in_header = false;
+	if ( header.substr(0, 4) != "aig " ) {
+	  ::close(fd);
+	  index_error(filename, "Illegal header signature, 'aig' expected.");
+	}
+	istringstream tmp{header.substr(4, string::npos)};
+	SizeType M;
+	tmp >> M >> index.mI >> index.mL >> index.mO >> index.mA;
+	if ( !tmp || M != index.mI + index.mL + index.mA ) {
+	  ::close(fd);
+	  index_error(filename, "Illegal header line.");
+	}
+	line_rest = index.mL + index.mO;
+	num_rest = index.mA * 2;
+	if ( line_rest == 0 && num_rest == 0 ) {
+	  index.mOffsetList.push_back(offset + 1);
+	  done = true;
+	  break;
+	}
+      }
+      else if ( line_rest > 0 ) {
+	if ( c == '\n' ) {
+	  -- line_rest;
+	  if ( line_rest == 0 && num_rest == 0 ) {
+	    index.mOffsetList.push_back(offset + 1);
+	    done = true;
+	    break;
+	  }
+	}
+      }
+      else {
+	if ( num_start && num_rest % 2 == 0 && and_pos % interval == 0 ) {
+	  // ブロックの先頭
+	  index.mOffsetList.push_back(offset);
+	}
+	num_start = (c & 128) == 0;
+	if ( num_start ) {
+	  -- num_rest;
+	  if ( num_rest % 2 == 0 ) {
+	    ++ and_pos;
+	  }
+	  if ( num_rest == 0 ) {
+	    index.mOffsetList.push_back(offset + 1);
+	    done = true;
+	    break;
+	  }
+	}
+      }
+    }
+  }
+  ::close(fd);
+  if ( !done ) {
+    index_error(filename, "Unexpected EOF");
+  }
+  return index;
+}
+
+// @brief 索引を得る．
+AigFileIndex
+AigFileIndex::open(
+  const string& filename,
+  SizeType interval
+)
+{
+  AigFileIndex index;
+  if ( index.load(filename) ) {
+    return index;
+  }
+  index = build(filename, interval);
+  try {
+    index.save();
+  }
+  catch ( std::invalid_argument& ) {
+    // 読み出し専用のディレクトリなどでは保存できなくてもよい．
+  }
+  return index;
+}
+
+// @brief 索引ファイル名を返す．
+string
+AigFileIndex::index_filename(
+  const string& filename
+)
+{
+  return filename + ".idx";
+}
+
+// @brief 索引ファイルに保存する．
+void
+AigFileIndex::save() const
+{
+  auto idx_filename = index_filename(mFilename);
+  ofstream s{idx_filename, std::ios::binary};
+  if ( !s ) {
+    index_error(idx_filename, "Could not create file");
+  }
+  vector<std::uint64_t> head{
+    IDX_VERSION, mFileSize, mMTime, mI, mL, mO, mA, mInterval,
+    mOffsetList.size()
+  };
+  s.write(IDX_MAGIC, sizeof(IDX_MAGIC));
+  s.write(reinterpret_cast<const char*>(head.data()),
+	  head.size() * sizeof(std::uint64_t));
+  vector<std::uint64_t> offset_list(mOffsetList.begin(), mOffsetList.end());
+  s.write(reinterpret_cast<const char*>(offset_list.data()),
+	  offset_list.size() * sizeof(std::uint64_t));
+  if ( !s ) {
+    index_error(idx_filename, "Write error");
+  }
+}
+
+// @brief 索引ファイルを読み込む．
+bool
+AigFileIndex::load(
+  const string& filename
+)
+{
+  SizeType size;
+  SizeType mtime;
+  if ( !get_stat(filename, size, mtime) ) {
+    return false;
+  }
+  ifstream s{index_filename(filename), std::ios::binary};
+  if ( !s ) {
+    return false;
+  }
+  char magic[sizeof(IDX_MAGIC)];
+  std::uint64_t head[9];
+  s.read(magic, sizeof(magic));
+  s.read(reinterpret_cast<char*>(head), sizeof(head));
+  if ( !s || memcmp(magic, IDX_MAGIC, sizeof(IDX_MAGIC)) != 0 ) {
+    return false;
+  }
+  if ( head[0] != IDX_VERSION || head[1] != size || head[2] != mtime ) {
+    // 元のファイルが変更されている．
+    return false;
+  }
+  auto interval = head[7];
+  auto offset_num = head[8];
+  auto A = head[6];
+  if ( interval == 0 || offset_num != (A + interval - 1) / interval + 1 ) {
+    return false;
+  }
+  vector<std::uint64_t> offset_list(offset_num);
+  s.read(reinterpret_cast<char*>(offset_list.data()),
+	 offset_num * sizeof(std::uint64_t));
+  if ( !s ) {
+    return false;
+  }
+  mFilename = filename;
+  mFileSize = size;
+  mMTime = mtime;
+  mI = head[3];
+  mL = head[4];
+  mO = head[5];
+  mA = A;
+  mInterval = interval;
+  mOffsetList.assign(offset_list.begin(), offset_list.end());
+  return true;
+}
+
+// @brief ANDノードの範囲を復号する．
+vector<SizeType>
+AigFileIndex::read_ands(
+  SizeType pos,
+  SizeType num
+) const
+{
+  ASSERT_COND( pos + num <= mA );
+
+  vector<SizeType> ans_list;
+  if ( num == 0 ) {
+    return ans_list;
+  }
+  ans_list.reserve(num * 3);
+
+  auto kb = pos / mInterval;
+  auto ke = (pos + num + mInterval - 1) / mInterval;
+  auto begin = mOffsetList[kb];
+  auto end = mOffsetList[ke];
+  vector<std::uint8_t> buff(end - begin);
+
+  int fd = ::open(mFilename.c_str(), O_RDONLY);
+  if ( fd < 0 ) {
+    index_error(mFilename, "Could not open file");
+  }
+  SizeType n = 0;
+  while ( n < buff.size() ) {
+    auto m = ::pread(fd, buff.data() + n, buff.size() - n, begin + n);
+    if ( m < 0 && errno == EINTR ) {
+      continue;
+    }
+    if ( m <= 0 ) {
+      ::close(fd);
+      index_error(mFilename, m < 0 ? strerror(errno) : "Unexpected EOF");
+    }
+    n += m;
+  }
+  ::close(fd);
+
+  SizeType offset = 0;
+  auto get_number = [&]() {
+    SizeType num = 0;
+    for ( SizeType shift = 0; ; shift += 7 ) {
+      if ( offset >= buff.size() ) {
+	index_error(mFilename, "Broken index");
+      }
+      SizeType c = buff[offset];
+      ++ offset;
+      num |= (c & 127) << shift;
+      if ( (c & 128) == 0 ) {
+	break;
+      }
+    }
+    return num;
+  };
+  auto base_lit = (mI + mL + 1) * 2;
+  for ( auto i = kb * mInterval; i < pos + num; ++ i ) {
+    auto d0 = get_number();
+    auto d1 = get_number();
+    if ( i < pos ) {
+      continue;
+    }
+    auto lit = base_lit + i * 2;
+    auto src1 = lit - d0;
+    auto src2 = src1 - d1;
+    ans_list.push_back(lit);
+    ans_list.push_back(src1);
+    ans_list.push_back(src2);
+  }
+  return ans_list;
+}
+
+END_NAMESPACE_YM_AIG
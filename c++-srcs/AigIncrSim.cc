@@ -0,0 +1,247 @@
+
+/// @file AigIncrSim.cc
+/// @brief AigIncrSim の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigIncrSim.h"
+#include "ModelImpl.h"
+#include "VarMap.h"
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+// クラス AigIncrSim
+//////////////////////////////////////////////////////////////////////
+
+// @brief 初期化する．
+void
+AigIncrSim::initialize(
+  const ModelImpl& model
+)
+{
+  auto order_list = model.and_topo_order();
+  VarMap var_map{model};
+  auto var_num = var_map.var_num();
+  // リテラルとファンアウトの枝数(ANDノード数の2倍以下)を
+  // 32 ビットで表せるように変数の数を制限する．
+  if ( var_num >= (SizeType{1} << 31) ) {
+    throw std::invalid_argument{"AigIncrSim: too many variables."};
+  }
+  if ( model.O() >= (SizeType{1} << 32) ) {
+    throw std::invalid_argument{"AigIncrSim: too many outputs."};
+  }
+
+  // ファンインとレベルを求める．
+  mFaninArray.assign(var_num * 2, 0);
+  mLevelArray.assign(var_num, 0);
+  std::uint32_t max_level = 0;
+  for ( auto pos: order_list ) {
+    auto var = model.and_node(pos) / 2;
+    auto lit1 = model.and_src1(pos);
+    auto lit2 = model.and_src2(pos);
+    mFaninArray[var * 2 + 0] = lit1;
+    mFaninArray[var * 2 + 1] = lit2;
+    auto lv = std::max(mLevelArray[lit1 / 2], mLevelArray[lit2 / 2]) + 1;
+    mLevelArray[var] = lv;
+    max_level = std::max(max_level, lv);
+  }
+
+  // ファンアウトの表を作る．
+  // 同じ変数が両方のファンインになっている場合は1つだけ登録する．
+  mFanoutBegin.assign(var_num + 1, 0);
+  for ( auto pos: order_list ) {
+    auto var1 = model.and_src1(pos) / 2;
+    auto var2 = model.and_src2(pos) / 2;
+    ++ mFanoutBegin[var1 + 1];
+    if ( var2 != var1 ) {
+      ++ mFanoutBegin[var2 + 1];
+    }
+  }
+  for ( SizeType var = 0; var < var_num; ++ var ) {
+    mFanoutBegin[var + 1] += mFanoutBegin[var];
+  }
+  mFanoutArray.resize(mFanoutBegin[var_num]);
+  {
+    vector<std::uint32_t> next_list(mFanoutBegin.begin(), mFanoutBegin.end() - 1);
+    for ( auto pos: order_list ) {
+      auto var = model.and_node(pos) / 2;
+      auto var1 = model.and_src1(pos) / 2;
+      auto var2 = model.and_src2(pos) / 2;
+      mFanoutArray[next_list[var1]] = var;
+      ++ next_list[var1];
+      if ( var2 != var1 ) {
+	mFanoutArray[next_list[var2]] = var;
+	++ next_list[var2];
+      }
+    }
+  }
+
+  // 出力の表を作る．
+  auto O = model.O();
+  mOutputBegin.assign(var_num + 1, 0);
+  for ( SizeType i = 0; i < O; ++ i ) {
+    ++ mOutputBegin[model.output_src(i) / 2 + 1];
+  }
+  for ( SizeType var = 0; var < var_num; ++ var ) {
+    mOutputBegin[var + 1] += mOutputBegin[var];
+  }
+  mOutputArray.resize(O);
+  {
+    vector<std::uint32_t> next_list(mOutputBegin.begin(), mOutputBegin.end() - 1);
+    for ( SizeType i = 0; i < O; ++ i ) {
+      auto var = model.output_src(i) / 2;
+      mOutputArray[next_list[var]] = i;
+      ++ next_list[var];
+    }
+  }
+
+  mInputList.resize(model.I());
+  for ( SizeType i = 0; i < model.I(); ++ i ) {
+    mInputList[i] = model.input(i) / 2;
+  }
+  mLatchList.resize(model.L());
+  mLatchSrcList.resize(model.L());
+  for ( SizeType i = 0; i < model.L(); ++ i ) {
+    mLatchList[i] = model.latch(i) / 2;
+    mLatchSrcList[i] = model.latch_src(i);
+  }
+  mOutputSrcList.resize(O);
+  for ( SizeType i = 0; i < O; ++ i ) {
+    mOutputSrcList[i] = model.output_src(i);
+  }
+
+  // 全ての入力とラッチを 0 として計算しておく．
+  mValArray.assign(var_num, 0ULL);
+  for ( auto pos: order_list ) {
+    auto var = model.and_node(pos) / 2;
+    mValArray[var] = lit_value(mFaninArray[var * 2 + 0])
+      & lit_value(mFaninArray[var * 2 + 1]);
+  }
+  mOutputValList.resize(O);
+  for ( SizeType i = 0; i < O; ++ i ) {
+    mOutputValList[i] = output_value(i);
+  }
+
+  mBucketList.clear();
+  mBucketList.resize(max_level + 1);
+  mQueued.assign(var_num, false);
+  mCandList.clear();
+  mCandMark.assign(O, false);
+  mChangedList.clear();
+  mMinLevel = mBucketList.size();
+  mMaxLevel = 0;
+  mEvalNum = 0;
+}
+
+// @brief 入力かラッチの値を設定する．
+void
+AigIncrSim::set_value(
+  SizeType var,
+  std::uint64_t val
+)
+{
+  if ( mValArray[var] == val ) {
+    return;
+  }
+  mValArray[var] = val;
+  schedule_fanouts(var);
+  mark_outputs(var);
+}
+
+// @brief 変化を伝搬させる．
+const vector<SizeType>&
+AigIncrSim::update()
+{
+  mChangedList.clear();
+  mEvalNum = 0;
+  // ファンアウトのレベルは必ず大きいので，
+  // 処理中のバケツに要素が追加されることはない．
+  for ( auto lv = mMinLevel; lv <= mMaxLevel && lv < mBucketList.size(); ++ lv ) {
+    auto& bucket = mBucketList[lv];
+    for ( auto var: bucket ) {
+      mQueued[var] = false;
+      auto val = lit_value(mFaninArray[var * 2 + 0])
+	& lit_value(mFaninArray[var * 2 + 1]);
+      ++ mEvalNum;
+      if ( val != mValArray[var] ) {
+	mValArray[var] = val;
+	schedule_fanouts(var);
+	mark_outputs(var);
+      }
+    }
+    bucket.clear();
+  }
+  mMinLevel = mBucketList.size();
+  mMaxLevel = 0;
+
+  // 変化の候補の出力を前回の値と比較する．
+  for ( auto pos: mCandList ) {
+    mCandMark[pos] = false;
+    auto val = output_value(pos);
+    if ( val != mOutputValList[pos] ) {
+      mOutputValList[pos] = val;
+      mChangedList.push_back(pos);
+    }
+  }
+  mCandList.clear();
+  std::sort(mChangedList.begin(), mChangedList.end());
+  return mChangedList;
+}
+
+// @brief ラッチの値を次状態の値で置き換えて update() を行う．
+const vector<SizeType>&
+AigIncrSim::step()
+{
+  // 次状態が他のラッチの値を参照している場合があるので
+  // 一旦全て取り出してから書き込む．
+  auto L = latch_num();
+  vector<std::uint64_t> next_list(L);
+  for ( SizeType i = 0; i < L; ++ i ) {
+    next_list[i] = latch_next_value(i);
+  }
+  for ( SizeType i = 0; i < L; ++ i ) {
+    set_latch(i, next_list[i]);
+  }
+  return update();
+}
+
+// @brief 変数のファンアウトをバケツに積む．
+void
+AigIncrSim::schedule_fanouts(
+  SizeType var
+)
+{
+  for ( auto i = mFanoutBegin[var]; i < mFanoutBegin[var + 1]; ++ i ) {
+    auto ovar = mFanoutArray[i];
+    if ( mQueued[ovar] ) {
+      continue;
+    }
+    mQueued[ovar] = true;
+    SizeType lv = mLevelArray[ovar];
+    mBucketList[lv].push_back(ovar);
+    mMinLevel = std::min(mMinLevel, lv);
+    mMaxLevel = std::max(mMaxLevel, lv);
+  }
+}
+
+// @brief 変数に接続している出力を変化の候補にする．
+void
+AigIncrSim::mark_outputs(
+  SizeType var
+)
+{
+  for ( auto i = mOutputBegin[var]; i < mOutputBegin[var + 1]; ++ i ) {
+    SizeType pos = mOutputArray[i];
+    if ( !mCandMark[pos] ) {
+      mCandMark[pos] = true;
+      mCandList.push_back(pos);
+    }
+  }
+}
+
+END_NAMESPACE_YM_AIG
@@ -0,0 +1,290 @@
+
+/// @file AigLatchGraph.cc
+/// @brief AigLatchGraph の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigLatchGraph.h"
+#include "ModelImpl.h"
+#include "VarMap.h"
+#include "WorkPool.h"
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+BEGIN_NONAMESPACE
+
+// 未定義を表す値
+const std::uint32_t UNDEF = 0xFFFFFFFFU;
+
+// スレッドごとの作業領域
+struct ThreadBuf
+{
+  // 変数ごとの訪問済みの印(ラッチ番号 + 1)
+  vector<std::uint32_t> mMark;
+
+  // DFS 用のスタック
+  vector<std::uint32_t> mStack;
+};
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス AigLatchGraph
+//////////////////////////////////////////////////////////////////////
+
+// @brief ファンインのラッチ番号のリストを返す．
+vector<SizeType>
+AigLatchGraph::fanin_list(
+  SizeType latch
+) const
+{
+  ASSERT_COND( 0 <= latch && latch < latch_num() );
+  vector<SizeType> ans_list(mFaninArray.begin() + mFaninBegin[latch],
+			    mFaninArray.begin() + mFaninBegin[latch + 1]);
+  return ans_list;
+}
+
+// @brief ファンアウトのラッチ番号のリストを返す．
+vector<SizeType>
+AigLatchGraph::fanout_list(
+  SizeType latch
+) const
+{
+  ASSERT_COND( 0 <= latch && latch < latch_num() );
+  vector<SizeType> ans_list(mFanoutArray.begin() + mFanoutBegin[latch],
+			    mFanoutArray.begin() + mFanoutBegin[latch + 1]);
+  return ans_list;
+}
+
+// @brief 強連結成分の要素のラッチ番号のリストを返す．
+vector<SizeType>
+AigLatchGraph::scc_latch_list(
+  SizeType id
+) const
+{
+  ASSERT_COND( 0 <= id && id < scc_num() );
+  vector<SizeType> ans_list(mSccArray.begin() + mSccBegin[id],
+			    mSccArray.begin() + mSccBegin[id + 1]);
+  return ans_list;
+}
+
+// @brief 強連結成分がループを含む時 true を返す．
+bool
+AigLatchGraph::is_cyclic(
+  SizeType id
+) const
+{
+  ASSERT_COND( 0 <= id && id < scc_num() );
+  if ( scc_size(id) > 1 ) {
+    return true;
+  }
+  auto latch = scc_latch(id, 0);
+  auto begin = mFaninArray.begin() + mFaninBegin[latch];
+  auto end = mFaninArray.begin() + mFaninBegin[latch + 1];
+  return std::binary_search(begin, end, latch);
+}
+
+// @brief 内容を出力する．
+void
+AigLatchGraph::print(
+  ostream& s
+) const
+{
+  for ( SizeType latch = 0; latch < latch_num(); ++ latch ) {
+    s << "L#" << latch << " [SCC#" << scc_id(latch) << "]:";
+    for ( SizeType i = 0; i < fanin_num(latch); ++ i ) {
+      s << " L#" << fanin(latch, i);
+    }
+    s << endl;
+  }
+  for ( SizeType id = 0; id < scc_num(); ++ id ) {
+    s << "SCC#" << id << (is_cyclic(id) ? " (cyclic)" : "") << ":";
+    for ( SizeType i = 0; i < scc_size(id); ++ i ) {
+      s << " L#" << scc_latch(id, i);
+    }
+    s << endl;
+  }
+}
+
+// @brief 依存グラフと強連結成分を求める．
+void
+AigLatchGraph::compute(
+  const ModelImpl& model,
+  const AigLatchGraphOpt& opt
+)
+{
+  VarMap var_map{model};
+  auto var_num = var_map.var_num();
+  auto L = model.L();
+  if ( L >= UNDEF ) {
+    throw std::invalid_argument{"AigLatchGraph: too many latches."};
+  }
+
+  // ANDノードのファンインの変数番号
+  vector<std::uint32_t> fanin_var(var_num * 2, 0);
+  for ( SizeType pos = 0; pos < model.A(); ++ pos ) {
+    auto var = model.and_node(pos) / 2;
+    fanin_var[var * 2 + 0] = model.and_src1(pos) / 2;
+    fanin_var[var * 2 + 1] = model.and_src2(pos) / 2;
+  }
+
+  // ラッチごとにソースの推移的ファンインをたどってラッチを集める．
+  // 訪問済みの印にラッチ番号を使うので，スレッドごとの印は
+  // ラッチごとに初期化しなくてよい．
+  WorkPool pool{opt.thread_num};
+  vector<ThreadBuf> buf_list(pool.thread_num());
+  vector<vector<std::uint32_t>> fanin_list(L);
+  pool.run(L, [&](SizeType latch, SizeType tid) {
+    auto& buf = buf_list[tid];
+    auto& mark = buf.mMark;
+    if ( mark.empty() ) {
+      mark.assign(var_num, 0);
+    }
+    auto& stack = buf.mStack;
+    std::uint32_t id = latch + 1;
+    auto& ans_list = fanin_list[latch];
+    auto push = [&](std::uint32_t var) {
+      if ( mark[var] != id ) {
+	mark[var] = id;
+	stack.push_back(var);
+      }
+    };
+    push(model.latch_src(latch) / 2);
+    while ( !stack.empty() ) {
+      auto var = stack.back();
+      stack.pop_back();
+      switch ( var_map.kind(var) ) {
+      case VarMap::LATCH:
+	ans_list.push_back(var_map.pos(var));
+	break;
+      case VarMap::AND:
+	push(fanin_var[var * 2 + 0]);
+	push(fanin_var[var * 2 + 1]);
+	break;
+      default:
+	break;
+      }
+    }
+    std::sort(ans_list.begin(), ans_list.end());
+  });
+
+  // CSR 形式にまとめる．
+  SizeType edge_num = 0;
+  for ( auto& src_list: fanin_list ) {
+    edge_num += src_list.size();
+  }
+  if ( edge_num >= UNDEF ) {
+    throw std::invalid_argument{"AigLatchGraph: too many edges."};
+  }
+  mFaninBegin.assign(L + 1, 0);
+  mFaninArray.clear();
+  mFaninArray.reserve(edge_num);
+  mFanoutBegin.assign(L + 1, 0);
+  for ( SizeType latch = 0; latch < L; ++ latch ) {
+    auto& src_list = fanin_list[latch];
+    mFaninArray.insert(mFaninArray.end(), src_list.begin(), src_list.end());
+    mFaninBegin[latch + 1] = mFaninArray.size();
+    for ( auto src: src_list ) {
+      ++ mFanoutBegin[src + 1];
+    }
+    vector<std::uint32_t>{}.swap(src_list);
+  }
+  for ( SizeType latch = 0; latch < L; ++ latch ) {
+    mFanoutBegin[latch + 1] += mFanoutBegin[latch];
+  }
+  // ファンインのラッチ番号の昇順に処理するのでファンアウトも昇順に並ぶ．
+  mFanoutArray.resize(edge_num);
+  {
+    vector<std::uint32_t> next_list(mFanoutBegin.begin(), mFanoutBegin.end() - 1);
+    for ( SizeType latch = 0; latch < L; ++ latch ) {
+      for ( auto i = mFaninBegin[latch]; i < mFaninBegin[latch + 1]; ++ i ) {
+	auto src = mFaninArray[i];
+	mFanoutArray[next_list[src]] = latch;
+	++ next_list[src];
+      }
+    }
+  }
+
+  compute_scc();
+}
+
+// @brief Tarjan のアルゴリズムで強連結成分を求める．
+//
+// ファンインの方向にたどるので，ファンイン側の成分が先に確定する．
+// 再帰は使わずに明示的なスタックで行う．
+void
+AigLatchGraph::compute_scc()
+{
+  auto L = latch_num();
+  vector<std::uint32_t> index(L, UNDEF);
+  vector<std::uint32_t> low(L, 0);
+  vector<bool> on_stack(L, false);
+  vector<std::uint32_t> scc_stack;
+  // (ラッチ番号, 次に調べるファンインの位置) のスタック
+  vector<std::pair<std::uint32_t, std::uint32_t>> call_stack;
+  std::uint32_t next_index = 0;
+  mSccId.assign(L, UNDEF);
+  mSccBegin.assign(1, 0);
+  mSccArray.clear();
+  mSccArray.reserve(L);
+
+  auto visit = [&](std::uint32_t latch) {
+    index[latch] = next_index;
+    low[latch] = next_index;
+    ++ next_index;
+    scc_stack.push_back(latch);
+    on_stack[latch] = true;
+    call_stack.push_back({latch, mFaninBegin[latch]});
+  };
+
+  for ( SizeType root = 0; root < L; ++ root ) {
+    if ( index[root] != UNDEF ) {
+      continue;
+    }
+    visit(root);
+    while ( !call_stack.empty() ) {
+      auto& frame = call_stack.back();
+      auto latch = frame.first;
+      if ( frame.second < mFaninBegin[latch + 1] ) {
+	auto src = mFaninArray[frame.second];
+	++ frame.second;
+	if ( index[src] == UNDEF ) {
+	  // frame は無効になる．
+	  visit(src);
+	}
+	else if ( on_stack[src] ) {
+	  low[latch] = std::min(low[latch], index[src]);
+	}
+	continue;
+      }
+      call_stack.pop_back();
+      if ( low[latch] == index[latch] ) {
+	std::uint32_t id = mSccBegin.size() - 1;
+	auto begin = mSccArray.size();
+	for ( ; ; ) {
+	  auto member = scc_stack.back();
+	  scc_stack.pop_back();
+	  on_stack[member] = false;
+	  mSccId[member] = id;
+	  mSccArray.push_back(member);
+	  if ( member == latch ) {
+	    break;
+	  }
+	}
+	std::sort(mSccArray.begin() + begin, mSccArray.end());
+	mSccBegin.push_back(mSccArray.size());
+      }
+      if ( !call_stack.empty() ) {
+	auto parent = call_stack.back().first;
+	low[parent] = std::min(low[parent], low[latch]);
+      }
+    }
+  }
+}
+
+END_NAMESPACE_YM_AIG
@@ -0,0 +1,371 @@
+
+/// @file AigLutNetwork.cc
+/// @brief AigLutNetwork の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigLutNetwork.h"
+#include "ym/AigCuts.h"
+#include "ModelImpl.h"
+#include <iomanip>
+#include <limits>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+BEGIN_NONAMESPACE
+
+// 要求時刻の制約が無いことを表す値
+const SizeType NO_REQ = std::numeric_limits<SizeType>::max();
+
+END_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// クラス AigLutNetwork
+//////////////////////////////////////////////////////////////////////
+
+// @brief LUT の真理値表を返す．
+vector<std::uint64_t>
+AigLutNetwork::lut_truth(
+  SizeType pos
+) const
+{
+  auto ptr = lut_truth_ptr(pos);
+  return vector<std::uint64_t>(ptr, ptr + mTruthWordNum);
+}
+
+// @brief 内容を出力する．
+void
+AigLutNetwork::print(
+  ostream& s
+) const
+{
+  s << "I: " << I() << endl
+    << "L: " << L() << endl
+    << "O: " << O() << endl
+    << "LUT: " << lut_num() << endl
+    << "depth: " << depth() << endl;
+
+  s << "=== Latches ===" << endl;
+  for ( SizeType i = 0; i < L(); ++ i ) {
+    s << "#" << (I() + i + 1) << ": src = " << latch_src(i) << endl;
+  }
+
+  s << "=== Outputs ===" << endl;
+  for ( SizeType i = 0; i < O(); ++ i ) {
+    s << "O#" << i << ": src = " << output_src(i) << endl;
+  }
+
+  s << "=== LUTs ===" << endl;
+  for ( SizeType i = 0; i < lut_num(); ++ i ) {
+    s << "#" << lut_id(i) << ": (";
+    for ( SizeType j = 0; j < lut_fanin_num(i); ++ j ) {
+      s << " " << lut_fanin(i, j);
+    }
+    s << " ) ";
+    auto ptr = lut_truth_ptr(i);
+    for ( SizeType w = mTruthWordNum; w -- > 0; ) {
+      s << std::hex << std::setw(16) << std::setfill('0') << ptr[w];
+    }
+    s << std::dec << std::setfill(' ') << endl;
+  }
+}
+
+// @brief マッピングを行う．
+void
+AigLutNetwork::map(
+  const ModelImpl& model,
+  const AigLutOpt& opt
+)
+{
+  if ( opt.lut_size < 2 || opt.lut_size > 8 ) {
+    ostringstream buf;
+    buf << "map_luts: lut_size(" << opt.lut_size
+	<< ") must be between 2 and 8.";
+    throw std::invalid_argument{buf.str()};
+  }
+
+  // カットの列挙は複数のスレッドで行う．
+  AigCutOpt cut_opt;
+  cut_opt.cut_size = opt.lut_size;
+  cut_opt.cut_limit = opt.cut_limit;
+  cut_opt.truth_table = true;
+  cut_opt.thread_num = opt.thread_num;
+  AigCuts cuts;
+  cuts.enumerate(model, cut_opt);
+
+  auto var_num = cuts.var_num();
+  vector<SizeType> and_var_list;
+  and_var_list.reserve(model.A());
+  vector<bool> is_and(var_num, false);
+  // AIG 上のファンアウト数
+  vector<double> est_refs(var_num, 0.0);
+  for ( auto pos: model.and_topo_order() ) {
+    auto var = model.and_node(pos) / 2;
+    and_var_list.push_back(var);
+    is_and[var] = true;
+    est_refs[model.and_src1(pos) / 2] += 1.0;
+    est_refs[model.and_src2(pos) / 2] += 1.0;
+  }
+
+  vector<SizeType> root_list;
+  root_list.reserve(model.O() + model.L());
+  for ( SizeType i = 0; i < model.O(); ++ i ) {
+    root_list.push_back(model.output_src(i));
+  }
+  for ( SizeType i = 0; i < model.L(); ++ i ) {
+    root_list.push_back(model.latch_src(i));
+  }
+  for ( auto lit: root_list ) {
+    est_refs[lit / 2] += 1.0;
+  }
+  for ( auto& r: est_refs ) {
+    r = std::max(r, 1.0);
+  }
+
+  // ノードごとの到着時刻，面積フロー，選ばれたカット，参照回数
+  vector<SizeType> arrival(var_num, 0);
+  vector<double> flow(var_num, 0.0);
+  vector<SizeType> best(var_num, 0);
+  vector<SizeType> refs(var_num, 0);
+  vector<SizeType> required(var_num, NO_REQ);
+
+  auto cut_arrival = [&](SizeType var, SizeType k) {
+    SizeType ans = 0;
+    for ( SizeType i = 0; i < cuts.leaf_num(var, k); ++ i ) {
+      ans = std::max(ans, arrival[cuts.leaf(var, k, i)]);
+    }
+    return ans + 1;
+  };
+  auto cut_flow = [&](SizeType var, SizeType k) {
+    double ans = 1.0;
+    for ( SizeType i = 0; i < cuts.leaf_num(var, k); ++ i ) {
+      auto leaf = cuts.leaf(var, k, i);
+      if ( is_and[leaf] ) {
+	ans += flow[leaf] / est_refs[leaf];
+      }
+    }
+    return ans;
+  };
+
+  // カットの葉の参照回数を増やす(減らす)．
+  // 参照回数が 0 から 1 (1 から 0)に変化したノードは再帰的に処理する．
+  // 返り値は処理した LUT 数
+  vector<std::pair<SizeType, SizeType>> stack;
+  auto ref_cut = [&](SizeType var, SizeType k) {
+    SizeType area = 0;
+    stack.clear();
+    stack.push_back({var, k});
+    while ( !stack.empty() ) {
+      auto v = stack.back().first;
+      auto c = stack.back().second;
+      stack.pop_back();
+      ++ area;
+      for ( SizeType i = 0; i < cuts.leaf_num(v, c); ++ i ) {
+	auto leaf = cuts.leaf(v, c, i);
+	if ( is_and[leaf] && refs[leaf] ++ == 0 ) {
+	  stack.push_back({leaf, best[leaf]});
+	}
+      }
+    }
+    return area;
+  };
+  auto deref_cut = [&](SizeType var, SizeType k) {
+    SizeType area = 0;
+    stack.clear();
+    stack.push_back({var, k});
+    while ( !stack.empty() ) {
+      auto v = stack.back().first;
+      auto c = stack.back().second;
+      stack.pop_back();
+      ++ area;
+      for ( SizeType i = 0; i < cuts.leaf_num(v, c); ++ i ) {
+	auto leaf = cuts.leaf(v, c, i);
+	if ( is_and[leaf] && -- refs[leaf] == 0 ) {
+	  stack.push_back({leaf, best[leaf]});
+	}
+      }
+    }
+    return area;
+  };
+
+  // 現在のマッピングの参照回数を求める．
+  auto set_refs = [&]() {
+    std::fill(refs.begin(), refs.end(), 0);
+    for ( auto lit: root_list ) {
+      auto var = lit / 2;
+      if ( is_and[var] && refs[var] ++ == 0 ) {
+	ref_cut(var, best[var]);
+      }
+    }
+  };
+
+  // 最大段数を求める．
+  auto max_depth = [&]() {
+    SizeType ans = 0;
+    for ( auto lit: root_list ) {
+      ans = std::max(ans, arrival[lit / 2]);
+    }
+    return ans;
+  };
+
+  // 現在のマッピングの要求時刻を求める．
+  auto set_required = [&](SizeType depth) {
+    std::fill(required.begin(), required.end(), NO_REQ);
+    for ( auto lit: root_list ) {
+      required[lit / 2] = depth;
+    }
+    for ( auto p = and_var_list.rbegin(); p != and_var_list.rend(); ++ p ) {
+      auto var = *p;
+      if ( refs[var] == 0 ) {
+	continue;
+      }
+      auto k = best[var];
+      for ( SizeType i = 0; i < cuts.leaf_num(var, k); ++ i ) {
+	auto leaf = cuts.leaf(var, k, i);
+	required[leaf] = std::min(required[leaf], required[var] - 1);
+      }
+    }
+  };
+
+  // 1. 段数最小のマッピング
+  //    同じ段数なら面積フローの小さいものを選ぶ．
+  for ( auto var: and_var_list ) {
+    SizeType best_k = 0;
+    SizeType best_arr = NO_REQ;
+    double best_flow = 0.0;
+    for ( SizeType k = 1; k < cuts.cut_num(var); ++ k ) {
+      auto arr = cut_arrival(var, k);
+      auto f = cut_flow(var, k);
+      if ( arr < best_arr || (arr == best_arr && f < best_flow) ) {
+	best_k = k;
+	best_arr = arr;
+	best_flow = f;
+      }
+    }
+    ASSERT_COND( best_k > 0 );
+    best[var] = best_k;
+    arrival[var] = best_arr;
+    flow[var] = best_flow;
+  }
+  auto depth = max_depth();
+  set_refs();
+
+  // 2. 面積フローによる面積回復
+  //    段数を増やさない範囲で面積フローの小さいカットを選ぶ．
+  for ( SizeType iter = 0; iter < opt.area_flow_iter; ++ iter ) {
+    for ( SizeType v = 0; v < var_num; ++ v ) {
+      if ( is_and[v] ) {
+	est_refs[v] = (est_refs[v] + 2.0 * std::max<SizeType>(refs[v], 1)) / 3.0;
+      }
+    }
+    set_required(depth);
+    for ( auto var: and_var_list ) {
+      auto best_k = best[var];
+      auto best_arr = cut_arrival(var, best_k);
+      auto best_flow = cut_flow(var, best_k);
+      for ( SizeType k = 1; k < cuts.cut_num(var); ++ k ) {
+	auto arr = cut_arrival(var, k);
+	if ( required[var] != NO_REQ && arr > required[var] ) {
+	  continue;
+	}
+	auto f = cut_flow(var, k);
+	if ( f < best_flow || (f == best_flow && arr < best_arr) ) {
+	  best_k = k;
+	  best_arr = arr;
+	  best_flow = f;
+	}
+      }
+      best[var] = best_k;
+      arrival[var] = best_arr;
+      flow[var] = best_flow;
+    }
+    set_refs();
+  }
+
+  // 3. 厳密な面積による面積回復
+  //    選ばれているノードのカットを外して，付け替えた時に増える
+  //    LUT 数が最小のカットを選ぶ．
+  for ( SizeType iter = 0; iter < opt.exact_area_iter; ++ iter ) {
+    set_required(depth);
+    for ( auto var: and_var_list ) {
+      if ( refs[var] == 0 ) {
+	arrival[var] = cut_arrival(var, best[var]);
+	continue;
+      }
+      deref_cut(var, best[var]);
+      auto best_k = best[var];
+      auto best_arr = cut_arrival(var, best_k);
+      auto best_area = ref_cut(var, best_k);
+      deref_cut(var, best_k);
+      for ( SizeType k = 1; k < cuts.cut_num(var); ++ k ) {
+	auto arr = cut_arrival(var, k);
+	if ( required[var] != NO_REQ && arr > required[var] ) {
+	  continue;
+	}
+	auto area = ref_cut(var, k);
+	deref_cut(var, k);
+	if ( area < best_area || (area == best_area && arr < best_arr) ) {
+	  best_k = k;
+	  best_arr = arr;
+	  best_area = area;
+	}
+      }
+      best[var] = best_k;
+      arrival[var] = best_arr;
+      ref_cut(var, best_k);
+    }
+  }
+  set_refs();
+
+  // 4. LUT ネットワークを作る．
+  auto I = model.I();
+  auto L = model.L();
+  vector<SizeType> id_map(var_num, 0);
+  for ( SizeType i = 0; i < I; ++ i ) {
+    id_map[model.input(i) / 2] = i + 1;
+  }
+  for ( SizeType i = 0; i < L; ++ i ) {
+    id_map[model.latch(i) / 2] = I + i + 1;
+  }
+  auto nw = cuts.truth_word_num();
+  mLutSize = opt.lut_size;
+  mTruthWordNum = nw;
+  mI = I;
+  mFaninBegin.clear();
+  mFaninBegin.push_back(0);
+  mFaninArray.clear();
+  mTruthArray.clear();
+  SizeType next_id = I + L + 1;
+  for ( auto var: and_var_list ) {
+    if ( refs[var] == 0 ) {
+      continue;
+    }
+    id_map[var] = next_id;
+    ++ next_id;
+    auto k = best[var];
+    for ( SizeType i = 0; i < cuts.leaf_num(var, k); ++ i ) {
+      mFaninArray.push_back(id_map[cuts.leaf(var, k, i)]);
+    }
+    mFaninBegin.push_back(mFaninArray.size());
+    auto ptr = cuts.truth_ptr(var, k);
+    mTruthArray.insert(mTruthArray.end(), ptr, ptr + nw);
+  }
+  mLatchSrcList.clear();
+  mLatchSrcList.reserve(L);
+  for ( SizeType i = 0; i < L; ++ i ) {
+    auto lit = model.latch_src(i);
+    mLatchSrcList.push_back(id_map[lit / 2] * 2 + (lit % 2));
+  }
+  mOutputSrcList.clear();
+  mOutputSrcList.reserve(model.O());
+  for ( SizeType i = 0; i < model.O(); ++ i ) {
+    auto lit = model.output_src(i);
+    mOutputSrcList.push_back(id_map[lit / 2] * 2 + (lit % 2));
+  }
+  mDepth = max_depth();
+}
+
+END_NAMESPACE_YM_AIG
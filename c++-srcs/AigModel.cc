@@ -8,10 +8,203 @@
 
 #include "ym/AigModel.h"
 #include "ModelImpl.h"
+#include "InputSource.h"
+#include "PipeBuf.h"
+#include "WorkPool.h"
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <sys/stat.h>
 
 
 BEGIN_NAMESPACE_YM_AIG
 
+BEGIN_NONAMESPACE
+
+// ファイルを開いて読み込む．
+//
+// 圧縮ファイルの場合は伸長しながら読み込む．
+void
+read_file(
+  const string& filename,
+  bool async_io,
+  const char* func_name,
+  ModelImpl& impl,
+  void (ModelImpl::*reader)(istream&)
+)
+{
+  auto src = InputSource::open(filename, async_io);
+  if ( src == nullptr ) {
+    ostringstream buf;
+    buf << "AigModel::" << func_name << ": Could not open file "
+	<< filename;
+    throw std::invalid_argument{buf.str()};
+  }
+  PipeBuf pbuf{std::move(src)};
+  istream s{&pbuf};
+  try {
+    (impl.*reader)(s);
+  }
+  catch ( std::invalid_argument& ) {
+    // 伸長時のエラーが原因ならそちらを優先する．
+    pbuf.check_error();
+    throw;
+  }
+  pbuf.check_error();
+}
+
+// 圧縮形式の拡張子
+const char* codec_ext_list[] = {
+  ".gz", ".zst", ".xz", nullptr
+};
+
+// 文字列が suffix で終わっていたら true を返す．
+bool
+ends_with(
+  const string& str,
+  const string& suffix
+)
+{
+  return str.size() >= suffix.size() &&
+    str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// 圧縮形式の拡張子を持つ時 true を返す．
+bool
+has_codec_ext(
+  const string& filename
+)
+{
+  for ( auto p = codec_ext_list; *p != nullptr; ++ p ) {
+    if ( ends_with(filename, *p) ) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// ファイル形式を判別する．
+//
+// 'aag' か 'aig' のヘッダの種類を返す．
+string
+check_format(
+  const string& filename
+)
+{
+  // 圧縮形式の拡張子を取り除いてから調べる．
+  auto name = filename;
+  for ( auto p = codec_ext_list; *p != nullptr; ++ p ) {
+    if ( ends_with(name, *p) ) {
+      name.erase(name.size() - strlen(*p));
+      break;
+    }
+  }
+  if ( ends_with(name, ".aag") ) {
+    return "aag";
+  }
+  if ( ends_with(name, ".aig") ) {
+    return "aig";
+  }
+
+  // 先頭の3文字で判断する．
+  auto src = InputSource::open(filename);
+  if ( src == nullptr ) {
+    ostringstream buf;
+    buf << "AigModel::read_many: Could not open file "
+	<< filename;
+    throw std::invalid_argument{buf.str()};
+  }
+  char header[3];
+  SizeType n = 0;
+  while ( n < 3 ) {
+    auto m = src->read(header + n, 3 - n);
+    if ( m == 0 ) {
+      break;
+    }
+    n += m;
+  }
+  auto sig = string(header, n);
+  if ( sig != "aag" && sig != "aig" ) {
+    ostringstream buf;
+    buf << filename << ": Unknown file format.";
+    throw std::invalid_argument{buf.str()};
+  }
+  return sig;
+}
+
+// 同時に読み込むデータ量を制限するためのクラス
+class MemBudget
+{
+public:
+
+  // コンストラクタ
+  explicit
+  MemBudget(
+    SizeType limit
+  ) : mLimit{limit}
+  {
+  }
+
+  // size 分の枠を確保する．
+  //
+  // 他に読み込み中のものが無い場合は上限を越えても確保する．
+  void
+  acquire(
+    SizeType size
+  )
+  {
+    if ( mLimit == 0 ) {
+      return;
+    }
+    std::unique_lock<std::mutex> lock{mMutex};
+    mCond.wait(lock, [&](){ return mUsed == 0 || mUsed + size <= mLimit; });
+    mUsed += size;
+  }
+
+  // size 分の枠を解放する．
+  void
+  release(
+    SizeType size
+  )
+  {
+    if ( mLimit == 0 ) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock{mMutex};
+      mUsed -= size;
+    }
+    mCond.notify_all();
+  }
+
+private:
+
+  // 上限
+  SizeType mLimit;
+
+  // 使用量
+  SizeType mUsed{0};
+
+  // 排他制御用の mutex
+  std::mutex mMutex;
+
+  // 解放を知らせる条件変数
+  std::condition_variable mCond;
+
+};
+
+// ムーブ元に残す空の ModelImpl を返す．
+//
+// 常にここで参照されているので，変更する前には必ず複製される．
+const std::shared_ptr<ModelImpl>&
+empty_impl()
+{
+  static std::shared_ptr<ModelImpl> impl{new ModelImpl};
+  return impl;
+}
+
+END_NONAMESPACE
+
 //////////////////////////////////////////////////////////////////////
 // クラス AigModel
 //////////////////////////////////////////////////////////////////////
@@ -25,16 +218,16 @@ AigModel::AigModel(
 // @brief コピーコンストラクタ
 AigModel::AigModel(
   const AigModel& src
-) : mImpl{new ModelImpl{*src.mImpl}}
+) : mImpl{src.mImpl}
 {
 }
 
 // @brief ムーブコンストラクタ
 AigModel::AigModel(
   AigModel&& src
-) : mImpl{src.mImpl}
+) : mImpl{std::move(src.mImpl)}
 {
-  src.mImpl = nullptr;
+  src.mImpl = empty_impl();
 }
 
 // @brief コピー代入文
@@ -43,10 +236,7 @@ AigModel::operator=(
   const AigModel& src
 )
 {
-  if ( this != &src ) {
-    delete mImpl;
-    mImpl = new ModelImpl{*src.mImpl};
-  }
+  mImpl = src.mImpl;
   return *this;
 }
 
@@ -56,31 +246,41 @@ AigModel::operator=(
   AigModel&& src
 )
 {
-  mImpl = src.mImpl;
-  src.mImpl = nullptr;
+  if ( this != &src ) {
+    mImpl = std::move(src.mImpl);
+    src.mImpl = empty_impl();
+  }
   return *this;
 }
 
 // @brief デストラクタ
 AigModel::~AigModel()
 {
-  delete mImpl;
+}
+
+// @brief 変更用に実装クラスを得る．
+ModelImpl&
+AigModel::_impl_for_write()
+{
+  if ( mImpl.use_count() > 1 ) {
+    mImpl.reset(new ModelImpl{*mImpl});
+  }
+  return *mImpl;
 }
 
 // @brief Ascii AIG フォーマットを読み込む．
 AigModel
 AigModel::read_aag(
-  const string& filename
+  const string& filename,
+  const AigReadOpt& opt
 )
 {
-  ifstream s{filename};
-  if ( !s ) {
-    ostringstream buf;
-    buf << "AigModel::read_aag: Could not open file "
-	<< filename;
-    throw std::invalid_argument{buf.str()};
+  AigModel aig;
+  read_file(filename, opt.async_io, "read_aag", *aig.mImpl, &ModelImpl::read_aag);
+  if ( opt.cleanup ) {
+    aig.cleanup();
   }
-  return read_aag(s);
+  return aig;
 }
 
 // @brief Ascii AIG フォーマットを読み込む．
@@ -97,17 +297,16 @@ AigModel::read_aag(
 // @brief AIG フォーマットを読み込む．
 AigModel
 AigModel::read_aig(
-  const string& filename
+  const string& filename,
+  const AigReadOpt& opt
 )
 {
-  ifstream s{filename};
-  if ( !s ) {
-    ostringstream buf;
-    buf << "AigModel::read_aag: Could not open file "
-	<< filename;
-    throw std::invalid_argument{buf.str()};
+  AigModel aig;
+  read_file(filename, opt.async_io, "read_aig", *aig.mImpl, &ModelImpl::read_aig);
+  if ( opt.cleanup ) {
+    aig.cleanup();
   }
-  return read_aig(s);
+  return aig;
 }
 
 // @brief AIG フォーマットを読み込む．
@@ -121,6 +320,121 @@ AigModel::read_aig(
   return aig;
 }
 
+// @brief 索引を用いて AIG フォーマットを並列に読み込む．
+AigModel
+AigModel::read_aig(
+  const AigFileIndex& index,
+  SizeType thread_num
+)
+{
+  AigModel aig;
+  aig.mImpl->read_aig(index, thread_num);
+  return aig;
+}
+
+// @brief 複数のファイルを並列に読み込む．
+vector<AigModel>
+AigModel::read_many(
+  const vector<string>& filename_list,
+  vector<string>& error_list,
+  const AigReadOpt& opt
+)
+{
+  auto n = filename_list.size();
+  vector<AigModel> model_list;
+  model_list.reserve(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    model_list.push_back(AigModel{});
+  }
+  error_list.clear();
+  error_list.resize(n);
+
+  // 読み込み中のデータ量の見積もり
+  vector<SizeType> cost_list(n, 0);
+  if ( opt.mem_limit > 0 ) {
+    for ( SizeType i = 0; i < n; ++ i ) {
+      auto& filename = filename_list[i];
+      struct stat st;
+      if ( stat(filename.c_str(), &st) == 0 ) {
+	cost_list[i] = st.st_size;
+	if ( has_codec_ext(filename) ) {
+	  cost_list[i] *= 4;
+	}
+      }
+    }
+  }
+
+  MemBudget budget{opt.mem_limit};
+  WorkPool pool{opt.thread_num};
+  pool.run(n, [&](SizeType i, SizeType) {
+    auto& filename = filename_list[i];
+    budget.acquire(cost_list[i]);
+    try {
+      auto& impl = *model_list[i].mImpl;
+      if ( check_format(filename) == "aag" ) {
+	read_file(filename, opt.async_io, "read_aag", impl, &ModelImpl::read_aag);
+      }
+      else {
+	read_file(filename, opt.async_io, "read_aig", impl, &ModelImpl::read_aig);
+      }
+      if ( opt.cleanup ) {
+	model_list[i].cleanup();
+      }
+    }
+    catch ( std::exception& error ) {
+      // 途中まで読み込んだ内容は捨てる．
+      model_list[i] = AigModel{};
+      error_list[i] = error.what();
+    }
+    budget.release(cost_list[i]);
+  });
+  return model_list;
+}
+
+// @brief スナップショットを書き出す．
+void
+AigModel::save_snapshot(
+  const string& filename
+) const
+{
+  mImpl->write_snapshot(filename);
+}
+
+// @brief 分割ごとの影響範囲をスナップショットとして書き出す．
+void
+AigModel::save_partitions(
+  const AigPartition& partition,
+  const vector<string>& filename_list,
+  SizeType thread_num
+) const
+{
+  if ( partition.output_num() != O() ) {
+    throw std::invalid_argument{"save_partitions: output_num mismatch."};
+  }
+  auto n = partition.partition_num();
+  if ( filename_list.size() != n ) {
+    throw std::invalid_argument{"save_partitions: filename_list size mismatch."};
+  }
+  WorkPool wpool{thread_num};
+  wpool.run(n, [&](SizeType id, SizeType) {
+    ModelImpl impl;
+    impl.extract_cone(*mImpl, partition.output_list(id), {});
+    impl.write_snapshot(filename_list[id]);
+  });
+}
+
+// @brief スナップショットを開く．
+AigModel
+AigModel::open_snapshot(
+  const string& filename,
+  bool verify
+)
+{
+  AigModel aig;
+  aig.mImpl->open_snapshot(filename, verify);
+  return aig;
+}
+
 // @brief 変数番号の最大値を返す．
 SizeType
 AigModel::M() const
@@ -219,6 +533,20 @@ AigModel::and_src2(
   return mImpl->and_src2(pos);
 }
 
+// @brief ANDノードの先頭の反復子を返す．
+AigAndIter
+AigModel::and_begin() const
+{
+  return AigAndIter{mImpl, 0};
+}
+
+// @brief ANDノードの末尾の反復子を返す．
+AigAndIter
+AigModel::and_end() const
+{
+  return AigAndIter{mImpl, A()};
+}
+
 // @brief 入力のシンボルを得る．
 const string&
 AigModel::input_symbol(
@@ -262,4 +590,314 @@ AigModel::print(
   mImpl->print(s);
 }
 
+// @brief ANDノードのリストを圧縮表現にする．
+void
+AigModel::pack_ands(
+  SizeType interval
+)
+{
+  if ( interval == 0 ) {
+    throw std::invalid_argument{"pack_ands: interval must be positive."};
+  }
+  if ( !mImpl->is_packed() ) {
+    _impl_for_write().pack_ands(interval);
+  }
+}
+
+// @brief ANDノードのリストを展開する．
+void
+AigModel::unpack_ands()
+{
+  if ( mImpl->is_packed() ) {
+    _impl_for_write().unpack_ands();
+  }
+}
+
+// @brief ANDノードのリストが圧縮表現の時 true を返す．
+bool
+AigModel::is_packed() const
+{
+  return mImpl->is_packed();
+}
+
+// @brief ANDノードのリストが使用しているメモリ量(バイト)を返す．
+SizeType
+AigModel::and_memory_size() const
+{
+  return mImpl->and_memory_size();
+}
+
+// @brief 指定された出力とラッチの影響範囲(cone of influence)を取り出す．
+AigModel
+AigModel::extract_cone(
+  const vector<SizeType>& output_list,
+  const vector<SizeType>& latch_list
+) const
+{
+  AigModel aig;
+  aig.mImpl->extract_cone(*mImpl, output_list, latch_list);
+  return aig;
+}
+
+// @brief 分割ごとの影響範囲を取り出す．
+vector<AigModel>
+AigModel::extract_partitions(
+  const AigPartition& partition,
+  SizeType thread_num
+) const
+{
+  if ( partition.output_num() != O() ) {
+    throw std::invalid_argument{"extract_partitions: output_num mismatch."};
+  }
+  auto n = partition.partition_num();
+  // デフォルトコンストラクタは private なので1つずつ作る．
+  vector<AigModel> model_list;
+  model_list.reserve(n);
+  for ( SizeType id = 0; id < n; ++ id ) {
+    model_list.push_back(AigModel{});
+  }
+  WorkPool wpool{thread_num};
+  wpool.run(n, [&](SizeType id, SizeType) {
+    model_list[id].mImpl->extract_cone(*mImpl, partition.output_list(id), {});
+  });
+  return model_list;
+}
+
+// @brief 定数の伝搬と不要なANDノードの削除を行う．
+SizeType
+AigModel::cleanup()
+{
+  std::shared_ptr<ModelImpl> impl{new ModelImpl};
+  auto n = impl->cleanup(*mImpl);
+  mImpl = impl;
+  return n;
+}
+
+// @brief 構造的に同じANDノードを併合する(structural hashing)．
+SizeType
+AigModel::strash()
+{
+  std::shared_ptr<ModelImpl> impl{new ModelImpl};
+  auto n = impl->strash(*mImpl);
+  mImpl = impl;
+  return n;
+}
+
+// @brief 参照の局所性がよくなるようにANDノードの番号を振り直す．
+void
+AigModel::reorder(
+  bool level_major
+)
+{
+  std::shared_ptr<ModelImpl> impl{new ModelImpl};
+  impl->reorder(*mImpl, level_major);
+  mImpl = impl;
+}
+
+// @brief 2つのモデルのマイタを作る．
+AigModel
+AigModel::make_miter(
+  const AigModel& model1,
+  const AigModel& model2,
+  const AigMiterOpt& opt
+)
+{
+  AigModel aig;
+  aig.mImpl->make_miter(*model1.mImpl, *model2.mImpl, opt);
+  return aig;
+}
+
+// @brief 時間展開を行う展開器を作る．
+AigUnroller
+AigModel::make_unroller(
+  const AigUnrollOpt& opt
+) const
+{
+  AigUnroller unroller;
+  unroller.initialize(mImpl, opt);
+  return unroller;
+}
+
+// @brief 時間展開した組み合わせ回路を返す．
+AigModel
+AigModel::unroll(
+  const AigUnrollOpt& opt
+) const
+{
+  return make_unroller(opt).model();
+}
+
+// @brief k-feasible カットを列挙する．
+AigCuts
+AigModel::enumerate_cuts(
+  const AigCutOpt& opt
+) const
+{
+  AigCuts cuts;
+  cuts.enumerate(*mImpl, opt);
+  return cuts;
+}
+
+// @brief k-LUT にマッピングする．
+AigLutNetwork
+AigModel::map_luts(
+  const AigLutOpt& opt
+) const
+{
+  AigLutNetwork network;
+  network.map(*mImpl, opt);
+  return network;
+}
+
+// @brief 出力ごとの真理値表を計算する．
+AigTruthTables
+AigModel::compute_truth_tables(
+  const AigTruthOpt& opt
+) const
+{
+  AigTruthTables tables;
+  tables.compute(*mImpl, opt);
+  return tables;
+}
+
+// @brief ランダムシミュレーションで等価候補のクラスを求める．
+AigEquivClasses
+AigModel::find_equiv_classes(
+  const AigEquivOpt& opt
+) const
+{
+  AigEquivClasses classes;
+  classes.compute(*mImpl, opt);
+  return classes;
+}
+
+// @brief ランダムシミュレーションで出力を 1 にする入力系列を探す．
+AigCex
+AigModel::falsify(
+  const AigFalsifyOpt& opt
+) const
+{
+  return mImpl->falsify(opt);
+}
+
+// @brief 3値(0, 1, X)のビット並列シミュレーションを行う．
+AigTernaryResult
+AigModel::ternary_simulate(
+  const AigTernaryOpt& opt
+) const
+{
+  AigTernaryResult result;
+  result.compute(*mImpl, opt);
+  return result;
+}
+
+// @brief 差分シミュレータを作る．
+AigIncrSim
+AigModel::make_incr_sim() const
+{
+  AigIncrSim sim;
+  sim.initialize(*mImpl);
+  return sim;
+}
+
+// @brief ランダムシミュレーションで信号確率とスイッチング率を求める．
+AigActivity
+AigModel::estimate_activity(
+  const AigActivityOpt& opt
+) const
+{
+  AigActivity activity;
+  activity.compute(*mImpl, opt);
+  return activity;
+}
+
+// @brief ラッチ間の依存グラフと強連結成分を求める．
+AigLatchGraph
+AigModel::compute_latch_graph(
+  const AigLatchGraphOpt& opt
+) const
+{
+  AigLatchGraph graph;
+  graph.compute(*mImpl, opt);
+  return graph;
+}
+
+// @brief 出力とラッチのソースの構造的なサポートを求める．
+AigSupports
+AigModel::compute_supports(
+  const AigSupportOpt& opt
+) const
+{
+  AigSupports supports;
+  supports.compute(*mImpl, opt);
+  return supports;
+}
+
+// @brief 出力方向の支配木と MFFC の大きさを求める．
+AigDominators
+AigModel::compute_dominators() const
+{
+  AigDominators dominators;
+  dominators.compute(*mImpl);
+  return dominators;
+}
+
+// @brief 共有する論理の多い出力同士をまとめて分割する．
+AigPartition
+AigModel::partition_outputs(
+  const AigPartitionOpt& opt
+) const
+{
+  AigLatchGraphOpt graph_opt;
+  graph_opt.thread_num = opt.thread_num;
+  AigLatchGraph graph;
+  graph.compute(*mImpl, graph_opt);
+  AigPartition partition;
+  partition.compute(*mImpl, graph, opt);
+  return partition;
+}
+
+// @brief Tseitin 変換した CNF を DIMACS 形式で書き出す．
+void
+AigModel::write_cnf(
+  const string& filename,
+  const AigCnfOpt& opt
+) const
+{
+  ofstream s{filename, std::ios::binary};
+  if ( !s ) {
+    ostringstream buf;
+    buf << "AigModel::write_cnf: Could not create file " << filename;
+    throw std::invalid_argument{buf.str()};
+  }
+  mImpl->write_cnf(s, opt);
+  s.close();
+  if ( !s ) {
+    ostringstream buf;
+    buf << "AigModel::write_cnf: Write error on " << filename;
+    throw std::invalid_argument{buf.str()};
+  }
+}
+
+// @brief Tseitin 変換した CNF を DIMACS 形式でストリームに書き出す．
+void
+AigModel::write_cnf(
+  ostream& s,
+  const AigCnfOpt& opt
+) const
+{
+  mImpl->write_cnf(s, opt);
+}
+
+// @brief Tseitin 変換した CNF をメモリ上に作る．
+AigCnf
+AigModel::make_cnf(
+  const AigCnfOpt& opt
+) const
+{
+  AigCnf cnf;
+  cnf.encode(*mImpl, opt);
+  return cnf;
+}
+
 END_NAMESPACE_YM_AIG
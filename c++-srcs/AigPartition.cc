@@ -0,0 +1,371 @@
+
+/// @file AigPartition.cc
+/// @brief AigPartition の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigPartition.h"
+#include "ym/AigLatchGraph.h"
+#include "ModelImpl.h"
+#include "VarMap.h"
+#include "BitSim.h"
+#include <algorithm>
+#include <numeric>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+BEGIN_NONAMESPACE
+
+// 未定義を表す値
+const std::uint32_t UNDEF = 0xFFFFFFFFU;
+
+// 署名の空の値
+const std::uint32_t EMPTY = 0xFFFFFFFFU;
+
+// 署名から集合の要素数を見積もる．
+//
+// 各ハッシュ値の最小値を [0, 1) の一様乱数の最小値とみなす．
+double
+estimate(
+  const std::uint32_t* sig,
+  SizeType k
+)
+{
+  double sum = 0.0;
+  for ( SizeType j = 0; j < k; ++ j ) {
+    sum += (static_cast<double>(sig[j]) + 1.0) / 4294967296.0;
+  }
+  return std::max(static_cast<double>(k) / sum - 1.0, 0.0);
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス AigPartition
+//////////////////////////////////////////////////////////////////////
+
+// @brief 分割に含まれる出力番号のリストを返す．
+vector<SizeType>
+AigPartition::output_list(
+  SizeType id
+) const
+{
+  ASSERT_COND( 0 <= id && id < partition_num() );
+  vector<SizeType> ans_list(mOutputArray.begin() + mBegin[id],
+			    mOutputArray.begin() + mBegin[id + 1]);
+  return ans_list;
+}
+
+// @brief 全ての分割のANDノード数の和を返す．
+SizeType
+AigPartition::total_and_num() const
+{
+  return std::accumulate(mAndNum.begin(), mAndNum.end(), SizeType{0});
+}
+
+// @brief 内容を出力する．
+void
+AigPartition::print(
+  ostream& s
+) const
+{
+  for ( SizeType id = 0; id < partition_num(); ++ id ) {
+    s << "P#" << id << " [" << and_num(id) << " ANDs]:";
+    for ( SizeType i = 0; i < output_num(id); ++ i ) {
+      s << " O#" << output(id, i);
+    }
+    s << endl;
+  }
+  s << "Total: " << total_and_num() << " ANDs" << endl;
+}
+
+// @brief 分割を求める．
+void
+AigPartition::compute(
+  const ModelImpl& model,
+  const AigLatchGraph& graph,
+  const AigPartitionOpt& opt
+)
+{
+  if ( opt.partition_num == 0 ) {
+    throw std::invalid_argument{"partition_outputs: partition_num should be positive."};
+  }
+  if ( opt.hash_num < 2 ) {
+    throw std::invalid_argument{"partition_outputs: hash_num should be at least 2."};
+  }
+  if ( opt.balance < 1.0 ) {
+    throw std::invalid_argument{"partition_outputs: balance should be at least 1.0."};
+  }
+
+  auto O = model.O();
+  auto L = model.L();
+  auto P = opt.partition_num;
+  auto K = opt.hash_num;
+  auto order_list = model.and_topo_order();
+  VarMap var_map{model};
+  auto var_num = var_map.var_num();
+
+  // ANDノードの集合の min-hash の署名をボトムアップに求める．
+  // 署名は K 個のハッシュ関数ごとの最小値で，ANDノードの署名は
+  // 自身のハッシュ値とファンインの署名の要素ごとの最小値となる．
+  // 入力と定数の署名は空で，ラッチの署名は latch_sig で与える．
+  // root_list の変数の署名を root_sig に書き込む．
+  // 署名の領域は残りのファンアウト数が 0 になったら再利用する．
+  vector<std::uint32_t> empty_sig(K, EMPTY);
+  auto propagate = [&](const vector<std::uint32_t>& latch_sig,
+		       const vector<SizeType>& root_list,
+		       vector<std::uint32_t>& root_sig) {
+    vector<std::uint32_t> slot_list(var_num, UNDEF);
+    vector<std::uint32_t> count_list(var_num, 0);
+    vector<std::uint32_t> arena;
+    vector<std::uint32_t> free_list;
+    for ( auto pos: order_list ) {
+      ++ count_list[model.and_src1(pos) / 2];
+      ++ count_list[model.and_src2(pos) / 2];
+    }
+    for ( auto var: root_list ) {
+      ++ count_list[var];
+    }
+    auto sig = [&](SizeType var) -> const std::uint32_t* {
+      auto slot = slot_list[var];
+      if ( slot != UNDEF ) {
+	return &arena[slot * K];
+      }
+      if ( !latch_sig.empty() && var_map.kind(var) == VarMap::LATCH ) {
+	return &latch_sig[var_map.pos(var) * K];
+      }
+      return empty_sig.data();
+    };
+    auto release = [&](SizeType var) {
+      -- count_list[var];
+      if ( count_list[var] == 0 && slot_list[var] != UNDEF ) {
+	free_list.push_back(slot_list[var]);
+      }
+    };
+    for ( auto pos: order_list ) {
+      auto var = model.and_node(pos) / 2;
+      auto var1 = model.and_src1(pos) / 2;
+      auto var2 = model.and_src2(pos) / 2;
+      std::uint32_t slot;
+      if ( free_list.empty() ) {
+	slot = arena.size() / K;
+	arena.resize(arena.size() + K);
+      }
+      else {
+	slot = free_list.back();
+	free_list.pop_back();
+      }
+      auto sig1 = sig(var1);
+      auto sig2 = sig(var2);
+      auto dst = &arena[slot * K];
+      for ( SizeType j = 0; j < K; ++ j ) {
+	std::uint32_t h = BitSim::random_word(opt.seed, var * K + j) >> 32;
+	dst[j] = std::min({h, sig1[j], sig2[j]});
+      }
+      slot_list[var] = slot;
+      release(var1);
+      release(var2);
+      if ( count_list[var] == 0 ) {
+	free_list.push_back(slot);
+      }
+    }
+    root_sig.resize(root_list.size() * K);
+    for ( SizeType i = 0; i < root_list.size(); ++ i ) {
+      auto src = sig(root_list[i]);
+      std::copy(src, src + K, &root_sig[i * K]);
+    }
+  };
+
+  // 出力の影響範囲は推移的ファンインのラッチの次状態関数も含むので，
+  // まずラッチのソースの組み合わせ回路的な署名を求め，
+  // 依存グラフの強連結成分ごとにファンイン側から閉包をとる．
+  vector<std::uint32_t> latch_sig;
+  if ( L > 0 ) {
+    vector<SizeType> src_list(L);
+    for ( SizeType i = 0; i < L; ++ i ) {
+      src_list[i] = model.latch_src(i) / 2;
+    }
+    vector<std::uint32_t> src_sig;
+    propagate({}, src_list, src_sig);
+    latch_sig.assign(L * K, EMPTY);
+    vector<std::uint32_t> acc(K);
+    for ( SizeType id = 0; id < graph.scc_num(); ++ id ) {
+      std::fill(acc.begin(), acc.end(), EMPTY);
+      for ( SizeType i = 0; i < graph.scc_size(id); ++ i ) {
+	auto latch = graph.scc_latch(id, i);
+	for ( SizeType j = 0; j < K; ++ j ) {
+	  acc[j] = std::min(acc[j], src_sig[latch * K + j]);
+	}
+	for ( SizeType k = 0; k < graph.fanin_num(latch); ++ k ) {
+	  auto latch1 = graph.fanin(latch, k);
+	  if ( graph.scc_id(latch1) != id ) {
+	    for ( SizeType j = 0; j < K; ++ j ) {
+	      acc[j] = std::min(acc[j], latch_sig[latch1 * K + j]);
+	    }
+	  }
+	}
+      }
+      for ( SizeType i = 0; i < graph.scc_size(id); ++ i ) {
+	auto latch = graph.scc_latch(id, i);
+	std::copy(acc.begin(), acc.end(), &latch_sig[latch * K]);
+      }
+    }
+  }
+
+  // 出力の署名を求める．
+  vector<SizeType> out_list(O);
+  for ( SizeType i = 0; i < O; ++ i ) {
+    out_list[i] = model.output_src(i) / 2;
+  }
+  vector<std::uint32_t> out_sig;
+  propagate(latch_sig, out_list, out_sig);
+  vector<std::uint32_t>().swap(latch_sig);
+  vector<double> out_size(O);
+  for ( SizeType i = 0; i < O; ++ i ) {
+    out_size[i] = estimate(&out_sig[i * K], K);
+  }
+
+  // 出力とラッチをたどって影響範囲に含まれる変数を数える．
+  // mark[var] が stamp に等しいか，skip が真を返す変数はたどらない．
+  // 新たに訪れた変数を visit_list に入れて，そのうちのANDノード数を返す．
+  vector<std::uint32_t> mark(var_num, UNDEF);
+  vector<SizeType> stack;
+  auto traverse = [&](const vector<SizeType>& root_list,
+		      std::uint32_t stamp,
+		      auto skip,
+		      vector<SizeType>& visit_list) {
+    visit_list.clear();
+    auto push = [&](SizeType var) {
+      if ( mark[var] != stamp && !skip(var) ) {
+	mark[var] = stamp;
+	stack.push_back(var);
+	visit_list.push_back(var);
+      }
+    };
+    for ( auto var: root_list ) {
+      push(var);
+    }
+    SizeType n = 0;
+    while ( !stack.empty() ) {
+      auto var = stack.back();
+      stack.pop_back();
+      auto kind = var_map.kind(var);
+      if ( kind == VarMap::AND ) {
+	auto pos = var_map.pos(var);
+	++ n;
+	push(model.and_src1(pos) / 2);
+	push(model.and_src2(pos) / 2);
+      }
+      else if ( kind == VarMap::LATCH ) {
+	push(model.latch_src(var_map.pos(var)) / 2);
+      }
+    }
+    return n;
+  };
+
+  // 全体の大きさから分割ごとの上限を決める．
+  vector<SizeType> visit_list;
+  auto total = traverse(out_list, 0, [](SizeType) { return false; }, visit_list);
+  auto limit = static_cast<double>(total) / P * opt.balance;
+
+  // 大きい出力から順に，共有部分が最大の分割に加える．
+  // 署名の値が一致する位置の割合は Jaccard 係数の推定値になるので，
+  // 共有部分の大きさは和集合の大きさとの積で見積もる．
+  // 分割の大きさは分割ごとの変数のビットベクタを用いて正確に数え，
+  // 加えると上限を越える場合や共有部分のある分割がない場合は
+  // 最小の分割に加える．
+  vector<SizeType> out_order(O);
+  std::iota(out_order.begin(), out_order.end(), 0);
+  std::stable_sort(out_order.begin(), out_order.end(),
+		   [&](SizeType a, SizeType b) {
+		     return out_size[a] > out_size[b];
+		   });
+  auto nw = (var_num + 63) / 64;
+  vector<vector<std::uint64_t>> bits_array(P);
+  vector<std::uint32_t> part_sig(P * K, EMPTY);
+  vector<std::uint32_t> tmp_sig(K);
+  mPartitionId.assign(O, 0);
+  mAndNum.assign(P, 0);
+  std::uint32_t stamp = 0;
+  vector<SizeType> root_list(1);
+  for ( auto i: out_order ) {
+    auto osig = &out_sig[i * K];
+    SizeType best = P;
+    double best_overlap = 0.0;
+    for ( SizeType id = 0; id < P; ++ id ) {
+      auto psig = &part_sig[id * K];
+      SizeType match = 0;
+      for ( SizeType j = 0; j < K; ++ j ) {
+	if ( osig[j] != EMPTY && osig[j] == psig[j] ) {
+	  ++ match;
+	}
+	tmp_sig[j] = std::min(psig[j], osig[j]);
+      }
+      auto overlap = estimate(tmp_sig.data(), K) * match / K;
+      if ( match > 0 && (best == P || overlap > best_overlap) ) {
+	best = id;
+	best_overlap = overlap;
+      }
+    }
+    root_list[0] = out_list[i];
+    SizeType n = 0;
+    auto add_num = [&](SizeType id) {
+      auto& bits = bits_array[id];
+      ++ stamp;
+      if ( bits.empty() ) {
+	return traverse(root_list, stamp, [](SizeType) { return false; },
+			visit_list);
+      }
+      return traverse(root_list, stamp,
+		      [&](SizeType var) {
+			return ((bits[var / 64] >> (var % 64)) & 1ULL) != 0;
+		      },
+		      visit_list);
+    };
+    if ( best != P ) {
+      n = add_num(best);
+      if ( mAndNum[best] > 0 && mAndNum[best] + n > limit ) {
+	best = P;
+      }
+    }
+    if ( best == P ) {
+      best = std::min_element(mAndNum.begin(), mAndNum.end()) - mAndNum.begin();
+      n = add_num(best);
+    }
+    auto& bits = bits_array[best];
+    if ( bits.empty() ) {
+      bits.assign(nw, 0ULL);
+    }
+    for ( auto var: visit_list ) {
+      bits[var / 64] |= 1ULL << (var % 64);
+    }
+    mAndNum[best] += n;
+    auto psig = &part_sig[best * K];
+    for ( SizeType j = 0; j < K; ++ j ) {
+      psig[j] = std::min(psig[j], osig[j]);
+    }
+    mPartitionId[i] = best;
+  }
+
+  // 分割ごとの出力番号の配列を作る．
+  mBegin.assign(P + 1, 0);
+  for ( auto id: mPartitionId ) {
+    ++ mBegin[id + 1];
+  }
+  for ( SizeType id = 0; id < P; ++ id ) {
+    mBegin[id + 1] += mBegin[id];
+  }
+  mOutputArray.resize(O);
+  vector<SizeType> next_list(mBegin.begin(), mBegin.end() - 1);
+  for ( SizeType i = 0; i < O; ++ i ) {
+    auto id = mPartitionId[i];
+    mOutputArray[next_list[id]] = i;
+    ++ next_list[id];
+  }
+}
+
+END_NAMESPACE_YM_AIG
@@ -0,0 +1,564 @@
+
+/// @file AigSupports.cc
+/// @brief AigSupports の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigSupports.h"
+#include "ModelImpl.h"
+#include "VarMap.h"
+#include "WorkPool.h"
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+BEGIN_NONAMESPACE
+
+// 未定義を表す値
+const std::uint32_t UNDEF = 0xFFFFFFFFU;
+
+// 和集合のキャッシュのサイズ(2のべき乗)
+const SizeType CACHE_SIZE = SizeType{1} << 16;
+
+// ハッシュ値に x を混ぜる．
+inline
+std::uint64_t
+hash_mix(
+  std::uint64_t h,
+  std::uint64_t x
+)
+{
+  h = (h ^ x) * 0x9E3779B97F4A7C15ULL;
+  return h ^ (h >> 32);
+}
+
+//////////////////////////////////////////////////////////////////////
+// 要素の集合(サポート)を共有して保持するクラス
+//
+// - 集合は要素数によって昇順のリストかビットベクタのどちらかで表す．
+//   要素数が決まれば表現も決まるので，内容の等しい集合は
+//   ハッシュ表で1つにまとめられる．
+// - 集合の番号は 0 が空集合，e + 1 が要素 e だけからなる集合となる．
+//   これらは常に残しておき，それ以外は参照回数が 0 になったら
+//   領域を再利用する．番号は再利用しない．
+// - 和集合の結果は直接写像のキャッシュに記録する．
+//////////////////////////////////////////////////////////////////////
+class SupportPool
+{
+public:
+
+  // コンストラクタ
+  SupportPool(
+    SizeType elem_num
+  ) : mWordNum{(elem_num + 63) / 64},
+      mThreshold{std::max<SizeType>(mWordNum * 2, 2)},
+      mFreeListArray(mThreshold),
+      mTmpBits(mWordNum),
+      mCache(CACHE_SIZE, Cache{UNDEF, UNDEF, UNDEF})
+  {
+    mHashTable.assign(1024, UNDEF);
+    // 空集合
+    mTmpList.clear();
+    intern_list();
+    // 要素1つの集合(mThreshold は 2 以上なので常にリストとなる)
+    for ( SizeType e = 0; e < elem_num; ++ e ) {
+      mTmpList.assign(1, e);
+      intern_list();
+    }
+    mPinnedNum = mEntryList.size();
+  }
+
+  // 和集合を返す．
+  //
+  // 結果の参照回数は増やさない．
+  std::uint32_t
+  merge(
+    std::uint32_t a,
+    std::uint32_t b
+  )
+  {
+    if ( a == b || b == 0 ) {
+      return a;
+    }
+    if ( a == 0 ) {
+      return b;
+    }
+    if ( a > b ) {
+      std::swap(a, b);
+    }
+    auto& cache = mCache[hash_mix(a, b) & (CACHE_SIZE - 1)];
+    if ( cache.mA == a && cache.mB == b && mEntryList[cache.mResult].mAlive ) {
+      return cache.mResult;
+    }
+    auto ans = merge_sub(a, b);
+    mCache[hash_mix(a, b) & (CACHE_SIZE - 1)] = Cache{a, b, ans};
+    return ans;
+  }
+
+  // 参照回数を増やす．
+  void
+  ref(
+    std::uint32_t id
+  )
+  {
+    if ( id >= mPinnedNum ) {
+      ++ mEntryList[id].mRef;
+    }
+  }
+
+  // 参照回数を減らす．
+  void
+  deref(
+    std::uint32_t id
+  )
+  {
+    if ( id < mPinnedNum ) {
+      return;
+    }
+    auto& entry = mEntryList[id];
+    ASSERT_COND( entry.mRef > 0 );
+    -- entry.mRef;
+    if ( entry.mRef == 0 ) {
+      // ハッシュ表の要素は削除済みの印として残す．
+      entry.mAlive = false;
+      if ( entry.mBitset ) {
+	mFreeBits.push_back(entry.mOffset);
+      }
+      else {
+	mFreeListArray[entry.mSize].push_back(entry.mOffset);
+      }
+    }
+  }
+
+  // 集合の要素数を返す．
+  SizeType
+  size(
+    std::uint32_t id
+  ) const
+  {
+    return mEntryList[id].mSize;
+  }
+
+  // 集合の要素を昇順に dst に書き込む．
+  void
+  get_list(
+    std::uint32_t id,
+    std::uint32_t* dst
+  ) const
+  {
+    auto& entry = mEntryList[id];
+    if ( entry.mBitset ) {
+      auto bits = &mBitArena[entry.mOffset];
+      for ( SizeType w = 0; w < mWordNum; ++ w ) {
+	auto word = bits[w];
+	while ( word != 0 ) {
+	  auto b = __builtin_ctzll(word);
+	  *dst = w * 64 + b;
+	  ++ dst;
+	  word &= word - 1;
+	}
+      }
+    }
+    else {
+      auto list = &mListArena[entry.mOffset];
+      std::copy(list, list + entry.mSize, dst);
+    }
+  }
+
+
+private:
+
+  // 集合の情報
+  struct Entry
+  {
+    SizeType mOffset;    // mListArena か mBitArena 中の先頭位置
+    std::uint64_t mHash; // ハッシュ値
+    std::uint32_t mSize; // 要素数
+    std::uint32_t mRef;  // 参照回数
+    bool mBitset;        // ビットベクタで表している時 true
+    bool mAlive;         // 使用中の時 true
+  };
+
+  // 和集合のキャッシュの要素
+  struct Cache
+  {
+    std::uint32_t mA;
+    std::uint32_t mB;
+    std::uint32_t mResult;
+  };
+
+  // 和集合を計算する．
+  std::uint32_t
+  merge_sub(
+    std::uint32_t a,
+    std::uint32_t b
+  )
+  {
+    auto& ea = mEntryList[a];
+    auto& eb = mEntryList[b];
+    if ( !ea.mBitset && !eb.mBitset ) {
+      auto la = &mListArena[ea.mOffset];
+      auto lb = &mListArena[eb.mOffset];
+      mTmpList.clear();
+      std::set_union(la, la + ea.mSize, lb, lb + eb.mSize,
+		     std::back_inserter(mTmpList));
+      // 要素数が変わらなければ一方に含まれている．
+      if ( mTmpList.size() == ea.mSize ) {
+	return a;
+      }
+      if ( mTmpList.size() == eb.mSize ) {
+	return b;
+      }
+      if ( mTmpList.size() >= mThreshold ) {
+	std::fill(mTmpBits.begin(), mTmpBits.end(), 0ULL);
+	for ( auto e: mTmpList ) {
+	  mTmpBits[e / 64] |= 1ULL << (e % 64);
+	}
+	return intern_bits(mTmpList.size());
+      }
+      return intern_list();
+    }
+
+    // 少なくとも一方はビットベクタ
+    // 要素数の大きい方をビットベクタとして先にコピーする．
+    auto big = (ea.mSize >= eb.mSize) ? a : b;
+    auto small = (big == a) ? b : a;
+    auto& e1 = mEntryList[big];
+    auto& e2 = mEntryList[small];
+    ASSERT_COND( e1.mBitset );
+    std::copy(&mBitArena[e1.mOffset], &mBitArena[e1.mOffset] + mWordNum,
+	      mTmpBits.begin());
+    if ( e2.mBitset ) {
+      auto bits = &mBitArena[e2.mOffset];
+      for ( SizeType w = 0; w < mWordNum; ++ w ) {
+	mTmpBits[w] |= bits[w];
+      }
+    }
+    else {
+      auto list = &mListArena[e2.mOffset];
+      for ( SizeType i = 0; i < e2.mSize; ++ i ) {
+	auto e = list[i];
+	mTmpBits[e / 64] |= 1ULL << (e % 64);
+      }
+    }
+    SizeType n = 0;
+    for ( SizeType w = 0; w < mWordNum; ++ w ) {
+      n += __builtin_popcountll(mTmpBits[w]);
+    }
+    if ( n == e1.mSize ) {
+      return big;
+    }
+    return intern_bits(n);
+  }
+
+  // mTmpList の内容を登録して番号を返す．
+  std::uint32_t
+  intern_list()
+  {
+    std::uint64_t h = 0;
+    for ( auto e: mTmpList ) {
+      h = hash_mix(h, e);
+    }
+    SizeType n = mTmpList.size();
+    auto equal = [&](const Entry& entry) {
+      return !entry.mBitset && entry.mSize == n
+	&& std::equal(mTmpList.begin(), mTmpList.end(),
+		      mListArena.begin() + entry.mOffset);
+    };
+    auto id = find(h, equal);
+    if ( id == UNDEF ) {
+      SizeType offset;
+      auto& free_list = mFreeListArray[n];
+      if ( free_list.empty() ) {
+	offset = mListArena.size();
+	mListArena.resize(offset + n);
+      }
+      else {
+	offset = free_list.back();
+	free_list.pop_back();
+      }
+      std::copy(mTmpList.begin(), mTmpList.end(), mListArena.begin() + offset);
+      id = add(Entry{offset, h, static_cast<std::uint32_t>(n), 0, false, true});
+    }
+    return id;
+  }
+
+  // mTmpBits の内容を登録して番号を返す．
+  std::uint32_t
+  intern_bits(
+    SizeType n
+  )
+  {
+    std::uint64_t h = 1;
+    for ( auto w: mTmpBits ) {
+      h = hash_mix(h, w);
+    }
+    auto equal = [&](const Entry& entry) {
+      return entry.mBitset && entry.mSize == n
+	&& std::memcmp(mTmpBits.data(), &mBitArena[entry.mOffset],
+		       mWordNum * sizeof(std::uint64_t)) == 0;
+    };
+    auto id = find(h, equal);
+    if ( id == UNDEF ) {
+      SizeType offset;
+      if ( mFreeBits.empty() ) {
+	offset = mBitArena.size();
+	mBitArena.resize(offset + mWordNum);
+      }
+      else {
+	offset = mFreeBits.back();
+	mFreeBits.pop_back();
+      }
+      std::copy(mTmpBits.begin(), mTmpBits.end(), mBitArena.begin() + offset);
+      id = add(Entry{offset, h, static_cast<std::uint32_t>(n), 0, true, true});
+    }
+    return id;
+  }
+
+  // ハッシュ表を探す．
+  //
+  // 削除済みの要素は読み飛ばす．
+  template<class Equal>
+  std::uint32_t
+  find(
+    std::uint64_t h,
+    Equal equal
+  ) const
+  {
+    auto mask = mHashTable.size() - 1;
+    for ( auto idx = h & mask; ; idx = (idx + 1) & mask ) {
+      auto id = mHashTable[idx];
+      if ( id == UNDEF ) {
+	return UNDEF;
+      }
+      auto& entry = mEntryList[id];
+      if ( entry.mAlive && entry.mHash == h && equal(entry) ) {
+	return id;
+      }
+    }
+  }
+
+  // 新しい集合を登録する．
+  std::uint32_t
+  add(
+    const Entry& entry
+  )
+  {
+    if ( mEntryList.size() >= UNDEF - 1 ) {
+      throw std::invalid_argument{"AigSupports: too many supports."};
+    }
+    std::uint32_t id = mEntryList.size();
+    mEntryList.push_back(entry);
+    ++ mLiveNum;
+    if ( (mUsedNum + 1) * 2 > mHashTable.size() ) {
+      // 削除済みの要素を除いて作り直す．
+      // 生きている要素が多ければ拡大する．
+      auto size = mHashTable.size();
+      while ( mLiveNum * 4 > size ) {
+	size <<= 1;
+      }
+      mHashTable.assign(size, UNDEF);
+      mUsedNum = 0;
+      mLiveNum = 0;
+      for ( std::uint32_t id1 = 0; id1 < mEntryList.size(); ++ id1 ) {
+	if ( mEntryList[id1].mAlive ) {
+	  insert(id1);
+	  ++ mLiveNum;
+	}
+      }
+    }
+    else {
+      insert(id);
+    }
+    return id;
+  }
+
+  // ハッシュ表に登録する．
+  //
+  // 削除済みの要素の場所は再利用する．
+  void
+  insert(
+    std::uint32_t id
+  )
+  {
+    auto mask = mHashTable.size() - 1;
+    for ( auto idx = mEntryList[id].mHash & mask; ; idx = (idx + 1) & mask ) {
+      auto id1 = mHashTable[idx];
+      if ( id1 == UNDEF ) {
+	mHashTable[idx] = id;
+	++ mUsedNum;
+	return;
+      }
+      if ( !mEntryList[id1].mAlive ) {
+	mHashTable[idx] = id;
+	return;
+      }
+    }
+  }
+
+  // ビットベクタのワード数
+  SizeType mWordNum;
+
+  // これ以上の要素数の集合はビットベクタで表す．
+  SizeType mThreshold;
+
+  // 常に残しておく集合の数
+  SizeType mPinnedNum{0};
+
+  // 集合のリスト
+  vector<Entry> mEntryList;
+
+  // 使用中の集合の数(ハッシュ表を作り直した時点で数え直す)
+  SizeType mLiveNum{0};
+
+  // リストで表した集合の要素の配列
+  vector<std::uint32_t> mListArena;
+
+  // 要素数ごとの mListArena 中の空き領域のリスト
+  vector<vector<SizeType>> mFreeListArray;
+
+  // ビットベクタで表した集合のワードの配列
+  vector<std::uint64_t> mBitArena;
+
+  // mBitArena 中の空き領域のリスト
+  vector<SizeType> mFreeBits;
+
+  // 集合の番号のハッシュ表
+  vector<std::uint32_t> mHashTable;
+
+  // mHashTable の空きでない場所の数
+  SizeType mUsedNum{0};
+
+  // 作業用のリスト
+  vector<std::uint32_t> mTmpList;
+
+  // 作業用のビットベクタ
+  vector<std::uint64_t> mTmpBits;
+
+  // 和集合のキャッシュ
+  vector<Cache> mCache;
+
+};
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス AigSupports
+//////////////////////////////////////////////////////////////////////
+
+// @brief サポートの要素のリストを返す．
+vector<SizeType>
+AigSupports::support_list(
+  SizeType id
+) const
+{
+  ASSERT_COND( 0 <= id && id < support_num() );
+  vector<SizeType> ans_list(mArray.begin() + mBegin[id],
+			    mArray.begin() + mBegin[id + 1]);
+  return ans_list;
+}
+
+// @brief サポートを求める．
+void
+AigSupports::compute(
+  const ModelImpl& model,
+  const AigSupportOpt& opt
+)
+{
+  auto I = model.I();
+  auto L = model.L();
+  auto O = model.O();
+  if ( I + L >= UNDEF - 1 ) {
+    throw std::invalid_argument{"AigSupports: too many inputs and latches."};
+  }
+  mInputNum = I;
+
+  // ボトムアップに全ノードのサポートを求める．
+  // 残りのファンアウト数が 0 になったノードのサポートは参照を外して
+  // 領域を再利用する．出力とラッチのソースは最後まで残す．
+  auto order_list = model.and_topo_order();
+  VarMap var_map{model};
+  auto var_num = var_map.var_num();
+  SupportPool pool{I + L};
+  vector<std::uint32_t> sup_list(var_num, 0);
+  vector<std::uint32_t> count_list(var_num, 0);
+  for ( SizeType i = 0; i < I; ++ i ) {
+    sup_list[model.input(i) / 2] = i + 1;
+  }
+  for ( SizeType i = 0; i < L; ++ i ) {
+    sup_list[model.latch(i) / 2] = I + i + 1;
+  }
+  for ( auto pos: order_list ) {
+    ++ count_list[model.and_src1(pos) / 2];
+    ++ count_list[model.and_src2(pos) / 2];
+  }
+  for ( SizeType i = 0; i < O; ++ i ) {
+    ++ count_list[model.output_src(i) / 2];
+  }
+  for ( SizeType i = 0; i < L; ++ i ) {
+    ++ count_list[model.latch_src(i) / 2];
+  }
+  auto release = [&](SizeType var) {
+    -- count_list[var];
+    if ( count_list[var] == 0 ) {
+      pool.deref(sup_list[var]);
+    }
+  };
+  for ( auto pos: order_list ) {
+    auto var = model.and_node(pos) / 2;
+    auto var1 = model.and_src1(pos) / 2;
+    auto var2 = model.and_src2(pos) / 2;
+    auto sup = pool.merge(sup_list[var1], sup_list[var2]);
+    sup_list[var] = sup;
+    pool.ref(sup);
+    release(var1);
+    release(var2);
+    if ( count_list[var] == 0 ) {
+      pool.deref(sup);
+    }
+  }
+
+  // 出力とラッチのソースのサポートに出現順に番号を振り直す．
+  vector<std::uint32_t> root_list;
+  std::unordered_map<std::uint32_t, std::uint32_t> id_map;
+  auto get_id = [&](SizeType lit) {
+    auto sup = sup_list[lit / 2];
+    auto p = id_map.find(sup);
+    if ( p != id_map.end() ) {
+      return p->second;
+    }
+    std::uint32_t id = root_list.size();
+    id_map.emplace(sup, id);
+    root_list.push_back(sup);
+    return id;
+  };
+  mOutputSupport.resize(O);
+  for ( SizeType i = 0; i < O; ++ i ) {
+    mOutputSupport[i] = get_id(model.output_src(i));
+  }
+  mLatchSupport.resize(L);
+  for ( SizeType i = 0; i < L; ++ i ) {
+    mLatchSupport[i] = get_id(model.latch_src(i));
+  }
+
+  // 要素の配列を作る．
+  // サポートごとに独立しているので並列に書き込む．
+  auto n = root_list.size();
+  mBegin.assign(n + 1, 0);
+  for ( SizeType id = 0; id < n; ++ id ) {
+    mBegin[id + 1] = mBegin[id] + pool.size(root_list[id]);
+  }
+  mArray.resize(mBegin[n]);
+  WorkPool wpool{opt.thread_num};
+  wpool.run(n, [&](SizeType id, SizeType) {
+    pool.get_list(root_list[id], mArray.data() + mBegin[id]);
+  });
+}
+
+END_NAMESPACE_YM_AIG
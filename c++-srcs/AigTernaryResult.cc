@@ -0,0 +1,194 @@
+
+/// @file AigTernaryResult.cc
+/// @brief AigTernaryResult の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigTernaryResult.h"
+#include "ModelImpl.h"
+#include "BitSim.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+BEGIN_NONAMESPACE
+
+// X のビット数を数える．
+inline
+SizeType
+count_x(
+  std::uint64_t v0,
+  std::uint64_t v1
+)
+{
+  return __builtin_popcountll(~(v0 | v1));
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス AigTernaryResult
+//////////////////////////////////////////////////////////////////////
+
+// @brief 出力が X に固定されている時 true を返す．
+bool
+AigTernaryResult::is_stuck_x(
+  SizeType pos
+) const
+{
+  ASSERT_COND( 0 <= pos && pos < output_num() );
+  if ( mCycleNum == 0 ) {
+    return false;
+  }
+  for ( SizeType c = 0; c < mCycleNum; ++ c ) {
+    if ( x_count(c, pos) < mPatNum ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// @brief X に固定されている出力番号のリストを返す．
+vector<SizeType>
+AigTernaryResult::stuck_x_list() const
+{
+  vector<SizeType> ans_list;
+  for ( SizeType pos = 0; pos < mOutputNum; ++ pos ) {
+    if ( is_stuck_x(pos) ) {
+      ans_list.push_back(pos);
+    }
+  }
+  return ans_list;
+}
+
+// @brief 内容を出力する．
+void
+AigTernaryResult::print(
+  ostream& s
+) const
+{
+  s << "#patterns: " << mPatNum
+    << ", #cycles: " << mCycleNum << endl;
+  for ( SizeType pos = 0; pos < mOutputNum; ++ pos ) {
+    s << "O#" << pos << ":";
+    for ( SizeType c = 0; c < mCycleNum; ++ c ) {
+      s << " " << x_count(c, pos);
+    }
+    if ( is_stuck_x(pos) ) {
+      s << " (stuck at X)";
+    }
+    s << endl;
+  }
+  for ( SizeType pos = 0; pos < latch_num(); ++ pos ) {
+    s << "L#" << pos << ": " << mLatchXCount[pos] << endl;
+  }
+}
+
+// @brief 3値シミュレーションを行う．
+void
+AigTernaryResult::compute(
+  const ModelImpl& model,
+  const AigTernaryOpt& opt
+)
+{
+  auto I = model.I();
+  auto L = model.L();
+  auto O = model.O();
+  for ( SizeType c = 0; c < opt.input_list.size(); ++ c ) {
+    auto& pat = opt.input_list[c];
+    if ( pat.size() != I ) {
+      ostringstream buf;
+      buf << "ternary_simulate: input pattern size mismatch at cycle " << c
+	  << " (" << pat.size() << " vs " << I << ").";
+      throw std::invalid_argument{buf.str()};
+    }
+    for ( SizeType i = 0; i < I; ++ i ) {
+      auto ch = pat[i];
+      if ( ch != '0' && ch != '1' && ch != 'X' && ch != 'x' && ch != '?' ) {
+	ostringstream buf;
+	buf << "ternary_simulate: illegal character '" << ch
+	    << "' in input pattern at cycle " << c << ", position " << i << ".";
+	throw std::invalid_argument{buf.str()};
+      }
+    }
+  }
+
+  BitSim sim{model, opt.word_num, opt.thread_num, true};
+  auto nw = sim.word_num();
+  mPatNum = nw * 64;
+  mCycleNum = opt.cycle_num;
+  mOutputNum = O;
+  mXCount.assign(mCycleNum * O, 0);
+  mLatchXCount.assign(L, 0);
+
+  // ラッチの初期値を設定する．
+  for ( SizeType i = 0; i < L; ++ i ) {
+    auto v = sim.value(model.latch(i) / 2);
+    std::fill(v, v + nw, opt.latch_x ? 0ULL : ~0ULL);
+    std::fill(v + nw, v + nw * 2, 0ULL);
+  }
+
+  vector<std::uint64_t> next_state(L * nw * 2);
+  for ( SizeType c = 0; c < mCycleNum; ++ c ) {
+    // 入力値を設定する．
+    for ( SizeType i = 0; i < I; ++ i ) {
+      auto ch = c < opt.input_list.size() ? opt.input_list[c][i] : '?';
+      auto v = sim.value(model.input(i) / 2);
+      for ( SizeType w = 0; w < nw; ++ w ) {
+	std::uint64_t v1;
+	std::uint64_t v0;
+	switch ( ch ) {
+	case '0': v0 = ~0ULL; v1 = 0ULL; break;
+	case '1': v0 = 0ULL; v1 = ~0ULL; break;
+	case '?':
+	  v1 = BitSim::random_word(opt.seed, (c * I + i) * nw + w);
+	  v0 = ~v1;
+	  break;
+	default: v0 = 0ULL; v1 = 0ULL; break;
+	}
+	v[w] = v0;
+	v[nw + w] = v1;
+      }
+    }
+    sim.simulate();
+
+    for ( SizeType o = 0; o < O; ++ o ) {
+      auto src = model.output_src(o);
+      SizeType n = 0;
+      for ( SizeType w = 0; w < nw; ++ w ) {
+	n += count_x(sim.lit_rail(src, 0, w), sim.lit_rail(src, 1, w));
+      }
+      mXCount[c * O + o] = n;
+    }
+
+    // 次状態をラッチに移す．
+    // ラッチの出力が他のラッチの入力になっている場合があるので
+    // 一旦全て取り出してから書き込む．
+    for ( SizeType i = 0; i < L; ++ i ) {
+      auto src = model.latch_src(i);
+      auto dst = &next_state[i * nw * 2];
+      for ( SizeType w = 0; w < nw; ++ w ) {
+	dst[w] = sim.lit_rail(src, 0, w);
+	dst[nw + w] = sim.lit_rail(src, 1, w);
+      }
+    }
+    for ( SizeType i = 0; i < L; ++ i ) {
+      auto v = sim.value(model.latch(i) / 2);
+      std::copy(&next_state[i * nw * 2], &next_state[(i + 1) * nw * 2], v);
+    }
+  }
+
+  for ( SizeType i = 0; i < L; ++ i ) {
+    auto v = sim.value(model.latch(i) / 2);
+    SizeType n = 0;
+    for ( SizeType w = 0; w < nw; ++ w ) {
+      n += count_x(v[w], v[nw + w]);
+    }
+    mLatchXCount[i] = n;
+  }
+}
+
+END_NAMESPACE_YM_AIG
@@ -0,0 +1,470 @@
+
+/// @file AigTruthTables.cc
+/// @brief AigTruthTables の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigTruthTables.h"
+#include "ModelImpl.h"
+#include "VarMap.h"
+#include "WorkPool.h"
+#include <algorithm>
+#include <bitset>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+BEGIN_NONAMESPACE
+
+// サポート数の上限の最大値
+const SizeType MAX_INPUT_LIMIT = 20;
+
+// ワード内の変数の真理値表
+const std::uint64_t VAR_MASK[6] = {
+  0xAAAAAAAAAAAAAAAAULL,
+  0xCCCCCCCCCCCCCCCCULL,
+  0xF0F0F0F0F0F0F0F0ULL,
+  0xFF00FF00FF00FF00ULL,
+  0xFFFF0000FFFF0000ULL,
+  0xFFFFFFFF00000000ULL
+};
+
+// 変数 v の w ワード目のパタンを返す．
+inline
+std::uint64_t
+var_word(
+  SizeType v,
+  SizeType w
+)
+{
+  if ( v < 6 ) {
+    return VAR_MASK[v];
+  }
+  return ((w >> (v - 6)) & 1) ? ~0ULL : 0ULL;
+}
+
+// ビット数を数える．
+inline
+SizeType
+popcount(
+  std::uint64_t x
+)
+{
+  return std::bitset<64>(x).count();
+}
+
+// dst = (a ^ inv_a) & (b ^ inv_b) を計算する．
+void
+tt_and(
+  std::uint64_t* dst,
+  const std::uint64_t* a,
+  bool inv_a,
+  const std::uint64_t* b,
+  bool inv_b,
+  SizeType nw
+)
+{
+  std::uint64_t ma = inv_a ? ~0ULL : 0ULL;
+  std::uint64_t mb = inv_b ? ~0ULL : 0ULL;
+  SizeType w = 0;
+#if defined(__AVX2__)
+  auto va = _mm256_set1_epi64x(static_cast<long long>(ma));
+  auto vb = _mm256_set1_epi64x(static_cast<long long>(mb));
+  for ( ; w + 4 <= nw; w += 4 ) {
+    auto x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + w));
+    auto y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + w));
+    auto z = _mm256_and_si256(_mm256_xor_si256(x, va),
+			      _mm256_xor_si256(y, vb));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + w), z);
+  }
+#endif
+  for ( ; w < nw; ++ w ) {
+    dst[w] = (a[w] ^ ma) & (b[w] ^ mb);
+  }
+}
+
+// 変数 v が真理値表 t の関数に依存しない時 true を返す．
+bool
+is_vacuous(
+  const std::uint64_t* t,
+  SizeType nw,
+  SizeType v
+)
+{
+  if ( v < 6 ) {
+    SizeType s = 1 << v;
+    auto m = ~VAR_MASK[v];
+    for ( SizeType w = 0; w < nw; ++ w ) {
+      if ( ((t[w] >> s) & m) != (t[w] & m) ) {
+	return false;
+      }
+    }
+  }
+  else {
+    SizeType a = 1 << (v - 6);
+    for ( SizeType w = 0; w < nw; ++ w ) {
+      if ( (w & a) == 0 && t[w] != t[w + a] ) {
+	return false;
+      }
+    }
+  }
+  return true;
+}
+
+// ハッシュ値に x を混ぜる．
+inline
+std::uint64_t
+hash_mix(
+  std::uint64_t h,
+  std::uint64_t x
+)
+{
+  h ^= x + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+  h *= 0xBF58476D1CE4E5B9ULL;
+  return h ^ (h >> 31);
+}
+
+// NPN 変換で不変なハッシュ値を計算する．
+//
+// 関数が依存する変数だけを対象にして，
+// - 1 の数
+// - 各変数の正負のコファクタの 1 の数の組(小さい方, 大きい方)を整列したもの
+// を出力の否定をとった場合ととらない場合で比べて小さい方から作る．
+std::uint64_t
+calc_npn_hash(
+  const std::uint64_t* t,
+  SizeType n
+)
+{
+  SizeType b = std::max<SizeType>(n, 6);
+  SizeType nw = 1 << (b - 6);
+  SizeType ones = 0;
+  for ( SizeType w = 0; w < nw; ++ w ) {
+    ones += popcount(t[w]);
+  }
+  SizeType c1_list[MAX_INPUT_LIMIT];
+  SizeType m = 0;
+  for ( SizeType v = 0; v < n; ++ v ) {
+    if ( is_vacuous(t, nw, v) ) {
+      continue;
+    }
+    SizeType c1 = 0;
+    for ( SizeType w = 0; w < nw; ++ w ) {
+      c1 += popcount(t[w] & var_word(v, w));
+    }
+    c1_list[m] = c1;
+    ++ m;
+  }
+  // 依存しない変数の分を取り除く．
+  auto shift = b - m;
+  ones >>= shift;
+  SizeType half = m > 0 ? (1 << (m - 1)) : 0;
+  using Sig = vector<std::pair<SizeType, SizeType>>;
+  Sig sig0(m);
+  Sig sig1(m);
+  for ( SizeType i = 0; i < m; ++ i ) {
+    auto c1 = c1_list[i] >> shift;
+    auto c0 = ones - c1;
+    sig0[i] = std::minmax(c0, c1);
+    sig1[i] = std::minmax(half - c0, half - c1);
+  }
+  std::sort(sig0.begin(), sig0.end());
+  std::sort(sig1.begin(), sig1.end());
+  auto ones0 = ones;
+  auto ones1 = (SizeType{1} << m) - ones;
+  if ( ones1 < ones0 || (ones1 == ones0 && sig1 < sig0) ) {
+    std::swap(ones0, ones1);
+    std::swap(sig0, sig1);
+  }
+  std::uint64_t h = hash_mix(0, m);
+  h = hash_mix(h, ones0);
+  for ( auto& p: sig0 ) {
+    h = hash_mix(h, p.first);
+    h = hash_mix(h, p.second);
+  }
+  return h;
+}
+
+// 1出力分の結果
+struct Result
+{
+  vector<SizeType> mSupport;
+  vector<std::uint64_t> mTruth;
+  std::uint64_t mNpnHash{0};
+};
+
+// スレッドごとの作業領域
+struct ThreadBuf
+{
+  // 変数番号をキーにしたマーク
+  vector<std::uint32_t> mMark;
+  // 現在のマークの値
+  std::uint32_t mCurMark{0};
+  // 変数番号をキーにしたコーン内のファンアウト数
+  vector<SizeType> mRefCount;
+  // 変数番号をキーにした真理値表の位置
+  vector<SizeType> mSlot;
+  // 真理値表の領域
+  vector<std::uint64_t> mPool;
+  // 空いている真理値表の位置のリスト
+  vector<SizeType> mFreeList;
+  // 使用した真理値表の数
+  SizeType mSlotNum{0};
+  // 作業用のリスト
+  vector<SizeType> mStack;
+  vector<SizeType> mAndList;
+
+  // 新しいマークの値を返す．
+  std::uint32_t
+  new_mark()
+  {
+    ++ mCurMark;
+    if ( mCurMark == 0 ) {
+      std::fill(mMark.begin(), mMark.end(), 0);
+      mCurMark = 1;
+    }
+    return mCurMark;
+  }
+
+  // 真理値表の領域を確保する．
+  SizeType
+  alloc(
+    SizeType nw
+  )
+  {
+    if ( !mFreeList.empty() ) {
+      auto slot = mFreeList.back();
+      mFreeList.pop_back();
+      return slot;
+    }
+    auto slot = mSlotNum;
+    ++ mSlotNum;
+    if ( mPool.size() < mSlotNum * nw ) {
+      mPool.resize(mSlotNum * nw);
+    }
+    return slot;
+  }
+
+  // 真理値表の領域を返す．
+  std::uint64_t*
+  ptr(
+    SizeType slot,
+    SizeType nw
+  )
+  {
+    return &mPool[slot * nw];
+  }
+};
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス AigTruthTables
+//////////////////////////////////////////////////////////////////////
+
+// @brief サポートのリストを返す．
+vector<SizeType>
+AigTruthTables::support_list(
+  SizeType pos
+) const
+{
+  auto& output = _output(pos);
+  vector<SizeType> ans_list(mSupportArray.begin() + output.mSupportBegin,
+			    mSupportArray.begin() + output.mSupportBegin + output.mSupportNum);
+  return ans_list;
+}
+
+// @brief 真理値表を返す．
+vector<std::uint64_t>
+AigTruthTables::truth_table(
+  SizeType pos
+) const
+{
+  auto ptr = truth_ptr(pos);
+  if ( ptr == nullptr ) {
+    return {};
+  }
+  return vector<std::uint64_t>(ptr, ptr + truth_word_num(pos));
+}
+
+// @brief 真理値表を計算する．
+void
+AigTruthTables::compute(
+  const ModelImpl& model,
+  const AigTruthOpt& opt
+)
+{
+  if ( opt.input_limit > MAX_INPUT_LIMIT ) {
+    ostringstream buf;
+    buf << "compute_truth_tables: input_limit(" << opt.input_limit
+	<< ") must be less than or equal to " << MAX_INPUT_LIMIT << ".";
+    throw std::invalid_argument{buf.str()};
+  }
+
+  // ANDノードのトポロジカル順の順位
+  auto order_list = model.and_topo_order();
+  VarMap var_map{model};
+  auto var_num = var_map.var_num();
+  vector<SizeType> rank(var_num, 0);
+  for ( SizeType i = 0; i < order_list.size(); ++ i ) {
+    rank[model.and_node(order_list[i]) / 2] = i;
+  }
+
+  auto limit = opt.input_limit;
+  auto nout = model.O();
+  vector<Result> result_list(nout);
+
+  WorkPool pool{opt.thread_num};
+  vector<ThreadBuf> buf_list(pool.thread_num());
+  for ( auto& buf: buf_list ) {
+    buf.mMark.resize(var_num, 0);
+    buf.mRefCount.resize(var_num, 0);
+    buf.mSlot.resize(var_num, 0);
+  }
+
+  // 1つの出力の真理値表を計算する．
+  auto compute_output = [&](SizeType opos, ThreadBuf& buf) {
+    auto& result = result_list[opos];
+    auto root_lit = model.output_src(opos);
+    auto root = root_lit / 2;
+
+    // ファンインコーンを求める．
+    auto mark = buf.new_mark();
+    auto& support = result.mSupport;
+    auto& and_list = buf.mAndList;
+    auto& stack = buf.mStack;
+    and_list.clear();
+    stack.clear();
+    bool use_const = false;
+    buf.mMark[root] = mark;
+    stack.push_back(root);
+    while ( !stack.empty() ) {
+      auto var = stack.back();
+      stack.pop_back();
+      switch ( var_map.kind(var) ) {
+      case VarMap::CONST:
+	use_const = true;
+	break;
+      case VarMap::INPUT:
+      case VarMap::LATCH:
+	support.push_back(var * 2);
+	break;
+      case VarMap::AND:
+	{
+	  and_list.push_back(var);
+	  auto pos = var_map.pos(var);
+	  for ( auto lit: {model.and_src1(pos), model.and_src2(pos)} ) {
+	    auto var1 = lit / 2;
+	    if ( buf.mMark[var1] != mark ) {
+	      buf.mMark[var1] = mark;
+	      stack.push_back(var1);
+	    }
+	  }
+	}
+	break;
+      default:
+	ASSERT_NOT_REACHED;
+      }
+      if ( support.size() > limit ) {
+	// 上限を超えたので計算しない．
+	support.clear();
+	return;
+      }
+    }
+    std::sort(support.begin(), support.end());
+    std::sort(and_list.begin(), and_list.end(),
+	      [&](SizeType a, SizeType b) {
+		return rank[a] < rank[b];
+	      });
+
+    auto n = support.size();
+    SizeType nw = n <= 6 ? 1 : (1 << (n - 6));
+    buf.mFreeList.clear();
+    buf.mSlotNum = 0;
+
+    // コーン内のファンアウト数を数える．
+    for ( auto var: and_list ) {
+      auto pos = var_map.pos(var);
+      ++ buf.mRefCount[model.and_src1(pos) / 2];
+      ++ buf.mRefCount[model.and_src2(pos) / 2];
+    }
+    ++ buf.mRefCount[root];
+
+    // 葉の真理値表を作る．
+    if ( use_const ) {
+      auto slot = buf.alloc(nw);
+      buf.mSlot[0] = slot;
+      std::fill(buf.ptr(slot, nw), buf.ptr(slot, nw) + nw, 0ULL);
+    }
+    for ( SizeType i = 0; i < n; ++ i ) {
+      auto slot = buf.alloc(nw);
+      buf.mSlot[support[i] / 2] = slot;
+      auto t = buf.ptr(slot, nw);
+      for ( SizeType w = 0; w < nw; ++ w ) {
+	t[w] = var_word(i, w);
+      }
+    }
+
+    // トポロジカル順に AND を計算する．
+    // ファンアウトを全て処理したノードの領域は再利用する．
+    auto release = [&](SizeType var) {
+      if ( -- buf.mRefCount[var] == 0 ) {
+	buf.mFreeList.push_back(buf.mSlot[var]);
+      }
+    };
+    for ( auto var: and_list ) {
+      auto pos = var_map.pos(var);
+      auto lit1 = model.and_src1(pos);
+      auto lit2 = model.and_src2(pos);
+      auto slot = buf.alloc(nw);
+      buf.mSlot[var] = slot;
+      tt_and(buf.ptr(slot, nw),
+	     buf.ptr(buf.mSlot[lit1 / 2], nw), lit1 % 2,
+	     buf.ptr(buf.mSlot[lit2 / 2], nw), lit2 % 2,
+	     nw);
+      release(lit1 / 2);
+      release(lit2 / 2);
+    }
+    buf.mRefCount[root] = 0;
+
+    auto t = buf.ptr(buf.mSlot[root], nw);
+    std::uint64_t inv = (root_lit % 2) ? ~0ULL : 0ULL;
+    result.mTruth.resize(nw);
+    for ( SizeType w = 0; w < nw; ++ w ) {
+      result.mTruth[w] = t[w] ^ inv;
+    }
+    result.mNpnHash = calc_npn_hash(result.mTruth.data(), n);
+  };
+
+  pool.run(nout, [&](SizeType opos, SizeType tid) {
+    compute_output(opos, buf_list[tid]);
+  });
+
+  // 結果をまとめる．
+  mInputLimit = limit;
+  mOutputList.clear();
+  mOutputList.resize(nout);
+  mSupportArray.clear();
+  mTruthArray.clear();
+  for ( SizeType i = 0; i < nout; ++ i ) {
+    auto& result = result_list[i];
+    auto& output = mOutputList[i];
+    output.mSupportBegin = mSupportArray.size();
+    output.mTruthBegin = mTruthArray.size();
+    output.mNpnHash = result.mNpnHash;
+    output.mSupportNum = result.mSupport.size();
+    output.mTruthNum = result.mTruth.size();
+    mSupportArray.insert(mSupportArray.end(),
+			 result.mSupport.begin(), result.mSupport.end());
+    mTruthArray.insert(mTruthArray.end(),
+		       result.mTruth.begin(), result.mTruth.end());
+  }
+}
+
+END_NAMESPACE_YM_AIG
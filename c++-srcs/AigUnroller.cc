@@ -0,0 +1,166 @@
+
+/// @file AigUnroller.cc
+/// @brief AigUnroller の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigUnroller.h"
+#include "ym/AigModel.h"
+#include "ModelImpl.h"
+#include "StrashTable.h"
+#include "VarMap.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+// クラス AigUnroller
+//////////////////////////////////////////////////////////////////////
+
+// @brief 空のコンストラクタ
+AigUnroller::AigUnroller() = default;
+
+// @brief ムーブコンストラクタ
+AigUnroller::AigUnroller(
+  AigUnroller&& src
+) = default;
+
+// @brief ムーブ代入文
+AigUnroller&
+AigUnroller::operator=(
+  AigUnroller&& src
+) = default;
+
+// @brief デストラクタ
+AigUnroller::~AigUnroller() = default;
+
+// @brief 初期化する．
+void
+AigUnroller::initialize(
+  const std::shared_ptr<ModelImpl>& src,
+  const AigUnrollOpt& opt
+)
+{
+  mSrc = src;
+  mOrderList = mSrc->and_topo_order();
+  mSrcInputNum = mSrc->I();
+  mSrcOutputNum = mSrc->O();
+  mInitFree = opt.init_free;
+  if ( opt.strash ) {
+    mTable.reset(new StrashTable{mSrc->A() * opt.frame_num});
+  }
+  else {
+    mTable.reset();
+  }
+  mFrameNum = 0;
+  mNodeList.clear();
+  mNodeList.push_back(Node{0, 0});
+  mInputNum = 0;
+  mOutputLitList.clear();
+  VarMap var_map{*mSrc};
+  mLitMap.assign(var_map.var_num(), 0);
+
+  // 時刻 0 のラッチの値
+  auto L = mSrc->L();
+  mLatchLitList.assign(L, 0);
+  if ( mInitFree ) {
+    for ( SizeType i = 0; i < L; ++ i ) {
+      mLatchLitList[i] = new_input();
+    }
+    mInitNum = L;
+  }
+  else {
+    mInitNum = 0;
+  }
+
+  extend(opt.frame_num);
+}
+
+// @brief 展開を n 時刻延ばす．
+void
+AigUnroller::extend(
+  SizeType n
+)
+{
+  auto& src = *mSrc;
+  auto I = src.I();
+  auto L = src.L();
+  auto O = src.O();
+  auto map_lit = [&](SizeType lit) {
+    return mLitMap[lit / 2] ^ (lit % 2);
+  };
+  for ( SizeType k = 0; k < n; ++ k ) {
+    for ( SizeType i = 0; i < I; ++ i ) {
+      mLitMap[src.input(i) / 2] = new_input();
+    }
+    for ( SizeType i = 0; i < L; ++ i ) {
+      mLitMap[src.latch(i) / 2] = mLatchLitList[i];
+    }
+    for ( auto pos: mOrderList ) {
+      auto src1 = map_lit(src.and_src1(pos));
+      auto src2 = map_lit(src.and_src2(pos));
+      mLitMap[src.and_node(pos) / 2] = new_and(src1, src2);
+    }
+    for ( SizeType i = 0; i < O; ++ i ) {
+      mOutputLitList.push_back(map_lit(src.output_src(i)));
+    }
+    for ( SizeType i = 0; i < L; ++ i ) {
+      mLatchLitList[i] = map_lit(src.latch_src(i));
+    }
+    ++ mFrameNum;
+  }
+}
+
+// @brief 展開した組み合わせ回路を返す．
+AigModel
+AigUnroller::model() const
+{
+  AigModel aig;
+  aig.mImpl->make_unrolled(*this);
+  return aig;
+}
+
+// @brief 入力ノードを作る．
+SizeType
+AigUnroller::new_input()
+{
+  auto lit = mNodeList.size() * 2;
+  mNodeList.push_back(Node{INPUT_MARK, mInputNum});
+  ++ mInputNum;
+  return lit;
+}
+
+// @brief ANDノードを作る．
+SizeType
+AigUnroller::new_and(
+  SizeType src1,
+  SizeType src2
+)
+{
+  if ( mTable == nullptr ) {
+    auto lit = mNodeList.size() * 2;
+    mNodeList.push_back(Node{src1, src2});
+    return lit;
+  }
+
+  if ( src1 < src2 ) {
+    std::swap(src1, src2);
+  }
+  if ( src2 == 0 || src1 == (src2 ^ 1) ) {
+    return 0;
+  }
+  if ( src2 == 1 || src1 == src2 ) {
+    return src1;
+  }
+  auto lit = mTable->find(src1, src2);
+  if ( lit == StrashTable::NOT_FOUND ) {
+    lit = mNodeList.size() * 2;
+    mNodeList.push_back(Node{src1, src2});
+    mTable->add(src1, src2, lit);
+  }
+  return lit;
+}
+
+END_NAMESPACE_YM_AIG
@@ -0,0 +1,261 @@
+
+/// @file AsyncSource.cc
+/// @brief AsyncSource の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "AsyncSource.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+BEGIN_NONAMESPACE
+
+// システムコールのエラーを送出する．
+void
+sys_error(
+  const char* func_name,
+  int err
+)
+{
+  ostringstream buf;
+  buf << "AsyncSource: " << func_name << ": " << strerror(err);
+  throw std::invalid_argument{buf.str()};
+}
+
+END_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// クラス AsyncSource
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+AsyncSource::AsyncSource(
+  int fd,
+  SizeType file_size,
+  SizeType buff_size,
+  SizeType buff_num
+) : mFd{fd},
+    mFileSize{file_size}
+{
+#if defined(YM_AIG_HAVE_LIBURING)
+  if ( io_uring_queue_init(buff_num, &mUring, 0) == 0 ) {
+    mUseUring = true;
+    mSlotList.resize(buff_num);
+    for ( SizeType i = 0; i < buff_num; ++ i ) {
+      mSlotList[i].mData.resize(buff_size);
+      uring_submit(i);
+    }
+    return;
+  }
+  // io_uring が使えない環境では pread() にフォールバックする．
+#endif
+  mRing.reset(new ChunkRing{buff_size, buff_num,
+			    [this](char* buff, SizeType size) {
+			      return fill(buff, size);
+			    }});
+}
+
+// @brief デストラクタ
+AsyncSource::~AsyncSource()
+{
+  // mFd を閉じる前にスレッドを止める．
+  mRing = nullptr;
+#if defined(YM_AIG_HAVE_LIBURING)
+  if ( mUseUring ) {
+    // 発行済みの要求の完了を待つ．
+    for ( auto& slot: mSlotList ) {
+      while ( slot.mBusy ) {
+	io_uring_cqe* cqe;
+	if ( io_uring_wait_cqe(&mUring, &cqe) < 0 ) {
+	  break;
+	}
+	auto id = reinterpret_cast<SizeType>(io_uring_cqe_get_data(cqe));
+	mSlotList[id].mBusy = false;
+	io_uring_cqe_seen(&mUring, cqe);
+      }
+    }
+    io_uring_queue_exit(&mUring);
+  }
+#endif
+  ::close(mFd);
+}
+
+// @brief 圧縮されたデータを伸長しているとき true を返す．
+bool
+AsyncSource::is_compressed() const
+{
+  return false;
+}
+
+// @brief データを読み出す．
+SizeType
+AsyncSource::read(
+  char* buff,
+  SizeType size
+)
+{
+  SizeType n = 0;
+  while ( n < size ) {
+    if ( mCurPos == mCurSize && !next_buff() ) {
+      break;
+    }
+    auto m = std::min(size - n, mCurSize - mCurPos);
+    memcpy(buff + n, mCur + mCurPos, m);
+    mCurPos += m;
+    n += m;
+  }
+  return n;
+}
+
+// @brief next_chunk() が使える時 true を返す．
+bool
+AsyncSource::has_chunk() const
+{
+  return true;
+}
+
+// @brief 内部のバッファを直接参照してデータを読み出す．
+std::pair<const char*, SizeType>
+AsyncSource::next_chunk()
+{
+  // read() で途中まで読んでいたら残りの部分を返す．
+  if ( mCurPos == mCurSize && !next_buff() ) {
+    return {nullptr, 0};
+  }
+  auto p = mCur + mCurPos;
+  auto size = mCurSize - mCurPos;
+  mCurPos = mCurSize;
+  return {p, size};
+}
+
+// @brief 次のバッファに進む．
+bool
+AsyncSource::next_buff()
+{
+#if defined(YM_AIG_HAVE_LIBURING)
+  if ( mUseUring ) {
+    if ( mFirst ) {
+      mFirst = false;
+    }
+    else {
+      // 読み終わったスロットでファイルの続きを要求する．
+      uring_submit(mCurSlot);
+      mCurSlot = (mCurSlot + 1) % mSlotList.size();
+    }
+    uring_wait(mCurSlot);
+    auto& slot = mSlotList[mCurSlot];
+    mCur = slot.mData.data();
+    mCurSize = slot.mFilled;
+    mCurPos = 0;
+    return mCurSize > 0;
+  }
+#endif
+  auto chunk = mRing->next();
+  mCur = chunk.first;
+  mCurSize = chunk.second;
+  mCurPos = 0;
+  return mCurSize > 0;
+}
+
+// @brief ファイルの続きを pread() で読み込む．
+SizeType
+AsyncSource::fill(
+  char* buff,
+  SizeType size
+)
+{
+  // 短い読み込みが起きても size バイトか末尾まで読み込む．
+  SizeType n = 0;
+  while ( n < size && mReqOffset < mFileSize ) {
+    auto m = ::pread(mFd, buff + n, size - n, mReqOffset);
+    if ( m < 0 ) {
+      if ( errno == EINTR ) {
+	continue;
+      }
+      sys_error("pread()", errno);
+    }
+    if ( m == 0 ) {
+      // ファイルが途中で短くなった．
+      mFileSize = mReqOffset;
+      break;
+    }
+    n += m;
+    mReqOffset += m;
+  }
+  return n;
+}
+
+#if defined(YM_AIG_HAVE_LIBURING)
+// @brief スロットの読み込み要求を発行する．
+void
+AsyncSource::uring_submit(
+  SizeType id
+)
+{
+  auto& slot = mSlotList[id];
+  slot.mOffset = mReqOffset;
+  slot.mWant = std::min(slot.mData.size(), mFileSize - mReqOffset);
+  slot.mFilled = 0;
+  mReqOffset += slot.mWant;
+  if ( slot.mWant == 0 ) {
+    return;
+  }
+  auto sqe = io_uring_get_sqe(&mUring);
+  io_uring_prep_read(sqe, mFd, slot.mData.data(), slot.mWant, slot.mOffset);
+  io_uring_sqe_set_data(sqe, reinterpret_cast<void*>(id));
+  slot.mBusy = true;
+  io_uring_submit(&mUring);
+}
+
+// @brief スロットの読み込みが完了するまで待つ．
+void
+AsyncSource::uring_wait(
+  SizeType id
+)
+{
+  auto& slot = mSlotList[id];
+  while ( slot.mBusy ) {
+    io_uring_cqe* cqe;
+    auto ret = io_uring_wait_cqe(&mUring, &cqe);
+    if ( ret < 0 ) {
+      if ( ret == -EINTR ) {
+	continue;
+      }
+      sys_error("io_uring_wait_cqe()", -ret);
+    }
+    auto id1 = reinterpret_cast<SizeType>(io_uring_cqe_get_data(cqe));
+    auto res = cqe->res;
+    io_uring_cqe_seen(&mUring, cqe);
+    auto& slot1 = mSlotList[id1];
+    if ( res < 0 && res != -EINTR && res != -EAGAIN ) {
+      slot1.mBusy = false;
+      sys_error("io_uring read", -res);
+    }
+    if ( res > 0 ) {
+      slot1.mFilled += res;
+    }
+    if ( res == 0 || slot1.mFilled == slot1.mWant ) {
+      // 完了(res == 0 はファイルが途中で短くなった場合)
+      slot1.mBusy = false;
+      continue;
+    }
+    // 短い読み込みの場合は残りを要求し直す．
+    auto sqe = io_uring_get_sqe(&mUring);
+    io_uring_prep_read(sqe, mFd,
+		       slot1.mData.data() + slot1.mFilled,
+		       slot1.mWant - slot1.mFilled,
+		       slot1.mOffset + slot1.mFilled);
+    io_uring_sqe_set_data(sqe, reinterpret_cast<void*>(id1));
+    io_uring_submit(&mUring);
+  }
+}
+#endif
+
+END_NAMESPACE_YM_AIG
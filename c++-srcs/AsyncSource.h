@@ -0,0 +1,164 @@
+#ifndef ASYNCSOURCE_H
+#define ASYNCSOURCE_H
+
+/// @file AsyncSource.h
+/// @brief AsyncSource のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "InputSource.h"
+#include "ChunkRing.h"
+#if defined(YM_AIG_HAVE_LIBURING)
+#include <liburing.h>
+#endif
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+/// @class AsyncSource AsyncSource.h "AsyncSource.h"
+/// @brief 先読みを行いながらファイルを読み出す InputSource
+///
+/// 大きなバッファのリングを用意し，消費側が一つのバッファを
+/// 処理している間に残りのバッファへの読み込みを進める．
+/// 読み込みには io_uring が使える場合はそれを用い，そうでない場合は
+/// 専用の I/O スレッドで pread() を行う．
+/// pread() を用いるので通常ファイルに対してのみ用いることができる．
+//////////////////////////////////////////////////////////////////////
+class AsyncSource :
+  public InputSource
+{
+public:
+
+  /// @brief コンストラクタ
+  ///
+  /// fd の所有権はこのオブジェクトに移る．
+  AsyncSource(
+    int fd,                            ///< [in] ファイルディスクリプタ
+    SizeType file_size,                ///< [in] ファイルサイズ
+    SizeType buff_size = 4 * 1024 * 1024, ///< [in] バッファのサイズ
+    SizeType buff_num = 4              ///< [in] バッファ数
+  );
+
+  /// @brief デストラクタ
+  ~AsyncSource();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // InputSource の仮想関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 圧縮されたデータを伸長しているとき true を返す．
+  bool
+  is_compressed() const override;
+
+  /// @brief データを読み出す．
+  SizeType
+  read(
+    char* buff,   ///< [in] 読み出したデータを格納する領域
+    SizeType size ///< [in] buff のサイズ
+  ) override;
+
+  /// @brief next_chunk() が使える時 true を返す．
+  bool
+  has_chunk() const override;
+
+  /// @brief 内部のバッファを直接参照してデータを読み出す．
+  std::pair<const char*, SizeType>
+  next_chunk() override;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 次のバッファに進む．
+  ///
+  /// 末尾に達したら false を返す．
+  bool
+  next_buff();
+
+  /// @brief ファイルの続きを pread() で読み込む．
+  SizeType
+  fill(
+    char* buff,   ///< [in] 読み込み先
+    SizeType size ///< [in] buff のサイズ
+  );
+
+#if defined(YM_AIG_HAVE_LIBURING)
+  /// @brief スロットの読み込み要求を発行する．
+  void
+  uring_submit(
+    SizeType id ///< [in] スロット番号
+  );
+
+  /// @brief スロットの読み込みが完了するまで待つ．
+  void
+  uring_wait(
+    SizeType id ///< [in] スロット番号
+  );
+#endif
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ファイルディスクリプタ
+  int mFd;
+
+  // ファイルサイズ
+  SizeType mFileSize;
+
+  // 次に読み込みを要求するオフセット
+  SizeType mReqOffset{0};
+
+  // pread() 用のリングバッファ
+  std::unique_ptr<ChunkRing> mRing;
+
+  // 現在のバッファの先頭
+  const char* mCur{nullptr};
+
+  // 現在のバッファの有効なサイズ
+  SizeType mCurSize{0};
+
+  // 現在のバッファ中の読み出し位置
+  SizeType mCurPos{0};
+
+#if defined(YM_AIG_HAVE_LIBURING)
+  // io_uring 用のスロット
+  struct Slot
+  {
+    vector<char> mData;  // データ本体
+    SizeType mOffset{0}; // ファイル上のオフセット
+    SizeType mWant{0};   // 読み込むべきサイズ
+    SizeType mFilled{0}; // 読み込み済みのサイズ
+    bool mBusy{false};   // 読み込み中の時 true
+  };
+
+  // io_uring を用いている時 true にするフラグ
+  bool mUseUring{false};
+
+  // io_uring 本体
+  io_uring mUring;
+
+  // スロットのリスト
+  vector<Slot> mSlotList;
+
+  // 読み出し中のスロット番号
+  SizeType mCurSlot{0};
+
+  // 最初のスロットを読み出す前の時 true にするフラグ
+  bool mFirst{true};
+#endif
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // ASYNCSOURCE_H
@@ -0,0 +1,132 @@
+
+/// @file BitSim.cc
+/// @brief BitSim の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "BitSim.h"
+#include "ModelImpl.h"
+#include "VarMap.h"
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+BEGIN_NONAMESPACE
+
+// 1回のタスクで処理するノード数
+const SizeType CHUNK_SIZE = 256;
+
+// これ以上のノードを含むレベルは複数のスレッドで処理する．
+const SizeType PARALLEL_MIN = CHUNK_SIZE * 8;
+
+END_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// クラス BitSim
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+BitSim::BitSim(
+  const ModelImpl& model,
+  SizeType word_num,
+  SizeType thread_num,
+  bool ternary
+) : mWordNum{std::max<SizeType>(word_num, 1)},
+    mRailNum{ternary ? SizeType{2} : SizeType{1}},
+    mStride{mWordNum * mRailNum},
+    mPool{thread_num}
+{
+  auto order_list = model.and_topo_order();
+  VarMap var_map{model};
+  mVarNum = var_map.var_num();
+  if ( mVarNum >= (SizeType{1} << 31) ) {
+    throw std::invalid_argument{"BitSim: too many variables."};
+  }
+
+  auto make_gate = [&](SizeType pos) {
+    return Gate{static_cast<std::uint32_t>(model.and_node(pos) / 2),
+		static_cast<std::uint32_t>(model.and_src1(pos)),
+		static_cast<std::uint32_t>(model.and_src2(pos))};
+  };
+
+  auto na = order_list.size();
+  mGateList.reserve(na);
+  if ( mPool.thread_num() <= 1 ) {
+    // 1スレッドの場合はトポロジカル順のまま計算する．
+    for ( auto pos: order_list ) {
+      mGateList.push_back(make_gate(pos));
+    }
+    mStageList.push_back(Stage{0, na, false});
+  }
+  else {
+    // レベルごとに分けて並べ直す．
+    vector<std::uint32_t> level(mVarNum, 0);
+    vector<SizeType> count_list;
+    for ( auto pos: order_list ) {
+      auto lv = std::max(level[model.and_src1(pos) / 2],
+			 level[model.and_src2(pos) / 2]) + 1;
+      level[model.and_node(pos) / 2] = lv;
+      if ( count_list.size() <= lv ) {
+	count_list.resize(lv + 1, 0);
+      }
+      ++ count_list[lv];
+    }
+    vector<SizeType> begin_list(count_list.size() + 1, 0);
+    for ( SizeType lv = 0; lv < count_list.size(); ++ lv ) {
+      begin_list[lv + 1] = begin_list[lv] + count_list[lv];
+    }
+    mGateList.resize(na);
+    auto next_list = begin_list;
+    for ( auto pos: order_list ) {
+      auto lv = level[model.and_node(pos) / 2];
+      mGateList[next_list[lv]] = make_gate(pos);
+      ++ next_list[lv];
+    }
+    // 小さなレベルが続く部分は1つにまとめる．
+    for ( SizeType lv = 1; lv < count_list.size(); ++ lv ) {
+      auto begin = begin_list[lv];
+      auto end = begin_list[lv + 1];
+      if ( end - begin >= PARALLEL_MIN ) {
+	mStageList.push_back(Stage{begin, end, true});
+      }
+      else if ( !mStageList.empty() && !mStageList.back().mParallel ) {
+	mStageList.back().mEnd = end;
+      }
+      else {
+	mStageList.push_back(Stage{begin, end, false});
+      }
+    }
+  }
+
+  mValArray.resize(mVarNum * mStride, 0ULL);
+}
+
+// @brief ANDノードの値を計算する．
+void
+BitSim::simulate()
+{
+  // 定数ノードは常に 0
+  // 3値モードでは 0 の線が全て 1 となる．
+  std::fill(mValArray.begin(), mValArray.begin() + mWordNum,
+	    (mRailNum == 2) ? ~0ULL : 0ULL);
+  std::fill(mValArray.begin() + mWordNum, mValArray.begin() + mStride, 0ULL);
+  for ( auto& stage: mStageList ) {
+    if ( stage.mParallel ) {
+      auto begin = stage.mBegin;
+      auto n = stage.mEnd - begin;
+      auto chunk_num = (n + CHUNK_SIZE - 1) / CHUNK_SIZE;
+      mPool.run(chunk_num, [&](SizeType c, SizeType) {
+	auto end = std::min(n, (c + 1) * CHUNK_SIZE);
+	eval_range(begin + c * CHUNK_SIZE, begin + end);
+      });
+    }
+    else {
+      eval_range(stage.mBegin, stage.mEnd);
+    }
+  }
+}
+
+END_NAMESPACE_YM_AIG
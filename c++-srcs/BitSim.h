@@ -0,0 +1,287 @@
+#ifndef BITSIM_H
+#define BITSIM_H
+
+/// @file BitSim.h
+/// @brief BitSim のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+#include "WorkPool.h"
+#include <cstdint>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+class ModelImpl;
+
+//////////////////////////////////////////////////////////////////////
+/// @class BitSim BitSim.h "BitSim.h"
+/// @brief ビット並列の論理シミュレータ
+///
+/// - 変数ごとに word_num() ワードの値を持ち，
+///   64 * word_num() 個のパタンを同時にシミュレーションする．
+/// - 入力とラッチ(現状態)の値を設定してから simulate() を呼ぶと
+///   全ANDノードの値が計算される．定数ノードの値は常に 0 となる．
+/// - 3値(0, 1, X)モードでは変数ごとに 2 * word_num() ワードを持ち，
+///   先頭の word_num() ワードが値が 0 であることを，
+///   残りの word_num() ワードが値が 1 であることを表す(2線式)．
+///   両方とも 0 のビットが X となる．
+/// - ANDノードはレベル順に並べておき，大きなレベルは複数のスレッドで，
+///   小さなレベルが続く部分はまとめて1つのスレッドで計算する．
+/// - ANDノードの情報は 32 ビットの配列に詰めて持つので，
+///   変数番号は 2^31 未満でなければならない．
+//////////////////////////////////////////////////////////////////////
+class BitSim
+{
+public:
+
+  /// @brief コンストラクタ
+  ///
+  /// - 組み合わせ回路のループがある場合や変数番号が大きすぎる場合は
+  ///   std::invalid_argument 例外を送出する．
+  BitSim(
+    const ModelImpl& model, ///< [in] 対象のモデル
+    SizeType word_num,      ///< [in] 変数あたりのワード数
+    SizeType thread_num,    ///< [in] スレッド数(0 の時はハードウェアの並列度)
+    bool ternary = false    ///< [in] 3値モードの時 true
+  );
+
+  /// @brief デストラクタ
+  ~BitSim() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 変数番号の最大値 + 1 を返す．
+  SizeType
+  var_num() const
+  {
+    return mVarNum;
+  }
+
+  /// @brief 変数あたりのワード数を返す．
+  SizeType
+  word_num() const
+  {
+    return mWordNum;
+  }
+
+  /// @brief 3値モードの時 true を返す．
+  bool
+  is_ternary() const
+  {
+    return mRailNum == 2;
+  }
+
+  /// @brief スレッド数を返す．
+  SizeType
+  thread_num() const
+  {
+    return mPool.thread_num();
+  }
+
+  /// @brief 変数の値の先頭を返す．
+  ///
+  /// 3値モードの時は 0 の線，1 の線の順に並んでいる．
+  std::uint64_t*
+  value(
+    SizeType var ///< [in] 変数番号 ( 0 <= var < var_num() )
+  )
+  {
+    ASSERT_COND( 0 <= var && var < mVarNum );
+    return &mValArray[var * mStride];
+  }
+
+  /// @brief 変数の値の先頭を返す．
+  ///
+  /// 3値モードの時は 0 の線，1 の線の順に並んでいる．
+  const std::uint64_t*
+  value(
+    SizeType var ///< [in] 変数番号 ( 0 <= var < var_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= var && var < mVarNum );
+    return &mValArray[var * mStride];
+  }
+
+  /// @brief リテラルの値の w ワード目を返す．
+  ///
+  /// 2値モード用
+  std::uint64_t
+  lit_value(
+    SizeType lit, ///< [in] リテラル
+    SizeType w    ///< [in] ワード位置 ( 0 <= w < word_num() )
+  ) const
+  {
+    auto v = value(lit / 2)[w];
+    return (lit % 2) ? ~v : v;
+  }
+
+  /// @brief リテラルの一方の線の w ワード目を返す．
+  ///
+  /// 3値モード用．反転したリテラルは2本の線を入れ替えたものとなる．
+  std::uint64_t
+  lit_rail(
+    SizeType lit,  ///< [in] リテラル
+    SizeType rail, ///< [in] 線の種類(0 か 1)
+    SizeType w     ///< [in] ワード位置 ( 0 <= w < word_num() )
+  ) const
+  {
+    auto r = rail ^ (lit % 2);
+    return value(lit / 2)[r * mWordNum + w];
+  }
+
+  /// @brief ANDノードの値を計算する．
+  void
+  simulate();
+
+  /// @brief 乱数のワードを返す．
+  ///
+  /// seed と index から決まる値(splitmix64)なので，
+  /// スレッドの割り当てによらず同じパタンが得られる．
+  static
+  std::uint64_t
+  random_word(
+    std::uint64_t seed, ///< [in] 乱数の種
+    std::uint64_t index ///< [in] 通し番号
+  )
+  {
+    auto z = seed + (index + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+
+  /// @brief 作業用の WorkPool を返す．
+  WorkPool&
+  pool()
+  {
+    return mPool;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief [begin, end) の範囲のANDノードを計算する．
+  void
+  eval_range(
+    SizeType begin,
+    SizeType end
+  )
+  {
+    if ( mRailNum == 2 ) {
+      for ( auto id = begin; id < end; ++ id ) {
+	eval_gate3(id);
+      }
+    }
+    else {
+      for ( auto id = begin; id < end; ++ id ) {
+	eval_gate(id);
+      }
+    }
+  }
+
+  /// @brief ANDノードを一つ計算する．
+  void
+  eval_gate(
+    SizeType id
+  )
+  {
+    auto& gate = mGateList[id];
+    auto dst = &mValArray[gate.mVar * mStride];
+    auto a = &mValArray[(gate.mLit1 / 2) * mStride];
+    auto b = &mValArray[(gate.mLit2 / 2) * mStride];
+    std::uint64_t ma = (gate.mLit1 % 2) ? ~0ULL : 0ULL;
+    std::uint64_t mb = (gate.mLit2 % 2) ? ~0ULL : 0ULL;
+    for ( SizeType w = 0; w < mWordNum; ++ w ) {
+      dst[w] = (a[w] ^ ma) & (b[w] ^ mb);
+    }
+  }
+
+  /// @brief 3値モードでANDノードを一つ計算する．
+  ///
+  /// 0 の線はファンインの 0 の線の OR，
+  /// 1 の線はファンインの 1 の線の AND となる．
+  /// 反転は線の入れ替えなのでループの外でポインタを選んでおく．
+  void
+  eval_gate3(
+    SizeType id
+  )
+  {
+    auto& gate = mGateList[id];
+    auto dst0 = &mValArray[gate.mVar * mStride];
+    auto dst1 = dst0 + mWordNum;
+    auto a = &mValArray[(gate.mLit1 / 2) * mStride];
+    auto b = &mValArray[(gate.mLit2 / 2) * mStride];
+    auto a0 = a + (gate.mLit1 % 2) * mWordNum;
+    auto a1 = a + (1 - gate.mLit1 % 2) * mWordNum;
+    auto b0 = b + (gate.mLit2 % 2) * mWordNum;
+    auto b1 = b + (1 - gate.mLit2 % 2) * mWordNum;
+    for ( SizeType w = 0; w < mWordNum; ++ w ) {
+      dst0[w] = a0[w] | b0[w];
+      dst1[w] = a1[w] & b1[w];
+    }
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ANDノードの情報
+  struct Gate
+  {
+    std::uint32_t mVar;  // 出力の変数番号
+    std::uint32_t mLit1; // ファンイン1のリテラル
+    std::uint32_t mLit2; // ファンイン2のリテラル
+  };
+
+  // 計算の単位
+  //
+  // mGateList の [mBegin, mEnd) の範囲を計算する．
+  struct Stage
+  {
+    SizeType mBegin;
+    SizeType mEnd;
+    bool mParallel; // 複数のスレッドで計算する時 true
+  };
+
+  // 変数番号の最大値 + 1
+  SizeType mVarNum;
+
+  // 変数あたりのワード数
+  SizeType mWordNum;
+
+  // 線の数(2値モードは 1, 3値モードは 2)
+  SizeType mRailNum;
+
+  // 変数あたりの mValArray 上の幅( = mWordNum * mRailNum )
+  SizeType mStride;
+
+  // スレッドプール
+  WorkPool mPool;
+
+  // レベル順に並べたANDノードのリスト
+  vector<Gate> mGateList;
+
+  // 計算の単位のリスト
+  vector<Stage> mStageList;
+
+  // 全変数の値の配列
+  vector<std::uint64_t> mValArray;
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // BITSIM_H
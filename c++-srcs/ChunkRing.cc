@@ -0,0 +1,115 @@
+
+/// @file ChunkRing.cc
+/// @brief ChunkRing の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ChunkRing.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+// クラス ChunkRing
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+ChunkRing::ChunkRing(
+  SizeType chunk_size,
+  SizeType chunk_num,
+  FillFunc fill_func
+) : mFillFunc{std::move(fill_func)},
+    mChunkList(chunk_num)
+{
+  ASSERT_COND( chunk_num >= 2 );
+  for ( auto& chunk: mChunkList ) {
+    chunk.mData.resize(chunk_size);
+  }
+  mThread = std::thread{[this](){ producer(); }};
+}
+
+// @brief デストラクタ
+ChunkRing::~ChunkRing()
+{
+  {
+    std::lock_guard<std::mutex> lock{mMutex};
+    mStop = true;
+  }
+  mFreed.notify_one();
+  mThread.join();
+}
+
+// @brief 次のチャンクを得る．
+std::pair<const char*, SizeType>
+ChunkRing::next()
+{
+  std::unique_lock<std::mutex> lock{mMutex};
+  if ( mHolding ) {
+    // 読み終わったチャンクを解放する．
+    mHolding = false;
+    mHead = (mHead + 1) % mChunkList.size();
+    -- mCount;
+    mFreed.notify_one();
+  }
+  mFilled.wait(lock, [this](){ return mCount > 0 || mEof; });
+  if ( mCount == 0 ) {
+    if ( mError ) {
+      std::rethrow_exception(mError);
+    }
+    return {nullptr, 0};
+  }
+  mHolding = true;
+  auto& chunk = mChunkList[mHead];
+  return {chunk.mData.data(), chunk.mSize};
+}
+
+// @brief スレッドの本体
+void
+ChunkRing::producer()
+{
+  for ( ; ; ) {
+    SizeType pos;
+    {
+      std::unique_lock<std::mutex> lock{mMutex};
+      mFreed.wait(lock, [this](){ return mCount < mChunkList.size() || mStop; });
+      if ( mStop ) {
+	return;
+      }
+      pos = mTail;
+    }
+
+    // ロックを外した状態でチャンクを埋める．
+    // pos のチャンクは消費側からは参照されていない．
+    auto& chunk = mChunkList[pos];
+    std::exception_ptr error;
+    SizeType size = 0;
+    try {
+      size = mFillFunc(chunk.mData.data(), chunk.mData.size());
+    }
+    catch ( ... ) {
+      error = std::current_exception();
+    }
+
+    bool eof = error || size == 0;
+    {
+      std::lock_guard<std::mutex> lock{mMutex};
+      if ( eof ) {
+	mError = error;
+	mEof = true;
+      }
+      else {
+	chunk.mSize = size;
+	mTail = (mTail + 1) % mChunkList.size();
+	++ mCount;
+      }
+    }
+    mFilled.notify_one();
+    if ( eof ) {
+      return;
+    }
+  }
+}
+
+END_NAMESPACE_YM_AIG
@@ -0,0 +1,139 @@
+#ifndef CHUNKRING_H
+#define CHUNKRING_H
+
+/// @file ChunkRing.h
+/// @brief ChunkRing のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+/// @class ChunkRing ChunkRing.h "ChunkRing.h"
+/// @brief 専用スレッドで埋められるチャンクのリングバッファ
+///
+/// 生成と同時にスレッドを起動し，フィル関数を用いて空いている
+/// チャンクを順に埋めていく．消費側は next() で次のチャンクを受け取る．
+/// 消費側が保持しているチャンク以外は全て先読みに用いられるので
+/// 読み込み(あるいは伸長)と消費側の処理が並行に行われる．
+//////////////////////////////////////////////////////////////////////
+class ChunkRing
+{
+public:
+
+  /// @brief チャンクを埋める関数の型
+  ///
+  /// 書き込んだバイト数を返す．0 を返したら末尾を表す．
+  using FillFunc = std::function<SizeType(char*, SizeType)>;
+
+  /// @brief コンストラクタ
+  ChunkRing(
+    SizeType chunk_size, ///< [in] チャンクのサイズ
+    SizeType chunk_num,  ///< [in] チャンク数 ( >= 2 )
+    FillFunc fill_func   ///< [in] チャンクを埋める関数
+  );
+
+  /// @brief デストラクタ
+  ///
+  /// スレッドを停止させる．
+  ~ChunkRing();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 次のチャンクを得る．
+  /// @return 先頭のアドレスとサイズのペアを返す．
+  ///
+  /// - 前回返したチャンクはこの時点で解放される．
+  /// - 末尾に達したらサイズ 0 を返す．
+  /// - フィル関数が例外を送出していたらそれを再送出する．
+  std::pair<const char*, SizeType>
+  next();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief スレッドの本体
+  void
+  producer();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // チャンク
+  struct Chunk
+  {
+    vector<char> mData; // データ本体
+    SizeType mSize{0};  // 有効なデータのサイズ
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // フィル関数
+  FillFunc mFillFunc;
+
+  // チャンクのリング
+  vector<Chunk> mChunkList;
+
+  // 次に読み出すチャンクの番号
+  SizeType mHead{0};
+
+  // 次に書き込むチャンクの番号
+  SizeType mTail{0};
+
+  // 書き込み済みのチャンク数(読み出し中のものも含む)
+  SizeType mCount{0};
+
+  // 読み出し中のチャンクがある時 true にするフラグ
+  bool mHolding{false};
+
+  // 末尾に達したら true にするフラグ
+  bool mEof{false};
+
+  // スレッドを止めるためのフラグ
+  bool mStop{false};
+
+  // フィル関数で起きたエラー
+  std::exception_ptr mError;
+
+  // 排他制御用の mutex
+  std::mutex mMutex;
+
+  // チャンクが書き込まれたことを知らせる条件変数
+  std::condition_variable mFilled;
+
+  // チャンクが空いたことを知らせる条件変数
+  std::condition_variable mFreed;
+
+  // スレッド
+  std::thread mThread;
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // CHUNKRING_H
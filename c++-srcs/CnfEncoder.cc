@@ -0,0 +1,162 @@
+
+/// @file CnfEncoder.cc
+/// @brief CnfEncoder の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "CnfEncoder.h"
+#include "VarMap.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+// クラス CnfEncoder
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+CnfEncoder::CnfEncoder(
+  const ModelImpl& model,
+  const AigCnfOpt& opt
+) : mModel{model},
+    mAssertOutputs{opt.assert_outputs},
+    mOutputList{opt.output_list},
+    mLatchList{opt.latch_list}
+{
+  auto& output_list = mOutputList;
+  auto& latch_list = mLatchList;
+  if ( output_list.empty() && latch_list.empty() ) {
+    for ( SizeType i = 0; i < model.O(); ++ i ) {
+      output_list.push_back(i);
+    }
+    for ( SizeType i = 0; i < model.L(); ++ i ) {
+      latch_list.push_back(i);
+    }
+  }
+  for ( auto pos: output_list ) {
+    if ( pos >= model.O() ) {
+      ostringstream buf;
+      buf << "CnfEncoder: Output#" << pos << " is out of range.";
+      throw std::invalid_argument{buf.str()};
+    }
+  }
+  for ( auto pos: latch_list ) {
+    if ( pos >= model.L() ) {
+      ostringstream buf;
+      buf << "CnfEncoder: Latch#" << pos << " is out of range.";
+      throw std::invalid_argument{buf.str()};
+    }
+  }
+
+  auto order_list = model.and_topo_order();
+  VarMap var_map{model};
+  auto var_num = var_map.var_num();
+  const std::uint8_t BOTH = POS | NEG;
+
+  auto check_lit = [&](SizeType lit) {
+    if ( lit / 2 >= var_num || var_map.kind(lit / 2) == VarMap::NONE ) {
+      ostringstream buf;
+      buf << "CnfEncoder: " << lit << " is not defined.";
+      throw std::invalid_argument{buf.str()};
+    }
+  };
+
+  // 必要な極性を求める．
+  mNeed.assign(var_num, 0);
+  for ( auto pos: output_list ) {
+    auto lit = model.output_src(pos);
+    check_lit(lit);
+    if ( opt.polarity && opt.assert_outputs ) {
+      mNeed[lit / 2] |= (lit % 2) ? NEG : POS;
+    }
+    else {
+      mNeed[lit / 2] |= BOTH;
+    }
+  }
+  for ( auto pos: latch_list ) {
+    auto lit = model.latch_src(pos);
+    check_lit(lit);
+    mNeed[lit / 2] |= BOTH;
+  }
+  // 出力側から順に処理するので，処理する時点で極性は確定している．
+  for ( auto p = order_list.rbegin(); p != order_list.rend(); ++ p ) {
+    auto pos = *p;
+    auto var = model.and_node(pos) / 2;
+    auto need = mNeed[var];
+    if ( need == 0 ) {
+      if ( opt.coi ) {
+	continue;
+      }
+      need = BOTH;
+      mNeed[var] = BOTH;
+    }
+    for ( auto lit: {model.and_src1(pos), model.and_src2(pos)} ) {
+      check_lit(lit);
+      std::uint8_t need1 = BOTH;
+      if ( opt.polarity ) {
+	need1 = 0;
+	if ( need & POS ) {
+	  need1 |= (lit % 2) ? NEG : POS;
+	}
+	if ( need & NEG ) {
+	  need1 |= (lit % 2) ? POS : NEG;
+	}
+      }
+      mNeed[lit / 2] |= need1;
+    }
+  }
+
+  // CNF の変数を割り当てる．
+  mVarMap.assign(var_num, 0);
+  int next_var = 1;
+  if ( mNeed[0] != 0 ) {
+    mVarMap[0] = next_var;
+    ++ next_var;
+    ++ mClauseNum;
+  }
+  for ( SizeType i = 0; i < model.I(); ++ i ) {
+    auto var = model.input(i) / 2;
+    if ( !opt.coi || mNeed[var] != 0 ) {
+      mVarMap[var] = next_var;
+      ++ next_var;
+    }
+  }
+  for ( SizeType i = 0; i < model.L(); ++ i ) {
+    auto var = model.latch(i) / 2;
+    if ( !opt.coi || mNeed[var] != 0 ) {
+      mVarMap[var] = next_var;
+      ++ next_var;
+    }
+  }
+  for ( auto pos: order_list ) {
+    auto var = model.and_node(pos) / 2;
+    auto need = mNeed[var];
+    if ( need == 0 ) {
+      continue;
+    }
+    mVarMap[var] = next_var;
+    ++ next_var;
+    mAndList.push_back(pos);
+    if ( need & POS ) {
+      mClauseNum += 2;
+    }
+    if ( need & NEG ) {
+      mClauseNum += 1;
+    }
+  }
+  mVarNum = next_var - 1;
+
+  for ( auto pos: output_list ) {
+    mOutputLitList.push_back(cnf_lit(model.output_src(pos)));
+  }
+  for ( auto pos: latch_list ) {
+    mLatchLitList.push_back(cnf_lit(model.latch_src(pos)));
+  }
+  if ( mAssertOutputs ) {
+    mClauseNum += mOutputLitList.size();
+  }
+}
+
+END_NAMESPACE_YM_AIG
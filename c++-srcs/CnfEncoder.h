@@ -0,0 +1,206 @@
+#ifndef CNFENCODER_H
+#define CNFENCODER_H
+
+/// @file CnfEncoder.h
+/// @brief CnfEncoder のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+#include "ym/AigCnfOpt.h"
+#include "ModelImpl.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+/// @class CnfEncoder CnfEncoder.h "CnfEncoder.h"
+/// @brief ModelImpl を Tseitin 変換するクラス
+///
+/// コンストラクタで符号化するノードと極性，CNF の変数番号を決め，
+/// 節の数を数えておく．
+/// 節そのものは encode() で一つずつ関数に渡すので
+/// 全体をメモリ上に保持することはない．
+//////////////////////////////////////////////////////////////////////
+class CnfEncoder
+{
+public:
+
+  /// @brief コンストラクタ
+  ///
+  /// 出力番号，ラッチ番号が範囲外の場合は
+  /// std::invalid_argument 例外を送出する．
+  CnfEncoder(
+    const ModelImpl& model, ///< [in] 対象のモデル
+    const AigCnfOpt& opt    ///< [in] オプション
+  );
+
+  /// @brief デストラクタ
+  ~CnfEncoder() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief CNF の変数の数を返す．
+  SizeType
+  var_num() const
+  {
+    return mVarNum;
+  }
+
+  /// @brief 節の数を返す．
+  SizeType
+  clause_num() const
+  {
+    return mClauseNum;
+  }
+
+  /// @brief 対象の出力番号のリストを返す．
+  const vector<SizeType>&
+  output_list() const
+  {
+    return mOutputList;
+  }
+
+  /// @brief 対象のラッチ番号のリストを返す．
+  const vector<SizeType>&
+  latch_list() const
+  {
+    return mLatchList;
+  }
+
+  /// @brief AIG の変数番号をキーにした CNF の変数のリストを返す．
+  const vector<int>&
+  var_map() const
+  {
+    return mVarMap;
+  }
+
+  /// @brief 対象の出力のリテラルのリストを返す．
+  const vector<int>&
+  output_lit_list() const
+  {
+    return mOutputLitList;
+  }
+
+  /// @brief 対象のラッチの次状態関数のリテラルのリストを返す．
+  const vector<int>&
+  latch_lit_list() const
+  {
+    return mLatchLitList;
+  }
+
+  /// @brief 節を生成する．
+  ///
+  /// 節ごとに sink(const int* lits, SizeType n) を呼び出す．
+  template<class Sink>
+  void
+  encode(
+    Sink&& sink ///< [in] 節を受け取る関数
+  ) const
+  {
+    int tmp[3];
+    if ( mVarMap[0] != 0 ) {
+      // 定数0
+      tmp[0] = - mVarMap[0];
+      sink(tmp, 1);
+    }
+    for ( auto pos: mAndList ) {
+      auto var = mModel.and_node(pos) / 2;
+      auto n = mVarMap[var];
+      auto a = cnf_lit(mModel.and_src1(pos));
+      auto b = cnf_lit(mModel.and_src2(pos));
+      auto need = mNeed[var];
+      if ( need & POS ) {
+	tmp[0] = -n;
+	tmp[1] = a;
+	sink(tmp, 2);
+	tmp[1] = b;
+	sink(tmp, 2);
+      }
+      if ( need & NEG ) {
+	tmp[0] = n;
+	tmp[1] = -a;
+	tmp[2] = -b;
+	sink(tmp, 3);
+      }
+    }
+    if ( mAssertOutputs ) {
+      for ( auto lit: mOutputLitList ) {
+	tmp[0] = lit;
+	sink(tmp, 1);
+      }
+    }
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief AIG のリテラルを CNF のリテラルに変換する．
+  int
+  cnf_lit(
+    SizeType lit
+  ) const
+  {
+    auto v = mVarMap[lit / 2];
+    return (lit % 2) ? -v : v;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 極性を表すビット
+  static
+  constexpr std::uint8_t POS = 1;
+  static
+  constexpr std::uint8_t NEG = 2;
+
+  // 対象のモデル
+  const ModelImpl& mModel;
+
+  // 出力の単位節を加える時 true
+  bool mAssertOutputs;
+
+  // CNF の変数の数
+  SizeType mVarNum{0};
+
+  // 節の数
+  SizeType mClauseNum{0};
+
+  // 対象の出力番号のリスト
+  vector<SizeType> mOutputList;
+
+  // 対象のラッチ番号のリスト
+  vector<SizeType> mLatchList;
+
+  // 変数番号をキーにした必要な極性
+  vector<std::uint8_t> mNeed;
+
+  // 変数番号をキーにした CNF の変数
+  vector<int> mVarMap;
+
+  // 符号化する AND 番号のリスト(トポロジカル順)
+  vector<SizeType> mAndList;
+
+  // 対象の出力のリテラルのリスト
+  vector<int> mOutputLitList;
+
+  // 対象のラッチの次状態関数のリテラルのリスト
+  vector<int> mLatchLitList;
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // CNFENCODER_H
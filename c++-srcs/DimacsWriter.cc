@@ -0,0 +1,124 @@
+
+/// @file DimacsWriter.cc
+/// @brief DimacsWriter の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "DimacsWriter.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+BEGIN_NONAMESPACE
+
+// 1行に現れる整数の文字数の上限(符号と区切りを含む)
+const SizeType MAX_INT_CHARS = 22;
+
+END_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// クラス DimacsWriter
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+DimacsWriter::DimacsWriter(
+  ostream& s,
+  SizeType buff_size
+) : mS{s},
+    mBuff(std::max(buff_size, MAX_INT_CHARS * 4))
+{
+}
+
+// @brief デストラクタ
+DimacsWriter::~DimacsWriter()
+{
+  flush();
+}
+
+// @brief コメント行を書き出す．
+void
+DimacsWriter::write_comment(
+  const string& comment
+)
+{
+  auto n = comment.size() + 3;
+  if ( n > mBuff.size() ) {
+    flush();
+    mS << "c " << comment << '\n';
+    return;
+  }
+  reserve(n);
+  put_char('c');
+  put_char(' ');
+  for ( auto c: comment ) {
+    put_char(c);
+  }
+  put_char('\n');
+}
+
+// @brief ヘッダ行を書き出す．
+void
+DimacsWriter::write_header(
+  SizeType var_num,
+  SizeType clause_num
+)
+{
+  reserve(6 + MAX_INT_CHARS * 2);
+  for ( auto c: {'p', ' ', 'c', 'n', 'f', ' '} ) {
+    put_char(c);
+  }
+  put_uint(var_num);
+  put_char(' ');
+  put_uint(clause_num);
+  put_char('\n');
+}
+
+// @brief 節を書き出す．
+void
+DimacsWriter::write_clause(
+  const int* lits,
+  SizeType n
+)
+{
+  for ( SizeType i = 0; i < n; ++ i ) {
+    reserve(MAX_INT_CHARS);
+    put_int(lits[i]);
+    put_char(' ');
+  }
+  reserve(2);
+  put_char('0');
+  put_char('\n');
+}
+
+// @brief バッファの内容を書き出す．
+void
+DimacsWriter::flush()
+{
+  if ( mPos > 0 ) {
+    mS.write(mBuff.data(), mPos);
+    mPos = 0;
+  }
+}
+
+// @brief 符号なし整数を追加する．
+void
+DimacsWriter::put_uint(
+  std::uint64_t x
+)
+{
+  char tmp[MAX_INT_CHARS];
+  SizeType n = 0;
+  do {
+    tmp[n] = static_cast<char>('0' + x % 10);
+    ++ n;
+    x /= 10;
+  } while ( x > 0 );
+  while ( n > 0 ) {
+    -- n;
+    put_char(tmp[n]);
+  }
+}
+
+END_NAMESPACE_YM_AIG
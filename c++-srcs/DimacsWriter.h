@@ -0,0 +1,141 @@
+#ifndef DIMACSWRITER_H
+#define DIMACSWRITER_H
+
+/// @file DimacsWriter.h
+/// @brief DimacsWriter のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+/// @class DimacsWriter DimacsWriter.h "DimacsWriter.h"
+/// @brief DIMACS 形式の CNF を書き出すクラス
+///
+/// 整数の変換を自前で行って大きなバッファに溜め，
+/// バッファが一杯になった時にまとめて書き出す．
+/// 書き込みエラーはストリームの状態で判定する．
+//////////////////////////////////////////////////////////////////////
+class DimacsWriter
+{
+public:
+
+  /// @brief デフォルトのバッファサイズ
+  static
+  constexpr SizeType DEFAULT_BUFF_SIZE = 4 * 1024 * 1024;
+
+  /// @brief コンストラクタ
+  explicit
+  DimacsWriter(
+    ostream& s,                            ///< [in] 出力先のストリーム
+    SizeType buff_size = DEFAULT_BUFF_SIZE ///< [in] バッファサイズ
+  );
+
+  /// @brief デストラクタ
+  ///
+  /// 残っている内容を書き出す．
+  ~DimacsWriter();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief コメント行を書き出す．
+  void
+  write_comment(
+    const string& comment ///< [in] コメント(改行を含まない)
+  );
+
+  /// @brief ヘッダ行を書き出す．
+  void
+  write_header(
+    SizeType var_num,   ///< [in] 変数の数
+    SizeType clause_num ///< [in] 節の数
+  );
+
+  /// @brief 節を書き出す．
+  void
+  write_clause(
+    const int* lits, ///< [in] リテラルの配列
+    SizeType n       ///< [in] リテラル数
+  );
+
+  /// @brief バッファの内容を書き出す．
+  void
+  flush();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief n バイト書き込めるようにする．
+  void
+  reserve(
+    SizeType n
+  )
+  {
+    if ( mPos + n > mBuff.size() ) {
+      flush();
+    }
+  }
+
+  /// @brief 文字を追加する．
+  void
+  put_char(
+    char c
+  )
+  {
+    mBuff[mPos] = c;
+    ++ mPos;
+  }
+
+  /// @brief 符号なし整数を追加する．
+  void
+  put_uint(
+    std::uint64_t x
+  );
+
+  /// @brief 符号付き整数を追加する．
+  void
+  put_int(
+    std::int64_t x
+  )
+  {
+    if ( x < 0 ) {
+      put_char('-');
+      put_uint(static_cast<std::uint64_t>(- x));
+    }
+    else {
+      put_uint(static_cast<std::uint64_t>(x));
+    }
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 出力先のストリーム
+  ostream& mS;
+
+  // バッファ
+  vector<char> mBuff;
+
+  // バッファ中の書き込み位置
+  SizeType mPos{0};
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // DIMACSWRITER_H
@@ -0,0 +1,61 @@
+
+/// @file FileSource.cc
+/// @brief FileSource の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "FileSource.h"
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+// クラス FileSource
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+FileSource::FileSource(
+  int fd
+) : mFd{fd}
+{
+}
+
+// @brief デストラクタ
+FileSource::~FileSource()
+{
+  ::close(mFd);
+}
+
+// @brief 圧縮されたデータを伸長しているとき true を返す．
+bool
+FileSource::is_compressed() const
+{
+  return false;
+}
+
+// @brief データを読み出す．
+SizeType
+FileSource::read(
+  char* buff,
+  SizeType size
+)
+{
+  for ( ; ; ) {
+    auto n = ::read(mFd, buff, size);
+    if ( n >= 0 ) {
+      return n;
+    }
+    if ( errno != EINTR ) {
+      ostringstream buf;
+      buf << "FileSource::read: " << strerror(errno);
+      throw std::invalid_argument{buf.str()};
+    }
+  }
+}
+
+END_NAMESPACE_YM_AIG
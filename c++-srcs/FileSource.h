@@ -0,0 +1,66 @@
+#ifndef FILESOURCE_H
+#define FILESOURCE_H
+
+/// @file FileSource.h
+/// @brief FileSource のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "InputSource.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+/// @class FileSource FileSource.h "FileSource.h"
+/// @brief ファイルディスクリプタから直接読み出す InputSource
+//////////////////////////////////////////////////////////////////////
+class FileSource :
+  public InputSource
+{
+public:
+
+  /// @brief コンストラクタ
+  ///
+  /// fd の所有権はこのオブジェクトに移る．
+  explicit
+  FileSource(
+    int fd ///< [in] ファイルディスクリプタ
+  );
+
+  /// @brief デストラクタ
+  ~FileSource();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // InputSource の仮想関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 圧縮されたデータを伸長しているとき true を返す．
+  bool
+  is_compressed() const override;
+
+  /// @brief データを読み出す．
+  SizeType
+  read(
+    char* buff,   ///< [in] 読み出したデータを格納する領域
+    SizeType size ///< [in] buff のサイズ
+  ) override;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ファイルディスクリプタ
+  int mFd;
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // FILESOURCE_H
@@ -0,0 +1,104 @@
+
+/// @file GzSource.cc
+/// @brief GzSource の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "GzSource.h"
+#include <climits>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+BEGIN_NONAMESPACE
+
+// 入力バッファのサイズ
+const SizeType IN_BUFF_SIZE = 256 * 1024;
+
+END_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// クラス GzSource
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+GzSource::GzSource(
+  std::unique_ptr<InputSource>&& src
+) : mSrc{std::move(src)},
+    mInBuff(IN_BUFF_SIZE)
+{
+  mStream.zalloc = Z_NULL;
+  mStream.zfree = Z_NULL;
+  mStream.opaque = Z_NULL;
+  mStream.next_in = Z_NULL;
+  mStream.avail_in = 0;
+  // 15 + 32 で gzip/zlib ヘッダを自動判別する．
+  if ( inflateInit2(&mStream, 15 + 32) != Z_OK ) {
+    throw std::invalid_argument{"GzSource: inflateInit2() failed"};
+  }
+}
+
+// @brief デストラクタ
+GzSource::~GzSource()
+{
+  inflateEnd(&mStream);
+}
+
+// @brief 圧縮されたデータを伸長しているとき true を返す．
+bool
+GzSource::is_compressed() const
+{
+  return true;
+}
+
+// @brief データを読み出す．
+SizeType
+GzSource::read(
+  char* buff,
+  SizeType size
+)
+{
+  if ( size > UINT_MAX ) {
+    size = UINT_MAX;
+  }
+  mStream.next_out = reinterpret_cast<Bytef*>(buff);
+  mStream.avail_out = size;
+  while ( mStream.avail_out > 0 ) {
+    if ( mStream.avail_in == 0 && !mInEof ) {
+      auto n = mSrc->read(mInBuff.data(), mInBuff.size());
+      if ( n == 0 ) {
+	mInEof = true;
+      }
+      mStream.next_in = reinterpret_cast<Bytef*>(mInBuff.data());
+      mStream.avail_in = n;
+    }
+    bool no_input = mStream.avail_in == 0;
+    if ( no_input && !mInMember ) {
+      // 全てのメンバを読み終わった．
+      break;
+    }
+    auto prev = mStream.avail_out;
+    auto ret = inflate(&mStream, Z_NO_FLUSH);
+    if ( ret == Z_STREAM_END ) {
+      // 複数のメンバが連結されている場合に備えてリセットする．
+      inflateReset(&mStream);
+      mInMember = false;
+      continue;
+    }
+    if ( ret != Z_OK && ret != Z_BUF_ERROR ) {
+      ostringstream buf;
+      buf << "GzSource::read: "
+	  << (mStream.msg != nullptr ? mStream.msg : "inflate() failed");
+      throw std::invalid_argument{buf.str()};
+    }
+    if ( no_input && mStream.avail_out == prev ) {
+      throw std::invalid_argument{"GzSource::read: Unexpected EOF"};
+    }
+    mInMember = true;
+  }
+  return size - mStream.avail_out;
+}
+
+END_NAMESPACE_YM_AIG
@@ -0,0 +1,79 @@
+#ifndef GZSOURCE_H
+#define GZSOURCE_H
+
+/// @file GzSource.h
+/// @brief GzSource のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "InputSource.h"
+#include <zlib.h>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+/// @class GzSource GzSource.h "GzSource.h"
+/// @brief gzip 形式のデータを伸長しながら読み出す InputSource
+//////////////////////////////////////////////////////////////////////
+class GzSource :
+  public InputSource
+{
+public:
+
+  /// @brief コンストラクタ
+  ///
+  /// 初期化に失敗したら std::invalid_argument 例外を送出する．
+  explicit
+  GzSource(
+    std::unique_ptr<InputSource>&& src ///< [in] 圧縮されたデータの入力元
+  );
+
+  /// @brief デストラクタ
+  ~GzSource();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // InputSource の仮想関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 圧縮されたデータを伸長しているとき true を返す．
+  bool
+  is_compressed() const override;
+
+  /// @brief データを読み出す．
+  SizeType
+  read(
+    char* buff,   ///< [in] 読み出したデータを格納する領域
+    SizeType size ///< [in] buff のサイズ
+  ) override;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 圧縮されたデータの入力元
+  std::unique_ptr<InputSource> mSrc;
+
+  // 圧縮されたデータを読み込むバッファ
+  vector<char> mInBuff;
+
+  // zlib のストリーム
+  z_stream mStream;
+
+  // 入力元の末尾に達したら true にするフラグ
+  bool mInEof{false};
+
+  // メンバの途中を読んでいる時 true にするフラグ
+  bool mInMember{false};
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // GZSOURCE_H
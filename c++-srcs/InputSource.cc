@@ -0,0 +1,140 @@
+
+/// @file InputSource.cc
+/// @brief InputSource の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "InputSource.h"
+#include "FileSource.h"
+#include "AsyncSource.h"
+#if defined(YM_AIG_HAVE_ZLIB)
+#include "GzSource.h"
+#endif
+#if defined(YM_AIG_HAVE_ZSTD)
+#include "ZstdSource.h"
+#endif
+#if defined(YM_AIG_HAVE_LZMA)
+#include "XzSource.h"
+#endif
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+BEGIN_NONAMESPACE
+
+// 圧縮形式
+enum class Codec {
+  None,
+  Gzip,
+  Zstd,
+  Xz
+};
+
+// 先頭のバイト列から圧縮形式を判定する．
+Codec
+check_magic(
+  const unsigned char* buff,
+  SizeType n
+)
+{
+  static const unsigned char gz_magic[] = { 0x1f, 0x8b };
+  static const unsigned char zstd_magic[] = { 0x28, 0xb5, 0x2f, 0xfd };
+  static const unsigned char xz_magic[] = { 0xfd, 0x37, 0x7a, 0x58, 0x5a, 0x00 };
+  if ( n >= sizeof(gz_magic) && memcmp(buff, gz_magic, sizeof(gz_magic)) == 0 ) {
+    return Codec::Gzip;
+  }
+  if ( n >= sizeof(zstd_magic) && memcmp(buff, zstd_magic, sizeof(zstd_magic)) == 0 ) {
+    return Codec::Zstd;
+  }
+  if ( n >= sizeof(xz_magic) && memcmp(buff, xz_magic, sizeof(xz_magic)) == 0 ) {
+    return Codec::Xz;
+  }
+  return Codec::None;
+}
+
+#if !defined(YM_AIG_HAVE_ZLIB) || !defined(YM_AIG_HAVE_ZSTD) || !defined(YM_AIG_HAVE_LZMA)
+// 対応していない圧縮形式のエラーを送出する．
+void
+unsupported(
+  const string& filename,
+  const char* codec_name
+)
+{
+  ostringstream buf;
+  buf << filename << ": " << codec_name
+      << " compressed file is not supported in this build.";
+  throw std::invalid_argument{buf.str()};
+}
+#endif
+
+END_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// クラス InputSource
+//////////////////////////////////////////////////////////////////////
+
+// @brief ファイルを開く．
+std::unique_ptr<InputSource>
+InputSource::open(
+  const string& filename,
+  bool async_io
+)
+{
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if ( fd < 0 ) {
+    return nullptr;
+  }
+
+  // 先頭のマジックナンバーを調べる．
+  // パイプなどで pread() が使えない場合は非圧縮とみなす．
+  unsigned char magic[6];
+  auto n = ::pread(fd, magic, sizeof(magic), 0);
+  auto codec = n > 0 ? check_magic(magic, n) : Codec::None;
+
+  std::unique_ptr<InputSource> src;
+  struct stat st;
+  if ( async_io && fstat(fd, &st) == 0 && S_ISREG(st.st_mode) ) {
+    src.reset(new AsyncSource{fd, static_cast<SizeType>(st.st_size)});
+  }
+  else {
+    src.reset(new FileSource{fd});
+  }
+  switch ( codec ) {
+  case Codec::None:
+    return src;
+
+  case Codec::Gzip:
+#if defined(YM_AIG_HAVE_ZLIB)
+    return std::unique_ptr<InputSource>{new GzSource{std::move(src)}};
+#else
+    unsupported(filename, "gzip");
+#endif
+    break;
+
+  case Codec::Zstd:
+#if defined(YM_AIG_HAVE_ZSTD)
+    return std::unique_ptr<InputSource>{new ZstdSource{std::move(src)}};
+#else
+    unsupported(filename, "zstd");
+#endif
+    break;
+
+  case Codec::Xz:
+#if defined(YM_AIG_HAVE_LZMA)
+    return std::unique_ptr<InputSource>{new XzSource{std::move(src)}};
+#else
+    unsupported(filename, "xz");
+#endif
+    break;
+  }
+  ASSERT_NOT_REACHED;
+  return nullptr;
+}
+
+END_NAMESPACE_YM_AIG
@@ -0,0 +1,99 @@
+#ifndef INPUTSOURCE_H
+#define INPUTSOURCE_H
+
+/// @file InputSource.h
+/// @brief InputSource のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+#include <memory>
+#include <utility>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+/// @class InputSource InputSource.h "InputSource.h"
+/// @brief バイト列を読み出す入力元を表す純粋仮想基底クラス
+///
+/// 生のファイルと，それを伸長しながら読み出す各種デコーダが
+/// このクラスを継承する．
+//////////////////////////////////////////////////////////////////////
+class InputSource
+{
+public:
+
+  /// @brief デストラクタ
+  virtual
+  ~InputSource() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ファイルを開く．
+  /// @return 生成した InputSource を返す．
+  ///
+  /// - ファイル先頭のマジックナンバーを調べて gzip/zstd/xz
+  ///   形式の場合には対応するデコーダを返す．
+  /// - async_io が true で通常ファイルの場合には AsyncSource を用いて
+  ///   先読みを行いながら読み込む．
+  /// - ファイルが開けなかった場合には nullptr を返す．
+  /// - 対応していない圧縮形式の場合には std::invalid_argument 例外を送出する．
+  static
+  std::unique_ptr<InputSource>
+  open(
+    const string& filename, ///< [in] ファイル名
+    bool async_io = false   ///< [in] 非同期読み込みを行う時 true にする．
+  );
+
+  /// @brief 圧縮されたデータを伸長しているとき true を返す．
+  virtual
+  bool
+  is_compressed() const = 0;
+
+  /// @brief データを読み出す．
+  /// @return 読み出したバイト数を返す．
+  ///
+  /// - 0 を返したら末尾に達したことを表す．
+  /// - エラーが起きたら std::invalid_argument 例外を送出する．
+  virtual
+  SizeType
+  read(
+    char* buff,   ///< [in] 読み出したデータを格納する領域
+    SizeType size ///< [in] buff のサイズ
+  ) = 0;
+
+  /// @brief next_chunk() が使える時 true を返す．
+  virtual
+  bool
+  has_chunk() const
+  {
+    return false;
+  }
+
+  /// @brief 内部のバッファを直接参照してデータを読み出す．
+  /// @return バッファの先頭と有効なサイズの組を返す．
+  ///
+  /// - コピーを行わない read() の代わりで，has_chunk() が true の時のみ使える．
+  /// - 返したバッファは次に next_chunk() か read() を呼ぶまで有効．
+  /// - サイズが 0 の時は末尾に達したことを表す．
+  /// - エラーが起きたら std::invalid_argument 例外を送出する．
+  virtual
+  std::pair<const char*, SizeType>
+  next_chunk()
+  {
+    ASSERT_NOT_REACHED;
+    return {nullptr, 0};
+  }
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // INPUTSOURCE_H
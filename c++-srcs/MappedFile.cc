@@ -0,0 +1,67 @@
+
+/// @file MappedFile.cc
+/// @brief MappedFile の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "MappedFile.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+// クラス MappedFile
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+MappedFile::MappedFile(
+  const string& filename
+)
+{
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if ( fd < 0 ) {
+    ostringstream buf;
+    buf << "MappedFile: Could not open file " << filename;
+    throw std::invalid_argument{buf.str()};
+  }
+  struct stat st;
+  if ( fstat(fd, &st) < 0 ) {
+    auto err = errno;
+    ::close(fd);
+    ostringstream buf;
+    buf << "MappedFile: " << filename << ": " << strerror(err);
+    throw std::invalid_argument{buf.str()};
+  }
+  mSize = st.st_size;
+  if ( mSize > 0 ) {
+    auto p = mmap(nullptr, mSize, PROT_READ, MAP_SHARED, fd, 0);
+    if ( p == MAP_FAILED ) {
+      auto err = errno;
+      ::close(fd);
+      ostringstream buf;
+      buf << "MappedFile: " << filename << ": " << strerror(err);
+      throw std::invalid_argument{buf.str()};
+    }
+    mData = static_cast<const char*>(p);
+  }
+  // マッピングはファイルを閉じても有効
+  ::close(fd);
+}
+
+// @brief デストラクタ
+MappedFile::~MappedFile()
+{
+  if ( mData != nullptr ) {
+    munmap(const_cast<char*>(mData), mSize);
+  }
+}
+
+END_NAMESPACE_YM_AIG
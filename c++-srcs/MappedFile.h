@@ -0,0 +1,85 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+/// @file MappedFile.h
+/// @brief MappedFile のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+/// @class MappedFile MappedFile.h "MappedFile.h"
+/// @brief 読み出し専用で mmap() したファイルを表すクラス
+///
+/// 共有マッピングなので同じファイルを開いた複数のプロセスの間で
+/// ページキャッシュが共有される．
+//////////////////////////////////////////////////////////////////////
+class MappedFile
+{
+public:
+
+  /// @brief コンストラクタ
+  ///
+  /// 失敗したら std::invalid_argument 例外を送出する．
+  explicit
+  MappedFile(
+    const string& filename ///< [in] ファイル名
+  );
+
+  /// @brief コピーコンストラクタは禁止
+  MappedFile(
+    const MappedFile& src
+  ) = delete;
+
+  /// @brief コピー代入文は禁止
+  MappedFile&
+  operator=(
+    const MappedFile& src
+  ) = delete;
+
+  /// @brief デストラクタ
+  ~MappedFile();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 先頭のアドレスを返す．
+  const char*
+  data() const
+  {
+    return mData;
+  }
+
+  /// @brief サイズを返す．
+  SizeType
+  size() const
+  {
+    return mSize;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 先頭のアドレス
+  const char* mData{nullptr};
+
+  // サイズ
+  SizeType mSize{0};
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // MAPPEDFILE_H
@@ -7,6 +7,12 @@
 /// All rights reserved.
 
 #include "ModelImpl.h"
+#include "VarMap.h"
+#include "WorkPool.h"
+#include "ym/AigFileIndex.h"
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
 
 
 BEGIN_NAMESPACE_YM_AIG
@@ -15,8 +21,161 @@ BEGIN_NONAMESPACE
 
 bool debug = false;
 
+// 元の変数番号から新しい変数番号への対応表
+//
+// 対応を付ける変数が少ない時はハッシュ表を，
+// それ以外は変数番号で引く配列を用いる．
+class NewVarTable
+{
+public:
+
+  // コンストラクタ
+  NewVarTable(
+    SizeType var_num, // 元の変数番号の最大値 + 1
+    SizeType num      // 対応を付ける変数の数
+  ) : mSparse{num * 8 < var_num}
+  {
+    if ( mSparse ) {
+      mHash.reserve(num);
+    }
+    else {
+      mArray.assign(var_num, 0);
+    }
+  }
+
+  // 対応を設定する．
+  void
+  set(
+    SizeType old_var,
+    SizeType new_var
+  )
+  {
+    if ( mSparse ) {
+      mHash.emplace(old_var, new_var);
+    }
+    else {
+      mArray[old_var] = new_var;
+    }
+  }
+
+  // 対応するリテラルを返す．
+  SizeType
+  lit(
+    SizeType old_lit
+  ) const
+  {
+    auto old_var = old_lit / 2;
+    SizeType new_var = 0;
+    if ( mSparse ) {
+      if ( old_var > 0 ) {
+	new_var = mHash.at(old_var);
+      }
+    }
+    else {
+      new_var = mArray[old_var];
+    }
+    return new_var * 2 + (old_lit % 2);
+  }
+
+private:
+
+  // ハッシュ表を用いる時 true
+  bool mSparse;
+
+  // 配列
+  vector<SizeType> mArray;
+
+  // ハッシュ表
+  std::unordered_map<SizeType, SizeType> mHash;
+
+};
+
 END_NONAMESPACE
 
+// @brief コピーコンストラクタ
+ModelImpl::ModelImpl(
+  const ModelImpl& src
+) : mInputList{src.mInputList},
+    mLatchList{src.mLatchList},
+    mOutputList{src.mOutputList},
+    mAndList{src.mAndList},
+    mAndArray{src.mAndArray},
+    mAndNum{src.mAndNum},
+    mMapping{src.mMapping},
+    mPacked{src.mPacked},
+    mComment{src.mComment},
+    mCanonical{src.mCanonical}
+{
+  if ( mMapping == nullptr ) {
+    mAndArray = mAndList.data();
+  }
+}
+
+// @brief ANDノードのリストを圧縮表現にする．
+void
+ModelImpl::pack_ands(
+  SizeType interval
+)
+{
+  if ( mPacked != nullptr ) {
+    return;
+  }
+
+  // バイナリ AIG と同じ標準形か調べる．
+  SizeType base_lit = (I() + L() + 1) * 2;
+  bool canonical = true;
+  for ( SizeType i = 0; i < A(); ++ i ) {
+    auto& node = mAndArray[i];
+    if ( node.mLiteral != base_lit + i * 2 ||
+	 node.mLiteral <= node.mSrc1 ||
+	 node.mSrc1 < node.mSrc2 ) {
+      canonical = false;
+      break;
+    }
+  }
+
+  auto packed = std::make_shared<PackedAndList>(interval, base_lit, canonical);
+  for ( SizeType i = 0; i < A(); ++ i ) {
+    auto& node = mAndArray[i];
+    packed->add(node.mLiteral, node.mSrc1, node.mSrc2);
+  }
+  packed->finish();
+
+  mPacked = packed;
+  mAndArray = nullptr;
+  mMapping = nullptr;
+  vector<AndInfo>{}.swap(mAndList);
+}
+
+// @brief ANDノードのリストを展開する．
+void
+ModelImpl::unpack_ands()
+{
+  if ( mPacked == nullptr ) {
+    return;
+  }
+
+  vector<AndInfo> and_list(A());
+  auto cursor = mPacked->begin();
+  for ( auto& node: and_list ) {
+    mPacked->decode(cursor);
+    node = AndInfo{cursor.mLit, cursor.mSrc1, cursor.mSrc2};
+  }
+  mAndList.swap(and_list);
+  mAndArray = mAndList.data();
+  mPacked = nullptr;
+}
+
+// @brief ANDノードのリストが使用しているメモリ量(バイト)を返す．
+SizeType
+ModelImpl::and_memory_size() const
+{
+  if ( mPacked != nullptr ) {
+    return mPacked->memory_size();
+  }
+  return mAndList.capacity() * sizeof(AndInfo);
+}
+
 // @brief 内容を初期化する．
 void
 ModelImpl::initialize(
@@ -37,8 +196,129 @@ ModelImpl::initialize(
 
   mAndList.clear();
   mAndList.resize(A);
+  mAndArray = mAndList.data();
+  mAndNum = A;
+  mMapping = nullptr;
+  mPacked = nullptr;
 
   mComment = string{};
+  mCanonical = false;
+}
+
+// @brief 変数番号が標準形か調べて記録する．
+void
+ModelImpl::check_canonical()
+{
+  mCanonical = false;
+  for ( SizeType i = 0; i < I(); ++ i ) {
+    if ( input(i) != (i + 1) * 2 ) {
+      return;
+    }
+  }
+  for ( SizeType i = 0; i < L(); ++ i ) {
+    if ( latch(i) != (i + I() + 1) * 2 ) {
+      return;
+    }
+  }
+  SizeType base_lit = (I() + L() + 1) * 2;
+  for ( SizeType i = 0; i < A(); ++ i ) {
+    if ( and_node(i) != base_lit + i * 2 ) {
+      return;
+    }
+  }
+  mCanonical = true;
+}
+
+// @brief ANDノードを指定された順番に並べて標準形の番号を振る．
+void
+ModelImpl::renumber(
+  const ModelImpl& src,
+  const vector<SizeType>& order_list,
+  const vector<SizeType>& repr
+)
+{
+  vector<SizeType> input_list(src.I());
+  std::iota(input_list.begin(), input_list.end(), 0);
+  vector<SizeType> latch_list(src.L());
+  std::iota(latch_list.begin(), latch_list.end(), 0);
+  vector<SizeType> output_list(src.O());
+  std::iota(output_list.begin(), output_list.end(), 0);
+  renumber(src, input_list, latch_list, output_list, order_list, repr);
+}
+
+// @brief 指定された部分を取り出して標準形の番号を振る．
+void
+ModelImpl::renumber(
+  const ModelImpl& src,
+  const vector<SizeType>& input_list,
+  const vector<SizeType>& latch_list,
+  const vector<SizeType>& output_list,
+  const vector<SizeType>& order_list,
+  const vector<SizeType>& repr
+)
+{
+  auto I = input_list.size();
+  auto L = latch_list.size();
+  auto O = output_list.size();
+  auto A = order_list.size();
+
+  // 元の変数番号の最大値 + 1
+  // 定義されている変数のみを調べればよいので VarMap は作らない．
+  SizeType var_num = src.I() + src.L() + src.A() + 1;
+  if ( !src.is_canonical() ) {
+    var_num = 1;
+    for ( auto& info: src.mInputList ) {
+      var_num = std::max(var_num, info.mLiteral / 2 + 1);
+    }
+    for ( auto& info: src.mLatchList ) {
+      var_num = std::max(var_num, info.mLiteral / 2 + 1);
+    }
+    for ( SizeType i = 0; i < src.A(); ++ i ) {
+      var_num = std::max(var_num, src.and_node(i) / 2 + 1);
+    }
+  }
+  NewVarTable new_var{var_num, I + L + A};
+  auto new_lit = [&](SizeType lit) {
+    if ( !repr.empty() ) {
+      lit = repr[lit / 2] ^ (lit % 2);
+    }
+    return new_var.lit(lit);
+  };
+
+  initialize(I, L, O, A);
+  for ( SizeType i = 0; i < I; ++ i ) {
+    auto pos = input_list[i];
+    new_var.set(src.input(pos) / 2, i + 1);
+    mInputList[i] = InputInfo{(i + 1) * 2, src.input_symbol(pos)};
+  }
+  for ( SizeType i = 0; i < L; ++ i ) {
+    auto pos = latch_list[i];
+    new_var.set(src.latch(pos) / 2, I + i + 1);
+  }
+  for ( SizeType i = 0; i < A; ++ i ) {
+    auto pos = order_list[i];
+    auto id = I + L + i + 1;
+    new_var.set(src.and_node(pos) / 2, id);
+    auto src1 = new_lit(src.and_src1(pos));
+    auto src2 = new_lit(src.and_src2(pos));
+    if ( src1 < src2 ) {
+      std::swap(src1, src2);
+    }
+    mAndList[i] = AndInfo{id * 2, src1, src2};
+  }
+  for ( SizeType i = 0; i < L; ++ i ) {
+    auto pos = latch_list[i];
+    mLatchList[i] = LatchInfo{(I + i + 1) * 2,
+			      new_lit(src.latch_src(pos)),
+			      src.latch_symbol(pos)};
+  }
+  for ( SizeType i = 0; i < O; ++ i ) {
+    auto pos = output_list[i];
+    mOutputList[i] = OutputInfo{new_lit(src.output_src(pos)),
+				src.output_symbol(pos)};
+  }
+  mComment = src.comment();
+  mCanonical = true;
 }
 
 // @brief Ascii AIG フォーマットを読み込む．
@@ -74,7 +354,17 @@ ModelImpl::read_aag(
   initialize(I, L, O, A);
 
   // 定義されたリテラルの辞書
-  vector<bool> defined(M * 2, false);
+  // 定数 0 と 1 は定義済みとみなす．
+  vector<bool> defined((M + 1) * 2, false);
+  defined[0] = true;
+  defined[1] = true;
+  auto check_range = [&](SizeType lit) {
+    if ( lit >= defined.size() ) {
+      ostringstream buf;
+      buf << lit << " is out of range.";
+      throw std::invalid_argument{buf.str()};
+    }
+  };
 
   // 入力行の読み込み
   for ( SizeType i = 0; i < I; ++ i ) {
@@ -90,6 +380,7 @@ ModelImpl::read_aag(
     if ( (lit % 2) == 1 ) {
       throw std::invalid_argument{"Positive Literal(even number) expected"};
     }
+    check_range(lit);
     if ( defined[lit] ) {
       ostringstream buf;
       buf << lit << " is already defined.";
@@ -113,6 +404,7 @@ ModelImpl::read_aag(
     if ( (lit % 2) == 1 ) {
       throw std::invalid_argument{"Positive Literal(even number) expected"};
     }
+    check_range(lit);
     if ( defined[lit] ) {
       ostringstream buf;
       buf << lit << " is already defined.";
@@ -151,6 +443,7 @@ ModelImpl::read_aag(
     if ( (lit % 2) == 1 ) {
       throw std::invalid_argument{"Positive Literal(even number) expected"};
     }
+    check_range(lit);
     if ( defined[lit] ) {
       ostringstream buf;
       buf << lit << " is already defined.";
@@ -165,6 +458,7 @@ ModelImpl::read_aag(
   // ソースリテラルが定義されているかチェック
   for ( SizeType i = 0; i < L; ++ i ) {
     auto src = latch_src(i);
+    check_range(src);
     if ( !defined[src] && !defined[src ^ 1] ) {
       ostringstream buf;
       buf << src << " is not defined required by Latch#" << i
@@ -174,6 +468,7 @@ ModelImpl::read_aag(
   }
   for ( SizeType i = 0; i < O; ++ i ) {
     auto src = output_src(i);
+    check_range(src);
     if ( !defined[src] && !defined[src ^ 1] ) {
       ostringstream buf;
       buf << src << " is not defined required by Output#" << i << ".";
@@ -182,6 +477,7 @@ ModelImpl::read_aag(
   }
   for ( SizeType i = 0; i < A; ++ i ) {
     auto src1 = and_src1(i);
+    check_range(src1);
     if ( !defined[src1] && !defined[src1 ^ 1] ) {
       ostringstream buf;
       buf << src1 << " is not defined required by And#" << i
@@ -189,6 +485,7 @@ ModelImpl::read_aag(
       throw std::invalid_argument{buf.str()};
     }
     auto src2 = and_src2(i);
+    check_range(src2);
     if ( !defined[src2] && !defined[src2 ^ 1] ) {
       ostringstream buf;
       buf << src2 << " is not defined required by And#" << i
@@ -199,6 +496,8 @@ ModelImpl::read_aag(
 
   // シンボルテーブルとコメントの読み込みを行う．
   read_symbols(s);
+
+  check_canonical();
 }
 
 BEGIN_NONAMESPACE
@@ -222,9 +521,9 @@ get_number(
 
 END_NONAMESPACE
 
-// @brief AIG フォーマットを読み込む．
+// @brief AIG フォーマットのヘッダとラッチ行，出力行を読み込む．
 void
-ModelImpl::read_aig(
+ModelImpl::read_aig_header(
   istream& s
 )
 {
@@ -289,6 +588,23 @@ ModelImpl::read_aig(
     mOutputList[i] = OutputInfo{src};
   }
 
+  // バイナリ AIG は常に標準形
+  mCanonical = true;
+}
+
+// @brief AIG フォーマットを読み込む．
+void
+ModelImpl::read_aig(
+  istream& s
+)
+{
+  // ヘッダ，ラッチ行，出力行の読み込み
+  read_aig_header(s);
+
+  SizeType I = this->I();
+  SizeType L = this->L();
+  SizeType A = this->A();
+
   // AND行の読み込み
   for ( SizeType i = 0; i < A; ++ i ) {
     SizeType d0 = get_number(s);
@@ -309,6 +625,47 @@ ModelImpl::read_aig(
   read_symbols(s);
 }
 
+// @brief 索引を用いて AIG フォーマットを並列に読み込む．
+void
+ModelImpl::read_aig(
+  const AigFileIndex& index,
+  SizeType thread_num
+)
+{
+  ifstream s{index.filename(), std::ios::binary};
+  if ( !s ) {
+    ostringstream buf;
+    buf << index.filename() << ": Could not open file";
+    throw std::invalid_argument{buf.str()};
+  }
+
+  // ヘッダ，ラッチ行，出力行の読み込み
+  read_aig_header(s);
+  if ( I() != index.I() || L() != index.L() ||
+       O() != index.O() || A() != index.A() ) {
+    throw std::invalid_argument{"read_aig: index does not match the file"};
+  }
+
+  // AND行はブロック単位で並列に復号する．
+  SizeType A = this->A();
+  SizeType interval = index.interval();
+  WorkPool pool{thread_num};
+  pool.run(index.block_num(), [&](SizeType k, SizeType) {
+    auto pos = k * interval;
+    auto num = std::min(interval, A - pos);
+    auto and_list = index.read_ands(pos, num);
+    for ( SizeType i = 0; i < num; ++ i ) {
+      mAndList[pos + i] = AndInfo{and_list[i * 3 + 0],
+				  and_list[i * 3 + 1],
+				  and_list[i * 3 + 2]};
+    }
+  });
+
+  // シンボルの読み込み
+  s.seekg(index.symbol_offset());
+  read_symbols(s);
+}
+
 // @brief シンボルテーブルとコメントを読み込む．
 void
 ModelImpl::read_symbols(
@@ -348,6 +705,82 @@ ModelImpl::read_symbols(
   }
 }
 
+// @brief ANDノードの番号をトポロジカル順に並べたリストを返す．
+vector<SizeType>
+ModelImpl::and_topo_order() const
+{
+  vector<SizeType> order_list;
+  order_list.reserve(A());
+
+  if ( mCanonical ) {
+    // バイナリ AIG と同じくファンインの番号が小さければそのままでよい．
+    bool sorted = true;
+    for ( SizeType i = 0; i < A(); ++ i ) {
+      auto lit = and_node(i);
+      if ( and_src1(i) >= lit || and_src2(i) >= lit ) {
+	sorted = false;
+	break;
+      }
+    }
+    if ( sorted ) {
+      for ( SizeType i = 0; i < A(); ++ i ) {
+	order_list.push_back(i);
+      }
+      return order_list;
+    }
+  }
+
+  // 再帰を用いない深さ優先探索で帰りがけ順に並べる．
+  // 状態は 0: 未訪問，1: 訪問中，2: 処理済み
+  VarMap var_map{*this};
+  vector<std::uint8_t> state(A(), 0);
+  vector<std::pair<SizeType, bool>> stack;
+  auto push = [&](SizeType lit) {
+    auto var = lit / 2;
+    if ( var >= var_map.var_num() || var_map.kind(var) == VarMap::NONE ) {
+      ostringstream buf;
+      buf << lit << " is not defined.";
+      throw std::invalid_argument{buf.str()};
+    }
+    if ( var_map.kind(var) != VarMap::AND ) {
+      return;
+    }
+    auto pos = var_map.pos(var);
+    if ( state[pos] == 1 ) {
+      ostringstream buf;
+      buf << lit << " is in a combinational loop.";
+      throw std::invalid_argument{buf.str()};
+    }
+    if ( state[pos] == 0 ) {
+      stack.push_back({pos, false});
+    }
+  };
+  for ( SizeType i = 0; i < A(); ++ i ) {
+    if ( state[i] != 0 ) {
+      continue;
+    }
+    stack.push_back({i, false});
+    while ( !stack.empty() ) {
+      auto pos = stack.back().first;
+      auto done = stack.back().second;
+      stack.pop_back();
+      if ( done ) {
+	state[pos] = 2;
+	order_list.push_back(pos);
+	continue;
+      }
+      if ( state[pos] != 0 ) {
+	continue;
+      }
+      state[pos] = 1;
+      stack.push_back({pos, true});
+      push(and_src1(pos));
+      push(and_src2(pos));
+    }
+  }
+  return order_list;
+}
+
 // @brief 内容を出力する．
 void
 ModelImpl::print(
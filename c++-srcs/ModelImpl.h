@@ -9,13 +9,22 @@
 /// All rights reserved.
 
 #include "ym/aig_nsdef.h"
+#include "PackedAndList.h"
+#include <memory>
 
 
 BEGIN_NAMESPACE_YM_AIG
 
+class MappedFile;
+
 //////////////////////////////////////////////////////////////////////
 /// @class ModelImpl ModelImpl.h "ModelImpl.h"
 /// @brief AIG 形式のファイルを読むためのクラス
+///
+/// ANDノードの配列は自前の mAndList か，スナップショットファイルを
+/// mmap() した領域のどちらかに置かれ，mAndArray を通して参照される．
+/// ただし，pack_ands() で圧縮表現にした場合は PackedAndList に置かれ，
+/// 参照のたびに復号される．
 //////////////////////////////////////////////////////////////////////
 class ModelImpl
 {
@@ -25,9 +34,17 @@ public:
   ModelImpl() = default;
 
   /// @brief コピーコンストラクタ
+  ///
+  /// スナップショットのマッピングは共有する．
   ModelImpl(
     const ModelImpl& src ///< [in] コピー元のオブジェクト
-  ) = default;
+  );
+
+  /// @brief コピー代入文は禁止
+  ModelImpl&
+  operator=(
+    const ModelImpl& src
+  ) = delete;
 
   /// @brief デストラクタ
   ~ModelImpl() = default;
@@ -55,6 +72,160 @@ public:
     istream& s ///< [in] 入力ストリーム
   );
 
+  /// @brief 索引を用いて AIG フォーマットを並列に読み込む．
+  ///
+  /// 読み込みが失敗したら std::invalid_argument 例外を送出する．
+  void
+  read_aig(
+    const AigFileIndex& index, ///< [in] 索引
+    SizeType thread_num        ///< [in] スレッド数
+  );
+
+  /// @brief スナップショットを書き出す．
+  ///
+  /// 書き込みが失敗したら std::invalid_argument 例外を送出する．
+  void
+  write_snapshot(
+    const string& filename ///< [in] ファイル名
+  ) const;
+
+  /// @brief スナップショットを開く．
+  ///
+  /// - ANDノードの配列はマッピングした領域をそのまま参照する．
+  /// - verify が true の時はチェックサムを検証する．
+  /// - 不正なファイルの場合は std::invalid_argument 例外を送出する．
+  void
+  open_snapshot(
+    const string& filename, ///< [in] ファイル名
+    bool verify             ///< [in] チェックサムを検証する時 true
+  );
+
+  /// @brief CNF を DIMACS 形式で書き出す．
+  ///
+  /// - 範囲外の出力やラッチが指定された場合は
+  ///   std::invalid_argument 例外を送出する．
+  /// - 書き込みエラーは s の状態で判定する．
+  void
+  write_cnf(
+    ostream& s,          ///< [in] 出力先のストリーム
+    const AigCnfOpt& opt ///< [in] オプション
+  ) const;
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name ANDノードの圧縮表現
+  /// @{
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ANDノードのリストを圧縮表現にする．
+  void
+  pack_ands(
+    SizeType interval ///< [in] チェックポイントの間隔
+  );
+
+  /// @brief ANDノードのリストを展開する．
+  void
+  unpack_ands();
+
+  /// @brief ANDノードのリストが圧縮表現の時 true を返す．
+  bool
+  is_packed() const
+  {
+    return mPacked != nullptr;
+  }
+
+  /// @brief ANDノードの圧縮表現を返す．
+  ///
+  /// 圧縮表現でない場合は nullptr を返す．
+  const PackedAndList*
+  packed_and_list() const
+  {
+    return mPacked.get();
+  }
+
+  /// @brief ANDノードのリストが使用しているメモリ量(バイト)を返す．
+  ///
+  /// スナップショットをマッピングしている場合は 0 を返す．
+  SizeType
+  and_memory_size() const;
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name 構造の変換
+  /// @{
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 指定された出力とラッチの推移的ファンインを取り出す．
+  ///
+  /// - 自身の内容は src の部分回路で置き換えられる．
+  /// - 番号の範囲外の出力やラッチが指定された場合は
+  ///   std::invalid_argument 例外を送出する．
+  void
+  extract_cone(
+    const ModelImpl& src,                 ///< [in] 元のモデル
+    const vector<SizeType>& output_list, ///< [in] 出力番号のリスト
+    const vector<SizeType>& latch_list   ///< [in] ラッチ番号のリスト
+  );
+
+  /// @brief 2つのモデルのマイタを設定する．
+  ///
+  /// - 入力は src1 の順番で，ラッチは src1 のラッチの後に src2 のラッチを並べる．
+  /// - 定数の伝搬と構造的ハッシュを行いながらANDノードを作る．
+  /// - 入出力の対応がとれない場合は std::invalid_argument 例外を送出する．
+  void
+  make_miter(
+    const ModelImpl& src1, ///< [in] モデル1
+    const ModelImpl& src2, ///< [in] モデル2
+    const AigMiterOpt& opt ///< [in] オプション
+  );
+
+  /// @brief 時間展開した組み合わせ回路を設定する．
+  void
+  make_unrolled(
+    const AigUnroller& unroller ///< [in] 展開器
+  );
+
+  /// @brief 定数の伝搬と不要なANDノードの削除を行った内容を設定する．
+  /// @return 削除されたANDノード数を返す．
+  ///
+  /// - 自身の内容は src を整理したもので置き換えられる．
+  /// - 入力，ラッチ，出力はそのまま残す．
+  SizeType
+  cleanup(
+    const ModelImpl& src ///< [in] 元のモデル
+  );
+
+  /// @brief 構造的に同じANDノードを併合した内容を設定する．
+  /// @return 削除されたANDノード数を返す．
+  ///
+  /// - 自身の内容は src のANDノードを併合したもので置き換えられる．
+  /// - 入力，ラッチ，出力はそのまま残す．
+  SizeType
+  strash(
+    const ModelImpl& src ///< [in] 元のモデル
+  );
+
+  /// @brief ANDノードの番号を参照の局所性がよくなるように振り直した内容を設定する．
+  ///
+  /// - level_major が false の時は出力，ラッチからの深さ優先探索の
+  ///   帰りがけ順に並べる．
+  /// - level_major が true の時はレベル順に並べ，同じレベル内では
+  ///   ファンインの番号の小さい順に並べる．
+  /// - 入力，ラッチ，出力はそのまま残す．
+  void
+  reorder(
+    const ModelImpl& src, ///< [in] 元のモデル
+    bool level_major      ///< [in] レベル順に並べる時 true
+  );
+
   /// @}
   //////////////////////////////////////////////////////////////////////
 
@@ -96,7 +267,17 @@ public:
   SizeType
   A() const
   {
-    return mAndList.size();
+    return mAndNum;
+  }
+
+  /// @brief 変数番号が標準形の時 true を返す．
+  ///
+  /// 標準形とはバイナリ AIG と同じく入力，ラッチ，ANDノードの順に
+  /// 1 から連続した番号が振られていることを表す．
+  bool
+  is_canonical() const
+  {
+    return mCanonical;
   }
 
   /// @brief 入力ノードのリテラルを得る．
@@ -146,7 +327,10 @@ public:
   ) const
   {
     ASSERT_COND( 0 <= pos && pos < A() );
-    return mAndList[pos].mLiteral;
+    if ( mPacked != nullptr ) {
+      return mPacked->get(pos).mLit;
+    }
+    return mAndArray[pos].mLiteral;
   }
 
   /// @brief ANDノードのソース1のリテラルを得る．
@@ -156,7 +340,10 @@ public:
   ) const
   {
     ASSERT_COND( 0 <= pos && pos < A() );
-    return mAndList[pos].mSrc1;
+    if ( mPacked != nullptr ) {
+      return mPacked->get(pos).mSrc1;
+    }
+    return mAndArray[pos].mSrc1;
   }
 
   /// @brief ANDノードのソース2のリテラルを得る．
@@ -166,7 +353,10 @@ public:
   ) const
   {
     ASSERT_COND( 0 <= pos && pos < A() );
-    return mAndList[pos].mSrc2;
+    if ( mPacked != nullptr ) {
+      return mPacked->get(pos).mSrc2;
+    }
+    return mAndArray[pos].mSrc2;
   }
 
   /// @brief 入力のシンボルを得る．
@@ -206,6 +396,21 @@ public:
     return mComment;
   }
 
+  /// @brief ANDノードの番号をトポロジカル順に並べたリストを返す．
+  ///
+  /// - ファンインのANDノードは必ず前に現れる．
+  /// - 標準形でファンインの番号が自身より小さい場合は元の順番のままとなる．
+  /// - 組み合わせ回路のループや未定義のリテラルがある場合は
+  ///   std::invalid_argument 例外を送出する．
+  vector<SizeType>
+  and_topo_order() const;
+
+  /// @brief ランダムシミュレーションで出力を 1 にする入力系列を探す．
+  AigCex
+  falsify(
+    const AigFalsifyOpt& opt ///< [in] オプション
+  ) const;
+
   /// @brief 内容を出力する．
   void
   print(
@@ -227,6 +432,44 @@ private:
     SizeType A  ///< [in] ANDノード数
   );
 
+  /// @brief 変数番号が標準形か調べて記録する．
+  void
+  check_canonical();
+
+  /// @brief ANDノードを指定された順番に並べて標準形の番号を振る．
+  ///
+  /// 入力，ラッチ，出力は全て同じ順番で残す．
+  /// それ以外は下の renumber() と同じ．
+  void
+  renumber(
+    const ModelImpl& src,                ///< [in] 元のモデル
+    const vector<SizeType>& order_list,  ///< [in] ANDノード番号のリスト
+    const vector<SizeType>& repr = {}    ///< [in] 代表リテラルの表
+  );
+
+  /// @brief 指定された部分を取り出して標準形の番号を振る．
+  ///
+  /// - input_list, latch_list, output_list で指定された入力，ラッチ，
+  ///   出力をこの順番で残す．
+  /// - order_list はトポロジカル順になっていなければならない．
+  ///   order_list に含まれないANDノードは削除される．
+  /// - repr が空でない時は変数番号をキーにした代表リテラル(元の番号)の
+  ///   表とみなし，ANDノードのファンイン，ラッチと出力のソースを
+  ///   代表に置き換えてから番号を振る．
+  /// - 参照されるリテラルは定数か残される入力，ラッチ，ANDノードの
+  ///   ものでなければならない．
+  /// - 残す部分が元のモデルに比べて小さい時は変数番号の対応表に
+  ///   ハッシュ表を用いて，元のモデルの大きさによらない手間で処理する．
+  void
+  renumber(
+    const ModelImpl& src,                 ///< [in] 元のモデル
+    const vector<SizeType>& input_list,   ///< [in] 入力番号のリスト
+    const vector<SizeType>& latch_list,   ///< [in] ラッチ番号のリスト
+    const vector<SizeType>& output_list,  ///< [in] 出力番号のリスト
+    const vector<SizeType>& order_list,   ///< [in] ANDノード番号のリスト
+    const vector<SizeType>& repr = {}     ///< [in] 代表リテラルの表
+  );
+
   /// @brief ラッチのソースリテラルを設定する．
   void
   set_latch_src(
@@ -258,6 +501,7 @@ private:
   )
   {
     ASSERT_COND( 0 <= pos && pos < A() );
+    ASSERT_COND( mMapping == nullptr && mPacked == nullptr );
     mAndList[pos].mSrc1 = src1;
     mAndList[pos].mSrc2 = src2;
   }
@@ -295,6 +539,14 @@ private:
     mOutputList[pos].mSymbol = name;
   }
 
+  /// @brief AIG フォーマットのヘッダとラッチ行，出力行を読み込む．
+  ///
+  /// ANDノードの領域も確保する．
+  void
+  read_aig_header(
+    istream& s ///< [in] 入力ストリーム
+  );
+
   /// @brief シンボルテーブルとコメントを読み込む．
   void
   read_symbols(
@@ -349,9 +601,26 @@ private:
   // ANDノードのソース１のリテラルのリスト
   vector<AndInfo> mAndList;
 
+  // ANDノードの配列の先頭
+  // mAndList の先頭かスナップショットのマッピング中の領域を指す．
+  const AndInfo* mAndArray{nullptr};
+
+  // ANDノード数
+  SizeType mAndNum{0};
+
+  // スナップショットのマッピング
+  std::shared_ptr<MappedFile> mMapping;
+
+  // ANDノードの圧縮表現
+  // 構築後は変更されないのでコピー間で共有する．
+  std::shared_ptr<const PackedAndList> mPacked;
+
   // コメント
   string mComment;
 
+  // 変数番号が標準形の時 true
+  bool mCanonical{false};
+
 };
 
 END_NAMESPACE_YM_AIG
@@ -0,0 +1,180 @@
+
+/// @file ModelImpl_cleanup.cc
+/// @brief ModelImpl::cleanup() の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ModelImpl.h"
+#include "VarMap.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+BEGIN_NONAMESPACE
+
+// 未処理を表す値
+const SizeType BAD_LIT = static_cast<SizeType>(-1);
+
+END_NONAMESPACE
+
+// @brief 定数の伝搬と不要なANDノードの削除を行った内容を設定する．
+SizeType
+ModelImpl::cleanup(
+  const ModelImpl& src
+)
+{
+  VarMap var_map{src};
+  auto var_num = var_map.var_num();
+
+  auto check_lit = [&](SizeType lit) {
+    if ( lit / 2 >= var_num || var_map.kind(lit / 2) == VarMap::NONE ) {
+      ostringstream buf;
+      buf << "cleanup: " << lit << " is not defined.";
+      throw std::invalid_argument{buf.str()};
+    }
+  };
+
+  // 1. 出力とラッチから到達可能なANDノードをトポロジカル順に並べる．
+  vector<SizeType> root_list;
+  root_list.reserve(src.O() + src.L());
+  for ( SizeType i = 0; i < src.O(); ++ i ) {
+    root_list.push_back(src.output_src(i));
+  }
+  for ( SizeType i = 0; i < src.L(); ++ i ) {
+    root_list.push_back(src.latch_src(i));
+  }
+
+  // 各変数の代表リテラル(元の番号)
+  // 定数に畳み込まれた場合は 0 か 1，それ以外は自分自身となる．
+  vector<SizeType> repr(var_num, BAD_LIT);
+  repr[0] = 0;
+  for ( SizeType i = 0; i < src.I(); ++ i ) {
+    repr[src.input(i) / 2] = src.input(i);
+  }
+  for ( SizeType i = 0; i < src.L(); ++ i ) {
+    repr[src.latch(i) / 2] = src.latch(i);
+  }
+  auto repr_lit = [&](SizeType lit) {
+    return repr[lit / 2] ^ (lit % 2);
+  };
+
+  // 畳み込んだ後のファンイン
+  vector<SizeType> fanin1(var_num, 0);
+  vector<SizeType> fanin2(var_num, 0);
+
+  {
+    vector<std::pair<SizeType, bool>> stack;
+    for ( auto lit: root_list ) {
+      check_lit(lit);
+      stack.push_back({lit / 2, false});
+    }
+    vector<bool> mark(var_num, false);
+    while ( !stack.empty() ) {
+      auto var = stack.back().first;
+      auto done = stack.back().second;
+      stack.pop_back();
+      if ( var_map.kind(var) != VarMap::AND ) {
+	continue;
+      }
+      auto pos = var_map.pos(var);
+      auto src1 = src.and_src1(pos);
+      auto src2 = src.and_src2(pos);
+      if ( done ) {
+	if ( repr[src1 / 2] == BAD_LIT || repr[src2 / 2] == BAD_LIT ) {
+	  // 組み合わせ回路のループがある．
+	  ostringstream buf;
+	  buf << "cleanup: " << (var * 2) << " is in a combinational loop.";
+	  throw std::invalid_argument{buf.str()};
+	}
+	auto a = repr_lit(src1);
+	auto b = repr_lit(src2);
+	if ( a < b ) {
+	  std::swap(a, b);
+	}
+	// ここで b <= a
+	if ( b == 0 ) {
+	  // x & 0 = 0
+	  repr[var] = 0;
+	}
+	else if ( b == 1 ) {
+	  // x & 1 = x
+	  repr[var] = a;
+	}
+	else if ( a == b ) {
+	  // x & x = x
+	  repr[var] = a;
+	}
+	else if ( a == (b ^ 1) ) {
+	  // x & ~x = 0
+	  repr[var] = 0;
+	}
+	else {
+	  repr[var] = var * 2;
+	  fanin1[var] = a;
+	  fanin2[var] = b;
+	}
+	continue;
+      }
+      if ( mark[var] ) {
+	continue;
+      }
+      mark[var] = true;
+      check_lit(src1);
+      check_lit(src2);
+      stack.push_back({var, true});
+      if ( !mark[src1 / 2] ) {
+	stack.push_back({src1 / 2, false});
+      }
+      if ( !mark[src2 / 2] ) {
+	stack.push_back({src2 / 2, false});
+      }
+    }
+  }
+
+  // 2. 畳み込んだ後のファンインで到達可能なANDノードを
+  //    トポロジカル順に並べる．
+  vector<SizeType> and_var_list;
+  {
+    vector<std::pair<SizeType, bool>> stack;
+    for ( auto lit: root_list ) {
+      stack.push_back({repr_lit(lit) / 2, false});
+    }
+    vector<bool> mark(var_num, false);
+    while ( !stack.empty() ) {
+      auto var = stack.back().first;
+      auto done = stack.back().second;
+      stack.pop_back();
+      if ( var_map.kind(var) != VarMap::AND ) {
+	continue;
+      }
+      if ( done ) {
+	and_var_list.push_back(var);
+	continue;
+      }
+      if ( mark[var] ) {
+	continue;
+      }
+      mark[var] = true;
+      stack.push_back({var, true});
+      for ( auto lit: {fanin1[var], fanin2[var]} ) {
+	if ( !mark[lit / 2] ) {
+	  stack.push_back({lit / 2, false});
+	}
+      }
+    }
+  }
+
+  // 3. 標準形の番号を振り直す．
+  vector<SizeType> order_list;
+  order_list.reserve(and_var_list.size());
+  for ( auto var: and_var_list ) {
+    order_list.push_back(var_map.pos(var));
+  }
+  renumber(src, order_list, repr);
+
+  return src.A() - A();
+}
+
+END_NAMESPACE_YM_AIG
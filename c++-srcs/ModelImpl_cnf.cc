@@ -0,0 +1,68 @@
+
+/// @file ModelImpl_cnf.cc
+/// @brief ModelImpl::write_cnf() の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ModelImpl.h"
+#include "CnfEncoder.h"
+#include "DimacsWriter.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+// クラス ModelImpl
+//////////////////////////////////////////////////////////////////////
+
+// @brief CNF を DIMACS 形式で書き出す．
+void
+ModelImpl::write_cnf(
+  ostream& s,
+  const AigCnfOpt& opt
+) const
+{
+  CnfEncoder encoder{*this, opt};
+  auto& var_map = encoder.var_map();
+
+  DimacsWriter writer{s};
+  // 入出力と CNF の変数の対応をコメントとして書いておく．
+  for ( SizeType i = 0; i < I(); ++ i ) {
+    auto v = var_map[input(i) / 2];
+    if ( v != 0 ) {
+      ostringstream buf;
+      buf << "input " << i << " " << v;
+      writer.write_comment(buf.str());
+    }
+  }
+  for ( SizeType i = 0; i < L(); ++ i ) {
+    auto v = var_map[latch(i) / 2];
+    if ( v != 0 ) {
+      ostringstream buf;
+      buf << "latch " << i << " " << v;
+      writer.write_comment(buf.str());
+    }
+  }
+  for ( SizeType i = 0; i < encoder.output_list().size(); ++ i ) {
+    ostringstream buf;
+    buf << "output " << encoder.output_list()[i]
+	<< " " << encoder.output_lit_list()[i];
+    writer.write_comment(buf.str());
+  }
+  for ( SizeType i = 0; i < encoder.latch_list().size(); ++ i ) {
+    ostringstream buf;
+    buf << "latch_src " << encoder.latch_list()[i]
+	<< " " << encoder.latch_lit_list()[i];
+    writer.write_comment(buf.str());
+  }
+
+  writer.write_header(encoder.var_num(), encoder.clause_num());
+  encoder.encode([&](const int* lits, SizeType n) {
+    writer.write_clause(lits, n);
+  });
+  writer.flush();
+}
+
+END_NAMESPACE_YM_AIG
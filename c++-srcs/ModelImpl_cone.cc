@@ -0,0 +1,145 @@
+
+/// @file ModelImpl_cone.cc
+/// @brief ModelImpl::extract_cone() の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ModelImpl.h"
+#include "VarMap.h"
+#include <algorithm>
+#include <unordered_map>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+// @brief 指定された出力とラッチの推移的ファンインを取り出す．
+void
+ModelImpl::extract_cone(
+  const ModelImpl& src,
+  const vector<SizeType>& output_list,
+  const vector<SizeType>& latch_list
+)
+{
+  for ( auto pos: output_list ) {
+    if ( pos >= src.O() ) {
+      ostringstream buf;
+      buf << "extract_cone: Output#" << pos << " is out of range.";
+      throw std::invalid_argument{buf.str()};
+    }
+  }
+  for ( auto pos: latch_list ) {
+    if ( pos >= src.L() ) {
+      ostringstream buf;
+      buf << "extract_cone: Latch#" << pos << " is out of range.";
+      throw std::invalid_argument{buf.str()};
+    }
+  }
+
+  // 標準形のモデルでは VarMap は表を作らないので，
+  // 以下の処理は取り出す部分の大きさに比例した手間で済む．
+  VarMap var_map{src};
+
+  // 訪問済みの変数番号と，ファンインの番号付けが終わっているかの印
+  // 元のモデルの大きさに比例した領域を使わないようにハッシュ表を用いる．
+  std::unordered_map<SizeType, bool> mark;
+
+  // 到達した入力番号とラッチ番号
+  vector<SizeType> input_pos_list;
+  vector<SizeType> latch_pos_list;
+  // 到達したANDノードの番号(トポロジカル順)
+  vector<SizeType> and_pos_list;
+
+  // 再帰を用いない深さ優先探索を行う．
+  // スタックの要素は (変数番号, ファンインを処理済みか) の組
+  vector<std::pair<SizeType, bool>> stack;
+  auto push = [&](SizeType lit) {
+    auto var = lit / 2;
+    if ( var >= var_map.var_num() ) {
+      ostringstream buf;
+      buf << "extract_cone: " << lit << " is not defined.";
+      throw std::invalid_argument{buf.str()};
+    }
+    if ( mark.count(var) == 0 ) {
+      stack.push_back({var, false});
+    }
+  };
+  for ( auto pos: output_list ) {
+    push(src.output_src(pos));
+  }
+  for ( auto pos: latch_list ) {
+    push(src.latch(pos));
+  }
+  // 次状態関数をたどるのを待っているラッチ番号のリスト
+  // ラッチは組み合わせ回路的にはファンインを持たないので，
+  // 現在の探索が終わってから次状態関数をたどる．
+  vector<SizeType> latch_queue;
+  for ( ; ; ) {
+    if ( stack.empty() ) {
+      if ( latch_queue.empty() ) {
+	break;
+      }
+      auto pos = latch_queue.back();
+      latch_queue.pop_back();
+      push(src.latch_src(pos));
+      continue;
+    }
+    auto var = stack.back().first;
+    auto done = stack.back().second;
+    stack.pop_back();
+    auto pos = var_map.pos(var);
+    if ( done ) {
+      // ファンインは訪問済みなので，番号付けが終わっていなければ
+      // 組み合わせ回路のループがある．
+      for ( auto lit: {src.and_src1(pos), src.and_src2(pos)} ) {
+	if ( !mark.at(lit / 2) ) {
+	  ostringstream buf;
+	  buf << "extract_cone: " << lit << " is in a combinational loop.";
+	  throw std::invalid_argument{buf.str()};
+	}
+      }
+      mark[var] = true;
+      and_pos_list.push_back(pos);
+      continue;
+    }
+    auto p = mark.emplace(var, false);
+    if ( !p.second ) {
+      continue;
+    }
+    switch ( var_map.kind(var) ) {
+    case VarMap::CONST:
+      p.first->second = true;
+      break;
+    case VarMap::INPUT:
+      p.first->second = true;
+      input_pos_list.push_back(pos);
+      break;
+    case VarMap::LATCH:
+      // 順序回路の影響範囲として次状態関数もたどる．
+      p.first->second = true;
+      latch_pos_list.push_back(pos);
+      latch_queue.push_back(pos);
+      break;
+    case VarMap::AND:
+      stack.push_back({var, true});
+      push(src.and_src1(pos));
+      push(src.and_src2(pos));
+      break;
+    case VarMap::NONE:
+      {
+	ostringstream buf;
+	buf << "extract_cone: " << (var * 2) << " is not defined.";
+	throw std::invalid_argument{buf.str()};
+      }
+    }
+  }
+
+  // 入力とラッチは元の順番を保つ．
+  std::sort(input_pos_list.begin(), input_pos_list.end());
+  std::sort(latch_pos_list.begin(), latch_pos_list.end());
+
+  renumber(src, input_pos_list, latch_pos_list, output_list, and_pos_list);
+}
+
+END_NAMESPACE_YM_AIG
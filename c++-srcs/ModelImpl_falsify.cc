@@ -0,0 +1,134 @@
+
+/// @file ModelImpl_falsify.cc
+/// @brief ModelImpl::falsify() の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ModelImpl.h"
+#include "ym/AigCex.h"
+#include "ym/AigFalsifyOpt.h"
+#include "BitSim.h"
+#include "WorkPool.h"
+#include <atomic>
+#include <memory>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+// @brief ランダムシミュレーションで出力を 1 にする入力系列を探す．
+AigCex
+ModelImpl::falsify(
+  const AigFalsifyOpt& opt
+) const
+{
+  auto nw = std::max<SizeType>(opt.word_num, 1);
+  auto cycle_num = std::max<SizeType>(opt.cycle_num, 1);
+  auto round_num = opt.round_num;
+  auto I = this->I();
+  auto L = this->L();
+  auto O = this->O();
+
+  // 入力の値の通し番号
+  auto input_index = [&](SizeType r, SizeType c, SizeType i, SizeType w) {
+    return ((r * cycle_num + c) * I + i) * nw + w;
+  };
+
+  // 1ラウンド分のシミュレーションを行う．
+  // 出力が 1 になったら cex に結果を入れて true を返す．
+  auto run_round = [&](SizeType r, BitSim& sim, AigCex* cex) {
+    vector<std::uint64_t> next_state(L * nw);
+    for ( SizeType i = 0; i < L; ++ i ) {
+      auto v = sim.value(latch(i) / 2);
+      std::fill(v, v + nw, 0ULL);
+    }
+    for ( SizeType c = 0; c < cycle_num; ++ c ) {
+      for ( SizeType i = 0; i < I; ++ i ) {
+	auto v = sim.value(input(i) / 2);
+	for ( SizeType w = 0; w < nw; ++ w ) {
+	  v[w] = BitSim::random_word(opt.seed, input_index(r, c, i, w));
+	}
+      }
+      sim.simulate();
+      for ( SizeType w = 0; w < nw; ++ w ) {
+	std::uint64_t acc = 0;
+	for ( SizeType o = 0; o < O; ++ o ) {
+	  acc |= sim.lit_value(output_src(o), w);
+	}
+	if ( acc == 0 ) {
+	  continue;
+	}
+	if ( cex != nullptr ) {
+	  // 最も若いパタンを反例とする．
+	  SizeType b = 0;
+	  while ( ((acc >> b) & 1) == 0 ) {
+	    ++ b;
+	  }
+	  cex->found = true;
+	  cex->cycle = c;
+	  for ( SizeType o = 0; o < O; ++ o ) {
+	    if ( (sim.lit_value(output_src(o), w) >> b) & 1 ) {
+	      cex->output = o;
+	      break;
+	    }
+	  }
+	  cex->input_list.resize(c + 1, vector<bool>(I));
+	  for ( SizeType c1 = 0; c1 <= c; ++ c1 ) {
+	    for ( SizeType i = 0; i < I; ++ i ) {
+	      auto v = BitSim::random_word(opt.seed, input_index(r, c1, i, w));
+	      cex->input_list[c1][i] = (v >> b) & 1;
+	    }
+	  }
+	}
+	return true;
+      }
+      if ( c + 1 < cycle_num ) {
+	for ( SizeType i = 0; i < L; ++ i ) {
+	  for ( SizeType w = 0; w < nw; ++ w ) {
+	    next_state[i * nw + w] = sim.lit_value(latch_src(i), w);
+	  }
+	}
+	for ( SizeType i = 0; i < L; ++ i ) {
+	  auto v = sim.value(latch(i) / 2);
+	  std::copy(&next_state[i * nw], &next_state[(i + 1) * nw], v);
+	}
+      }
+    }
+    return false;
+  };
+
+  // ラウンドごとに独立なのでスレッドごとにシミュレータを持って並列に行う．
+  // 結果がスレッドの割り当てによらないように，反例の見つかった
+  // 最も若いラウンドを探す．
+  WorkPool pool{opt.thread_num};
+  vector<std::unique_ptr<BitSim>> sim_list(pool.thread_num());
+  std::atomic<SizeType> found_round{round_num};
+  pool.run(round_num, [&](SizeType r, SizeType tid) {
+    if ( r >= found_round.load() ) {
+      return;
+    }
+    auto& sim = sim_list[tid];
+    if ( sim == nullptr ) {
+      sim.reset(new BitSim{*this, nw, 1});
+    }
+    if ( run_round(r, *sim, nullptr) ) {
+      auto cur = found_round.load();
+      while ( r < cur && !found_round.compare_exchange_weak(cur, r) ) {
+      }
+    }
+  });
+
+  AigCex cex;
+  auto r = found_round.load();
+  if ( r < round_num ) {
+    auto& sim = sim_list[0];
+    if ( sim == nullptr ) {
+      sim.reset(new BitSim{*this, nw, 1});
+    }
+    run_round(r, *sim, &cex);
+  }
+  return cex;
+}
+
+END_NAMESPACE_YM_AIG
@@ -0,0 +1,243 @@
+
+/// @file ModelImpl_miter.cc
+/// @brief ModelImpl::make_miter() の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ModelImpl.h"
+#include "ym/AigMiterOpt.h"
+#include "StrashTable.h"
+#include "VarMap.h"
+#include <functional>
+#include <unordered_map>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+BEGIN_NONAMESPACE
+
+// シンボル名から番号を引く辞書を作る．
+std::unordered_map<string, SizeType>
+make_name_dict(
+  SizeType n,
+  const std::function<const string&(SizeType)>& get_name,
+  const char* kind
+)
+{
+  std::unordered_map<string, SizeType> dict;
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto& name = get_name(i);
+    if ( name == string{} ) {
+      ostringstream buf;
+      buf << "make_miter: " << kind << "#" << i << " has no symbol.";
+      throw std::invalid_argument{buf.str()};
+    }
+    if ( dict.count(name) > 0 ) {
+      ostringstream buf;
+      buf << "make_miter: " << kind << " symbol '" << name << "' is duplicated.";
+      throw std::invalid_argument{buf.str()};
+    }
+    dict.emplace(name, i);
+  }
+  return dict;
+}
+
+END_NONAMESPACE
+
+// @brief 2つのモデルのマイタを作る．
+void
+ModelImpl::make_miter(
+  const ModelImpl& src1,
+  const ModelImpl& src2,
+  const AigMiterOpt& opt
+)
+{
+  // 入力と出力の対応を求める．
+  if ( src1.I() != src2.I() ) {
+    ostringstream buf;
+    buf << "make_miter: the numbers of inputs differ ("
+	<< src1.I() << " vs " << src2.I() << ").";
+    throw std::invalid_argument{buf.str()};
+  }
+  if ( src1.O() != src2.O() ) {
+    ostringstream buf;
+    buf << "make_miter: the numbers of outputs differ ("
+	<< src1.O() << " vs " << src2.O() << ").";
+    throw std::invalid_argument{buf.str()};
+  }
+  auto I = src1.I();
+  auto O1 = src1.O();
+  // src2 の入力番号から src1 の入力番号への対応表
+  vector<SizeType> input_map(I);
+  // src1 の出力番号から src2 の出力番号への対応表
+  vector<SizeType> output_map(O1);
+  if ( opt.match_by_name ) {
+    auto idict = make_name_dict(I, [&](SizeType i) -> const string& {
+      return src1.input_symbol(i);
+    }, "Input");
+    for ( SizeType i = 0; i < I; ++ i ) {
+      auto& name = src2.input_symbol(i);
+      if ( idict.count(name) == 0 ) {
+	ostringstream buf;
+	buf << "make_miter: Input '" << name << "' is not found.";
+	throw std::invalid_argument{buf.str()};
+      }
+      input_map[i] = idict.at(name);
+    }
+    auto odict = make_name_dict(O1, [&](SizeType i) -> const string& {
+      return src2.output_symbol(i);
+    }, "Output");
+    for ( SizeType i = 0; i < O1; ++ i ) {
+      auto& name = src1.output_symbol(i);
+      if ( odict.count(name) == 0 ) {
+	ostringstream buf;
+	buf << "make_miter: Output '" << name << "' is not found.";
+	throw std::invalid_argument{buf.str()};
+      }
+      output_map[i] = odict.at(name);
+    }
+    // 名前が重複していなければ input_map と output_map は全単射になっている．
+    vector<bool> used(I, false);
+    for ( auto i: input_map ) {
+      if ( used[i] ) {
+	throw std::invalid_argument{"make_miter: src2 has duplicated input symbols."};
+      }
+      used[i] = true;
+    }
+    vector<bool> oused(O1, false);
+    for ( auto i: output_map ) {
+      if ( oused[i] ) {
+	throw std::invalid_argument{"make_miter: src1 has duplicated output symbols."};
+      }
+      oused[i] = true;
+    }
+  }
+  else {
+    for ( SizeType i = 0; i < I; ++ i ) {
+      input_map[i] = i;
+    }
+    for ( SizeType i = 0; i < O1; ++ i ) {
+      output_map[i] = i;
+    }
+  }
+
+  auto L1 = src1.L();
+  auto L2 = src2.L();
+  auto L = L1 + L2;
+
+  // 定数の伝搬と構造的ハッシュを行いながらANDノードを作る．
+  vector<AndInfo> and_list;
+  and_list.reserve(src1.A() + src2.A() + O1 * 3);
+  StrashTable table{src1.A() + src2.A()};
+  auto new_and = [&](SizeType a, SizeType b) -> SizeType {
+    if ( a < b ) {
+      std::swap(a, b);
+    }
+    if ( b == 0 || a == (b ^ 1) ) {
+      return 0;
+    }
+    if ( b == 1 || a == b ) {
+      return a;
+    }
+    auto lit = table.find(a, b);
+    if ( lit == StrashTable::NOT_FOUND ) {
+      lit = (I + L + and_list.size() + 1) * 2;
+      and_list.push_back(AndInfo{lit, a, b});
+      table.add(a, b, lit);
+    }
+    return lit;
+  };
+
+  // src のANDノードをコピーする．
+  auto copy_ands = [&](const ModelImpl& src,
+		       vector<SizeType>& lit_map) {
+    for ( auto pos: src.and_topo_order() ) {
+      auto src1 = lit_map[src.and_src1(pos) / 2] ^ (src.and_src1(pos) % 2);
+      auto src2 = lit_map[src.and_src2(pos) / 2] ^ (src.and_src2(pos) % 2);
+      lit_map[src.and_node(pos) / 2] = new_and(src1, src2);
+    }
+  };
+
+  VarMap var_map1{src1};
+  vector<SizeType> lit_map1(var_map1.var_num(), 0);
+  for ( SizeType i = 0; i < I; ++ i ) {
+    lit_map1[src1.input(i) / 2] = (i + 1) * 2;
+  }
+  for ( SizeType i = 0; i < L1; ++ i ) {
+    lit_map1[src1.latch(i) / 2] = (I + i + 1) * 2;
+  }
+  copy_ands(src1, lit_map1);
+
+  VarMap var_map2{src2};
+  vector<SizeType> lit_map2(var_map2.var_num(), 0);
+  for ( SizeType i = 0; i < I; ++ i ) {
+    lit_map2[src2.input(i) / 2] = (input_map[i] + 1) * 2;
+  }
+  for ( SizeType i = 0; i < L2; ++ i ) {
+    lit_map2[src2.latch(i) / 2] = (I + L1 + i + 1) * 2;
+  }
+  copy_ands(src2, lit_map2);
+
+  auto lit1 = [&](SizeType lit) {
+    return lit_map1[lit / 2] ^ (lit % 2);
+  };
+  auto lit2 = [&](SizeType lit) {
+    return lit_map2[lit / 2] ^ (lit % 2);
+  };
+
+  // 出力対の XOR を作る．
+  vector<SizeType> xor_list(O1);
+  for ( SizeType i = 0; i < O1; ++ i ) {
+    auto a = lit1(src1.output_src(i));
+    auto b = lit2(src2.output_src(output_map[i]));
+    auto t1 = new_and(a, b ^ 1);
+    auto t2 = new_and(a ^ 1, b);
+    xor_list[i] = new_and(t1 ^ 1, t2 ^ 1) ^ 1;
+  }
+
+  auto O = opt.single_output ? 1 : O1;
+  initialize(I, L, O, 0);
+  if ( opt.single_output ) {
+    // 平衡木で OR をとる．
+    while ( xor_list.size() > 1 ) {
+      vector<SizeType> next_list;
+      for ( SizeType i = 0; i + 1 < xor_list.size(); i += 2 ) {
+	next_list.push_back(new_and(xor_list[i] ^ 1, xor_list[i + 1] ^ 1) ^ 1);
+      }
+      if ( xor_list.size() % 2 == 1 ) {
+	next_list.push_back(xor_list.back());
+      }
+      xor_list.swap(next_list);
+    }
+    auto src = xor_list.empty() ? 0 : xor_list[0];
+    mOutputList[0] = OutputInfo{src, "miter"};
+  }
+  else {
+    for ( SizeType i = 0; i < O1; ++ i ) {
+      mOutputList[i] = OutputInfo{xor_list[i], src1.output_symbol(i)};
+    }
+  }
+
+  auto A = and_list.size();
+  mAndList.swap(and_list);
+  mAndArray = mAndList.data();
+  mAndNum = A;
+  for ( SizeType i = 0; i < I; ++ i ) {
+    mInputList[i] = InputInfo{(i + 1) * 2, src1.input_symbol(i)};
+  }
+  for ( SizeType i = 0; i < L1; ++ i ) {
+    mLatchList[i] = LatchInfo{(I + i + 1) * 2,
+			      lit1(src1.latch_src(i)),
+			      src1.latch_symbol(i)};
+  }
+  for ( SizeType i = 0; i < L2; ++ i ) {
+    mLatchList[L1 + i] = LatchInfo{(I + L1 + i + 1) * 2,
+				   lit2(src2.latch_src(i)),
+				   src2.latch_symbol(i)};
+  }
+  mCanonical = true;
+}
+
+END_NAMESPACE_YM_AIG
@@ -0,0 +1,160 @@
+
+/// @file ModelImpl_reorder.cc
+/// @brief ModelImpl::reorder() の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ModelImpl.h"
+#include "VarMap.h"
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+// @brief ANDノードの番号を参照の局所性がよくなるように振り直した内容を設定する．
+void
+ModelImpl::reorder(
+  const ModelImpl& src,
+  bool level_major
+)
+{
+  // まずトポロジカル順を求めておく(ループの検出も兼ねる)．
+  auto topo_list = src.and_topo_order();
+  VarMap var_map{src};
+  auto A = src.A();
+  auto and_pos = [&](SizeType lit) {
+    auto var = lit / 2;
+    if ( var >= var_map.var_num() ) {
+      ostringstream buf;
+      buf << "reorder: " << lit << " is not defined.";
+      throw std::invalid_argument{buf.str()};
+    }
+    if ( var_map.kind(var) == VarMap::AND ) {
+      return var_map.pos(var);
+    }
+    return A;
+  };
+
+  vector<SizeType> order_list;
+  order_list.reserve(A);
+  if ( level_major ) {
+    // レベルを求める．
+    vector<SizeType> level(A, 0);
+    SizeType max_level = 0;
+    for ( auto pos: topo_list ) {
+      SizeType lv = 0;
+      for ( auto lit: {src.and_src1(pos), src.and_src2(pos)} ) {
+	auto ipos = and_pos(lit);
+	if ( ipos < A ) {
+	  lv = std::max(lv, level[ipos]);
+	}
+      }
+      level[pos] = lv + 1;
+      max_level = std::max(max_level, lv + 1);
+    }
+
+    // レベルごとのバケツに分ける(計数ソート)．
+    vector<SizeType> count(max_level + 2, 0);
+    for ( SizeType i = 0; i < A; ++ i ) {
+      ++ count[level[i] + 1];
+    }
+    for ( SizeType lv = 1; lv <= max_level + 1; ++ lv ) {
+      count[lv] += count[lv - 1];
+    }
+    order_list.resize(A);
+    for ( auto pos: topo_list ) {
+      order_list[count[level[pos]] ++] = pos;
+    }
+
+    // 同じレベル内ではファンインの新しい番号の小さい順に並べることで
+    // ファンインを共有するノードを近くに置く．
+    vector<SizeType> new_id(A, 0);
+    SizeType begin = 0;
+    while ( begin < A ) {
+      auto lv = level[order_list[begin]];
+      auto end = begin;
+      while ( end < A && level[order_list[end]] == lv ) {
+	++ end;
+      }
+      auto key = [&](SizeType pos) {
+	SizeType k = static_cast<SizeType>(-1);
+	for ( auto lit: {src.and_src1(pos), src.and_src2(pos)} ) {
+	  auto ipos = and_pos(lit);
+	  // 入力とラッチは先頭に置かれる．
+	  auto id = ipos < A ? new_id[ipos] + 1 : 0;
+	  k = std::min(k, id);
+	}
+	return k;
+      };
+      vector<std::pair<SizeType, SizeType>> tmp_list;
+      tmp_list.reserve(end - begin);
+      for ( auto i = begin; i < end; ++ i ) {
+	tmp_list.push_back({key(order_list[i]), order_list[i]});
+      }
+      std::stable_sort(tmp_list.begin(), tmp_list.end(),
+		       [](const std::pair<SizeType, SizeType>& a,
+			  const std::pair<SizeType, SizeType>& b) {
+			 return a.first < b.first;
+		       });
+      for ( auto i = begin; i < end; ++ i ) {
+	auto pos = tmp_list[i - begin].second;
+	order_list[i] = pos;
+	new_id[pos] = i;
+      }
+      begin = end;
+    }
+  }
+  else {
+    // 出力，ラッチから深さ優先探索を行い帰りがけ順に並べる．
+    vector<bool> mark(A, false);
+    vector<std::pair<SizeType, bool>> stack;
+    auto push = [&](SizeType lit) {
+      auto pos = and_pos(lit);
+      if ( pos < A && !mark[pos] ) {
+	stack.push_back({pos, false});
+      }
+    };
+    auto dfs = [&](SizeType lit) {
+      push(lit);
+      while ( !stack.empty() ) {
+	auto pos = stack.back().first;
+	auto done = stack.back().second;
+	stack.pop_back();
+	if ( done ) {
+	  order_list.push_back(pos);
+	  continue;
+	}
+	if ( mark[pos] ) {
+	  continue;
+	}
+	mark[pos] = true;
+	stack.push_back({pos, true});
+	// リテラルの小さいファンインを先に処理するように後から積む．
+	// 並べ替えた後も先に処理した方が小さいリテラルとなるので，
+	// 結果をもう一度並べ替えても同じ順序になる．
+	auto lit1 = src.and_src1(pos);
+	auto lit2 = src.and_src2(pos);
+	push(std::max(lit1, lit2));
+	push(std::min(lit1, lit2));
+      }
+    };
+    for ( SizeType i = 0; i < src.O(); ++ i ) {
+      dfs(src.output_src(i));
+    }
+    for ( SizeType i = 0; i < src.L(); ++ i ) {
+      dfs(src.latch_src(i));
+    }
+    // どこからも参照されていないノードは最後に置く．
+    for ( auto pos: topo_list ) {
+      if ( !mark[pos] ) {
+	dfs(src.and_node(pos));
+      }
+    }
+  }
+
+  renumber(src, order_list);
+}
+
+END_NAMESPACE_YM_AIG
@@ -0,0 +1,474 @@
+
+/// @file ModelImpl_snapshot.cc
+/// @brief ModelImpl のスナップショット関係の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ModelImpl.h"
+#include "MappedFile.h"
+#include <cstdint>
+#include <cstring>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+BEGIN_NONAMESPACE
+
+// スナップショットファイルのレイアウト
+//
+// - 先頭にヘッダ(SnapHeader)を置く．
+// - 以降の各セクションは 64 バイト境界から始まる．
+//   - 入力: uint64 literal[I]
+//   - ラッチ: uint64 {literal, src}[L]
+//   - 出力: uint64 src[O]
+//   - AND: uint64 {literal, src1, src2}[A]
+//     (ModelImpl::AndInfo と同じレイアウトなのでそのまま参照する)
+//   - シンボル: uint64 offset[I + L + O + 2] の後に文字列本体
+//     (入力，ラッチ，出力のシンボル，コメントの順)
+// - チェックサムはヘッダ以降の全てのバイトに対して計算する．
+// - 数値はホストのバイトオーダーで格納し，mByteOrder で検査する．
+// - mFlags には変数番号が標準形かどうかを記録しておき，
+//   開く時に O(A) の検査をしなくて済むようにする．
+
+// マジックナンバー
+const char SNAP_MAGIC[8] = { 'Y', 'M', 'A', 'I', 'G', 'S', 'N', 'P' };
+
+// バージョン番号
+const std::uint32_t SNAP_VERSION = 1;
+
+// バイトオーダーの検査用の値
+const std::uint32_t SNAP_BYTE_ORDER = 0x01020304;
+
+// セクションのアラインメント
+const SizeType SNAP_ALIGN = 64;
+
+// mFlags のビット: 変数番号が標準形
+const std::uint64_t SNAP_CANONICAL = 1;
+
+// ヘッダ
+struct SnapHeader
+{
+  char mMagic[8];
+  std::uint32_t mVersion;
+  std::uint32_t mByteOrder;
+  std::uint64_t mI;
+  std::uint64_t mL;
+  std::uint64_t mO;
+  std::uint64_t mA;
+  std::uint64_t mInputOffset;
+  std::uint64_t mLatchOffset;
+  std::uint64_t mOutputOffset;
+  std::uint64_t mAndOffset;
+  std::uint64_t mSymbolOffset;
+  std::uint64_t mSymbolSize;
+  std::uint64_t mFileSize;
+  std::uint64_t mChecksum;
+  std::uint64_t mFlags;
+  std::uint64_t mReserved[1];
+};
+
+static_assert( sizeof(SnapHeader) % SNAP_ALIGN == 0,
+	       "SnapHeader must be a multiple of SNAP_ALIGN" );
+
+// 64ビット単位のチェックサムを計算するクラス
+//
+// 入力を任意の位置で区切って update() しても結果は変わらない．
+class Checksum
+{
+public:
+
+  // データを加える．
+  void
+  update(
+    const char* data,
+    SizeType size
+  )
+  {
+    mTotal += size;
+    // 前回の端数を埋める．
+    while ( mRest > 0 && mRest < 8 && size > 0 ) {
+      mTail[mRest] = *data;
+      ++ mRest;
+      ++ data;
+      -- size;
+    }
+    if ( mRest == 8 ) {
+      add_word(mTail);
+      mRest = 0;
+    }
+    for ( ; size >= 8; data += 8, size -= 8 ) {
+      add_word(data);
+    }
+    for ( ; size > 0; ++ data, -- size ) {
+      mTail[mRest] = *data;
+      ++ mRest;
+    }
+  }
+
+  // 値を返す．
+  std::uint64_t
+  value() const
+  {
+    auto h = mHash;
+    if ( mRest > 0 ) {
+      char tmp[8] = { 0 };
+      memcpy(tmp, mTail, mRest);
+      std::uint64_t w;
+      memcpy(&w, tmp, 8);
+      h = (h ^ w) * PRIME;
+    }
+    h ^= mTotal;
+    h ^= h >> 29;
+    return h;
+  }
+
+private:
+
+  // 1ワード分を加える．
+  void
+  add_word(
+    const char* p
+  )
+  {
+    std::uint64_t w;
+    memcpy(&w, p, 8);
+    mHash = (mHash ^ w) * PRIME;
+  }
+
+  static const std::uint64_t PRIME = 0x9E3779B97F4A7C15ULL;
+
+  std::uint64_t mHash{0xCBF29CE484222325ULL};
+  std::uint64_t mTotal{0};
+  char mTail[8];
+  SizeType mRest{0};
+
+};
+
+// 書き込みとチェックサムの計算を同時に行うクラス
+class SnapWriter
+{
+public:
+
+  // コンストラクタ
+  explicit
+  SnapWriter(
+    ostream& s
+  ) : mS{s}
+  {
+  }
+
+  // データを書き込む．
+  void
+  write(
+    const void* data,
+    SizeType size
+  )
+  {
+    auto p = static_cast<const char*>(data);
+    mS.write(p, size);
+    mChecksum.update(p, size);
+    mPos += size;
+  }
+
+  // SNAP_ALIGN の境界まで 0 を書き込む．
+  void
+  align()
+  {
+    static const char zeros[SNAP_ALIGN] = { 0 };
+    auto rest = mPos % SNAP_ALIGN;
+    if ( rest > 0 ) {
+      write(zeros, SNAP_ALIGN - rest);
+    }
+  }
+
+  // 現在の位置
+  SizeType
+  pos() const
+  {
+    return mPos;
+  }
+
+  // チェックサム
+  std::uint64_t
+  checksum() const
+  {
+    return mChecksum.value();
+  }
+
+private:
+
+  ostream& mS;
+  Checksum mChecksum;
+  SizeType mPos{sizeof(SnapHeader)};
+
+};
+
+// 不正なスナップショットのエラーを送出する．
+void
+bad_snapshot(
+  const string& filename,
+  const char* reason
+)
+{
+  ostringstream buf;
+  buf << filename << ": Illegal snapshot file, " << reason << ".";
+  throw std::invalid_argument{buf.str()};
+}
+
+END_NONAMESPACE
+
+// @brief スナップショットを書き出す．
+void
+ModelImpl::write_snapshot(
+  const string& filename
+) const
+{
+  static_assert( sizeof(SizeType) == sizeof(std::uint64_t),
+		 "SizeType must be 64 bits" );
+  static_assert( sizeof(AndInfo) == sizeof(std::uint64_t) * 3,
+		 "AndInfo must consist of three 64 bit words" );
+
+  ofstream s{filename, std::ios::binary};
+  if ( !s ) {
+    ostringstream buf;
+    buf << "ModelImpl::write_snapshot: Could not create file " << filename;
+    throw std::invalid_argument{buf.str()};
+  }
+
+  SnapHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.mMagic, SNAP_MAGIC, sizeof(SNAP_MAGIC));
+  header.mVersion = SNAP_VERSION;
+  header.mByteOrder = SNAP_BYTE_ORDER;
+  header.mI = I();
+  header.mL = L();
+  header.mO = O();
+  header.mA = A();
+  header.mFlags = mCanonical ? SNAP_CANONICAL : 0;
+
+  // ヘッダは最後に書き直す．
+  s.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  SnapWriter writer{s};
+
+  header.mInputOffset = writer.pos();
+  {
+    vector<std::uint64_t> buf;
+    buf.reserve(I());
+    for ( auto& info: mInputList ) {
+      buf.push_back(info.mLiteral);
+    }
+    writer.write(buf.data(), buf.size() * sizeof(std::uint64_t));
+  }
+  writer.align();
+
+  header.mLatchOffset = writer.pos();
+  {
+    vector<std::uint64_t> buf;
+    buf.reserve(L() * 2);
+    for ( auto& info: mLatchList ) {
+      buf.push_back(info.mLiteral);
+      buf.push_back(info.mSrc);
+    }
+    writer.write(buf.data(), buf.size() * sizeof(std::uint64_t));
+  }
+  writer.align();
+
+  header.mOutputOffset = writer.pos();
+  {
+    vector<std::uint64_t> buf;
+    buf.reserve(O());
+    for ( auto& info: mOutputList ) {
+      buf.push_back(info.mSrc);
+    }
+    writer.write(buf.data(), buf.size() * sizeof(std::uint64_t));
+  }
+  writer.align();
+
+  header.mAndOffset = writer.pos();
+  if ( mPacked != nullptr ) {
+    // 圧縮表現の場合はブロックごとに展開して書き出す．
+    const SizeType BLOCK_SIZE = 4096;
+    vector<AndInfo> buf;
+    buf.reserve(BLOCK_SIZE);
+    auto cursor = mPacked->begin();
+    for ( SizeType i = 0; i < A(); ++ i ) {
+      mPacked->decode(cursor);
+      buf.push_back(AndInfo{cursor.mLit, cursor.mSrc1, cursor.mSrc2});
+      if ( buf.size() == BLOCK_SIZE ) {
+	writer.write(buf.data(), buf.size() * sizeof(AndInfo));
+	buf.clear();
+      }
+    }
+    writer.write(buf.data(), buf.size() * sizeof(AndInfo));
+  }
+  else {
+    writer.write(mAndArray, A() * sizeof(AndInfo));
+  }
+  writer.align();
+
+  header.mSymbolOffset = writer.pos();
+  {
+    vector<const string*> str_list;
+    str_list.reserve(I() + L() + O() + 1);
+    for ( auto& info: mInputList ) {
+      str_list.push_back(&info.mSymbol);
+    }
+    for ( auto& info: mLatchList ) {
+      str_list.push_back(&info.mSymbol);
+    }
+    for ( auto& info: mOutputList ) {
+      str_list.push_back(&info.mSymbol);
+    }
+    str_list.push_back(&mComment);
+    vector<std::uint64_t> offset_list;
+    offset_list.reserve(str_list.size() + 1);
+    std::uint64_t offset = 0;
+    for ( auto str: str_list ) {
+      offset_list.push_back(offset);
+      offset += str->size();
+    }
+    offset_list.push_back(offset);
+    writer.write(offset_list.data(), offset_list.size() * sizeof(std::uint64_t));
+    for ( auto str: str_list ) {
+      writer.write(str->data(), str->size());
+    }
+  }
+  header.mSymbolSize = writer.pos() - header.mSymbolOffset;
+  writer.align();
+
+  header.mFileSize = writer.pos();
+  header.mChecksum = writer.checksum();
+  s.seekp(0);
+  s.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  if ( !s ) {
+    ostringstream buf;
+    buf << "ModelImpl::write_snapshot: Write error on " << filename;
+    throw std::invalid_argument{buf.str()};
+  }
+}
+
+// @brief スナップショットを開く．
+void
+ModelImpl::open_snapshot(
+  const string& filename,
+  bool verify
+)
+{
+  auto mapping = std::make_shared<MappedFile>(filename);
+  auto base = mapping->data();
+  auto size = mapping->size();
+
+  SnapHeader header;
+  if ( size < sizeof(header) ) {
+    bad_snapshot(filename, "too short");
+  }
+  memcpy(&header, base, sizeof(header));
+  if ( memcmp(header.mMagic, SNAP_MAGIC, sizeof(SNAP_MAGIC)) != 0 ) {
+    bad_snapshot(filename, "wrong signature");
+  }
+  if ( header.mVersion != SNAP_VERSION ) {
+    bad_snapshot(filename, "unsupported version");
+  }
+  if ( header.mByteOrder != SNAP_BYTE_ORDER ) {
+    bad_snapshot(filename, "byte order mismatch");
+  }
+  if ( header.mFileSize != size ) {
+    bad_snapshot(filename, "size mismatch");
+  }
+
+  // 各セクションの範囲を検査する．
+  auto check_section = [&](std::uint64_t offset,
+			   std::uint64_t num,
+			   std::uint64_t unit) {
+    if ( offset % SNAP_ALIGN != 0 || offset > size ||
+	 num > (size - offset) / unit ) {
+      bad_snapshot(filename, "broken section");
+    }
+  };
+  auto w = sizeof(std::uint64_t);
+  check_section(header.mInputOffset, header.mI, w);
+  check_section(header.mLatchOffset, header.mL, w * 2);
+  check_section(header.mOutputOffset, header.mO, w);
+  check_section(header.mAndOffset, header.mA, sizeof(AndInfo));
+  auto str_num = header.mI + header.mL + header.mO + 1;
+  check_section(header.mSymbolOffset, str_num + 1, w);
+  // シンボルセクションはオフセットの表を含んでいなければならない．
+  if ( header.mSymbolSize > size - header.mSymbolOffset ||
+       header.mSymbolSize < (str_num + 1) * w ) {
+    bad_snapshot(filename, "broken section");
+  }
+
+  if ( verify ) {
+    Checksum checksum;
+    checksum.update(base + sizeof(header), size - sizeof(header));
+    if ( checksum.value() != header.mChecksum ) {
+      bad_snapshot(filename, "checksum mismatch");
+    }
+  }
+
+  initialize(header.mI, header.mL, header.mO, 0);
+
+  auto word = [&](std::uint64_t offset,
+		  SizeType pos) {
+    std::uint64_t val;
+    memcpy(&val, base + offset + pos * sizeof(std::uint64_t), sizeof(val));
+    return val;
+  };
+  for ( SizeType i = 0; i < I(); ++ i ) {
+    mInputList[i].mLiteral = word(header.mInputOffset, i);
+  }
+  for ( SizeType i = 0; i < L(); ++ i ) {
+    mLatchList[i].mLiteral = word(header.mLatchOffset, i * 2 + 0);
+    mLatchList[i].mSrc = word(header.mLatchOffset, i * 2 + 1);
+  }
+  for ( SizeType i = 0; i < O(); ++ i ) {
+    mOutputList[i].mSrc = word(header.mOutputOffset, i);
+  }
+
+  // シンボルとコメント
+  auto str_base = header.mSymbolOffset + (str_num + 1) * w;
+  auto str_size = header.mSymbolSize - (str_num + 1) * w;
+  auto get_str = [&](SizeType k) {
+    auto begin = word(header.mSymbolOffset, k);
+    auto end = word(header.mSymbolOffset, k + 1);
+    if ( begin > end || end > str_size ) {
+      bad_snapshot(filename, "broken symbol table");
+    }
+    return string{base + str_base + begin, end - begin};
+  };
+  SizeType k = 0;
+  for ( auto& info: mInputList ) {
+    info.mSymbol = get_str(k);
+    ++ k;
+  }
+  for ( auto& info: mLatchList ) {
+    info.mSymbol = get_str(k);
+    ++ k;
+  }
+  for ( auto& info: mOutputList ) {
+    info.mSymbol = get_str(k);
+    ++ k;
+  }
+  mComment = get_str(k);
+
+  // ANDノードはマッピングした領域をそのまま用いる．
+  mAndArray = reinterpret_cast<const AndInfo*>(base + header.mAndOffset);
+  mAndNum = header.mA;
+  mMapping = mapping;
+
+  // 標準形かどうかはヘッダの記録を用いる．
+  // verify が true の時は記録が正しいかも調べる．
+  bool canonical = (header.mFlags & SNAP_CANONICAL) != 0;
+  if ( verify ) {
+    check_canonical();
+    if ( mCanonical != canonical ) {
+      bad_snapshot(filename, "inconsistent canonical flag");
+    }
+  }
+  mCanonical = canonical;
+}
+
+END_NAMESPACE_YM_AIG
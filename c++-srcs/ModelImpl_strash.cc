@@ -0,0 +1,62 @@
+
+/// @file ModelImpl_strash.cc
+/// @brief ModelImpl::strash() の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ModelImpl.h"
+#include "StrashTable.h"
+#include "VarMap.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+// @brief 構造的に同じANDノードを併合した内容を設定する．
+SizeType
+ModelImpl::strash(
+  const ModelImpl& src
+)
+{
+  auto topo_list = src.and_topo_order();
+  VarMap var_map{src};
+
+  // 変数番号をキーにした代表リテラル(元の番号)
+  // 併合されたANDノードは残った方のリテラルとなる．
+  vector<SizeType> repr(var_map.var_num(), 0);
+  auto repr_lit = [&](SizeType lit) {
+    return repr[lit / 2] ^ (lit % 2);
+  };
+  for ( SizeType i = 0; i < src.I(); ++ i ) {
+    repr[src.input(i) / 2] = src.input(i);
+  }
+  for ( SizeType i = 0; i < src.L(); ++ i ) {
+    repr[src.latch(i) / 2] = src.latch(i);
+  }
+
+  // トポロジカル順に処理すればファンインは併合済みとなっている．
+  vector<SizeType> order_list;
+  order_list.reserve(src.A());
+  StrashTable table{src.A()};
+  for ( auto pos: topo_list ) {
+    auto src1 = repr_lit(src.and_src1(pos));
+    auto src2 = repr_lit(src.and_src2(pos));
+    if ( src1 < src2 ) {
+      std::swap(src1, src2);
+    }
+    auto lit = table.find(src1, src2);
+    if ( lit == StrashTable::NOT_FOUND ) {
+      lit = src.and_node(pos);
+      order_list.push_back(pos);
+      table.add(src1, src2, lit);
+    }
+    repr[src.and_node(pos) / 2] = lit;
+  }
+
+  renumber(src, order_list, repr);
+
+  return src.A() - A();
+}
+
+END_NAMESPACE_YM_AIG
@@ -0,0 +1,97 @@
+
+/// @file ModelImpl_unroll.cc
+/// @brief ModelImpl::make_unrolled() の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ModelImpl.h"
+#include "ym/AigUnroller.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+BEGIN_NONAMESPACE
+
+// 名前に時刻を表す接尾辞を付ける．
+string
+frame_name(
+  const string& name,
+  const string& suffix
+)
+{
+  if ( name == string{} ) {
+    return string{};
+  }
+  return name + "@" + suffix;
+}
+
+END_NONAMESPACE
+
+// @brief 時間展開した組み合わせ回路を作る．
+void
+ModelImpl::make_unrolled(
+  const AigUnroller& unroller
+)
+{
+  auto& src = *unroller.mSrc;
+  auto& node_list = unroller.mNodeList;
+  auto I = unroller.mInputNum;
+  auto O = unroller.mOutputLitList.size();
+  auto A = node_list.size() - I - 1;
+
+  // ノードは作られた順にトポロジカル順になっているので，
+  // 入力とANDノードに分けて順に番号を振れば標準形となる．
+  vector<SizeType> lit_map(node_list.size(), 0);
+  vector<AndInfo> and_list;
+  and_list.reserve(A);
+  SizeType input_id = 0;
+  for ( SizeType var = 1; var < node_list.size(); ++ var ) {
+    auto& node = node_list[var];
+    if ( node.mSrc1 == AigUnroller::INPUT_MARK ) {
+      ++ input_id;
+      lit_map[var] = input_id * 2;
+    }
+    else {
+      auto lit = (I + and_list.size() + 1) * 2;
+      lit_map[var] = lit;
+      auto src1 = lit_map[node.mSrc1 / 2] ^ (node.mSrc1 % 2);
+      auto src2 = lit_map[node.mSrc2 / 2] ^ (node.mSrc2 % 2);
+      if ( src1 < src2 ) {
+	std::swap(src1, src2);
+      }
+      and_list.push_back(AndInfo{lit, src1, src2});
+    }
+  }
+
+  initialize(I, 0, O, 0);
+  auto init_num = unroller.mInitNum;
+  for ( SizeType i = 0; i < init_num; ++ i ) {
+    mInputList[i] = InputInfo{(i + 1) * 2,
+			      frame_name(src.latch_symbol(i), "init")};
+  }
+  auto SI = src.I();
+  auto SO = src.O();
+  for ( SizeType f = 0; f < unroller.mFrameNum; ++ f ) {
+    auto suffix = std::to_string(f);
+    for ( SizeType i = 0; i < SI; ++ i ) {
+      auto pos = init_num + f * SI + i;
+      mInputList[pos] = InputInfo{(pos + 1) * 2,
+				  frame_name(src.input_symbol(i), suffix)};
+    }
+    for ( SizeType i = 0; i < SO; ++ i ) {
+      auto pos = f * SO + i;
+      auto lit = unroller.mOutputLitList[pos];
+      mOutputList[pos] = OutputInfo{lit_map[lit / 2] ^ (lit % 2),
+				    frame_name(src.output_symbol(i), suffix)};
+    }
+  }
+
+  mAndList.swap(and_list);
+  mAndArray = mAndList.data();
+  mAndNum = A;
+  mCanonical = true;
+}
+
+END_NAMESPACE_YM_AIG
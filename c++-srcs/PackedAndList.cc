@@ -0,0 +1,225 @@
+
+/// @file PackedAndList.cc
+/// @brief PackedAndList の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "PackedAndList.h"
+#include <atomic>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+BEGIN_NONAMESPACE
+
+// 識別番号の生成用のカウンタ
+std::atomic<std::uint64_t> id_counter{1};
+
+// 可変長整数を読み出す．
+inline
+SizeType
+get_number(
+  const std::uint8_t* data,
+  SizeType& offset
+)
+{
+  SizeType num = 0;
+  for ( SizeType shift = 0; ; shift += 7 ) {
+    SizeType c = data[offset];
+    ++ offset;
+    num |= (c & 127) << shift;
+    if ( (c & 128) == 0 ) {
+      break;
+    }
+  }
+  return num;
+}
+
+// zigzag 符号化された差分を元に戻して base に加える．
+inline
+SizeType
+add_signed(
+  SizeType base,
+  SizeType zz
+)
+{
+  if ( zz & 1 ) {
+    return base - ((zz >> 1) + 1);
+  }
+  return base + (zz >> 1);
+}
+
+// zigzag 符号化された差分を元に戻して base から引く．
+inline
+SizeType
+sub_signed(
+  SizeType base,
+  SizeType zz
+)
+{
+  if ( zz & 1 ) {
+    return base + ((zz >> 1) + 1);
+  }
+  return base - (zz >> 1);
+}
+
+END_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// クラス PackedAndList
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+PackedAndList::PackedAndList(
+  SizeType interval,
+  SizeType base_lit,
+  bool canonical
+) : mId{id_counter ++},
+    mInterval{interval},
+    mBaseLit{base_lit},
+    mCanonical{canonical},
+    mLastLit{base_lit - 2}
+{
+  ASSERT_COND( mInterval > 0 );
+}
+
+// @brief ANDノードを追加する．
+void
+PackedAndList::add(
+  SizeType lit,
+  SizeType src1,
+  SizeType src2
+)
+{
+  if ( mNum % mInterval == 0 ) {
+    mCheckPointList.push_back(CheckPoint{mData.size(), mLastLit});
+  }
+  if ( mCanonical ) {
+    ASSERT_COND( lit == mBaseLit + mNum * 2 );
+    ASSERT_COND( lit > src1 && src1 >= src2 );
+    put_number(lit - src1);
+    put_number(src1 - src2);
+  }
+  else {
+    put_signed(lit, mLastLit + 2);
+    put_signed(lit, src1);
+    put_signed(src1, src2);
+  }
+  mLastLit = lit;
+  ++ mNum;
+}
+
+// @brief 構築を終える．
+void
+PackedAndList::finish()
+{
+  mData.shrink_to_fit();
+  mCheckPointList.shrink_to_fit();
+}
+
+// @brief 使用しているメモリ量(バイト)を返す．
+SizeType
+PackedAndList::memory_size() const
+{
+  return sizeof(*this) + mData.capacity()
+    + mCheckPointList.capacity() * sizeof(CheckPoint);
+}
+
+// @brief 先頭のカーソルを返す．
+PackedAndList::Cursor
+PackedAndList::begin() const
+{
+  Cursor cursor;
+  cursor.mLit = mBaseLit - 2;
+  return cursor;
+}
+
+// @brief カーソルの次のノードを復号する．
+void
+PackedAndList::decode(
+  Cursor& cursor
+) const
+{
+  ASSERT_COND( cursor.mNext < mNum );
+  auto data = mData.data();
+  if ( mCanonical ) {
+    auto d0 = get_number(data, cursor.mOffset);
+    auto d1 = get_number(data, cursor.mOffset);
+    cursor.mLit = mBaseLit + cursor.mNext * 2;
+    cursor.mSrc1 = cursor.mLit - d0;
+    cursor.mSrc2 = cursor.mSrc1 - d1;
+  }
+  else {
+    auto z0 = get_number(data, cursor.mOffset);
+    auto z1 = get_number(data, cursor.mOffset);
+    auto z2 = get_number(data, cursor.mOffset);
+    // 差分は lit - (prev + 2), lit - src1, src1 - src2 の順
+    cursor.mLit = add_signed(cursor.mLit + 2, z0);
+    cursor.mSrc1 = sub_signed(cursor.mLit, z1);
+    cursor.mSrc2 = sub_signed(cursor.mSrc1, z2);
+  }
+  ++ cursor.mNext;
+}
+
+// @brief pos 番目のノードを復号したカーソルを返す．
+const PackedAndList::Cursor&
+PackedAndList::get(
+  SizeType pos
+) const
+{
+  ASSERT_COND( pos < mNum );
+
+  // スレッドごとの直前の位置
+  thread_local std::uint64_t cache_id = 0;
+  thread_local Cursor cache;
+
+  if ( cache_id == mId && cache.mNext == pos + 1 ) {
+    return cache;
+  }
+  if ( cache_id != mId || cache.mNext > pos ||
+       pos - cache.mNext >= mInterval ) {
+    // チェックポイントから復号し直す．
+    auto& cp = mCheckPointList[pos / mInterval];
+    cache_id = mId;
+    cache.mNext = (pos / mInterval) * mInterval;
+    cache.mOffset = cp.mOffset;
+    cache.mLit = cp.mPrevLit;
+  }
+  while ( cache.mNext <= pos ) {
+    decode(cache);
+  }
+  return cache;
+}
+
+// @brief 符号なし整数を書き込む．
+void
+PackedAndList::put_number(
+  SizeType num
+)
+{
+  while ( num & ~127UL ) {
+    mData.push_back((num & 127) | 128);
+    num >>= 7;
+  }
+  mData.push_back(num);
+}
+
+// @brief 符号付き整数を書き込む．
+void
+PackedAndList::put_signed(
+  SizeType a,
+  SizeType b
+)
+{
+  // a - b を zigzag 符号化する．
+  if ( a >= b ) {
+    put_number((a - b) << 1);
+  }
+  else {
+    put_number(((b - a - 1) << 1) | 1);
+  }
+}
+
+END_NAMESPACE_YM_AIG
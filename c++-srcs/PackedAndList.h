@@ -0,0 +1,178 @@
+#ifndef PACKEDANDLIST_H
+#define PACKEDANDLIST_H
+
+/// @file PackedAndList.h
+/// @brief PackedAndList のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+#include <cstdint>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+/// @class PackedAndList PackedAndList.h "PackedAndList.h"
+/// @brief ANDノードのリストを可変長整数で符号化して保持するクラス
+///
+/// 符号化は2通りある．
+/// - 標準形: ANDノードのリテラルが base_lit から2ずつ増えていき，
+///   lit > src1 >= src2 を満たす場合．バイナリ AIG 形式と同じく
+///   lit - src1 と src1 - src2 のみを符号化する．
+/// - 一般形: それ以外の場合．直前のリテラルとの差，lit - src1，
+///   src1 - src2 を符号付き(zigzag)で符号化する．
+///
+/// interval 個おきにチェックポイント(バイト位置)を記録しておき，
+/// 任意の位置のノードを高々 interval 個の復号で得る．
+/// 一度構築したら内容は変更しない．
+//////////////////////////////////////////////////////////////////////
+class PackedAndList
+{
+public:
+
+  /// @brief 復号位置を表す構造体
+  struct Cursor
+  {
+    SizeType mNext{0};   ///< 次に復号するノード番号
+    SizeType mOffset{0}; ///< 次に復号するノードのバイト位置
+    SizeType mLit{0};    ///< 直前に復号したノードのリテラル
+    SizeType mSrc1{0};   ///< 直前に復号したノードのソース1
+    SizeType mSrc2{0};   ///< 直前に復号したノードのソース2
+  };
+
+  /// @brief コンストラクタ
+  PackedAndList(
+    SizeType interval, ///< [in] チェックポイントの間隔
+    SizeType base_lit, ///< [in] 最初のANDノードのリテラル(標準形の場合)
+    bool canonical     ///< [in] 標準形の時 true
+  );
+
+  /// @brief デストラクタ
+  ~PackedAndList() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 構築用の関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ANDノードを追加する．
+  void
+  add(
+    SizeType lit,  ///< [in] リテラル
+    SizeType src1, ///< [in] ソース1
+    SizeType src2  ///< [in] ソース2
+  );
+
+  /// @brief 構築を終える．
+  ///
+  /// 余分な領域を解放する．
+  void
+  finish();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 復号用の関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ノード数を返す．
+  SizeType
+  size() const
+  {
+    return mNum;
+  }
+
+  /// @brief 使用しているメモリ量(バイト)を返す．
+  SizeType
+  memory_size() const;
+
+  /// @brief 先頭のカーソルを返す．
+  Cursor
+  begin() const;
+
+  /// @brief カーソルの次のノードを復号する．
+  void
+  decode(
+    Cursor& cursor ///< [inout] カーソル
+  ) const;
+
+  /// @brief pos 番目のノードを復号したカーソルを返す．
+  ///
+  /// スレッドごとに直前の位置を覚えておき，前方への短い移動は
+  /// その位置から復号を続ける．
+  const Cursor&
+  get(
+    SizeType pos ///< [in] ノード番号 ( 0 <= pos < size() )
+  ) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 符号なし整数を書き込む．
+  void
+  put_number(
+    SizeType num
+  );
+
+  /// @brief 符号付き整数を書き込む．
+  void
+  put_signed(
+    SizeType a, ///< [in] 被減数
+    SizeType b  ///< [in] 減数
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // チェックポイント
+  struct CheckPoint
+  {
+    SizeType mOffset;  // バイト位置
+    SizeType mPrevLit; // 直前のノードのリテラル
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 識別番号(スレッドごとのキャッシュの検証用)
+  std::uint64_t mId;
+
+  // チェックポイントの間隔
+  SizeType mInterval;
+
+  // 最初のANDノードのリテラル
+  SizeType mBaseLit;
+
+  // 標準形の時 true
+  bool mCanonical;
+
+  // ノード数
+  SizeType mNum{0};
+
+  // 直前に追加したノードのリテラル
+  SizeType mLastLit;
+
+  // 符号化されたデータ
+  vector<std::uint8_t> mData;
+
+  // チェックポイントのリスト
+  vector<CheckPoint> mCheckPointList;
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // PACKEDANDLIST_H
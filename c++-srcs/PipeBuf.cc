@@ -0,0 +1,95 @@
+
+/// @file PipeBuf.cc
+/// @brief PipeBuf の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "PipeBuf.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+// クラス PipeBuf
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+PipeBuf::PipeBuf(
+  std::unique_ptr<InputSource>&& src,
+  SizeType chunk_size,
+  SizeType chunk_num
+) : mSrc{std::move(src)}
+{
+  if ( mSrc->is_compressed() ) {
+    auto src_ptr = mSrc.get();
+    mRing.reset(new ChunkRing{chunk_size, chunk_num,
+			      [src_ptr](char* buff, SizeType size) {
+				return src_ptr->read(buff, size);
+			      }});
+  }
+  else if ( !mSrc->has_chunk() ) {
+    mBuff.resize(chunk_size);
+  }
+}
+
+// @brief デストラクタ
+PipeBuf::~PipeBuf()
+{
+  // mSrc よりも先にスレッドを止める必要がある．
+  mRing = nullptr;
+}
+
+// @brief 入力元でエラーが起きていたらその例外を再送出する．
+void
+PipeBuf::check_error()
+{
+  if ( mError ) {
+    std::rethrow_exception(mError);
+  }
+}
+
+// @brief バッファが空になった時に呼ばれる関数
+PipeBuf::int_type
+PipeBuf::underflow()
+{
+  if ( gptr() < egptr() ) {
+    return traits_type::to_int_type(*gptr());
+  }
+
+  // 例外はそのまま istream 側に伝わるが，
+  // istream は badbit を立てるだけなので記録しておく．
+  char* p = nullptr;
+  SizeType size = 0;
+  try {
+    if ( mRing != nullptr ) {
+      auto chunk = mRing->next();
+      // ChunkRing が保持しているバッファなので書き換えない．
+      p = const_cast<char*>(chunk.first);
+      size = chunk.second;
+    }
+    else if ( mBuff.empty() ) {
+      auto chunk = mSrc->next_chunk();
+      // 入力元が保持しているバッファなので書き換えない．
+      p = const_cast<char*>(chunk.first);
+      size = chunk.second;
+    }
+    else {
+      p = mBuff.data();
+      size = mSrc->read(p, mBuff.size());
+    }
+  }
+  catch ( ... ) {
+    mError = std::current_exception();
+    throw;
+  }
+  if ( size == 0 ) {
+    setg(nullptr, nullptr, nullptr);
+    return traits_type::eof();
+  }
+  setg(p, p, p + size);
+  return traits_type::to_int_type(*p);
+}
+
+END_NAMESPACE_YM_AIG
@@ -0,0 +1,88 @@
+#ifndef PIPEBUF_H
+#define PIPEBUF_H
+
+/// @file PipeBuf.h
+/// @brief PipeBuf のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+#include "InputSource.h"
+#include "ChunkRing.h"
+#include <exception>
+#include <streambuf>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+/// @class PipeBuf PipeBuf.h "PipeBuf.h"
+/// @brief InputSource から読み出す streambuf
+///
+/// InputSource が圧縮データを伸長する場合には ChunkRing を用いて
+/// 専用のスレッドで伸長を行う．これにより伸長とパーズが並行に行われる．
+/// 非圧縮の場合にはスレッドを用いずに直接大きなバッファに読み込む．
+/// 入力元が内部のバッファを直接参照させる場合(AsyncSource)は
+/// コピーせずにそのバッファから読み出す．
+//////////////////////////////////////////////////////////////////////
+class PipeBuf :
+  public std::streambuf
+{
+public:
+
+  /// @brief コンストラクタ
+  explicit
+  PipeBuf(
+    std::unique_ptr<InputSource>&& src,     ///< [in] 入力元
+    SizeType chunk_size = 1024 * 1024,      ///< [in] チャンクのサイズ
+    SizeType chunk_num = 4                  ///< [in] チャンク数
+  );
+
+  /// @brief デストラクタ
+  ~PipeBuf();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 入力元でエラーが起きていたらその例外を再送出する．
+  void
+  check_error();
+
+
+protected:
+  //////////////////////////////////////////////////////////////////////
+  // std::streambuf の仮想関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief バッファが空になった時に呼ばれる関数
+  int_type
+  underflow() override;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 入力元
+  std::unique_ptr<InputSource> mSrc;
+
+  // 非圧縮でバッファを直接参照できない場合に用いるバッファ
+  vector<char> mBuff;
+
+  // 圧縮データの場合に用いるリングバッファ
+  std::unique_ptr<ChunkRing> mRing;
+
+  // 入力元で起きたエラー
+  std::exception_ptr mError;
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // PIPEBUF_H
@@ -0,0 +1,89 @@
+
+/// @file StrashTable.cc
+/// @brief StrashTable の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "StrashTable.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+// クラス StrashTable
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+StrashTable::StrashTable(
+  SizeType size_hint
+)
+{
+  // 使用率が 1/2 以下になるようにする．
+  SizeType size = 1024;
+  while ( size < size_hint * 2 ) {
+    size <<= 1;
+  }
+  expand(size);
+}
+
+// @brief 探す．
+SizeType
+StrashTable::find(
+  SizeType src1,
+  SizeType src2
+) const
+{
+  for ( auto pos = hash(src1, src2); ; pos = (pos + 1) & mMask ) {
+    auto& cell = mTable[pos];
+    if ( cell.mLit == NOT_FOUND ) {
+      return NOT_FOUND;
+    }
+    if ( cell.mSrc1 == src1 && cell.mSrc2 == src2 ) {
+      return cell.mLit;
+    }
+  }
+}
+
+// @brief 登録する．
+void
+StrashTable::add(
+  SizeType src1,
+  SizeType src2,
+  SizeType lit
+)
+{
+  if ( (mNum + 1) * 2 > mTable.size() ) {
+    expand(mTable.size() * 2);
+  }
+  auto pos = hash(src1, src2);
+  while ( mTable[pos].mLit != NOT_FOUND ) {
+    pos = (pos + 1) & mMask;
+  }
+  mTable[pos] = Cell{src1, src2, lit};
+  ++ mNum;
+}
+
+// @brief 表を拡大する．
+void
+StrashTable::expand(
+  SizeType size
+)
+{
+  vector<Cell> old_table;
+  old_table.swap(mTable);
+  mTable.resize(size);
+  mMask = size - 1;
+  for ( auto& cell: old_table ) {
+    if ( cell.mLit != NOT_FOUND ) {
+      auto pos = hash(cell.mSrc1, cell.mSrc2);
+      while ( mTable[pos].mLit != NOT_FOUND ) {
+	pos = (pos + 1) & mMask;
+      }
+      mTable[pos] = cell;
+    }
+  }
+}
+
+END_NAMESPACE_YM_AIG
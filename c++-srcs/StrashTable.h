@@ -0,0 +1,126 @@
+#ifndef STRASHTABLE_H
+#define STRASHTABLE_H
+
+/// @file StrashTable.h
+/// @brief StrashTable のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+/// @class StrashTable StrashTable.h "StrashTable.h"
+/// @brief ANDノードのファンインの組をキーにしたハッシュ表
+///
+/// 構造的ハッシュ(strash)に用いる．
+/// キーは src1 >= src2 に正規化されたファンインのリテラルの組．
+/// 連続した配列上の開番地法(線形探索)で実装しているので
+/// ノードごとのメモリ確保は行わない．
+//////////////////////////////////////////////////////////////////////
+class StrashTable
+{
+public:
+
+  /// @brief 見つからなかったことを表す値
+  static
+  constexpr SizeType NOT_FOUND = static_cast<SizeType>(-1);
+
+  /// @brief コンストラクタ
+  explicit
+  StrashTable(
+    SizeType size_hint = 0 ///< [in] 登録される要素数の見込み
+  );
+
+  /// @brief デストラクタ
+  ~StrashTable() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 登録されている要素数を返す．
+  SizeType
+  size() const
+  {
+    return mNum;
+  }
+
+  /// @brief 探す．
+  /// @return 登録されているリテラルを返す．
+  ///
+  /// 見つからなかった場合は NOT_FOUND を返す．
+  SizeType
+  find(
+    SizeType src1, ///< [in] ファンイン1のリテラル
+    SizeType src2  ///< [in] ファンイン2のリテラル ( src1 >= src2 )
+  ) const;
+
+  /// @brief 登録する．
+  ///
+  /// 同じキーの要素が登録されていないこと．
+  void
+  add(
+    SizeType src1, ///< [in] ファンイン1のリテラル
+    SizeType src2, ///< [in] ファンイン2のリテラル ( src1 >= src2 )
+    SizeType lit   ///< [in] ANDノードのリテラル
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ハッシュ値を計算する．
+  SizeType
+  hash(
+    SizeType src1,
+    SizeType src2
+  ) const
+  {
+    auto h = src1 * 0x9E3779B97F4A7C15ULL ^ src2 * 0xC2B2AE3D27D4EB4FULL;
+    return (h ^ (h >> 29)) & mMask;
+  }
+
+  /// @brief 表を拡大する．
+  void
+  expand(
+    SizeType size ///< [in] 新しいサイズ(2のべき乗)
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 表の要素
+  // mLit が NOT_FOUND の要素は空きを表す．
+  struct Cell
+  {
+    SizeType mSrc1{0};
+    SizeType mSrc2{0};
+    SizeType mLit{NOT_FOUND};
+  };
+
+  // 表の本体
+  vector<Cell> mTable;
+
+  // ハッシュ値のマスク
+  SizeType mMask{0};
+
+  // 要素数
+  SizeType mNum{0};
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // STRASHTABLE_H
@@ -0,0 +1,62 @@
+
+/// @file VarMap.cc
+/// @brief VarMap の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "VarMap.h"
+#include "ModelImpl.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+// クラス VarMap
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+VarMap::VarMap(
+  const ModelImpl& model
+) : mI{model.I()},
+    mL{model.L()},
+    mVarNum{model.M() + 1},
+    mCanonical{model.is_canonical()}
+{
+  if ( mCanonical ) {
+    return;
+  }
+
+  // 番号が飛んでいる場合もあるので最大値を求める．
+  for ( SizeType i = 0; i < model.I(); ++ i ) {
+    mVarNum = std::max(mVarNum, model.input(i) / 2 + 1);
+  }
+  for ( SizeType i = 0; i < model.L(); ++ i ) {
+    mVarNum = std::max(mVarNum, model.latch(i) / 2 + 1);
+  }
+  for ( SizeType i = 0; i < model.A(); ++ i ) {
+    mVarNum = std::max(mVarNum, model.and_node(i) / 2 + 1);
+  }
+
+  mKindList.resize(mVarNum, NONE);
+  mPosList.resize(mVarNum, 0);
+  mKindList[0] = CONST;
+  for ( SizeType i = 0; i < model.I(); ++ i ) {
+    auto var = model.input(i) / 2;
+    mKindList[var] = INPUT;
+    mPosList[var] = i;
+  }
+  for ( SizeType i = 0; i < model.L(); ++ i ) {
+    auto var = model.latch(i) / 2;
+    mKindList[var] = LATCH;
+    mPosList[var] = i;
+  }
+  for ( SizeType i = 0; i < model.A(); ++ i ) {
+    auto var = model.and_node(i) / 2;
+    mKindList[var] = AND;
+    mPosList[var] = i;
+  }
+}
+
+END_NAMESPACE_YM_AIG
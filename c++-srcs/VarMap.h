@@ -0,0 +1,134 @@
+#ifndef VARMAP_H
+#define VARMAP_H
+
+/// @file VarMap.h
+/// @brief VarMap のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+#include <cstdint>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+class ModelImpl;
+
+//////////////////////////////////////////////////////////////////////
+/// @class VarMap VarMap.h "VarMap.h"
+/// @brief 変数番号から定義元(入力，ラッチ，ANDノード)を引くためのクラス
+///
+/// 変数番号が入力，ラッチ，ANDノードの順に連続している標準形の
+/// モデルでは表を作らずに計算で求める．
+/// それ以外(Ascii AIG で番号が飛んでいる場合など)は変数番号で
+/// 引く表を作る．
+//////////////////////////////////////////////////////////////////////
+class VarMap
+{
+public:
+
+  /// @brief 定義元の種類
+  enum Kind : std::uint8_t {
+    NONE,  ///< 未定義
+    CONST, ///< 定数
+    INPUT, ///< 入力
+    LATCH, ///< ラッチ
+    AND    ///< ANDノード
+  };
+
+  /// @brief コンストラクタ
+  explicit
+  VarMap(
+    const ModelImpl& model ///< [in] 対象のモデル
+  );
+
+  /// @brief デストラクタ
+  ~VarMap() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 変数番号の最大値 + 1 を返す．
+  SizeType
+  var_num() const
+  {
+    return mVarNum;
+  }
+
+  /// @brief 定義元の種類を返す．
+  Kind
+  kind(
+    SizeType var ///< [in] 変数番号 ( 0 <= var < var_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= var && var < var_num() );
+    if ( mCanonical ) {
+      if ( var == 0 ) {
+	return CONST;
+      }
+      if ( var <= mI ) {
+	return INPUT;
+      }
+      if ( var <= mI + mL ) {
+	return LATCH;
+      }
+      return AND;
+    }
+    return static_cast<Kind>(mKindList[var]);
+  }
+
+  /// @brief 定義元の番号(入力番号，ラッチ番号，AND番号)を返す．
+  SizeType
+  pos(
+    SizeType var ///< [in] 変数番号 ( 0 <= var < var_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= var && var < var_num() );
+    if ( mCanonical ) {
+      if ( var <= mI ) {
+	return var - 1;
+      }
+      if ( var <= mI + mL ) {
+	return var - mI - 1;
+      }
+      return var - mI - mL - 1;
+    }
+    return mPosList[var];
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 入力数
+  SizeType mI;
+
+  // ラッチ数
+  SizeType mL;
+
+  // 変数番号の最大値 + 1
+  SizeType mVarNum;
+
+  // 標準形の時 true
+  bool mCanonical;
+
+  // 変数番号をキーにして種類を格納する配列
+  // 標準形の時は空
+  vector<std::uint8_t> mKindList;
+
+  // 変数番号をキーにして定義元の番号を格納する配列
+  // 標準形の時は空
+  vector<SizeType> mPosList;
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // VARMAP_H
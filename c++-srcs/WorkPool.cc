@@ -0,0 +1,249 @@
+
+/// @file WorkPool.cc
+/// @brief WorkPool の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "WorkPool.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+BEGIN_NONAMESPACE
+
+// 各スレッドが担当するタスクの範囲
+//
+// [mBegin, mEnd) が未実行のタスク．
+// 持ち主は先頭から取り出し，他のスレッドは末尾から奪う．
+struct TaskRange
+{
+  std::mutex mMutex;
+  SizeType mBegin{0};
+  SizeType mEnd{0};
+};
+
+END_NONAMESPACE
+
+// run() 1回分の仕事
+struct WorkPool::Job
+{
+  // タスク数
+  SizeType mTaskNum;
+
+  // 参加するスレッド数
+  SizeType mThreadNum;
+
+  // タスクを実行する関数
+  const TaskFunc& mFunc;
+
+  // スレッドごとの担当範囲
+  vector<TaskRange> mRangeList;
+
+  // 例外が起きた時 true にするフラグ
+  std::atomic<bool> mAbort{false};
+
+  // 最初に起きた例外
+  std::exception_ptr mError;
+
+  // mError を保護する mutex
+  std::mutex mErrorMutex;
+
+  // コンストラクタ
+  Job(
+    SizeType n,
+    SizeType nt,
+    const TaskFunc& func
+  ) : mTaskNum{n},
+      mThreadNum{nt},
+      mFunc{func},
+      mRangeList(nt)
+  {
+    for ( SizeType t = 0; t < nt; ++ t ) {
+      mRangeList[t].mBegin = n * t / nt;
+      mRangeList[t].mEnd = n * (t + 1) / nt;
+    }
+  }
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス WorkPool
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+WorkPool::WorkPool(
+  SizeType thread_num
+) : mThreadNum{thread_num}
+{
+  if ( mThreadNum == 0 ) {
+    mThreadNum = std::max<SizeType>(std::thread::hardware_concurrency(), 1);
+  }
+}
+
+// @brief デストラクタ
+WorkPool::~WorkPool()
+{
+  {
+    std::lock_guard<std::mutex> lock{mMutex};
+    mShutdown = true;
+  }
+  mStartCond.notify_all();
+  for ( auto& th: mThreadList ) {
+    th.join();
+  }
+}
+
+// @brief タスクを並列に実行する．
+void
+WorkPool::run(
+  SizeType n,
+  const TaskFunc& func
+)
+{
+  auto nt = std::min(mThreadNum, n);
+  if ( nt <= 1 ) {
+    for ( SizeType i = 0; i < n; ++ i ) {
+      func(i, 0);
+    }
+    return;
+  }
+
+  // ワーカースレッドは必要になった時点で作る．
+  while ( mThreadList.size() + 1 < nt ) {
+    auto tid = mThreadList.size() + 1;
+    mThreadList.emplace_back([this, tid]() { worker_loop(tid); });
+  }
+
+  Job job{n, nt, func};
+  {
+    std::lock_guard<std::mutex> lock{mMutex};
+    mJob = &job;
+    mJobThreadNum = nt;
+    mActiveNum = nt - 1;
+    ++ mGeneration;
+  }
+  mStartCond.notify_all();
+  work(job, 0);
+  {
+    std::unique_lock<std::mutex> lock{mMutex};
+    mDoneCond.wait(lock, [&]() { return mActiveNum == 0; });
+    mJob = nullptr;
+    mJobThreadNum = 0;
+  }
+  if ( job.mError ) {
+    std::rethrow_exception(job.mError);
+  }
+}
+
+// @brief ワーカースレッドの本体
+void
+WorkPool::worker_loop(
+  SizeType tid
+)
+{
+  SizeType generation = 0;
+  for ( ; ; ) {
+    Job* job;
+    {
+      std::unique_lock<std::mutex> lock{mMutex};
+      mStartCond.wait(lock, [&]() {
+	return mShutdown || mGeneration != generation;
+      });
+      if ( mShutdown ) {
+	return;
+      }
+      generation = mGeneration;
+      // 参加しない仕事は読み飛ばす．
+      // 参加しないスレッドは完了を待たれていないので，
+      // mJob の指す先は既に破棄されているかもしれない．
+      // そのため参加するかどうかはロックを保持したまま
+      // mJobThreadNum で判定し，mJob には触れない．
+      // 参加する仕事は完了を待たれているので読み飛ばされることはない．
+      if ( mJob == nullptr || tid >= mJobThreadNum ) {
+	continue;
+      }
+      job = mJob;
+    }
+    work(*job, tid);
+    bool last;
+    {
+      std::lock_guard<std::mutex> lock{mMutex};
+      -- mActiveNum;
+      last = mActiveNum == 0;
+    }
+    if ( last ) {
+      mDoneCond.notify_one();
+    }
+  }
+}
+
+// @brief 仕事のタスクを取り出しながら実行する．
+void
+WorkPool::work(
+  Job& job,
+  SizeType tid
+)
+{
+  auto n = job.mTaskNum;
+  auto nt = job.mThreadNum;
+  auto& range_list = job.mRangeList;
+  auto& my_range = range_list[tid];
+  for ( ; ; ) {
+    if ( job.mAbort ) {
+      return;
+    }
+    SizeType task;
+    {
+      std::lock_guard<std::mutex> lock{my_range.mMutex};
+      if ( my_range.mBegin < my_range.mEnd ) {
+	task = my_range.mBegin;
+	++ my_range.mBegin;
+      }
+      else {
+	task = n;
+      }
+    }
+    if ( task == n ) {
+      // 他のスレッドの担当分の後ろ半分を奪う．
+      SizeType begin = 0;
+      SizeType end = 0;
+      for ( SizeType k = 1; k < nt && begin == end; ++ k ) {
+	auto& victim = range_list[(tid + k) % nt];
+	std::lock_guard<std::mutex> lock{victim.mMutex};
+	auto rest = victim.mEnd - victim.mBegin;
+	if ( rest == 0 ) {
+	  continue;
+	}
+	begin = victim.mEnd - (rest + 1) / 2;
+	end = victim.mEnd;
+	victim.mEnd = begin;
+      }
+      if ( begin == end ) {
+	// 全てのタスクが取り出された．
+	return;
+      }
+      std::lock_guard<std::mutex> lock{my_range.mMutex};
+      my_range.mBegin = begin;
+      my_range.mEnd = end;
+      continue;
+    }
+    try {
+      job.mFunc(task, tid);
+    }
+    catch ( ... ) {
+      std::lock_guard<std::mutex> lock{job.mErrorMutex};
+      if ( !job.mError ) {
+	job.mError = std::current_exception();
+      }
+      job.mAbort = true;
+      return;
+    }
+  }
+}
+
+END_NAMESPACE_YM_AIG
@@ -0,0 +1,152 @@
+#ifndef WORKPOOL_H
+#define WORKPOOL_H
+
+/// @file WorkPool.h
+/// @brief WorkPool のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+/// @class WorkPool WorkPool.h "WorkPool.h"
+/// @brief work stealing 方式で独立なタスクを並列に実行するクラス
+///
+/// タスクは 0 から n - 1 の番号で表される．
+/// 最初に各スレッドに連続した範囲のタスクを割り当て，
+/// 自分の担当分が無くなったスレッドは他のスレッドの担当分の
+/// 後ろ半分を奪って実行する．
+///
+/// ワーカースレッドは最初に複数のスレッドで run() を行う時に作られ，
+/// オブジェクトが破棄されるまで待機しながら再利用される．
+/// run() を呼び出したスレッドもスレッド番号 0 として実行に加わる．
+/// run() を複数のスレッドから同時に呼び出してはならない．
+//////////////////////////////////////////////////////////////////////
+class WorkPool
+{
+public:
+
+  /// @brief タスクを実行する関数の型
+  ///
+  /// 引数はタスク番号とスレッド番号
+  using TaskFunc = std::function<void(SizeType, SizeType)>;
+
+  /// @brief コンストラクタ
+  explicit
+  WorkPool(
+    SizeType thread_num = 0 ///< [in] スレッド数(0 の時はハードウェアの並列度)
+  );
+
+  /// @brief コピーコンストラクタは禁止
+  WorkPool(
+    const WorkPool& src
+  ) = delete;
+
+  /// @brief 代入演算子は禁止
+  WorkPool&
+  operator=(
+    const WorkPool& src
+  ) = delete;
+
+  /// @brief デストラクタ
+  ///
+  /// ワーカースレッドを終了させる．
+  ~WorkPool();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief スレッド数を返す．
+  SizeType
+  thread_num() const
+  {
+    return mThreadNum;
+  }
+
+  /// @brief タスクを並列に実行する．
+  ///
+  /// 全てのタスクが終わるまで戻らない．
+  /// func が例外を送出した場合には残りのタスクは実行せずに
+  /// 最初の例外を再送出する．
+  void
+  run(
+    SizeType n,         ///< [in] タスク数
+    const TaskFunc& func ///< [in] タスクを実行する関数
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる型と関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief run() 1回分の仕事を表す構造体
+  struct Job;
+
+  /// @brief ワーカースレッドの本体
+  void
+  worker_loop(
+    SizeType tid ///< [in] スレッド番号
+  );
+
+  /// @brief 仕事のタスクを取り出しながら実行する．
+  static
+  void
+  work(
+    Job& job,    ///< [in] 仕事
+    SizeType tid ///< [in] スレッド番号
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // スレッド数
+  SizeType mThreadNum;
+
+  // ワーカースレッドのリスト(スレッド番号 1 から順に並ぶ)
+  vector<std::thread> mThreadList;
+
+  // 以下のメンバを保護する mutex
+  std::mutex mMutex;
+
+  // 新しい仕事か終了を知らせる条件変数
+  std::condition_variable mStartCond;
+
+  // 仕事の完了を知らせる条件変数
+  std::condition_variable mDoneCond;
+
+  // 現在の仕事
+  Job* mJob{nullptr};
+
+  // 現在の仕事に参加するスレッド数
+  SizeType mJobThreadNum{0};
+
+  // 仕事の通し番号
+  SizeType mGeneration{0};
+
+  // 現在の仕事を実行中のワーカースレッド数
+  SizeType mActiveNum{0};
+
+  // 終了を指示する時 true にするフラグ
+  bool mShutdown{false};
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // WORKPOOL_H
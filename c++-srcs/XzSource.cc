@@ -0,0 +1,86 @@
+
+/// @file XzSource.cc
+/// @brief XzSource の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "XzSource.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+BEGIN_NONAMESPACE
+
+// 入力バッファのサイズ
+const SizeType IN_BUFF_SIZE = 256 * 1024;
+
+END_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// クラス XzSource
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+XzSource::XzSource(
+  std::unique_ptr<InputSource>&& src
+) : mSrc{std::move(src)},
+    mInBuff(IN_BUFF_SIZE)
+{
+  lzma_stream init = LZMA_STREAM_INIT;
+  mStream = init;
+  auto ret = lzma_stream_decoder(&mStream, UINT64_MAX, LZMA_CONCATENATED);
+  if ( ret != LZMA_OK ) {
+    throw std::invalid_argument{"XzSource: lzma_stream_decoder() failed"};
+  }
+}
+
+// @brief デストラクタ
+XzSource::~XzSource()
+{
+  lzma_end(&mStream);
+}
+
+// @brief 圧縮されたデータを伸長しているとき true を返す．
+bool
+XzSource::is_compressed() const
+{
+  return true;
+}
+
+// @brief データを読み出す．
+SizeType
+XzSource::read(
+  char* buff,
+  SizeType size
+)
+{
+  mStream.next_out = reinterpret_cast<uint8_t*>(buff);
+  mStream.avail_out = size;
+  while ( mStream.avail_out > 0 && !mEnd ) {
+    if ( mStream.avail_in == 0 && !mInEof ) {
+      auto n = mSrc->read(mInBuff.data(), mInBuff.size());
+      if ( n == 0 ) {
+	mInEof = true;
+      }
+      mStream.next_in = reinterpret_cast<const uint8_t*>(mInBuff.data());
+      mStream.avail_in = n;
+    }
+    // LZMA_CONCATENATED の場合は入力の末尾で LZMA_FINISH を指定する．
+    auto action = mInEof ? LZMA_FINISH : LZMA_RUN;
+    auto ret = lzma_code(&mStream, action);
+    if ( ret == LZMA_STREAM_END ) {
+      mEnd = true;
+      break;
+    }
+    if ( ret != LZMA_OK ) {
+      ostringstream buf;
+      buf << "XzSource::read: lzma_code() failed (" << ret << ")";
+      throw std::invalid_argument{buf.str()};
+    }
+  }
+  return size - mStream.avail_out;
+}
+
+END_NAMESPACE_YM_AIG
@@ -0,0 +1,83 @@
+
+/// @file ZstdSource.cc
+/// @brief ZstdSource の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ZstdSource.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+// クラス ZstdSource
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+ZstdSource::ZstdSource(
+  std::unique_ptr<InputSource>&& src
+) : mSrc{std::move(src)},
+    mInBuff(ZSTD_DStreamInSize()),
+    mStream{ZSTD_createDStream()},
+    mIn{mInBuff.data(), 0, 0}
+{
+  if ( mStream == nullptr ) {
+    throw std::invalid_argument{"ZstdSource: ZSTD_createDStream() failed"};
+  }
+  ZSTD_initDStream(mStream);
+}
+
+// @brief デストラクタ
+ZstdSource::~ZstdSource()
+{
+  ZSTD_freeDStream(mStream);
+}
+
+// @brief 圧縮されたデータを伸長しているとき true を返す．
+bool
+ZstdSource::is_compressed() const
+{
+  return true;
+}
+
+// @brief データを読み出す．
+SizeType
+ZstdSource::read(
+  char* buff,
+  SizeType size
+)
+{
+  ZSTD_outBuffer out{buff, size, 0};
+  while ( out.pos < out.size ) {
+    if ( mIn.pos == mIn.size && !mInEof ) {
+      auto n = mSrc->read(mInBuff.data(), mInBuff.size());
+      if ( n == 0 ) {
+	mInEof = true;
+      }
+      mIn.size = n;
+      mIn.pos = 0;
+    }
+    bool no_input = mIn.pos == mIn.size;
+    if ( no_input && mFrameEnd ) {
+      // 全てのフレームを読み終わった．
+      break;
+    }
+    auto prev = out.pos;
+    auto ret = ZSTD_decompressStream(mStream, &out, &mIn);
+    if ( ZSTD_isError(ret) ) {
+      ostringstream buf;
+      buf << "ZstdSource::read: " << ZSTD_getErrorName(ret);
+      throw std::invalid_argument{buf.str()};
+    }
+    // ret == 0 はフレームが完結したことを表す．
+    mFrameEnd = ret == 0;
+    if ( no_input && out.pos == prev && !mFrameEnd ) {
+      throw std::invalid_argument{"ZstdSource::read: Unexpected EOF"};
+    }
+  }
+  return out.pos;
+}
+
+END_NAMESPACE_YM_AIG
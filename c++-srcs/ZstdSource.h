@@ -0,0 +1,82 @@
+#ifndef ZSTDSOURCE_H
+#define ZSTDSOURCE_H
+
+/// @file ZstdSource.h
+/// @brief ZstdSource のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "InputSource.h"
+#include <zstd.h>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+/// @class ZstdSource ZstdSource.h "ZstdSource.h"
+/// @brief zstd 形式のデータを伸長しながら読み出す InputSource
+//////////////////////////////////////////////////////////////////////
+class ZstdSource :
+  public InputSource
+{
+public:
+
+  /// @brief コンストラクタ
+  ///
+  /// 初期化に失敗したら std::invalid_argument 例外を送出する．
+  explicit
+  ZstdSource(
+    std::unique_ptr<InputSource>&& src ///< [in] 圧縮されたデータの入力元
+  );
+
+  /// @brief デストラクタ
+  ~ZstdSource();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // InputSource の仮想関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 圧縮されたデータを伸長しているとき true を返す．
+  bool
+  is_compressed() const override;
+
+  /// @brief データを読み出す．
+  SizeType
+  read(
+    char* buff,   ///< [in] 読み出したデータを格納する領域
+    SizeType size ///< [in] buff のサイズ
+  ) override;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 圧縮されたデータの入力元
+  std::unique_ptr<InputSource> mSrc;
+
+  // 圧縮されたデータを読み込むバッファ
+  vector<char> mInBuff;
+
+  // zstd のストリーム
+  ZSTD_DStream* mStream;
+
+  // 入力バッファの状態
+  ZSTD_inBuffer mIn;
+
+  // 入力元の末尾に達したら true にするフラグ
+  bool mInEof{false};
+
+  // 直前のフレームが完結していたら true にするフラグ
+  bool mFrameEnd{true};
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // ZSTDSOURCE_H
@@ -0,0 +1,137 @@
+#ifndef AIGACTIVITY_H
+#define AIGACTIVITY_H
+
+/// @file AigActivity.h
+/// @brief AigActivity のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+#include "ym/AigActivityOpt.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+class ModelImpl;
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigActivity AigActivity.h "ym/AigActivity.h"
+/// @brief シミュレーションで求めた信号確率とスイッチング率を表すクラス
+///
+/// - 値は変数番号をキーにした float の配列で持つ．
+/// - 信号確率は全ての時刻とパタンで値が 1 となった割合を表す．
+/// - スイッチング率は連続する2時刻の間で値が変化した割合を表す．
+///   時刻数が 1 以下の時は 0 となる．
+/// - 変数 0 (定数)の値は共に 0 となる．
+//////////////////////////////////////////////////////////////////////
+class AigActivity
+{
+  friend class AigModel;
+
+public:
+
+  /// @brief 空のコンストラクタ
+  AigActivity() = default;
+
+  /// @brief デストラクタ
+  ~AigActivity() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 変数番号の最大値 + 1 を返す．
+  SizeType
+  var_num() const
+  {
+    return mOneProb.size();
+  }
+
+  /// @brief 時刻ごとのパタン数を返す．
+  SizeType
+  pattern_num() const
+  {
+    return mPatNum;
+  }
+
+  /// @brief 統計を取った時刻数を返す．
+  SizeType
+  cycle_num() const
+  {
+    return mCycleNum;
+  }
+
+  /// @brief 変数の値が 1 となる確率を返す．
+  double
+  one_prob(
+    SizeType var ///< [in] 変数番号 ( 0 <= var < var_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= var && var < var_num() );
+    return mOneProb[var];
+  }
+
+  /// @brief 変数のスイッチング率を返す．
+  double
+  toggle_rate(
+    SizeType var ///< [in] 変数番号 ( 0 <= var < var_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= var && var < var_num() );
+    return mToggleRate[var];
+  }
+
+  /// @brief 信号確率の配列を返す．
+  const vector<float>&
+  one_prob_array() const
+  {
+    return mOneProb;
+  }
+
+  /// @brief スイッチング率の配列を返す．
+  const vector<float>&
+  toggle_rate_array() const
+  {
+    return mToggleRate;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief シミュレーションを行って統計を求める．
+  void
+  compute(
+    const ModelImpl& model,   ///< [in] 対象のモデル
+    const AigActivityOpt& opt ///< [in] オプション
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 時刻ごとのパタン数
+  SizeType mPatNum{0};
+
+  // 統計を取った時刻数
+  SizeType mCycleNum{0};
+
+  // 変数ごとの信号確率
+  vector<float> mOneProb;
+
+  // 変数ごとのスイッチング率
+  vector<float> mToggleRate;
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGACTIVITY_H
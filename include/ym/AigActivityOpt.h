@@ -0,0 +1,54 @@
+#ifndef AIGACTIVITYOPT_H
+#define AIGACTIVITYOPT_H
+
+/// @file AigActivityOpt.h
+/// @brief AigActivityOpt のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+#include <cstdint>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigActivityOpt AigActivityOpt.h "ym/AigActivityOpt.h"
+/// @brief AigModel::estimate_activity() のオプションを表す構造体
+//////////////////////////////////////////////////////////////////////
+struct AigActivityOpt
+{
+  /// @brief 変数ごとのワード数
+  ///
+  /// 64 * word_num 個の系列を同時にシミュレーションする．
+  SizeType word_num{4};
+
+  /// @brief 統計を取る時刻数
+  SizeType cycle_num{64};
+
+  /// @brief 統計を取る前に進める時刻数
+  ///
+  /// ラッチの初期状態の影響を除くために用いる．
+  SizeType warmup_num{0};
+
+  /// @brief 入力ごとの値が 1 となる確率
+  ///
+  /// 空の時は全て 0.5 とする．
+  /// 確率は 1/65536 の精度に丸められる．
+  vector<double> input_prob;
+
+  /// @brief 乱数の種
+  std::uint64_t seed{1};
+
+  /// @brief スレッド数
+  ///
+  /// 0 の時はハードウェアの並列度を用いる．
+  SizeType thread_num{0};
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGACTIVITYOPT_H
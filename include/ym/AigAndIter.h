@@ -0,0 +1,150 @@
+#ifndef AIGANDITER_H
+#define AIGANDITER_H
+
+/// @file AigAndIter.h
+/// @brief AigAndIter のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+#include <memory>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+class ModelImpl;
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigAndIter AigAndIter.h "ym/AigAndIter.h"
+/// @brief AigModel のANDノードを先頭から順に辿る反復子
+///
+/// ANDノードのリストが圧縮表現の場合でも1ノードあたり定数時間で
+/// 次のノードに進むことができる．
+/// 実装クラスを共有して持つので，元の AigModel が変更されたり
+/// 破棄されたりしても作られた時点の内容を辿り続ける．
+//////////////////////////////////////////////////////////////////////
+class AigAndIter
+{
+  friend class AigModel;
+
+private:
+
+  /// @brief 内容を指定したコンストラクタ
+  AigAndIter(
+    const std::shared_ptr<ModelImpl>& impl, ///< [in] 実装クラス
+    SizeType pos                            ///< [in] 位置
+  );
+
+
+public:
+
+  /// @brief 空のコンストラクタ
+  AigAndIter() = default;
+
+  /// @brief デストラクタ
+  ~AigAndIter() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ANDノード番号を返す．
+  SizeType
+  pos() const
+  {
+    return mPos;
+  }
+
+  /// @brief ANDノードのリテラルを返す．
+  SizeType
+  node() const
+  {
+    return mLit;
+  }
+
+  /// @brief ANDノードのソース1のリテラルを返す．
+  SizeType
+  src1() const
+  {
+    return mSrc1;
+  }
+
+  /// @brief ANDノードのソース2のリテラルを返す．
+  SizeType
+  src2() const
+  {
+    return mSrc2;
+  }
+
+  /// @brief 自分自身を返す．
+  const AigAndIter&
+  operator*() const
+  {
+    return *this;
+  }
+
+  /// @brief 次のノードに進む．
+  AigAndIter&
+  operator++();
+
+  /// @brief 等価比較演算子
+  bool
+  operator==(
+    const AigAndIter& right ///< [in] 比較対象
+  ) const
+  {
+    return mImpl == right.mImpl && mPos == right.mPos;
+  }
+
+  /// @brief 非等価比較演算子
+  bool
+  operator!=(
+    const AigAndIter& right ///< [in] 比較対象
+  ) const
+  {
+    return !operator==(right);
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 現在位置のノードの内容を読み込む．
+  void
+  load();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 実装クラス
+  std::shared_ptr<const ModelImpl> mImpl;
+
+  // ANDノード番号
+  SizeType mPos{0};
+
+  // 圧縮表現中の次のノードのバイト位置
+  SizeType mOffset{0};
+
+  // リテラル
+  SizeType mLit{0};
+
+  // ソース1のリテラル
+  SizeType mSrc1{0};
+
+  // ソース2のリテラル
+  SizeType mSrc2{0};
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGANDITER_H
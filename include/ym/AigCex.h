@@ -0,0 +1,43 @@
+#ifndef AIGCEX_H
+#define AIGCEX_H
+
+/// @file AigCex.h
+/// @brief AigCex のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigCex AigCex.h "ym/AigCex.h"
+/// @brief AigModel::falsify() の結果(反例)を表す構造体
+///
+/// ラッチの初期値を 0 として，input_list の入力値を時刻 0 から順に
+/// 与えると時刻 cycle で出力 output が 1 になる．
+//////////////////////////////////////////////////////////////////////
+struct AigCex
+{
+  /// @brief 反例が見つかった時 true
+  bool found{false};
+
+  /// @brief 1 になった出力番号
+  SizeType output{0};
+
+  /// @brief 出力が 1 になった時刻
+  SizeType cycle{0};
+
+  /// @brief 時刻ごとの入力値のリスト
+  ///
+  /// 要素数は cycle + 1 で，各要素は入力数の大きさを持つ．
+  vector<vector<bool>> input_list;
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGCEX_H
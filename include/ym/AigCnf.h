@@ -0,0 +1,150 @@
+#ifndef AIGCNF_H
+#define AIGCNF_H
+
+/// @file AigCnf.h
+/// @brief AigCnf のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+#include "ym/AigCnfOpt.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+class ModelImpl;
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigCnf AigCnf.h "ym/AigCnf.h"
+/// @brief AigModel を Tseitin 変換した CNF を表すクラス
+///
+/// - 変数とリテラルは DIMACS 形式と同様に 1 から始まる整数と
+///   その符号で表す．
+/// - 節は 0 で終端したリテラルの列として一つの配列に連続して格納する．
+/// - 符号化されていない AIG の変数に対応する CNF の変数は 0 となる．
+//////////////////////////////////////////////////////////////////////
+class AigCnf
+{
+  friend class AigModel;
+
+public:
+
+  /// @brief 空のコンストラクタ
+  AigCnf() = default;
+
+  /// @brief デストラクタ
+  ~AigCnf() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief CNF の変数の数を返す．
+  SizeType
+  var_num() const
+  {
+    return mVarNum;
+  }
+
+  /// @brief 節の数を返す．
+  SizeType
+  clause_num() const
+  {
+    return mClauseNum;
+  }
+
+  /// @brief 節の配列を返す．
+  ///
+  /// 各節は 0 で終端している．
+  const vector<int>&
+  lit_buffer() const
+  {
+    return mLitBuffer;
+  }
+
+  /// @brief AIG の変数に対応する CNF の変数を返す．
+  ///
+  /// 符号化されていない場合は 0 を返す．
+  int
+  cnf_var(
+    SizeType var ///< [in] AIG の変数番号
+  ) const
+  {
+    if ( var >= mVarMap.size() ) {
+      return 0;
+    }
+    return mVarMap[var];
+  }
+
+  /// @brief 対象の出力に対応するリテラルを返す．
+  int
+  output_lit(
+    SizeType pos ///< [in] AigCnfOpt::output_list 中の位置(両方のリストが空の時は出力番号)
+  ) const
+  {
+    ASSERT_COND( 0 <= pos && pos < mOutputLitList.size() );
+    return mOutputLitList[pos];
+  }
+
+  /// @brief 対象のラッチの次状態関数に対応するリテラルを返す．
+  int
+  latch_src_lit(
+    SizeType pos ///< [in] AigCnfOpt::latch_list 中の位置(両方のリストが空の時はラッチ番号)
+  ) const
+  {
+    ASSERT_COND( 0 <= pos && pos < mLatchLitList.size() );
+    return mLatchLitList[pos];
+  }
+
+  /// @brief DIMACS 形式で出力する．
+  void
+  write_dimacs(
+    ostream& s ///< [in] 出力先のストリーム
+  ) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief CNF を作る．
+  void
+  encode(
+    const ModelImpl& model, ///< [in] 対象のモデル
+    const AigCnfOpt& opt    ///< [in] オプション
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 変数の数
+  SizeType mVarNum{0};
+
+  // 節の数
+  SizeType mClauseNum{0};
+
+  // 0 で終端した節の配列
+  vector<int> mLitBuffer;
+
+  // AIG の変数番号をキーにした CNF の変数
+  vector<int> mVarMap;
+
+  // 対象の出力のリテラルのリスト
+  vector<int> mOutputLitList;
+
+  // 対象のラッチの次状態関数のリテラルのリスト
+  vector<int> mLatchLitList;
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGCNF_H
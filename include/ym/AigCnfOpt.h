@@ -0,0 +1,49 @@
+#ifndef AIGCNFOPT_H
+#define AIGCNFOPT_H
+
+/// @file AigCnfOpt.h
+/// @brief AigCnfOpt のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigCnfOpt AigCnfOpt.h "ym/AigCnfOpt.h"
+/// @brief AigModel::write_cnf() などのオプションを表す構造体
+//////////////////////////////////////////////////////////////////////
+struct AigCnfOpt
+{
+  /// @brief 対象の出力番号のリスト
+  ///
+  /// output_list と latch_list が共に空の時は
+  /// 全ての出力と全てのラッチの次状態関数が対象となる．
+  vector<SizeType> output_list;
+
+  /// @brief 対象のラッチ番号(次状態関数)のリスト
+  vector<SizeType> latch_list;
+
+  /// @brief 対象のファンインコーンに含まれるノードのみを符号化する時 true にする．
+  ///
+  /// false の時は全ての入力，ラッチ，ANDノードを符号化する．
+  bool coi{true};
+
+  /// @brief 極性を考慮して不要な節を省く時 true にする．
+  ///
+  /// ノードが正(負)の極性でしか参照されない場合は
+  /// その極性の節だけを生成する(Plaisted-Greenbaum 符号化)．
+  bool polarity{false};
+
+  /// @brief 対象の出力が 1 となる単位節を加える時 true にする．
+  bool assert_outputs{false};
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGCNFOPT_H
@@ -0,0 +1,42 @@
+#ifndef AIGCUTOPT_H
+#define AIGCUTOPT_H
+
+/// @file AigCutOpt.h
+/// @brief AigCutOpt のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigCutOpt AigCutOpt.h "ym/AigCutOpt.h"
+/// @brief AigModel::enumerate_cuts() のオプションを表す構造体
+//////////////////////////////////////////////////////////////////////
+struct AigCutOpt
+{
+  /// @brief カットの葉の数の上限( 1 <= cut_size <= 8 )
+  SizeType cut_size{4};
+
+  /// @brief ノードあたりのカット数の上限(自明なカットを除く)
+  ///
+  /// 葉の数の少ないものから優先して残す．
+  SizeType cut_limit{8};
+
+  /// @brief カットごとの論理関数(真理値表)を計算する時 true にする．
+  bool truth_table{false};
+
+  /// @brief スレッド数
+  ///
+  /// 0 の時はハードウェアの並列度を用いる．
+  SizeType thread_num{0};
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGCUTOPT_H
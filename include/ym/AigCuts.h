@@ -0,0 +1,254 @@
+#ifndef AIGCUTS_H
+#define AIGCUTS_H
+
+/// @file AigCuts.h
+/// @brief AigCuts のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+#include "ym/AigCutOpt.h"
+#include <cstdint>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+class ModelImpl;
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigCuts AigCuts.h "ym/AigCuts.h"
+/// @brief AigModel の各ノードの k-feasible カットを保持するクラス
+///
+/// - ノードは AigModel の変数番号(リテラル / 2)で指定する．
+/// - 各ノードの 0 番目のカットは自分自身のみを葉とする自明なカット．
+///   ただし，定数ノード(変数番号 0)は葉を持たないカットのみを持つ．
+/// - カットの葉は変数番号の昇順に並んでいる．
+/// - 真理値表は葉の i 番目を変数 i とした cut_size() 変数の表で，
+///   i >= leaf_num() の変数には依存しない．
+///   2^cut_size() ビットを 64 ビットのワード単位で保持する
+///   (cut_size() が 6 以下の場合は1ワード)．
+//////////////////////////////////////////////////////////////////////
+class AigCuts
+{
+  friend class AigModel;
+  friend class AigLutNetwork;
+
+public:
+
+  /// @brief 空のコンストラクタ
+  AigCuts() = default;
+
+  /// @brief デストラクタ
+  ~AigCuts() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief カットの葉の数の上限を返す．
+  SizeType
+  cut_size() const
+  {
+    return mCutSize;
+  }
+
+  /// @brief 真理値表を持っている時 true を返す．
+  bool
+  has_truth_table() const
+  {
+    return mTruthWordNum > 0;
+  }
+
+  /// @brief 真理値表のワード数を返す．
+  ///
+  /// 真理値表を持たない場合は 0 を返す．
+  SizeType
+  truth_word_num() const
+  {
+    return mTruthWordNum;
+  }
+
+  /// @brief 変数番号の最大値 + 1 を返す．
+  SizeType
+  var_num() const
+  {
+    return mNodeList.size();
+  }
+
+  /// @brief ノードのカット数を返す．
+  ///
+  /// 自明なカットを含む．
+  SizeType
+  cut_num(
+    SizeType var ///< [in] 変数番号 ( 0 <= var < var_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= var && var < var_num() );
+    return mNodeList[var].mCutNum;
+  }
+
+  /// @brief カットの葉の数を返す．
+  SizeType
+  leaf_num(
+    SizeType var, ///< [in] 変数番号 ( 0 <= var < var_num() )
+    SizeType k    ///< [in] カット番号 ( 0 <= k < cut_num(var) )
+  ) const
+  {
+    return _cut(var, k).mSize;
+  }
+
+  /// @brief カットの葉を返す．
+  SizeType
+  leaf(
+    SizeType var, ///< [in] 変数番号 ( 0 <= var < var_num() )
+    SizeType k,   ///< [in] カット番号 ( 0 <= k < cut_num(var) )
+    SizeType pos  ///< [in] 葉の位置 ( 0 <= pos < leaf_num(var, k) )
+  ) const
+  {
+    auto& cut = _cut(var, k);
+    ASSERT_COND( 0 <= pos && pos < cut.mSize );
+    return mLeafArray[cut.mLeafBegin + pos];
+  }
+
+  /// @brief カットの葉のリストを返す．
+  vector<SizeType>
+  leaf_list(
+    SizeType var, ///< [in] 変数番号 ( 0 <= var < var_num() )
+    SizeType k    ///< [in] カット番号 ( 0 <= k < cut_num(var) )
+  ) const;
+
+  /// @brief カットのシグネチャを返す．
+  ///
+  /// 葉の変数番号を 64 で割った余りのビットの論理和
+  std::uint64_t
+  signature(
+    SizeType var, ///< [in] 変数番号 ( 0 <= var < var_num() )
+    SizeType k    ///< [in] カット番号 ( 0 <= k < cut_num(var) )
+  ) const
+  {
+    return _cut(var, k).mSign;
+  }
+
+  /// @brief カットの真理値表を返す．
+  ///
+  /// 真理値表を持たない場合は空のリストを返す．
+  vector<std::uint64_t>
+  truth_table(
+    SizeType var, ///< [in] 変数番号 ( 0 <= var < var_num() )
+    SizeType k    ///< [in] カット番号 ( 0 <= k < cut_num(var) )
+  ) const;
+
+  /// @brief カットの真理値表の先頭を返す．
+  ///
+  /// truth_word_num() ワードの領域を指す．
+  /// 真理値表を持たない場合は nullptr を返す．
+  const std::uint64_t*
+  truth_ptr(
+    SizeType var, ///< [in] 変数番号 ( 0 <= var < var_num() )
+    SizeType k    ///< [in] カット番号 ( 0 <= k < cut_num(var) )
+  ) const
+  {
+    auto id = _cut_id(var, k);
+    if ( mTruthWordNum == 0 ) {
+      return nullptr;
+    }
+    return &mTruthArray[id * mTruthWordNum];
+  }
+
+  /// @brief ノードのレベルを返す．
+  ///
+  /// 入力，ラッチ，定数のレベルは 0
+  SizeType
+  level(
+    SizeType var ///< [in] 変数番号 ( 0 <= var < var_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= var && var < var_num() );
+    return mNodeList[var].mLevel;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief カットを列挙する．
+  void
+  enumerate(
+    const ModelImpl& model, ///< [in] 対象のモデル
+    const AigCutOpt& opt    ///< [in] オプション
+  );
+
+  // カットの情報
+  struct Cut
+  {
+    std::uint64_t mSign;     // シグネチャ
+    SizeType mLeafBegin;     // mLeafArray 中の先頭位置
+    std::uint32_t mSize;     // 葉の数
+  };
+
+  /// @brief カットの通し番号を返す．
+  SizeType
+  _cut_id(
+    SizeType var,
+    SizeType k
+  ) const
+  {
+    ASSERT_COND( 0 <= var && var < var_num() );
+    auto& node = mNodeList[var];
+    ASSERT_COND( 0 <= k && k < node.mCutNum );
+    return node.mCutBegin + k;
+  }
+
+  /// @brief カットを返す．
+  const Cut&
+  _cut(
+    SizeType var,
+    SizeType k
+  ) const
+  {
+    return mCutArray[_cut_id(var, k)];
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ノードの情報
+  struct Node
+  {
+    SizeType mCutBegin{0};    // mCutArray 中の先頭位置
+    std::uint32_t mCutNum{0}; // カット数
+    std::uint32_t mLevel{0};  // レベル
+  };
+
+  // カットの葉の数の上限
+  SizeType mCutSize{0};
+
+  // 真理値表のワード数
+  SizeType mTruthWordNum{0};
+
+  // 変数番号をキーにしたノードの情報
+  vector<Node> mNodeList;
+
+  // 全カットの配列
+  vector<Cut> mCutArray;
+
+  // 全カットの葉の配列
+  vector<std::uint32_t> mLeafArray;
+
+  // 全カットの真理値表の配列
+  vector<std::uint64_t> mTruthArray;
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGCUTS_H
@@ -0,0 +1,167 @@
+#ifndef AIGDOMINATORS_H
+#define AIGDOMINATORS_H
+
+/// @file AigDominators.h
+/// @brief AigDominators のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+class ModelImpl;
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigDominators AigDominators.h "ym/AigDominators.h"
+/// @brief 出力方向の支配木と MFFC の大きさを表すクラス
+///
+/// - 出力とラッチのソースを仮想的な根につないだ DAG 上で，
+///   根に向かう全ての経路が通る変数を支配ノードとする．
+///   ファンアウトを持たない変数も根につながっているものとみなす．
+/// - 値は変数番号をキーにした配列で持つ．
+///   直接支配ノードが仮想的な根の場合は var_num() となる．
+/// - 変数 v の MFFC (maximum fanout-free cone) は v が支配する
+///   ANDノードの集合に等しいので，その大きさは支配木の部分木に
+///   含まれるANDノード数として求める．
+//////////////////////////////////////////////////////////////////////
+class AigDominators
+{
+  friend class AigModel;
+
+public:
+
+  /// @brief 空のコンストラクタ
+  AigDominators() = default;
+
+  /// @brief デストラクタ
+  ~AigDominators() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 変数番号の最大値 + 1 を返す．
+  ///
+  /// 仮想的な根を表す値でもある．
+  SizeType
+  var_num() const
+  {
+    return mIdom.size();
+  }
+
+  /// @brief 直接支配ノードを返す．
+  ///
+  /// 仮想的な根の場合は var_num() を返す．
+  SizeType
+  idom(
+    SizeType var ///< [in] 変数番号 ( 0 <= var < var_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= var && var < var_num() );
+    return mIdom[var];
+  }
+
+  /// @brief 支配木での深さを返す．
+  ///
+  /// 仮想的な根の子供の深さが 1 となる．
+  SizeType
+  depth(
+    SizeType var ///< [in] 変数番号 ( 0 <= var < var_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= var && var < var_num() );
+    return mDepth[var];
+  }
+
+  /// @brief var1 が var2 を支配している時 true を返す．
+  ///
+  /// var1 == var2 の時も true を返す．
+  bool
+  dominates(
+    SizeType var1, ///< [in] 変数番号1 ( 0 <= var1 < var_num() )
+    SizeType var2  ///< [in] 変数番号2 ( 0 <= var2 < var_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= var1 && var1 < var_num() );
+    ASSERT_COND( 0 <= var2 && var2 < var_num() );
+    return mPreOrder[var1] <= mPreOrder[var2]
+      && mPreOrder[var2] < mPreOrder[var1] + mTreeSize[var1];
+  }
+
+  /// @brief MFFC に含まれるANDノード数を返す．
+  ///
+  /// var 自身がANDノードの場合はそれも数える．
+  SizeType
+  mffc_size(
+    SizeType var ///< [in] 変数番号 ( 0 <= var < var_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= var && var < var_num() );
+    return mMffcSize[var];
+  }
+
+  /// @brief 直接支配ノードの配列を返す．
+  const vector<SizeType>&
+  idom_array() const
+  {
+    return mIdom;
+  }
+
+  /// @brief 支配木での深さの配列を返す．
+  const vector<SizeType>&
+  depth_array() const
+  {
+    return mDepth;
+  }
+
+  /// @brief MFFC の大きさの配列を返す．
+  const vector<SizeType>&
+  mffc_size_array() const
+  {
+    return mMffcSize;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 支配木と MFFC の大きさを求める．
+  void
+  compute(
+    const ModelImpl& model ///< [in] 対象のモデル
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 変数ごとの直接支配ノード
+  vector<SizeType> mIdom;
+
+  // 変数ごとの支配木での深さ
+  vector<SizeType> mDepth;
+
+  // 変数ごとの支配木の先行順の番号
+  vector<SizeType> mPreOrder;
+
+  // 変数ごとの支配木の部分木の大きさ
+  vector<SizeType> mTreeSize;
+
+  // 変数ごとの MFFC の大きさ
+  vector<SizeType> mMffcSize;
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGDOMINATORS_H
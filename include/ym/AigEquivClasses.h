@@ -0,0 +1,157 @@
+#ifndef AIGEQUIVCLASSES_H
+#define AIGEQUIVCLASSES_H
+
+/// @file AigEquivClasses.h
+/// @brief AigEquivClasses のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+#include "ym/AigEquivOpt.h"
+#include <cstdint>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+class ModelImpl;
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigEquivClasses AigEquivClasses.h "ym/AigEquivClasses.h"
+/// @brief シミュレーションで求めた等価候補のクラスを表すクラス
+///
+/// - 全てのパタンで値が等しい(または全て反転している)ノードを
+///   同じクラスにまとめたもので，等価性は保証されない．
+/// - 定数，入力，ラッチ，ANDノード(トポロジカル順)の順で最初に現れる
+///   ノードをクラスの代表とする．
+/// - クラスの要素は代表に対する極性を含めたリテラルで表す．
+///   先頭の要素は代表で，極性は常に正となる．
+/// - 要素が1つのクラスは含まない．
+/// - 併合表は変数番号をキーにして代表のリテラルを 32 ビットで保持する．
+///   クラスに含まれない変数と代表の変数は自身の正のリテラルとなる．
+//////////////////////////////////////////////////////////////////////
+class AigEquivClasses
+{
+  friend class AigModel;
+
+public:
+
+  /// @brief 空のコンストラクタ
+  AigEquivClasses() = default;
+
+  /// @brief デストラクタ
+  ~AigEquivClasses() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 変数番号の最大値 + 1 を返す．
+  SizeType
+  var_num() const
+  {
+    return mMergeMap.size();
+  }
+
+  /// @brief クラス数を返す．
+  SizeType
+  class_num() const
+  {
+    return mClassBegin.size() - 1;
+  }
+
+  /// @brief クラスの要素数を返す．
+  SizeType
+  class_size(
+    SizeType id ///< [in] クラス番号 ( 0 <= id < class_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= id && id < class_num() );
+    return mClassBegin[id + 1] - mClassBegin[id];
+  }
+
+  /// @brief クラスの要素を返す．
+  SizeType
+  class_lit(
+    SizeType id, ///< [in] クラス番号 ( 0 <= id < class_num() )
+    SizeType pos ///< [in] 位置 ( 0 <= pos < class_size(id) )
+  ) const
+  {
+    ASSERT_COND( 0 <= pos && pos < class_size(id) );
+    return mLitArray[mClassBegin[id] + pos];
+  }
+
+  /// @brief クラスの要素のリストを返す．
+  vector<SizeType>
+  class_lit_list(
+    SizeType id ///< [in] クラス番号 ( 0 <= id < class_num() )
+  ) const;
+
+  /// @brief 代表でない要素の総数を返す．
+  ///
+  /// 全てのクラスを併合した時に減るノード数となる．
+  SizeType
+  merge_num() const
+  {
+    return mLitArray.size() - class_num();
+  }
+
+  /// @brief 変数の代表のリテラルを返す．
+  SizeType
+  merge_lit(
+    SizeType var ///< [in] 変数番号 ( 0 <= var < var_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= var && var < var_num() );
+    return mMergeMap[var];
+  }
+
+  /// @brief 併合表を返す．
+  const vector<std::uint32_t>&
+  merge_map() const
+  {
+    return mMergeMap;
+  }
+
+  /// @brief 内容を出力する．
+  void
+  print(
+    ostream& s ///< [in] 出力先のストリーム
+  ) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 等価候補のクラスを求める．
+  void
+  compute(
+    const ModelImpl& model, ///< [in] 対象のモデル
+    const AigEquivOpt& opt  ///< [in] オプション
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // クラスごとの mLitArray 中の先頭位置(末尾に番兵を持つ)
+  vector<SizeType> mClassBegin{0};
+
+  // 全クラスの要素の配列
+  vector<SizeType> mLitArray;
+
+  // 変数番号をキーにした代表のリテラル
+  vector<std::uint32_t> mMergeMap;
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGEQUIVCLASSES_H
@@ -0,0 +1,44 @@
+#ifndef AIGEQUIVOPT_H
+#define AIGEQUIVOPT_H
+
+/// @file AigEquivOpt.h
+/// @brief AigEquivOpt のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+#include <cstdint>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigEquivOpt AigEquivOpt.h "ym/AigEquivOpt.h"
+/// @brief AigModel::find_equiv_classes() のオプションを表す構造体
+//////////////////////////////////////////////////////////////////////
+struct AigEquivOpt
+{
+  /// @brief 1ラウンドあたりの変数ごとのワード数
+  ///
+  /// 1ラウンドで 64 * word_num 個のパタンをシミュレーションする．
+  /// メモリ量は(変数の数) * word_num * 8 バイトとなる．
+  SizeType word_num{2};
+
+  /// @brief ラウンド数
+  SizeType round_num{8};
+
+  /// @brief 乱数の種
+  std::uint64_t seed{1};
+
+  /// @brief スレッド数
+  ///
+  /// 0 の時はハードウェアの並列度を用いる．
+  SizeType thread_num{0};
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGEQUIVOPT_H
@@ -0,0 +1,48 @@
+#ifndef AIGFALSIFYOPT_H
+#define AIGFALSIFYOPT_H
+
+/// @file AigFalsifyOpt.h
+/// @brief AigFalsifyOpt のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+#include <cstdint>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigFalsifyOpt AigFalsifyOpt.h "ym/AigFalsifyOpt.h"
+/// @brief AigModel::falsify() のオプションを表す構造体
+//////////////////////////////////////////////////////////////////////
+struct AigFalsifyOpt
+{
+  /// @brief 1ラウンドあたりの変数ごとのワード数
+  ///
+  /// 1ラウンドで 64 * word_num 個の系列を同時にシミュレーションする．
+  SizeType word_num{4};
+
+  /// @brief ラウンド数の上限
+  SizeType round_num{256};
+
+  /// @brief 1ラウンドでシミュレーションする時刻数
+  ///
+  /// ラッチを持たないモデルでは 1 でよい．
+  SizeType cycle_num{1};
+
+  /// @brief 乱数の種
+  std::uint64_t seed{1};
+
+  /// @brief スレッド数
+  ///
+  /// 0 の時はハードウェアの並列度を用いる．
+  SizeType thread_num{0};
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGFALSIFYOPT_H
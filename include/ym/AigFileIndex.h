@@ -0,0 +1,221 @@
+#ifndef AIGFILEINDEX_H
+#define AIGFILEINDEX_H
+
+/// @file AigFileIndex.h
+/// @brief AigFileIndex のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigFileIndex AigFileIndex.h "ym/AigFileIndex.h"
+/// @brief バイナリ AIG ファイル中のANDノードの位置の索引
+///
+/// interval 個おきのANDノードのファイル上のバイト位置と
+/// シンボルテーブルの位置を保持する．
+/// これを用いると先行するANDノードを復号せずに任意の範囲の
+/// ANDノードを復号したり，複数のスレッドで分担して復号したりできる．
+///
+/// 索引は元のファイル名に ".idx" を付けた名前のファイルに保存され，
+/// 元のファイルのサイズと更新時刻が一致する場合に再利用される．
+/// バイト位置を用いるので非圧縮のファイルにのみ用いることができる．
+//////////////////////////////////////////////////////////////////////
+class AigFileIndex
+{
+public:
+
+  /// @brief 空のコンストラクタ
+  AigFileIndex() = default;
+
+  /// @brief デストラクタ
+  ~AigFileIndex() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 索引の生成と保存
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ファイルを走査して索引を作る．
+  ///
+  /// 失敗したら std::invalid_argument 例外を送出する．
+  /// interval が 0 の時も std::invalid_argument 例外を送出する．
+  static
+  AigFileIndex
+  build(
+    const string& filename,  ///< [in] AIG ファイル名
+    SizeType interval = 4096 ///< [in] チェックポイントの間隔
+  );
+
+  /// @brief 索引を得る．
+  ///
+  /// - 有効な索引ファイルがあればそれを読み込む．
+  /// - 無ければ build() で作って保存する．保存に失敗しても
+  ///   作った索引は返す．
+  /// - 失敗したら std::invalid_argument 例外を送出する．
+  static
+  AigFileIndex
+  open(
+    const string& filename,  ///< [in] AIG ファイル名
+    SizeType interval = 4096 ///< [in] 新たに作る場合のチェックポイントの間隔
+  );
+
+  /// @brief 索引ファイル名を返す．
+  static
+  string
+  index_filename(
+    const string& filename ///< [in] AIG ファイル名
+  );
+
+  /// @brief 索引ファイルに保存する．
+  ///
+  /// 失敗したら std::invalid_argument 例外を送出する．
+  void
+  save() const;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 内容を取得する関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief AIG ファイル名を返す．
+  const string&
+  filename() const
+  {
+    return mFilename;
+  }
+
+  /// @brief 入力数を得る．
+  SizeType
+  I() const
+  {
+    return mI;
+  }
+
+  /// @brief ラッチ数を得る．
+  SizeType
+  L() const
+  {
+    return mL;
+  }
+
+  /// @brief 出力数を得る．
+  SizeType
+  O() const
+  {
+    return mO;
+  }
+
+  /// @brief ANDノード数を返す．
+  SizeType
+  A() const
+  {
+    return mA;
+  }
+
+  /// @brief チェックポイントの間隔を返す．
+  SizeType
+  interval() const
+  {
+    return mInterval;
+  }
+
+  /// @brief ブロック数を返す．
+  ///
+  /// k 番目のブロックは k * interval() 番目から始まる
+  /// (最後のブロックを除いて) interval() 個のANDノードからなる．
+  SizeType
+  block_num() const
+  {
+    return mOffsetList.size() - 1;
+  }
+
+  /// @brief ブロックの先頭のバイト位置を返す．
+  ///
+  /// block_offset(block_num()) はシンボルテーブルの位置となる．
+  SizeType
+  block_offset(
+    SizeType k ///< [in] ブロック番号 ( 0 <= k <= block_num() )
+  ) const
+  {
+    ASSERT_COND( k < mOffsetList.size() );
+    return mOffsetList[k];
+  }
+
+  /// @brief シンボルテーブルのバイト位置を返す．
+  SizeType
+  symbol_offset() const
+  {
+    return mOffsetList.back();
+  }
+
+  /// @brief ANDノードの範囲を復号する．
+  ///
+  /// - pos 番目から num 個のANDノードのリテラル，ソース1，ソース2を
+  ///   この順で並べたリスト(長さ 3 * num)を返す．
+  /// - 読み込みに失敗したら std::invalid_argument 例外を送出する．
+  vector<SizeType>
+  read_ands(
+    SizeType pos, ///< [in] 先頭のANDノード番号
+    SizeType num  ///< [in] ANDノード数
+  ) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 索引ファイルを読み込む．
+  /// @return 元のファイルに対して有効な索引を読み込めたら true を返す．
+  bool
+  load(
+    const string& filename ///< [in] AIG ファイル名
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // AIG ファイル名
+  string mFilename;
+
+  // AIG ファイルのサイズ
+  SizeType mFileSize{0};
+
+  // AIG ファイルの更新時刻(ナノ秒)
+  SizeType mMTime{0};
+
+  // 入力数
+  SizeType mI{0};
+
+  // ラッチ数
+  SizeType mL{0};
+
+  // 出力数
+  SizeType mO{0};
+
+  // ANDノード数
+  SizeType mA{0};
+
+  // チェックポイントの間隔
+  SizeType mInterval{1};
+
+  // ブロックの先頭のバイト位置のリスト
+  // 末尾にシンボルテーブルの位置を加える．
+  vector<SizeType> mOffsetList{0};
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGFILEINDEX_H
@@ -0,0 +1,288 @@
+#ifndef AIGINCRSIM_H
+#define AIGINCRSIM_H
+
+/// @file AigIncrSim.h
+/// @brief AigIncrSim のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+#include <cstdint>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+class ModelImpl;
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigIncrSim AigIncrSim.h "ym/AigIncrSim.h"
+/// @brief イベントドリブンの差分シミュレータ
+///
+/// - 変数ごとに 64 パタン分(1ワード)の値を保持する．
+/// - set_input() や set_latch() で値を変えると，その変数のファンアウトが
+///   レベルごとのバケツ(待ち行列)に積まれる．update() はバケツを
+///   レベルの小さい順に処理し，値の変わったノードのファンアウトだけを
+///   再計算する．
+/// - 計算量は値の変わったノードとそのファンアウトの数に比例し，
+///   ANDノード数には依存しない．
+/// - 作成時には全ての入力とラッチの値を 0 として計算した状態となる．
+/// - モデルの情報は全て内部にコピーするので元の AigModel とは独立している．
+//////////////////////////////////////////////////////////////////////
+class AigIncrSim
+{
+  friend class AigModel;
+
+public:
+
+  /// @brief 空のコンストラクタ
+  AigIncrSim() = default;
+
+  /// @brief デストラクタ
+  ~AigIncrSim() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 入力数を返す．
+  SizeType
+  input_num() const
+  {
+    return mInputList.size();
+  }
+
+  /// @brief ラッチ数を返す．
+  SizeType
+  latch_num() const
+  {
+    return mLatchList.size();
+  }
+
+  /// @brief 出力数を返す．
+  SizeType
+  output_num() const
+  {
+    return mOutputSrcList.size();
+  }
+
+  /// @brief 入力の値を設定する．
+  ///
+  /// 変化は update() を呼ぶまで伝搬されない．
+  void
+  set_input(
+    SizeType pos,      ///< [in] 入力番号 ( 0 <= pos < input_num() )
+    std::uint64_t val  ///< [in] 値
+  )
+  {
+    ASSERT_COND( 0 <= pos && pos < input_num() );
+    set_value(mInputList[pos], val);
+  }
+
+  /// @brief 入力の値を反転させる．
+  ///
+  /// 変化は update() を呼ぶまで伝搬されない．
+  void
+  flip_input(
+    SizeType pos,      ///< [in] 入力番号 ( 0 <= pos < input_num() )
+    std::uint64_t mask ///< [in] 反転させるビットのマスク
+  )
+  {
+    ASSERT_COND( 0 <= pos && pos < input_num() );
+    auto var = mInputList[pos];
+    set_value(var, mValArray[var] ^ mask);
+  }
+
+  /// @brief ラッチ(現状態)の値を設定する．
+  ///
+  /// 変化は update() を呼ぶまで伝搬されない．
+  void
+  set_latch(
+    SizeType pos,      ///< [in] ラッチ番号 ( 0 <= pos < latch_num() )
+    std::uint64_t val  ///< [in] 値
+  )
+  {
+    ASSERT_COND( 0 <= pos && pos < latch_num() );
+    set_value(mLatchList[pos], val);
+  }
+
+  /// @brief 変化を伝搬させる．
+  ///
+  /// 値の変わった出力番号のリスト(昇順)を返す．
+  /// 前回の update() の時点と値が同じものは含まない．
+  const vector<SizeType>&
+  update();
+
+  /// @brief ラッチの値を次状態の値で置き換えて update() を行う．
+  const vector<SizeType>&
+  step();
+
+  /// @brief 入力の値を返す．
+  std::uint64_t
+  input_value(
+    SizeType pos ///< [in] 入力番号 ( 0 <= pos < input_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= pos && pos < input_num() );
+    return mValArray[mInputList[pos]];
+  }
+
+  /// @brief ラッチ(現状態)の値を返す．
+  std::uint64_t
+  latch_value(
+    SizeType pos ///< [in] ラッチ番号 ( 0 <= pos < latch_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= pos && pos < latch_num() );
+    return mValArray[mLatchList[pos]];
+  }
+
+  /// @brief ラッチの次状態の値を返す．
+  ///
+  /// update() の後でのみ意味を持つ．
+  std::uint64_t
+  latch_next_value(
+    SizeType pos ///< [in] ラッチ番号 ( 0 <= pos < latch_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= pos && pos < latch_num() );
+    return lit_value(mLatchSrcList[pos]);
+  }
+
+  /// @brief 出力の値を返す．
+  ///
+  /// update() の後でのみ意味を持つ．
+  std::uint64_t
+  output_value(
+    SizeType pos ///< [in] 出力番号 ( 0 <= pos < output_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= pos && pos < output_num() );
+    return lit_value(mOutputSrcList[pos]);
+  }
+
+  /// @brief リテラルの値を返す．
+  std::uint64_t
+  lit_value(
+    SizeType lit ///< [in] リテラル
+  ) const
+  {
+    ASSERT_COND( 0 <= lit / 2 && lit / 2 < mValArray.size() );
+    auto v = mValArray[lit / 2];
+    return (lit % 2) ? ~v : v;
+  }
+
+  /// @brief 直前の update() で計算したANDノード数を返す．
+  SizeType
+  eval_num() const
+  {
+    return mEvalNum;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 初期化する．
+  void
+  initialize(
+    const ModelImpl& model ///< [in] 対象のモデル
+  );
+
+  /// @brief 入力かラッチの値を設定する．
+  void
+  set_value(
+    SizeType var,
+    std::uint64_t val
+  );
+
+  /// @brief 変数のファンアウトをバケツに積む．
+  void
+  schedule_fanouts(
+    SizeType var
+  );
+
+  /// @brief 変数に接続している出力を変化の候補にする．
+  void
+  mark_outputs(
+    SizeType var
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ANDノードのファンインのリテラル
+  // 変数番号 * 2 + 0/1 でアクセスする．
+  // ANDノード以外の変数の値は使わない．
+  vector<std::uint32_t> mFaninArray;
+
+  // 変数ごとのレベル
+  vector<std::uint32_t> mLevelArray;
+
+  // 変数ごとの mFanoutArray 中の先頭位置(末尾に番兵を持つ)
+  vector<std::uint32_t> mFanoutBegin;
+
+  // 全変数のファンアウト(ANDノードの変数番号)の配列
+  vector<std::uint32_t> mFanoutArray;
+
+  // 変数ごとの mOutputArray 中の先頭位置(末尾に番兵を持つ)
+  vector<std::uint32_t> mOutputBegin;
+
+  // 全変数の接続している出力番号の配列
+  vector<std::uint32_t> mOutputArray;
+
+  // 入力の変数番号のリスト
+  vector<SizeType> mInputList;
+
+  // ラッチの変数番号のリスト
+  vector<SizeType> mLatchList;
+
+  // ラッチの次状態のリテラルのリスト
+  vector<SizeType> mLatchSrcList;
+
+  // 出力のリテラルのリスト
+  vector<SizeType> mOutputSrcList;
+
+  // 変数ごとの値
+  vector<std::uint64_t> mValArray;
+
+  // 直前の update() の時点での出力の値
+  vector<std::uint64_t> mOutputValList;
+
+  // レベルごとのバケツ
+  vector<vector<std::uint32_t>> mBucketList;
+
+  // バケツに積まれている時 true となるフラグ
+  vector<bool> mQueued;
+
+  // 変化の候補の出力番号のリスト
+  vector<SizeType> mCandList;
+
+  // 変化の候補になっている時 true となるフラグ
+  vector<bool> mCandMark;
+
+  // 値の変わった出力番号のリスト
+  vector<SizeType> mChangedList;
+
+  // バケツに積まれている最小のレベル
+  SizeType mMinLevel{0};
+
+  // バケツに積まれている最大のレベル
+  SizeType mMaxLevel{0};
+
+  // 直前の update() で計算したANDノード数
+  SizeType mEvalNum{0};
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGINCRSIM_H
@@ -0,0 +1,248 @@
+#ifndef AIGLATCHGRAPH_H
+#define AIGLATCHGRAPH_H
+
+/// @file AigLatchGraph.h
+/// @brief AigLatchGraph のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+#include "ym/AigLatchGraphOpt.h"
+#include <cstdint>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+class ModelImpl;
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigLatchGraph AigLatchGraph.h "ym/AigLatchGraph.h"
+/// @brief ラッチ間の依存グラフと強連結成分を表すクラス
+///
+/// - ラッチ u の出力から組み合わせ回路を通ってラッチ v のソースに
+///   到達できる時，u を v のファンインとする(u -> v の枝)．
+/// - ファンインとファンアウトはラッチ番号の昇順に並んだ
+///   32 ビットの配列(CSR形式)で持つ．
+/// - 強連結成分(SCC)はファンイン側が先になるトポロジカル順に番号を振る．
+///   つまり枝 u -> v があれば scc_id(u) <= scc_id(v) となる．
+//////////////////////////////////////////////////////////////////////
+class AigLatchGraph
+{
+  friend class AigModel;
+
+public:
+
+  /// @brief 空のコンストラクタ
+  AigLatchGraph() = default;
+
+  /// @brief デストラクタ
+  ~AigLatchGraph() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ラッチ数を返す．
+  SizeType
+  latch_num() const
+  {
+    return mFaninBegin.size() - 1;
+  }
+
+  /// @brief 枝の数を返す．
+  SizeType
+  edge_num() const
+  {
+    return mFaninArray.size();
+  }
+
+  /// @brief ファンイン数を返す．
+  SizeType
+  fanin_num(
+    SizeType latch ///< [in] ラッチ番号 ( 0 <= latch < latch_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= latch && latch < latch_num() );
+    return mFaninBegin[latch + 1] - mFaninBegin[latch];
+  }
+
+  /// @brief ファンインのラッチ番号を返す．
+  SizeType
+  fanin(
+    SizeType latch, ///< [in] ラッチ番号 ( 0 <= latch < latch_num() )
+    SizeType pos    ///< [in] 位置 ( 0 <= pos < fanin_num(latch) )
+  ) const
+  {
+    ASSERT_COND( 0 <= pos && pos < fanin_num(latch) );
+    return mFaninArray[mFaninBegin[latch] + pos];
+  }
+
+  /// @brief ファンインのラッチ番号のリストを返す．
+  vector<SizeType>
+  fanin_list(
+    SizeType latch ///< [in] ラッチ番号 ( 0 <= latch < latch_num() )
+  ) const;
+
+  /// @brief ファンアウト数を返す．
+  SizeType
+  fanout_num(
+    SizeType latch ///< [in] ラッチ番号 ( 0 <= latch < latch_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= latch && latch < latch_num() );
+    return mFanoutBegin[latch + 1] - mFanoutBegin[latch];
+  }
+
+  /// @brief ファンアウトのラッチ番号を返す．
+  SizeType
+  fanout(
+    SizeType latch, ///< [in] ラッチ番号 ( 0 <= latch < latch_num() )
+    SizeType pos    ///< [in] 位置 ( 0 <= pos < fanout_num(latch) )
+  ) const
+  {
+    ASSERT_COND( 0 <= pos && pos < fanout_num(latch) );
+    return mFanoutArray[mFanoutBegin[latch] + pos];
+  }
+
+  /// @brief ファンアウトのラッチ番号のリストを返す．
+  vector<SizeType>
+  fanout_list(
+    SizeType latch ///< [in] ラッチ番号 ( 0 <= latch < latch_num() )
+  ) const;
+
+  /// @brief 強連結成分の数を返す．
+  SizeType
+  scc_num() const
+  {
+    return mSccBegin.size() - 1;
+  }
+
+  /// @brief ラッチの属する強連結成分の番号を返す．
+  SizeType
+  scc_id(
+    SizeType latch ///< [in] ラッチ番号 ( 0 <= latch < latch_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= latch && latch < latch_num() );
+    return mSccId[latch];
+  }
+
+  /// @brief 強連結成分の要素数を返す．
+  SizeType
+  scc_size(
+    SizeType id ///< [in] 強連結成分の番号 ( 0 <= id < scc_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= id && id < scc_num() );
+    return mSccBegin[id + 1] - mSccBegin[id];
+  }
+
+  /// @brief 強連結成分の要素のラッチ番号を返す．
+  SizeType
+  scc_latch(
+    SizeType id, ///< [in] 強連結成分の番号 ( 0 <= id < scc_num() )
+    SizeType pos ///< [in] 位置 ( 0 <= pos < scc_size(id) )
+  ) const
+  {
+    ASSERT_COND( 0 <= pos && pos < scc_size(id) );
+    return mSccArray[mSccBegin[id] + pos];
+  }
+
+  /// @brief 強連結成分の要素のラッチ番号のリストを返す．
+  ///
+  /// ラッチ番号の昇順に並んでいる．
+  vector<SizeType>
+  scc_latch_list(
+    SizeType id ///< [in] 強連結成分の番号 ( 0 <= id < scc_num() )
+  ) const;
+
+  /// @brief 強連結成分がループを含む時 true を返す．
+  ///
+  /// 要素が2つ以上あるか，自己ループを持つラッチ1つからなる場合である．
+  bool
+  is_cyclic(
+    SizeType id ///< [in] 強連結成分の番号 ( 0 <= id < scc_num() )
+  ) const;
+
+  /// @brief ファンインの先頭位置の配列を返す．
+  ///
+  /// 要素数は latch_num() + 1 である．
+  const vector<std::uint32_t>&
+  fanin_begin_array() const
+  {
+    return mFaninBegin;
+  }
+
+  /// @brief ファンインの配列を返す．
+  const vector<std::uint32_t>&
+  fanin_array() const
+  {
+    return mFaninArray;
+  }
+
+  /// @brief ラッチごとの強連結成分の番号の配列を返す．
+  const vector<std::uint32_t>&
+  scc_id_array() const
+  {
+    return mSccId;
+  }
+
+  /// @brief 内容を出力する．
+  void
+  print(
+    ostream& s ///< [in] 出力先のストリーム
+  ) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 依存グラフと強連結成分を求める．
+  void
+  compute(
+    const ModelImpl& model,     ///< [in] 対象のモデル
+    const AigLatchGraphOpt& opt ///< [in] オプション
+  );
+
+  /// @brief Tarjan のアルゴリズムで強連結成分を求める．
+  void
+  compute_scc();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ラッチごとの mFaninArray 中の先頭位置(末尾に番兵を持つ)
+  vector<std::uint32_t> mFaninBegin{0};
+
+  // 全ラッチのファンインの配列
+  vector<std::uint32_t> mFaninArray;
+
+  // ラッチごとの mFanoutArray 中の先頭位置(末尾に番兵を持つ)
+  vector<std::uint32_t> mFanoutBegin{0};
+
+  // 全ラッチのファンアウトの配列
+  vector<std::uint32_t> mFanoutArray;
+
+  // ラッチごとの強連結成分の番号
+  vector<std::uint32_t> mSccId;
+
+  // 強連結成分ごとの mSccArray 中の先頭位置(末尾に番兵を持つ)
+  vector<std::uint32_t> mSccBegin{0};
+
+  // 全強連結成分の要素の配列
+  vector<std::uint32_t> mSccArray;
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGLATCHGRAPH_H
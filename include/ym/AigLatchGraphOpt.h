@@ -0,0 +1,31 @@
+#ifndef AIGLATCHGRAPHOPT_H
+#define AIGLATCHGRAPHOPT_H
+
+/// @file AigLatchGraphOpt.h
+/// @brief AigLatchGraphOpt のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigLatchGraphOpt AigLatchGraphOpt.h "ym/AigLatchGraphOpt.h"
+/// @brief AigModel::compute_latch_graph() のオプションを表す構造体
+//////////////////////////////////////////////////////////////////////
+struct AigLatchGraphOpt
+{
+  /// @brief スレッド数
+  ///
+  /// 0 の時はハードウェアの並列度を用いる．
+  SizeType thread_num{0};
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGLATCHGRAPHOPT_H
@@ -0,0 +1,226 @@
+#ifndef AIGLUTNETWORK_H
+#define AIGLUTNETWORK_H
+
+/// @file AigLutNetwork.h
+/// @brief AigLutNetwork のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+#include "ym/AigLutOpt.h"
+#include <cstdint>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+class ModelImpl;
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigLutNetwork AigLutNetwork.h "ym/AigLutNetwork.h"
+/// @brief AigModel を LUT にマッピングした結果を表すクラス
+///
+/// - ノード番号は 0 が定数0，1 から I() が入力，
+///   I() + 1 から I() + L() がラッチ，その後が LUT となる．
+///   LUT はトポロジカル順に並んでいる．
+/// - 出力とラッチのソースはノード番号 * 2 + 極性のリテラルで表す．
+/// - LUT のファンインはノード番号で表し，否定は真理値表に含める．
+/// - LUT の真理値表は i 番目のファンインを変数 i とした lut_size() 変数の
+///   表で，64 ビットのワード単位で保持する．
+/// - 入力，ラッチ，出力の順番は元の AigModel と同じなので
+///   シンボルは元の AigModel から得る．
+//////////////////////////////////////////////////////////////////////
+class AigLutNetwork
+{
+  friend class AigModel;
+
+public:
+
+  /// @brief 空のコンストラクタ
+  AigLutNetwork() = default;
+
+  /// @brief デストラクタ
+  ~AigLutNetwork() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief LUT の入力数の上限を返す．
+  SizeType
+  lut_size() const
+  {
+    return mLutSize;
+  }
+
+  /// @brief 真理値表のワード数を返す．
+  SizeType
+  truth_word_num() const
+  {
+    return mTruthWordNum;
+  }
+
+  /// @brief 入力数を返す．
+  SizeType
+  I() const
+  {
+    return mI;
+  }
+
+  /// @brief ラッチ数を返す．
+  SizeType
+  L() const
+  {
+    return mLatchSrcList.size();
+  }
+
+  /// @brief 出力数を返す．
+  SizeType
+  O() const
+  {
+    return mOutputSrcList.size();
+  }
+
+  /// @brief LUT 数を返す．
+  SizeType
+  lut_num() const
+  {
+    return mFaninBegin.size() - 1;
+  }
+
+  /// @brief 段数を返す．
+  SizeType
+  depth() const
+  {
+    return mDepth;
+  }
+
+  /// @brief LUT のノード番号を返す．
+  SizeType
+  lut_id(
+    SizeType pos ///< [in] LUT 番号 ( 0 <= pos < lut_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= pos && pos < lut_num() );
+    return mI + L() + pos + 1;
+  }
+
+  /// @brief LUT のファンイン数を返す．
+  SizeType
+  lut_fanin_num(
+    SizeType pos ///< [in] LUT 番号 ( 0 <= pos < lut_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= pos && pos < lut_num() );
+    return mFaninBegin[pos + 1] - mFaninBegin[pos];
+  }
+
+  /// @brief LUT のファンインのノード番号を返す．
+  SizeType
+  lut_fanin(
+    SizeType pos, ///< [in] LUT 番号 ( 0 <= pos < lut_num() )
+    SizeType i    ///< [in] ファンイン番号 ( 0 <= i < lut_fanin_num(pos) )
+  ) const
+  {
+    ASSERT_COND( 0 <= i && i < lut_fanin_num(pos) );
+    return mFaninArray[mFaninBegin[pos] + i];
+  }
+
+  /// @brief LUT の真理値表を返す．
+  vector<std::uint64_t>
+  lut_truth(
+    SizeType pos ///< [in] LUT 番号 ( 0 <= pos < lut_num() )
+  ) const;
+
+  /// @brief LUT の真理値表の先頭を返す．
+  ///
+  /// truth_word_num() ワードの領域を指す．
+  const std::uint64_t*
+  lut_truth_ptr(
+    SizeType pos ///< [in] LUT 番号 ( 0 <= pos < lut_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= pos && pos < lut_num() );
+    return &mTruthArray[pos * mTruthWordNum];
+  }
+
+  /// @brief ラッチのソースのリテラルを返す．
+  SizeType
+  latch_src(
+    SizeType pos ///< [in] ラッチ番号 ( 0 <= pos < L() )
+  ) const
+  {
+    ASSERT_COND( 0 <= pos && pos < L() );
+    return mLatchSrcList[pos];
+  }
+
+  /// @brief 出力のソースのリテラルを返す．
+  SizeType
+  output_src(
+    SizeType pos ///< [in] 出力番号 ( 0 <= pos < O() )
+  ) const
+  {
+    ASSERT_COND( 0 <= pos && pos < O() );
+    return mOutputSrcList[pos];
+  }
+
+  /// @brief 内容を出力する．
+  void
+  print(
+    ostream& s ///< [in] 出力先のストリーム
+  ) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief マッピングを行う．
+  void
+  map(
+    const ModelImpl& model, ///< [in] 対象のモデル
+    const AigLutOpt& opt    ///< [in] オプション
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // LUT の入力数の上限
+  SizeType mLutSize{0};
+
+  // 真理値表のワード数
+  SizeType mTruthWordNum{0};
+
+  // 入力数
+  SizeType mI{0};
+
+  // 段数
+  SizeType mDepth{0};
+
+  // LUT ごとのファンインの先頭位置(末尾に全体の大きさを持つ)
+  vector<SizeType> mFaninBegin{0};
+
+  // 全 LUT のファンインの配列
+  vector<std::uint32_t> mFaninArray;
+
+  // 全 LUT の真理値表の配列
+  vector<std::uint64_t> mTruthArray;
+
+  // ラッチのソースのリテラルのリスト
+  vector<SizeType> mLatchSrcList;
+
+  // 出力のソースのリテラルのリスト
+  vector<SizeType> mOutputSrcList;
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGLUTNETWORK_H
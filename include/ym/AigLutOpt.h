@@ -0,0 +1,43 @@
+#ifndef AIGLUTOPT_H
+#define AIGLUTOPT_H
+
+/// @file AigLutOpt.h
+/// @brief AigLutOpt のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigLutOpt AigLutOpt.h "ym/AigLutOpt.h"
+/// @brief AigModel::map_luts() のオプションを表す構造体
+//////////////////////////////////////////////////////////////////////
+struct AigLutOpt
+{
+  /// @brief LUT の入力数( 2 <= lut_size <= 8 )
+  SizeType lut_size{6};
+
+  /// @brief ノードあたりのカット数の上限
+  SizeType cut_limit{8};
+
+  /// @brief 面積フローによる面積回復の繰り返し回数
+  SizeType area_flow_iter{1};
+
+  /// @brief 厳密な面積による面積回復の繰り返し回数
+  SizeType exact_area_iter{1};
+
+  /// @brief カット列挙のスレッド数
+  ///
+  /// 0 の時はハードウェアの並列度を用いる．
+  SizeType thread_num{0};
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGLUTOPT_H
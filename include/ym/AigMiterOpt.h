@@ -0,0 +1,36 @@
+#ifndef AIGMITEROPT_H
+#define AIGMITEROPT_H
+
+/// @file AigMiterOpt.h
+/// @brief AigMiterOpt のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigMiterOpt AigMiterOpt.h "ym/AigMiterOpt.h"
+/// @brief AigModel::make_miter() のオプションを表す構造体
+//////////////////////////////////////////////////////////////////////
+struct AigMiterOpt
+{
+  /// @brief 入力と出力をシンボル名で対応付ける時 true にする．
+  ///
+  /// false の時は番号で対応付ける．
+  bool match_by_name{false};
+
+  /// @brief 全ての出力対の XOR の OR を1つの出力にする時 true にする．
+  ///
+  /// false の時は出力対ごとに XOR を出力とする．
+  bool single_output{true};
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGMITEROPT_H
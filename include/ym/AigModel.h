@@ -9,6 +9,25 @@
 /// All rights reserved.
 
 #include "ym/aig_nsdef.h"
+#include "ym/AigReadOpt.h"
+#include "ym/AigActivity.h"
+#include "ym/AigAndIter.h"
+#include "ym/AigCex.h"
+#include "ym/AigCnf.h"
+#include "ym/AigCuts.h"
+#include "ym/AigDominators.h"
+#include "ym/AigEquivClasses.h"
+#include "ym/AigFalsifyOpt.h"
+#include "ym/AigIncrSim.h"
+#include "ym/AigLatchGraph.h"
+#include "ym/AigLutNetwork.h"
+#include "ym/AigMiterOpt.h"
+#include "ym/AigPartition.h"
+#include "ym/AigSupports.h"
+#include "ym/AigTernaryResult.h"
+#include "ym/AigTruthTables.h"
+#include "ym/AigUnroller.h"
+#include <memory>
 
 
 BEGIN_NAMESPACE_YM_AIG
@@ -20,9 +39,16 @@ class ModelImpl;
 /// @brief AIG 形式のファイルを読み込んだ結果を表すクラス
 ///
 /// 実際の処理は ModelImpl が行う．
+/// ModelImpl は複数の AigModel の間で参照回数付きで共有されるので
+/// コピーは定数時間で行える．共有された ModelImpl は変更されないので
+/// 複数のスレッドから同時に読み出してもよい．
+/// 内容を変更する操作は ModelImpl が共有されている場合には
+/// 複製を作ってから変更を行う(copy-on-write)．
 //////////////////////////////////////////////////////////////////////
 class AigModel
 {
+  friend class AigUnroller;
+
 private:
 
   /// @brief コンストラクタ
@@ -32,22 +58,30 @@ private:
 public:
 
   /// @brief コピーコンストラクタ
+  ///
+  /// 内容は共有される．
   AigModel(
     const AigModel& src ///< [in] コピー元のオブジェクト
   );
 
   /// @brief ムーブコンストラクタ
+  ///
+  /// ムーブ元は空のモデルとなる．
   AigModel(
     AigModel&& src ///< [in] ムーブ元のオブジェクト
   );
 
   /// @brief コピー代入文
+  ///
+  /// 内容は共有される．
   AigModel&
   operator=(
     const AigModel& src ///< [in] コピー元のオブジェクト
   );
 
   /// @brief ムーブ代入文
+  ///
+  /// ムーブ元は空のモデルとなる．
   AigModel&
   operator=(
     AigModel&& src ///< [in] ムーブ元のオブジェクト
@@ -65,11 +99,19 @@ public:
 
   /// @brief Ascii AIG フォーマットを読み込む．
   ///
-  /// 読み込みが失敗したら std::invalid_argument 例外を送出する．
+  /// - gzip/zstd/xz で圧縮されたファイルはマジックナンバーで判別して
+  ///   伸長しながら読み込む．
+  /// - opt.async_io が true の時は専用の I/O スレッド(あるいは io_uring)で
+  ///   大きなバッファに先読みを行い，読み込みとパーズを並行に行う．
+  ///   ネットワークファイルシステム上のファイルで有効．
+  /// - opt.cleanup が true の時は読み込んだ直後に cleanup() を行う．
+  /// - opt.thread_num と opt.mem_limit は用いない．
+  /// - 読み込みが失敗したら std::invalid_argument 例外を送出する．
   static
   AigModel
   read_aag(
-    const string& filename ///< [in] ファイル名
+    const string& filename,              ///< [in] ファイル名
+    const AigReadOpt& opt = AigReadOpt{} ///< [in] オプション
   );
 
   /// @brief Ascii AIG フォーマットを読み込む．
@@ -83,11 +125,19 @@ public:
 
   /// @brief AIG フォーマットを読み込む．
   ///
-  /// 読み込みが失敗したら std::invalid_argument 例外を送出する．
+  /// - gzip/zstd/xz で圧縮されたファイルはマジックナンバーで判別して
+  ///   伸長しながら読み込む．
+  /// - opt.async_io が true の時は専用の I/O スレッド(あるいは io_uring)で
+  ///   大きなバッファに先読みを行い，読み込みとパーズを並行に行う．
+  ///   ネットワークファイルシステム上のファイルで有効．
+  /// - opt.cleanup が true の時は読み込んだ直後に cleanup() を行う．
+  /// - opt.thread_num と opt.mem_limit は用いない．
+  /// - 読み込みが失敗したら std::invalid_argument 例外を送出する．
   static
   AigModel
   read_aig(
-    const string& filename ///< [in] ファイル名
+    const string& filename,              ///< [in] ファイル名
+    const AigReadOpt& opt = AigReadOpt{} ///< [in] オプション
   );
 
   /// @brief AIG フォーマットを読み込む．
@@ -99,6 +149,87 @@ public:
     istream& s ///< [in] 入力ストリーム
   );
 
+  /// @brief 索引を用いて AIG フォーマットを並列に読み込む．
+  ///
+  /// - AND行をチェックポイントごとのブロックに分けて，
+  ///   複数のスレッドで復号する．
+  /// - 非圧縮の AIG ファイルのみが対象となる．
+  /// - 読み込みが失敗したら std::invalid_argument 例外を送出する．
+  static
+  AigModel
+  read_aig(
+    const AigFileIndex& index, ///< [in] 索引
+    SizeType thread_num = 0    ///< [in] スレッド数(0 の時はハードウェアの並列度)
+  );
+
+  /// @brief 複数のファイルを並列に読み込む．
+  /// @return 読み込んだ AigModel のリストを返す．
+  ///
+  /// - 形式は拡張子(.aag/.aig，圧縮形式の拡張子は除く)で判別し，
+  ///   判別できない場合はヘッダで判別する．
+  /// - 返り値と error_list は filename_list と同じ順序で同じ長さとなる．
+  /// - 読み込みに失敗したファイルに対応する要素は空の AigModel となり，
+  ///   error_list にエラーメッセージが入る．成功した場合は空文字列となる．
+  static
+  vector<AigModel>
+  read_many(
+    const vector<string>& filename_list, ///< [in] ファイル名のリスト
+    vector<string>& error_list,          ///< [out] エラーメッセージのリスト
+    const AigReadOpt& opt = AigReadOpt{} ///< [in] オプション
+  );
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name スナップショット
+  /// @{
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief スナップショットを書き出す．
+  ///
+  /// - スナップショットは ModelImpl の内容をそのまま書き出した
+  ///   独自形式のファイルで，open_snapshot() で読み込む．
+  /// - 書き込みが失敗したら std::invalid_argument 例外を送出する．
+  void
+  save_snapshot(
+    const string& filename ///< [in] ファイル名
+  ) const;
+
+  /// @brief 分割ごとの影響範囲をスナップショットとして書き出す．
+  ///
+  /// - 分割ごとに extract_cone() で取り出して save_snapshot() で
+  ///   書き出す．これを thread_num 個のスレッドで並列に行うので，
+  ///   同時に保持する部分回路は高々 thread_num 個となる．
+  /// - filename_list は分割番号の順のファイル名のリストで，
+  ///   partition の分割数と同じ長さでなければならない．
+  /// - 引数が不正な場合や書き込みが失敗した場合は
+  ///   std::invalid_argument 例外を送出する．
+  void
+  save_partitions(
+    const AigPartition& partition,         ///< [in] partition_outputs() の結果
+    const vector<string>& filename_list,   ///< [in] ファイル名のリスト
+    SizeType thread_num = 0                ///< [in] スレッド数(0 の時はハードウェアの並列度)
+  ) const;
+
+  /// @brief スナップショットを開く．
+  ///
+  /// - ファイルを読み出し専用で mmap() し，ANDノードの配列は
+  ///   パーズせずにそのまま参照する．同じファイルを開いた
+  ///   複数のプロセスの間でページキャッシュが共有される．
+  /// - 入力，ラッチ，出力の情報とシンボルはメモリ上に展開する．
+  /// - verify が true の時はチェックサムとヘッダの記録を検証する．
+  ///   この場合はファイル全体を読むことになる．
+  /// - 不正なファイルの場合は std::invalid_argument 例外を送出する．
+  static
+  AigModel
+  open_snapshot(
+    const string& filename, ///< [in] ファイル名
+    bool verify = false     ///< [in] チェックサムを検証する時 true
+  );
+
   /// @}
   //////////////////////////////////////////////////////////////////////
 
@@ -170,6 +301,17 @@ public:
     SizeType pos ///< [in] ANDノード番号 ( 0 <= pos < A() )
   ) const;
 
+  /// @brief ANDノードの先頭の反復子を返す．
+  ///
+  /// ANDノードのリストが圧縮表現の場合は and_node() などで
+  /// 順に参照するよりもこちらの方が効率がよい．
+  AigAndIter
+  and_begin() const;
+
+  /// @brief ANDノードの末尾の反復子を返す．
+  AigAndIter
+  and_end() const;
+
   /// @brief 入力のシンボルを得る．
   const string&
   input_symbol(
@@ -199,13 +341,374 @@ public:
   ) const;
 
 
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name ANDノードの圧縮表現
+  /// @{
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ANDノードのリストを圧縮表現にする．
+  ///
+  /// - バイナリ AIG 形式と同様の可変長整数の差分で符号化し，
+  ///   interval 個おきにチェックポイントを置く．
+  /// - 以降 and_node() などは高々 interval 個のノードの復号を伴う．
+  ///   ただし，スレッドごとに直前の位置を覚えているので
+  ///   前から順に参照する場合はノードあたり定数時間となる．
+  /// - 標準的なバイナリ AIG の場合はメモリ量が 1/5 から 1/10 程度になる．
+  /// - interval が 0 の時は std::invalid_argument 例外を送出する．
+  void
+  pack_ands(
+    SizeType interval = 64 ///< [in] チェックポイントの間隔
+  );
+
+  /// @brief ANDノードのリストを展開する．
+  void
+  unpack_ands();
+
+  /// @brief ANDノードのリストが圧縮表現の時 true を返す．
+  bool
+  is_packed() const;
+
+  /// @brief ANDノードのリストが使用しているメモリ量(バイト)を返す．
+  ///
+  /// スナップショットをマッピングしている場合は 0 を返す．
+  SizeType
+  and_memory_size() const;
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name 構造の変換
+  /// @{
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 指定された出力とラッチの影響範囲(cone of influence)を取り出す．
+  /// @return 取り出した部分回路を返す．
+  ///
+  /// - 推移的ファンインに含まれるラッチの次状態関数もたどる．
+  /// - 結果は必要な入力，ラッチ，ANDノードのみからなり，
+  ///   バイナリ AIG と同じ標準形の番号が振り直される．
+  /// - 入力とラッチは元の順番を保ち，シンボルも引き継ぐ．
+  /// - 出力は output_list の順に並ぶ．
+  ///   latch_list で指定されたラッチは出力にはならない．
+  /// - 標準形のモデルでは影響範囲の大きさに比例した時間で行われる．
+  ///   それ以外のモデルでは変数番号の対応表を作る手間がかかる．
+  /// - 番号の範囲外の出力やラッチが指定された場合は
+  ///   std::invalid_argument 例外を送出する．
+  AigModel
+  extract_cone(
+    const vector<SizeType>& output_list,     ///< [in] 出力番号のリスト
+    const vector<SizeType>& latch_list = {} ///< [in] ラッチ番号のリスト
+  ) const;
+
+  /// @brief 分割ごとの影響範囲を取り出す．
+  /// @return 分割番号の順に取り出した部分回路のリストを返す．
+  ///
+  /// - 分割ごとに extract_cone() を thread_num 個のスレッドで並列に行う．
+  /// - partition の出力数が異なる場合は std::invalid_argument 例外を送出する．
+  vector<AigModel>
+  extract_partitions(
+    const AigPartition& partition, ///< [in] partition_outputs() の結果
+    SizeType thread_num = 0        ///< [in] スレッド数(0 の時はハードウェアの並列度)
+  ) const;
+
+  /// @brief 定数の伝搬と不要なANDノードの削除を行う．
+  /// @return 削除されたANDノード数を返す．
+  ///
+  /// - 定数をファンインに持つANDノード，同じリテラルや
+  ///   互いに否定のリテラルをファンインに持つANDノードを畳み込む．
+  /// - 出力とラッチから到達できなくなったANDノードを削除する．
+  /// - 入力，ラッチ，出力の数と順番，シンボルは変わらない．
+  /// - バイナリ AIG と同じ標準形の番号が振り直される．
+  SizeType
+  cleanup();
+
+  /// @brief 構造的に同じANDノードを併合する(structural hashing)．
+  /// @return 削除されたANDノード数を返す．
+  ///
+  /// - ファンインの順番を src1 >= src2 に正規化した上で，
+  ///   トポロジカル順に同じファンインの組を持つANDノードを併合する．
+  /// - 併合されたノードを参照していたラッチや出力は残った方を参照する．
+  /// - 入力，ラッチ，出力の数と順番，シンボルは変わらない．
+  /// - バイナリ AIG と同じ標準形の番号が振り直される．
+  SizeType
+  strash();
+
+  /// @brief 参照の局所性がよくなるようにANDノードの番号を振り直す．
+  ///
+  /// - level_major が false の時は出力，ラッチの順に深さ優先探索を行い，
+  ///   帰りがけ順に番号を振る．ファンインがファンアウトの直前に
+  ///   置かれやすいので出力ごとの処理に向いている．
+  /// - level_major が true の時はレベル順に番号を振り，同じレベル内では
+  ///   ファンインの番号の小さい順に並べる．
+  ///   レベルごとに一斉に処理するシミュレーションなどに向いている．
+  /// - level_major が false の時は出力やラッチから到達できないANDノードは
+  ///   末尾に置かれる．
+  /// - 結果は標準形でトポロジカル順となり，もう一度 reorder() を行っても
+  ///   変わらない．
+  /// - 入力，ラッチ，出力の数と順番，シンボルは変わらない．
+  void
+  reorder(
+    bool level_major = false ///< [in] レベル順に並べる時 true
+  );
+
+  /// @brief 2つのモデルのマイタを作る．
+  ///
+  /// - 入力と出力を番号(opt.match_by_name が true の時はシンボル名)で
+  ///   対応付け，対応する出力の XOR を出力とする．
+  ///   opt.single_output が true の時は全ての XOR の OR を1つの出力とする．
+  /// - 入力の順番とシンボルは model1 のものとなる．
+  ///   ラッチは model1 のラッチの後に model2 のラッチを並べる．
+  /// - 定数の伝搬と構造的ハッシュを行いながら作るので
+  ///   構造の同じ部分は共有される．
+  /// - 入出力の数が異なる場合やシンボル名で対応がとれない場合は
+  ///   std::invalid_argument 例外を送出する．
+  static
+  AigModel
+  make_miter(
+    const AigModel& model1,                ///< [in] モデル1
+    const AigModel& model2,                ///< [in] モデル2
+    const AigMiterOpt& opt = AigMiterOpt{} ///< [in] オプション
+  );
+
+  /// @brief 時間展開を行う展開器を作る．
+  ///
+  /// - opt.frame_num 時刻分を展開した状態で返す．
+  /// - 組み合わせ回路のループがある場合は std::invalid_argument 例外を送出する．
+  AigUnroller
+  make_unroller(
+    const AigUnrollOpt& opt = AigUnrollOpt{} ///< [in] オプション
+  ) const;
+
+  /// @brief 時間展開した組み合わせ回路を返す．
+  ///
+  /// make_unroller(opt).model() と同じ．
+  AigModel
+  unroll(
+    const AigUnrollOpt& opt = AigUnrollOpt{} ///< [in] オプション
+  ) const;
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name 解析
+  /// @{
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief k-feasible カットを列挙する．
+  ///
+  /// - 各ANDノードについてファンインのカットの組み合わせから
+  ///   葉の数が opt.cut_size 以下のカットを作り，
+  ///   シグネチャを用いた支配関係の判定で冗長なカットを除く．
+  /// - ノードあたり opt.cut_limit 個まで葉の数の少ないカットを残す．
+  /// - 同じレベルのノードは複数のスレッドで並列に処理する．
+  /// - opt.cut_size が範囲外の場合は std::invalid_argument 例外を送出する．
+  AigCuts
+  enumerate_cuts(
+    const AigCutOpt& opt = AigCutOpt{} ///< [in] オプション
+  ) const;
+
+  /// @brief k-LUT にマッピングする．
+  ///
+  /// - opt.lut_size 入力のカットを用いて段数最小のマッピングを求めた後，
+  ///   段数を増やさない範囲で面積フローと厳密な面積による面積回復を行う．
+  /// - カットの列挙は opt.thread_num 個のスレッドで並列に行う．
+  /// - opt.lut_size が範囲外の場合は std::invalid_argument 例外を送出する．
+  AigLutNetwork
+  map_luts(
+    const AigLutOpt& opt = AigLutOpt{} ///< [in] オプション
+  ) const;
+
+  /// @brief 出力ごとの真理値表を計算する．
+  ///
+  /// - サポート(コーン内の入力とラッチ)の数が opt.input_limit 以下の
+  ///   出力について，コーンをワード単位のビット演算で評価する．
+  /// - 出力ごとに NPN 変換で不変なハッシュ値も計算する．
+  /// - 出力は opt.thread_num 個のスレッドで並列に処理する．
+  /// - opt.input_limit が範囲外の場合は std::invalid_argument 例外を送出する．
+  AigTruthTables
+  compute_truth_tables(
+    const AigTruthOpt& opt = AigTruthOpt{} ///< [in] オプション
+  ) const;
+
+  /// @brief ランダムシミュレーションで等価候補のクラスを求める．
+  ///
+  /// - 1ラウンドごとに入力とラッチに乱数を与えて全ノードを
+  ///   ビット並列にシミュレーションし，値(反転を同一視する)の
+  ///   ハッシュ値で既存のクラスを細分化する．
+  /// - 1つのラウンドのシミュレーションは opt.thread_num 個の
+  ///   スレッドでレベルごとに並列に行う．
+  AigEquivClasses
+  find_equiv_classes(
+    const AigEquivOpt& opt = AigEquivOpt{} ///< [in] オプション
+  ) const;
+
+  /// @brief ランダムシミュレーションで出力を 1 にする入力系列を探す．
+  ///
+  /// - マイタに対して用いると2つのモデルを区別する入力系列が得られる．
+  /// - ラッチの初期値を 0 として，1ラウンドごとに 64 * opt.word_num 個の
+  ///   乱数系列を opt.cycle_num 時刻分ビット並列にシミュレーションする．
+  /// - ラウンドは互いに独立なので opt.thread_num 個のスレッドで並列に行う．
+  ///   結果はスレッド数によらず，反例の見つかった最も若いラウンドのものとなる．
+  /// - 見つからなかった場合は found が false の結果を返す．
+  AigCex
+  falsify(
+    const AigFalsifyOpt& opt = AigFalsifyOpt{} ///< [in] オプション
+  ) const;
+
+  /// @brief 3値(0, 1, X)のビット並列シミュレーションを行う．
+  ///
+  /// - 値は 0 の線と 1 の線の2線式で表し，64 * opt.word_num 個の
+  ///   パタンを opt.cycle_num 時刻分同時にシミュレーションする．
+  /// - opt.latch_x が true の時はラッチの初期値を X とする．
+  /// - 入力値は opt.input_list で時刻ごとに 0, 1, X, 乱数を指定できる．
+  /// - 入力値の文字列の長さが入力数と異なる場合や不正な文字を含む場合は
+  ///   std::invalid_argument 例外を送出する．
+  AigTernaryResult
+  ternary_simulate(
+    const AigTernaryOpt& opt = AigTernaryOpt{} ///< [in] オプション
+  ) const;
+
+  /// @brief 差分シミュレータを作る．
+  ///
+  /// - 入力やラッチの一部の値を変えて再シミュレーションを繰り返す場合に用いる．
+  /// - 組み合わせ回路のループがある場合は std::invalid_argument 例外を送出する．
+  AigIncrSim
+  make_incr_sim() const;
+
+  /// @brief ランダムシミュレーションで信号確率とスイッチング率を求める．
+  ///
+  /// - ラッチの初期値を 0 として，64 * opt.word_num 個の系列を
+  ///   opt.warmup_num + opt.cycle_num 時刻分ビット並列にシミュレーションし，
+  ///   後半の opt.cycle_num 時刻の値を変数ごとに集計する．
+  /// - 入力の値は opt.input_prob で指定した確率で 1 となる．
+  /// - opt.input_prob の要素数が入力数と異なる場合や範囲外の値を含む場合は
+  ///   std::invalid_argument 例外を送出する．
+  AigActivity
+  estimate_activity(
+    const AigActivityOpt& opt = AigActivityOpt{} ///< [in] オプション
+  ) const;
+
+  /// @brief ラッチ間の依存グラフと強連結成分を求める．
+  ///
+  /// - ラッチごとにソースの推移的ファンインを構造的にたどり，
+  ///   到達したラッチをファンインとする．
+  ///   ラッチごとの探索は opt.thread_num 個のスレッドで並列に行う．
+  /// - 強連結成分は Tarjan のアルゴリズムで求める．
+  AigLatchGraph
+  compute_latch_graph(
+    const AigLatchGraphOpt& opt = AigLatchGraphOpt{} ///< [in] オプション
+  ) const;
+
+  /// @brief 出力とラッチのソースの構造的なサポートを求める．
+  ///
+  /// - 全ノードのサポートをボトムアップに求める．
+  ///   サポートは要素数に応じて昇順のリストかビットベクタで表し，
+  ///   同じ内容のものは共有する．
+  /// - 結果の要素の配列は opt.thread_num 個のスレッドで並列に作る．
+  /// - 組み合わせ回路のループがある場合は std::invalid_argument 例外を送出する．
+  AigSupports
+  compute_supports(
+    const AigSupportOpt& opt = AigSupportOpt{} ///< [in] オプション
+  ) const;
+
+  /// @brief 出力方向の支配木と MFFC の大きさを求める．
+  ///
+  /// - 出力とラッチのソースを根として，トポロジカル順の逆順に
+  ///   ファンアウトの支配ノードの共通祖先を求める．
+  /// - MFFC の大きさは支配木の部分木のANDノード数として求める．
+  /// - 組み合わせ回路のループがある場合は std::invalid_argument 例外を送出する．
+  AigDominators
+  compute_dominators() const;
+
+  /// @brief 共有する論理の多い出力同士をまとめて分割する．
+  ///
+  /// - 出力ごとの影響範囲のANDノードの集合を min-hash の署名で表す．
+  ///   署名はトポロジカル順にたどって求める．ラッチの次状態関数の
+  ///   署名はラッチ間の依存グラフ(compute_latch_graph())の
+  ///   強連結成分ごとにまとめて求める．
+  /// - 見積もった大きさの大きい出力から順に，署名から見積もった
+  ///   共有部分が最大の分割に加える．ただし，分割の影響範囲の
+  ///   ANDノード数が全体の平均の opt.balance 倍を越える場合は
+  ///   最小の分割に加える．
+  /// - 分割ごとのANDノード数は extract_cone() で取り出した場合の値で，
+  ///   分割ごとの変数のビットベクタを用いて正確に数える．
+  /// - 組み合わせ回路のループがある場合や opt の値が不正な場合は
+  ///   std::invalid_argument 例外を送出する．
+  AigPartition
+  partition_outputs(
+    const AigPartitionOpt& opt = AigPartitionOpt{} ///< [in] オプション
+  ) const;
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name CNF への変換
+  /// @{
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief Tseitin 変換した CNF を DIMACS 形式で書き出す．
+  ///
+  /// - ANDノードごとに3つの節を生成する．
+  ///   opt.polarity が true の時は不要な極性の節を省く．
+  /// - 入力，ラッチ，対象の出力と CNF の変数の対応をコメント行に書く．
+  /// - 節はメモリ上に保持せずに大きなバッファを通して書き出す．
+  /// - 範囲外の出力やラッチが指定された場合や書き込みが失敗した場合は
+  ///   std::invalid_argument 例外を送出する．
+  void
+  write_cnf(
+    const string& filename,            ///< [in] ファイル名
+    const AigCnfOpt& opt = AigCnfOpt{} ///< [in] オプション
+  ) const;
+
+  /// @brief Tseitin 変換した CNF を DIMACS 形式でストリームに書き出す．
+  void
+  write_cnf(
+    ostream& s,                        ///< [in] 出力先のストリーム
+    const AigCnfOpt& opt = AigCnfOpt{} ///< [in] オプション
+  ) const;
+
+  /// @brief Tseitin 変換した CNF をメモリ上に作る．
+  ///
+  /// 範囲外の出力やラッチが指定された場合は
+  /// std::invalid_argument 例外を送出する．
+  AigCnf
+  make_cnf(
+    const AigCnfOpt& opt = AigCnfOpt{} ///< [in] オプション
+  ) const;
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 変更用に実装クラスを得る．
+  ///
+  /// 他の AigModel と共有されている場合には複製を作る．
+  ModelImpl&
+  _impl_for_write();
+
+
 private:
   //////////////////////////////////////////////////////////////////////
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
   // 実装クラス
-  ModelImpl* mImpl;
+  std::shared_ptr<ModelImpl> mImpl;
 
 };
 
@@ -0,0 +1,156 @@
+#ifndef AIGPARTITION_H
+#define AIGPARTITION_H
+
+/// @file AigPartition.h
+/// @brief AigPartition のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+#include "ym/AigPartitionOpt.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+class ModelImpl;
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigPartition AigPartition.h "ym/AigPartition.h"
+/// @brief 出力を共有する論理の多いもの同士でまとめた分割を表すクラス
+///
+/// - 出力ごとに分割番号を持つ．
+/// - 分割ごとの出力番号は昇順に並んだ配列(CSR形式)で持つ．
+/// - 分割ごとのANDノード数は AigModel::extract_cone() で
+///   取り出した場合のANDノード数(ラッチの次状態関数も含む)を表す．
+//////////////////////////////////////////////////////////////////////
+class AigPartition
+{
+  friend class AigModel;
+
+public:
+
+  /// @brief 空のコンストラクタ
+  AigPartition() = default;
+
+  /// @brief デストラクタ
+  ~AigPartition() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 分割数を返す．
+  SizeType
+  partition_num() const
+  {
+    return mAndNum.size();
+  }
+
+  /// @brief 出力数を返す．
+  SizeType
+  output_num() const
+  {
+    return mPartitionId.size();
+  }
+
+  /// @brief 出力の分割番号を返す．
+  SizeType
+  partition_id(
+    SizeType pos ///< [in] 出力番号 ( 0 <= pos < output_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= pos && pos < output_num() );
+    return mPartitionId[pos];
+  }
+
+  /// @brief 分割に含まれる出力数を返す．
+  SizeType
+  output_num(
+    SizeType id ///< [in] 分割番号 ( 0 <= id < partition_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= id && id < partition_num() );
+    return mBegin[id + 1] - mBegin[id];
+  }
+
+  /// @brief 分割に含まれる出力番号を返す．
+  SizeType
+  output(
+    SizeType id, ///< [in] 分割番号 ( 0 <= id < partition_num() )
+    SizeType pos ///< [in] 位置 ( 0 <= pos < output_num(id) )
+  ) const
+  {
+    ASSERT_COND( 0 <= pos && pos < output_num(id) );
+    return mOutputArray[mBegin[id] + pos];
+  }
+
+  /// @brief 分割に含まれる出力番号のリストを返す．
+  vector<SizeType>
+  output_list(
+    SizeType id ///< [in] 分割番号 ( 0 <= id < partition_num() )
+  ) const;
+
+  /// @brief 分割のANDノード数を返す．
+  SizeType
+  and_num(
+    SizeType id ///< [in] 分割番号 ( 0 <= id < partition_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= id && id < partition_num() );
+    return mAndNum[id];
+  }
+
+  /// @brief 全ての分割のANDノード数の和を返す．
+  ///
+  /// 複数の分割に重複して含まれるANDノードはその数だけ数える．
+  SizeType
+  total_and_num() const;
+
+  /// @brief 内容を出力する．
+  void
+  print(
+    ostream& s ///< [in] 出力先のストリーム
+  ) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 分割を求める．
+  void
+  compute(
+    const ModelImpl& model,     ///< [in] 対象のモデル
+    const AigLatchGraph& graph, ///< [in] ラッチ間の依存グラフ
+    const AigPartitionOpt& opt  ///< [in] オプション
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 出力ごとの分割番号
+  vector<SizeType> mPartitionId;
+
+  // 分割ごとの mOutputArray 中の先頭位置
+  // 分割数 + 1 の要素を持つ．
+  vector<SizeType> mBegin;
+
+  // 分割ごとの出力番号の配列
+  vector<SizeType> mOutputArray;
+
+  // 分割ごとのANDノード数
+  vector<SizeType> mAndNum;
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGPARTITION_H
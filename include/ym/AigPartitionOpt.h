@@ -0,0 +1,52 @@
+#ifndef AIGPARTITIONOPT_H
+#define AIGPARTITIONOPT_H
+
+/// @file AigPartitionOpt.h
+/// @brief AigPartitionOpt のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+#include <cstdint>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigPartitionOpt AigPartitionOpt.h "ym/AigPartitionOpt.h"
+/// @brief AigModel::partition_outputs() のオプションを表す構造体
+//////////////////////////////////////////////////////////////////////
+struct AigPartitionOpt
+{
+  /// @brief 分割数
+  SizeType partition_num{2};
+
+  /// @brief min-hash の署名の長さ
+  ///
+  /// 大きいほど共有部分の見積もりが正確になるが，
+  /// 時間とメモリ量は比例して増える．
+  SizeType hash_num{32};
+
+  /// @brief 分割ごとのANDノード数の上限(平均に対する比)
+  ///
+  /// 1.0 以上でなければならない．
+  /// 小さくすると分割の大きさは揃うが，共有する論理が
+  /// 別の分割に入って重複するANDノードが増える．
+  double balance{1.2};
+
+  /// @brief ハッシュ関数の種
+  std::uint64_t seed{1};
+
+  /// @brief スレッド数
+  ///
+  /// ラッチ間の依存グラフを求める際に用いる．
+  /// 0 の時はハードウェアの並列度を用いる．
+  SizeType thread_num{0};
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGPARTITIONOPT_H
@@ -0,0 +1,46 @@
+#ifndef AIGREADOPT_H
+#define AIGREADOPT_H
+
+/// @file AigReadOpt.h
+/// @brief AigReadOpt のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigReadOpt AigReadOpt.h "ym/AigReadOpt.h"
+/// @brief AigModel::read_aag()，read_aig()，read_many() のオプションを表す構造体
+///
+/// thread_num と mem_limit は read_many() でのみ用いられる．
+//////////////////////////////////////////////////////////////////////
+struct AigReadOpt
+{
+  /// @brief スレッド数
+  ///
+  /// 0 の時はハードウェアの並列度を用いる．
+  SizeType thread_num{0};
+
+  /// @brief 同時に読み込み中のファイルの見積もりサイズの上限(バイト)
+  ///
+  /// - 0 の時は制限しない．
+  /// - 見積もりサイズはファイルサイズ(圧縮ファイルの場合はその4倍)
+  /// - 単独で上限を越えるファイルは他に読み込み中のファイルが無い時に読み込む．
+  SizeType mem_limit{0};
+
+  /// @brief 非同期読み込みを行う時 true にする．
+  bool async_io{false};
+
+  /// @brief 読み込み直後に AigModel::cleanup() を行う時 true にする．
+  bool cleanup{false};
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGREADOPT_H
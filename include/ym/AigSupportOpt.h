@@ -0,0 +1,31 @@
+#ifndef AIGSUPPORTOPT_H
+#define AIGSUPPORTOPT_H
+
+/// @file AigSupportOpt.h
+/// @brief AigSupportOpt のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigSupportOpt AigSupportOpt.h "ym/AigSupportOpt.h"
+/// @brief AigModel::compute_supports() のオプションを表す構造体
+//////////////////////////////////////////////////////////////////////
+struct AigSupportOpt
+{
+  /// @brief スレッド数
+  ///
+  /// 0 の時はハードウェアの並列度を用いる．
+  SizeType thread_num{0};
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGSUPPORTOPT_H
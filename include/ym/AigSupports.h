@@ -0,0 +1,177 @@
+#ifndef AIGSUPPORTS_H
+#define AIGSUPPORTS_H
+
+/// @file AigSupports.h
+/// @brief AigSupports のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+#include "ym/AigSupportOpt.h"
+#include <cstdint>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+class ModelImpl;
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigSupports AigSupports.h "ym/AigSupports.h"
+/// @brief 出力とラッチのソースの構造的なサポートを表すクラス
+///
+/// - サポートの要素は入力とラッチで，入力 i を i で，
+///   ラッチ l を input_num() + l で表す．
+/// - 同じサポートは1つにまとめて番号を振り，出力とラッチのソースは
+///   サポート番号を持つ．
+/// - サポートの要素は昇順に並んだ 32 ビットの配列(CSR形式)で持つ．
+//////////////////////////////////////////////////////////////////////
+class AigSupports
+{
+  friend class AigModel;
+
+public:
+
+  /// @brief 空のコンストラクタ
+  AigSupports() = default;
+
+  /// @brief デストラクタ
+  ~AigSupports() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 入力数を返す．
+  SizeType
+  input_num() const
+  {
+    return mInputNum;
+  }
+
+  /// @brief ラッチ数を返す．
+  SizeType
+  latch_num() const
+  {
+    return mLatchSupport.size();
+  }
+
+  /// @brief 出力数を返す．
+  SizeType
+  output_num() const
+  {
+    return mOutputSupport.size();
+  }
+
+  /// @brief 異なるサポートの数を返す．
+  SizeType
+  support_num() const
+  {
+    return mBegin.size() - 1;
+  }
+
+  /// @brief 出力のサポート番号を返す．
+  SizeType
+  output_support(
+    SizeType pos ///< [in] 出力番号 ( 0 <= pos < output_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= pos && pos < output_num() );
+    return mOutputSupport[pos];
+  }
+
+  /// @brief ラッチのソースのサポート番号を返す．
+  SizeType
+  latch_support(
+    SizeType pos ///< [in] ラッチ番号 ( 0 <= pos < latch_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= pos && pos < latch_num() );
+    return mLatchSupport[pos];
+  }
+
+  /// @brief サポートの要素数を返す．
+  SizeType
+  support_size(
+    SizeType id ///< [in] サポート番号 ( 0 <= id < support_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= id && id < support_num() );
+    return mBegin[id + 1] - mBegin[id];
+  }
+
+  /// @brief サポートの要素を返す．
+  SizeType
+  support_elem(
+    SizeType id, ///< [in] サポート番号 ( 0 <= id < support_num() )
+    SizeType pos ///< [in] 位置 ( 0 <= pos < support_size(id) )
+  ) const
+  {
+    ASSERT_COND( 0 <= pos && pos < support_size(id) );
+    return mArray[mBegin[id] + pos];
+  }
+
+  /// @brief サポートの要素のリストを返す．
+  vector<SizeType>
+  support_list(
+    SizeType id ///< [in] サポート番号 ( 0 <= id < support_num() )
+  ) const;
+
+  /// @brief サポートの先頭位置の配列を返す．
+  ///
+  /// 要素数は support_num() + 1 である．
+  const vector<SizeType>&
+  begin_array() const
+  {
+    return mBegin;
+  }
+
+  /// @brief 全サポートの要素の配列を返す．
+  const vector<std::uint32_t>&
+  elem_array() const
+  {
+    return mArray;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief サポートを求める．
+  void
+  compute(
+    const ModelImpl& model,  ///< [in] 対象のモデル
+    const AigSupportOpt& opt ///< [in] オプション
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 入力数
+  SizeType mInputNum{0};
+
+  // 出力ごとのサポート番号
+  vector<std::uint32_t> mOutputSupport;
+
+  // ラッチごとのサポート番号
+  vector<std::uint32_t> mLatchSupport;
+
+  // サポートごとの mArray 中の先頭位置(末尾に番兵を持つ)
+  vector<SizeType> mBegin{0};
+
+  // 全サポートの要素の配列
+  vector<std::uint32_t> mArray;
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGSUPPORTS_H
@@ -0,0 +1,55 @@
+#ifndef AIGTERNARYOPT_H
+#define AIGTERNARYOPT_H
+
+/// @file AigTernaryOpt.h
+/// @brief AigTernaryOpt のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+#include <cstdint>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigTernaryOpt AigTernaryOpt.h "ym/AigTernaryOpt.h"
+/// @brief AigModel::ternary_simulate() のオプションを表す構造体
+//////////////////////////////////////////////////////////////////////
+struct AigTernaryOpt
+{
+  /// @brief 変数ごとのワード数
+  ///
+  /// 64 * word_num 個の系列を同時にシミュレーションする．
+  SizeType word_num{1};
+
+  /// @brief シミュレーションする時刻数
+  SizeType cycle_num{1};
+
+  /// @brief ラッチの初期値を X とする時 true にする．
+  ///
+  /// false の時は 0 となる．
+  bool latch_x{true};
+
+  /// @brief 時刻ごとの入力値のリスト
+  ///
+  /// - 各要素は入力数の長さの文字列で，i 文字目が i 番目の入力の値を表す．
+  /// - '0', '1' はその値を，'X', 'x' は X を，'?' はパタンごとの乱数を表す．
+  /// - 要素数が cycle_num より少ない場合，残りの時刻の入力は全て乱数となる．
+  vector<string> input_list;
+
+  /// @brief 乱数の種
+  std::uint64_t seed{1};
+
+  /// @brief スレッド数
+  ///
+  /// 0 の時はハードウェアの並列度を用いる．
+  SizeType thread_num{0};
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGTERNARYOPT_H
@@ -0,0 +1,150 @@
+#ifndef AIGTERNARYRESULT_H
+#define AIGTERNARYRESULT_H
+
+/// @file AigTernaryResult.h
+/// @brief AigTernaryResult のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+#include "ym/AigTernaryOpt.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+class ModelImpl;
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigTernaryResult AigTernaryResult.h "ym/AigTernaryResult.h"
+/// @brief 3値(0, 1, X)シミュレーションの結果を表すクラス
+///
+/// - 時刻と出力ごとに値が X となったパタン数を持つ．
+/// - 全ての時刻の全てのパタンで X となった出力を X に固定された
+///   (stuck at X)出力とみなす．
+/// - 最後の時刻の後のラッチの状態が X となったパタン数も持つ．
+//////////////////////////////////////////////////////////////////////
+class AigTernaryResult
+{
+  friend class AigModel;
+
+public:
+
+  /// @brief 空のコンストラクタ
+  AigTernaryResult() = default;
+
+  /// @brief デストラクタ
+  ~AigTernaryResult() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 時刻ごとのパタン数を返す．
+  SizeType
+  pattern_num() const
+  {
+    return mPatNum;
+  }
+
+  /// @brief 時刻数を返す．
+  SizeType
+  cycle_num() const
+  {
+    return mCycleNum;
+  }
+
+  /// @brief 出力数を返す．
+  SizeType
+  output_num() const
+  {
+    return mOutputNum;
+  }
+
+  /// @brief ラッチ数を返す．
+  SizeType
+  latch_num() const
+  {
+    return mLatchXCount.size();
+  }
+
+  /// @brief 出力が X となったパタン数を返す．
+  SizeType
+  x_count(
+    SizeType cycle, ///< [in] 時刻 ( 0 <= cycle < cycle_num() )
+    SizeType pos    ///< [in] 出力番号 ( 0 <= pos < output_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= cycle && cycle < cycle_num() );
+    ASSERT_COND( 0 <= pos && pos < output_num() );
+    return mXCount[cycle * mOutputNum + pos];
+  }
+
+  /// @brief 出力が X に固定されている時 true を返す．
+  bool
+  is_stuck_x(
+    SizeType pos ///< [in] 出力番号 ( 0 <= pos < output_num() )
+  ) const;
+
+  /// @brief X に固定されている出力番号のリストを返す．
+  vector<SizeType>
+  stuck_x_list() const;
+
+  /// @brief 最後の時刻の後にラッチが X となっているパタン数を返す．
+  SizeType
+  latch_x_count(
+    SizeType pos ///< [in] ラッチ番号 ( 0 <= pos < latch_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= pos && pos < latch_num() );
+    return mLatchXCount[pos];
+  }
+
+  /// @brief 内容を出力する．
+  void
+  print(
+    ostream& s ///< [in] 出力先のストリーム
+  ) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 3値シミュレーションを行う．
+  void
+  compute(
+    const ModelImpl& model,  ///< [in] 対象のモデル
+    const AigTernaryOpt& opt ///< [in] オプション
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 時刻ごとのパタン数
+  SizeType mPatNum{0};
+
+  // 時刻数
+  SizeType mCycleNum{0};
+
+  // 出力数
+  SizeType mOutputNum{0};
+
+  // 時刻と出力ごとの X となったパタン数
+  vector<SizeType> mXCount;
+
+  // ラッチごとの最後の状態が X となったパタン数
+  vector<SizeType> mLatchXCount;
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGTERNARYRESULT_H
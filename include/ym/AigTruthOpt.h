@@ -0,0 +1,36 @@
+#ifndef AIGTRUTHOPT_H
+#define AIGTRUTHOPT_H
+
+/// @file AigTruthOpt.h
+/// @brief AigTruthOpt のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigTruthOpt AigTruthOpt.h "ym/AigTruthOpt.h"
+/// @brief AigModel::compute_truth_tables() のオプションを表す構造体
+//////////////////////////////////////////////////////////////////////
+struct AigTruthOpt
+{
+  /// @brief 真理値表を計算する出力のサポート数の上限( 0 <= input_limit <= 20 )
+  ///
+  /// これを超える出力の真理値表は計算しない．
+  SizeType input_limit{16};
+
+  /// @brief スレッド数
+  ///
+  /// 0 の時はハードウェアの並列度を用いる．
+  SizeType thread_num{0};
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGTRUTHOPT_H
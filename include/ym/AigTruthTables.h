@@ -0,0 +1,204 @@
+#ifndef AIGTRUTHTABLES_H
+#define AIGTRUTHTABLES_H
+
+/// @file AigTruthTables.h
+/// @brief AigTruthTables のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+#include "ym/AigTruthOpt.h"
+#include <cstdint>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+class ModelImpl;
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigTruthTables AigTruthTables.h "ym/AigTruthTables.h"
+/// @brief AigModel の出力ごとの論理関数(真理値表)を表すクラス
+///
+/// - 出力のサポートはファンインコーンに含まれる入力とラッチで，
+///   リテラル(変数番号 * 2)の昇順に並べる．
+///   i 番目のサポートが真理値表の変数 i となる．
+/// - 真理値表は 2^support_num() ビットを 64 ビットのワード単位で保持する
+///   (サポート数が 6 以下の場合は1ワードで，パタンを繰り返して埋める)．
+/// - サポート数が上限を超えた出力は真理値表を持たない．
+/// - npn_hash() は入力の否定，入力の置換，出力の否定で不変なハッシュ値で，
+///   NPN 同値な関数は同じ値を持つ(逆は成り立たない)．
+//////////////////////////////////////////////////////////////////////
+class AigTruthTables
+{
+  friend class AigModel;
+
+public:
+
+  /// @brief 空のコンストラクタ
+  AigTruthTables() = default;
+
+  /// @brief デストラクタ
+  ~AigTruthTables() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief サポート数の上限を返す．
+  SizeType
+  input_limit() const
+  {
+    return mInputLimit;
+  }
+
+  /// @brief 出力数を返す．
+  SizeType
+  output_num() const
+  {
+    return mOutputList.size();
+  }
+
+  /// @brief 真理値表を持っている時 true を返す．
+  bool
+  has_truth_table(
+    SizeType pos ///< [in] 出力番号 ( 0 <= pos < output_num() )
+  ) const
+  {
+    return _output(pos).mTruthNum > 0;
+  }
+
+  /// @brief サポート数を返す．
+  ///
+  /// 真理値表を持たない場合は 0 を返す．
+  SizeType
+  support_num(
+    SizeType pos ///< [in] 出力番号 ( 0 <= pos < output_num() )
+  ) const
+  {
+    return _output(pos).mSupportNum;
+  }
+
+  /// @brief サポートを返す．
+  SizeType
+  support(
+    SizeType pos, ///< [in] 出力番号 ( 0 <= pos < output_num() )
+    SizeType i    ///< [in] サポートの位置 ( 0 <= i < support_num(pos) )
+  ) const
+  {
+    auto& output = _output(pos);
+    ASSERT_COND( 0 <= i && i < output.mSupportNum );
+    return mSupportArray[output.mSupportBegin + i];
+  }
+
+  /// @brief サポートのリストを返す．
+  vector<SizeType>
+  support_list(
+    SizeType pos ///< [in] 出力番号 ( 0 <= pos < output_num() )
+  ) const;
+
+  /// @brief 真理値表のワード数を返す．
+  ///
+  /// 真理値表を持たない場合は 0 を返す．
+  SizeType
+  truth_word_num(
+    SizeType pos ///< [in] 出力番号 ( 0 <= pos < output_num() )
+  ) const
+  {
+    return _output(pos).mTruthNum;
+  }
+
+  /// @brief 真理値表を返す．
+  ///
+  /// 真理値表を持たない場合は空のリストを返す．
+  vector<std::uint64_t>
+  truth_table(
+    SizeType pos ///< [in] 出力番号 ( 0 <= pos < output_num() )
+  ) const;
+
+  /// @brief 真理値表の先頭を返す．
+  ///
+  /// truth_word_num(pos) ワードの領域を指す．
+  /// 真理値表を持たない場合は nullptr を返す．
+  const std::uint64_t*
+  truth_ptr(
+    SizeType pos ///< [in] 出力番号 ( 0 <= pos < output_num() )
+  ) const
+  {
+    auto& output = _output(pos);
+    if ( output.mTruthNum == 0 ) {
+      return nullptr;
+    }
+    return &mTruthArray[output.mTruthBegin];
+  }
+
+  /// @brief NPN 変換で不変なハッシュ値を返す．
+  ///
+  /// 真理値表を持たない場合は 0 を返す．
+  std::uint64_t
+  npn_hash(
+    SizeType pos ///< [in] 出力番号 ( 0 <= pos < output_num() )
+  ) const
+  {
+    return _output(pos).mNpnHash;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 真理値表を計算する．
+  void
+  compute(
+    const ModelImpl& model, ///< [in] 対象のモデル
+    const AigTruthOpt& opt  ///< [in] オプション
+  );
+
+  // 出力の情報
+  struct Output
+  {
+    SizeType mSupportBegin{0};     // mSupportArray 中の先頭位置
+    SizeType mTruthBegin{0};       // mTruthArray 中の先頭位置
+    std::uint64_t mNpnHash{0};     // NPN ハッシュ値
+    std::uint32_t mSupportNum{0};  // サポート数
+    std::uint32_t mTruthNum{0};    // 真理値表のワード数
+  };
+
+  /// @brief 出力の情報を返す．
+  const Output&
+  _output(
+    SizeType pos
+  ) const
+  {
+    ASSERT_COND( 0 <= pos && pos < output_num() );
+    return mOutputList[pos];
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // サポート数の上限
+  SizeType mInputLimit{0};
+
+  // 出力の情報のリスト
+  vector<Output> mOutputList;
+
+  // 全出力のサポートの配列
+  vector<SizeType> mSupportArray;
+
+  // 全出力の真理値表の配列
+  vector<std::uint64_t> mTruthArray;
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGTRUTHTABLES_H
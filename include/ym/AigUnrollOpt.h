@@ -0,0 +1,39 @@
+#ifndef AIGUNROLLOPT_H
+#define AIGUNROLLOPT_H
+
+/// @file AigUnrollOpt.h
+/// @brief AigUnrollOpt のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigUnrollOpt AigUnrollOpt.h "ym/AigUnrollOpt.h"
+/// @brief AigModel::make_unroller() のオプションを表す構造体
+//////////////////////////////////////////////////////////////////////
+struct AigUnrollOpt
+{
+  /// @brief 最初に展開する時刻数
+  SizeType frame_num{1};
+
+  /// @brief 初期状態を自由な入力とする時 true にする．
+  ///
+  /// false の時はラッチの初期値を定数 0 とする．
+  bool init_free{false};
+
+  /// @brief 展開しながら定数の伝搬と構造的ハッシュを行う時 true にする．
+  ///
+  /// false の時は各時刻のANDノードをそのまま複製する．
+  bool strash{true};
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGUNROLLOPT_H
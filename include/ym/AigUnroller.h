@@ -0,0 +1,219 @@
+#ifndef AIGUNROLLER_H
+#define AIGUNROLLER_H
+
+/// @file AigUnroller.h
+/// @brief AigUnroller のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+#include "ym/AigUnrollOpt.h"
+#include <memory>
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+class ModelImpl;
+class StrashTable;
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigUnroller AigUnroller.h "ym/AigUnroller.h"
+/// @brief 時間展開(unrolling)を行うクラス
+///
+/// - 順序回路を k 時刻分展開した組み合わせ回路を作る．
+///   時刻 f のラッチは時刻 f - 1 のラッチのソースに置き換えられ，
+///   時刻 0 のラッチは定数 0 か自由な入力となる．
+/// - extend() で1時刻ずつ展開を延ばすことができる．
+///   それまでに展開した部分は作り直さない．
+/// - model() が返すモデルの入力は，初期状態の入力(init_free の時のみ)，
+///   時刻 0 の入力，時刻 1 の入力，... の順に並ぶ．
+///   出力は時刻 0 の出力，時刻 1 の出力，... の順に並ぶ．
+/// - 入力と出力のシンボル名は元の名前に "@時刻" を付けたものとなる．
+///   初期状態の入力はラッチの名前に "@init" を付けたものとなる．
+///   元の名前がない場合は名前を持たない．
+//////////////////////////////////////////////////////////////////////
+class AigUnroller
+{
+  friend class AigModel;
+  friend class ModelImpl;
+
+public:
+
+  /// @brief 空のコンストラクタ
+  AigUnroller();
+
+  /// @brief ムーブコンストラクタ
+  AigUnroller(
+    AigUnroller&& src ///< [in] ムーブ元のオブジェクト
+  );
+
+  /// @brief ムーブ代入文
+  AigUnroller&
+  operator=(
+    AigUnroller&& src ///< [in] ムーブ元のオブジェクト
+  );
+
+  /// @brief デストラクタ
+  ~AigUnroller();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 展開した時刻数を返す．
+  SizeType
+  frame_num() const
+  {
+    return mFrameNum;
+  }
+
+  /// @brief 展開を n 時刻延ばす．
+  void
+  extend(
+    SizeType n = 1 ///< [in] 延ばす時刻数
+  );
+
+  /// @brief 展開した組み合わせ回路を返す．
+  AigModel
+  model() const;
+
+  /// @brief 展開した回路の入力数を返す．
+  SizeType
+  input_num() const
+  {
+    return mInputNum;
+  }
+
+  /// @brief 展開した回路のANDノード数を返す．
+  SizeType
+  and_num() const
+  {
+    return mNodeList.size() - mInputNum - 1;
+  }
+
+  /// @brief 初期状態の入力の位置を返す．
+  ///
+  /// init_free が true の時のみ意味を持つ．
+  SizeType
+  init_input_pos(
+    SizeType latch ///< [in] 元のモデルのラッチ番号
+  ) const
+  {
+    ASSERT_COND( mInitFree );
+    return latch;
+  }
+
+  /// @brief 時刻 frame の入力の位置を返す．
+  SizeType
+  input_pos(
+    SizeType frame, ///< [in] 時刻 ( 0 <= frame < frame_num() )
+    SizeType input  ///< [in] 元のモデルの入力番号
+  ) const
+  {
+    ASSERT_COND( 0 <= frame && frame < frame_num() );
+    return mInitNum + frame * mSrcInputNum + input;
+  }
+
+  /// @brief 時刻 frame の出力の位置を返す．
+  SizeType
+  output_pos(
+    SizeType frame, ///< [in] 時刻 ( 0 <= frame < frame_num() )
+    SizeType output ///< [in] 元のモデルの出力番号
+  ) const
+  {
+    ASSERT_COND( 0 <= frame && frame < frame_num() );
+    return frame * mSrcOutputNum + output;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 初期化する．
+  void
+  initialize(
+    const std::shared_ptr<ModelImpl>& src, ///< [in] 元のモデル
+    const AigUnrollOpt& opt                ///< [in] オプション
+  );
+
+  /// @brief 入力ノードを作る．
+  SizeType
+  new_input();
+
+  /// @brief ANDノードを作る．
+  SizeType
+  new_and(
+    SizeType src1,
+    SizeType src2
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 入力ノードの mSrc1 に入れる値
+  static
+  constexpr SizeType INPUT_MARK = static_cast<SizeType>(-1);
+
+  // 展開した回路のノード
+  //
+  // ノード番号が内部の変数番号となる．
+  // 0 番目は定数ノード．
+  struct Node
+  {
+    SizeType mSrc1; // ファンイン1のリテラル(入力の場合は INPUT_MARK)
+    SizeType mSrc2; // ファンイン2のリテラル
+  };
+
+  // 元のモデル
+  std::shared_ptr<ModelImpl> mSrc;
+
+  // 元のモデルのANDノードのトポロジカル順
+  vector<SizeType> mOrderList;
+
+  // 元のモデルの入力数
+  SizeType mSrcInputNum{0};
+
+  // 元のモデルの出力数
+  SizeType mSrcOutputNum{0};
+
+  // 初期状態を自由な入力とする時 true
+  bool mInitFree{false};
+
+  // 初期状態の入力数
+  SizeType mInitNum{0};
+
+  // 構造的ハッシュ表(strash を行わない時は nullptr)
+  std::unique_ptr<StrashTable> mTable;
+
+  // 展開した時刻数
+  SizeType mFrameNum{0};
+
+  // 展開した回路のノードのリスト
+  vector<Node> mNodeList;
+
+  // 展開した回路の入力数
+  SizeType mInputNum{0};
+
+  // 展開した回路の出力の内部リテラルのリスト
+  vector<SizeType> mOutputLitList;
+
+  // 次の時刻のラッチの値を表す内部リテラルのリスト
+  vector<SizeType> mLatchLitList;
+
+  // 元の変数番号から内部リテラルへの対応表(作業用)
+  vector<SizeType> mLitMap;
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGUNROLLER_H
@@ -34,6 +34,36 @@ BEGIN_NAMESPACE_YM_AIG
 //////////////////////////////////////////////////////////////////////
 
 class AigModel;
+class AigActivity;
+struct AigActivityOpt;
+class AigAndIter;
+struct AigCex;
+class AigCnf;
+struct AigCnfOpt;
+class AigCuts;
+struct AigCutOpt;
+class AigDominators;
+class AigEquivClasses;
+struct AigEquivOpt;
+struct AigFalsifyOpt;
+class AigFileIndex;
+class AigIncrSim;
+class AigLatchGraph;
+struct AigLatchGraphOpt;
+class AigLutNetwork;
+struct AigLutOpt;
+struct AigMiterOpt;
+class AigPartition;
+struct AigPartitionOpt;
+struct AigReadOpt;
+struct AigSupportOpt;
+class AigSupports;
+struct AigTernaryOpt;
+class AigTernaryResult;
+class AigTruthTables;
+struct AigTruthOpt;
+class AigUnroller;
+struct AigUnrollOpt;
 
 END_NAMESPACE_YM_AIG
 
@@ -41,6 +71,36 @@ END_NAMESPACE_YM_AIG
 BEGIN_NAMESPACE_YM
 
 using nsAig::AigModel;
+using nsAig::AigActivity;
+using nsAig::AigActivityOpt;
+using nsAig::AigAndIter;
+using nsAig::AigCex;
+using nsAig::AigCnf;
+using nsAig::AigCnfOpt;
+using nsAig::AigCuts;
+using nsAig::AigCutOpt;
+using nsAig::AigDominators;
+using nsAig::AigEquivClasses;
+using nsAig::AigEquivOpt;
+using nsAig::AigFalsifyOpt;
+using nsAig::AigFileIndex;
+using nsAig::AigIncrSim;
+using nsAig::AigLatchGraph;
+using nsAig::AigLatchGraphOpt;
+using nsAig::AigLutNetwork;
+using nsAig::AigLutOpt;
+using nsAig::AigMiterOpt;
+using nsAig::AigPartition;
+using nsAig::AigPartitionOpt;
+using nsAig::AigReadOpt;
+using nsAig::AigSupportOpt;
+using nsAig::AigSupports;
+using nsAig::AigTernaryOpt;
+using nsAig::AigTernaryResult;
+using nsAig::AigTruthTables;
+using nsAig::AigTruthOpt;
+using nsAig::AigUnroller;
+using nsAig::AigUnrollOpt;
 
 END_NAMESPACE_YM
 
@@ -8,6 +8,8 @@
 
 #include "pym/PyAigModel.h"
 #include "pym/PyModule.h"
+#include <functional>
+#include <new>
 
 
 BEGIN_NAMESPACE_YM
@@ -52,15 +54,29 @@ AigModel_dealloc(
 PyObject*
 AigModel_read_aag(
   PyObject* Py_UNUSED(self),
-  PyObject* args
+  PyObject* args,
+  PyObject* kwds
 )
 {
+  static const char* kwlist[] = {
+    "",
+    "async_io",
+    "cleanup",
+    nullptr
+  };
   const char* filename = nullptr;
-  if ( !PyArg_ParseTuple(args, "s", &filename) ) {
+  int async_io = false;
+  int cleanup = false;
+  if ( !PyArg_ParseTupleAndKeywords(args, kwds, "s|$pp",
+				    const_cast<char**>(kwlist),
+				    &filename, &async_io, &cleanup) ) {
     return nullptr;
   }
+  AigReadOpt opt;
+  opt.async_io = async_io;
+  opt.cleanup = cleanup;
   try {
-    auto aig_model = AigModel::read_aag(filename);
+    auto aig_model = AigModel::read_aag(filename, opt);
     auto obj = AigModelType.tp_alloc(&AigModelType, 0);
     auto aig_obj = reinterpret_cast<AigModelObject*>(obj);
     aig_obj->mPtr = new AigModel{std::move(aig_model)};
@@ -77,15 +93,29 @@ AigModel_read_aag(
 PyObject*
 AigModel_read_aig(
   PyObject* Py_UNUSED(self),
-  PyObject* args
+  PyObject* args,
+  PyObject* kwds
 )
 {
+  static const char* kwlist[] = {
+    "",
+    "async_io",
+    "cleanup",
+    nullptr
+  };
   const char* filename = nullptr;
-  if ( !PyArg_ParseTuple(args, "s", &filename) ) {
+  int async_io = false;
+  int cleanup = false;
+  if ( !PyArg_ParseTupleAndKeywords(args, kwds, "s|$pp",
+				    const_cast<char**>(kwlist),
+				    &filename, &async_io, &cleanup) ) {
     return nullptr;
   }
+  AigReadOpt opt;
+  opt.async_io = async_io;
+  opt.cleanup = cleanup;
   try {
-    auto aig_model = AigModel::read_aig(filename);
+    auto aig_model = AigModel::read_aig(filename, opt);
     auto obj = AigModelType.tp_alloc(&AigModelType, 0);
     auto aig_obj = reinterpret_cast<AigModelObject*>(obj);
     aig_obj->mPtr = new AigModel{std::move(aig_model)};
@@ -99,6 +129,144 @@ AigModel_read_aig(
   }
 }
 
+// GIL を解放して func を実行する．
+//
+// 例外は GIL を取り戻してから Python のエラーにする．
+// std::invalid_argument は ValueError，std::bad_alloc は MemoryError，
+// それ以外の std::exception は RuntimeError となる．
+// 例外が起きた時は false を返す．
+bool
+run_without_gil(
+  const std::function<void()>& func
+)
+{
+  PyObject* error_type = nullptr;
+  string error_msg;
+  Py_BEGIN_ALLOW_THREADS
+  try {
+    func();
+  }
+  catch ( std::invalid_argument& error ) {
+    error_type = PyExc_ValueError;
+    error_msg = error.what();
+  }
+  catch ( std::bad_alloc& ) {
+    error_type = PyExc_MemoryError;
+  }
+  catch ( std::exception& error ) {
+    error_type = PyExc_RuntimeError;
+    error_msg = error.what();
+  }
+  Py_END_ALLOW_THREADS
+  if ( error_type == PyExc_MemoryError ) {
+    PyErr_NoMemory();
+    return false;
+  }
+  if ( error_type != nullptr ) {
+    PyErr_SetString(error_type, error_msg.c_str());
+    return false;
+  }
+  return true;
+}
+
+PyObject*
+AigModel_read_many(
+  PyObject* Py_UNUSED(self),
+  PyObject* args,
+  PyObject* kwds
+)
+{
+  static const char* kwlist[] = {
+    "",
+    "thread_num",
+    "mem_limit",
+    "async_io",
+    "cleanup",
+    nullptr
+  };
+  PyObject* list_obj = nullptr;
+  SizeType thread_num = 0;
+  SizeType mem_limit = 0;
+  int async_io = false;
+  int cleanup = false;
+  if ( !PyArg_ParseTupleAndKeywords(args, kwds, "O|$kkpp",
+				    const_cast<char**>(kwlist),
+				    &list_obj, &thread_num, &mem_limit,
+				    &async_io, &cleanup) ) {
+    return nullptr;
+  }
+  auto seq = PySequence_Fast(list_obj, "argument 1 must be a sequence of str");
+  if ( seq == nullptr ) {
+    return nullptr;
+  }
+  SizeType n = PySequence_Fast_GET_SIZE(seq);
+  vector<string> filename_list;
+  filename_list.reserve(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto item = PySequence_Fast_GET_ITEM(seq, i);
+    auto str = PyUnicode_AsUTF8(item);
+    if ( str == nullptr ) {
+      Py_DECREF(seq);
+      return nullptr;
+    }
+    filename_list.push_back(str);
+  }
+  Py_DECREF(seq);
+
+  AigReadOpt opt;
+  opt.thread_num = thread_num;
+  opt.mem_limit = mem_limit;
+  opt.async_io = async_io;
+  opt.cleanup = cleanup;
+  vector<AigModel> model_list;
+  vector<string> error_list;
+  if ( !run_without_gil([&]() {
+    model_list = AigModel::read_many(filename_list, error_list, opt);
+  }) ) {
+    return nullptr;
+  }
+
+  // 失敗したファイルの AigModel は None とする．
+  auto model_obj = PyList_New(n);
+  if ( model_obj == nullptr ) {
+    return nullptr;
+  }
+  auto error_obj = PyList_New(n);
+  if ( error_obj == nullptr ) {
+    Py_DECREF(model_obj);
+    return nullptr;
+  }
+  for ( SizeType i = 0; i < n; ++ i ) {
+    PyObject* obj1 = nullptr;
+    PyObject* obj2 = nullptr;
+    if ( error_list[i].empty() ) {
+      obj1 = AigModelType.tp_alloc(&AigModelType, 0);
+      if ( obj1 != nullptr ) {
+	auto aig_obj = reinterpret_cast<AigModelObject*>(obj1);
+	aig_obj->mPtr = new AigModel{std::move(model_list[i])};
+      }
+      Py_INCREF(Py_None);
+      obj2 = Py_None;
+    }
+    else {
+      Py_INCREF(Py_None);
+      obj1 = Py_None;
+      obj2 = PyUnicode_FromString(error_list[i].c_str());
+    }
+    // 作りかけのリストの未設定の要素は NULL のままで破棄できる．
+    if ( obj1 == nullptr || obj2 == nullptr ) {
+      Py_XDECREF(obj1);
+      Py_XDECREF(obj2);
+      Py_DECREF(model_obj);
+      Py_DECREF(error_obj);
+      return nullptr;
+    }
+    PyList_SET_ITEM(model_obj, i, obj1);
+    PyList_SET_ITEM(error_obj, i, obj2);
+  }
+  return Py_BuildValue("(NN)", model_obj, error_obj);
+}
+
 PyObject*
 AigModel_input(
   PyObject* self,
@@ -201,14 +369,109 @@ AigModel_print(
   Py_RETURN_NONE;
 }
 
+// float の配列を読み出し専用の memoryview (format 'f') に変換する．
+PyObject*
+to_float_buffer(
+  const vector<float>& array
+)
+{
+  auto bytes_obj = PyBytes_FromStringAndSize(reinterpret_cast<const char*>(array.data()),
+					     array.size() * sizeof(float));
+  if ( bytes_obj == nullptr ) {
+    return nullptr;
+  }
+  auto view_obj = PyMemoryView_FromObject(bytes_obj);
+  Py_DECREF(bytes_obj);
+  if ( view_obj == nullptr ) {
+    return nullptr;
+  }
+  auto ans_obj = PyObject_CallMethod(view_obj, "cast", "s", "f");
+  Py_DECREF(view_obj);
+  return ans_obj;
+}
+
+PyObject*
+AigModel_estimate_activity(
+  PyObject* self,
+  PyObject* args,
+  PyObject* kwds
+)
+{
+  static const char* kwlist[] = {
+    "word_num",
+    "cycle_num",
+    "warmup_num",
+    "input_prob",
+    "seed",
+    "thread_num",
+    nullptr
+  };
+  AigActivityOpt opt;
+  SizeType word_num = opt.word_num;
+  SizeType cycle_num = opt.cycle_num;
+  SizeType warmup_num = opt.warmup_num;
+  PyObject* prob_obj = nullptr;
+  unsigned long long seed = opt.seed;
+  SizeType thread_num = opt.thread_num;
+  if ( !PyArg_ParseTupleAndKeywords(args, kwds, "|$kkkOKk",
+				    const_cast<char**>(kwlist),
+				    &word_num, &cycle_num, &warmup_num,
+				    &prob_obj, &seed, &thread_num) ) {
+    return nullptr;
+  }
+  opt.word_num = word_num;
+  opt.cycle_num = cycle_num;
+  opt.warmup_num = warmup_num;
+  opt.seed = seed;
+  opt.thread_num = thread_num;
+  if ( prob_obj != nullptr && prob_obj != Py_None ) {
+    auto seq = PySequence_Fast(prob_obj, "input_prob must be a sequence of float");
+    if ( seq == nullptr ) {
+      return nullptr;
+    }
+    SizeType n = PySequence_Fast_GET_SIZE(seq);
+    opt.input_prob.reserve(n);
+    for ( SizeType i = 0; i < n; ++ i ) {
+      auto val = PyFloat_AsDouble(PySequence_Fast_GET_ITEM(seq, i));
+      if ( val == -1.0 && PyErr_Occurred() ) {
+	Py_DECREF(seq);
+	return nullptr;
+      }
+      opt.input_prob.push_back(val);
+    }
+    Py_DECREF(seq);
+  }
+
+  auto& aig = PyAigModel::Get(self);
+  AigActivity activity;
+  if ( !run_without_gil([&]() {
+    activity = aig.estimate_activity(opt);
+  }) ) {
+    return nullptr;
+  }
+  auto one_obj = to_float_buffer(activity.one_prob_array());
+  if ( one_obj == nullptr ) {
+    return nullptr;
+  }
+  auto toggle_obj = to_float_buffer(activity.toggle_rate_array());
+  if ( toggle_obj == nullptr ) {
+    Py_DECREF(one_obj);
+    return nullptr;
+  }
+  return Py_BuildValue("(NN)", one_obj, toggle_obj);
+}
+
 // メソッド定義
 PyMethodDef AigModel_methods[] = {
   {"read_aag", reinterpret_cast<PyCFunction>(AigModel_read_aag),
-   METH_VARARGS | METH_STATIC,
+   METH_VARARGS | METH_KEYWORDS | METH_STATIC,
    PyDoc_STR("read 'aag' file")},
   {"read_aig", reinterpret_cast<PyCFunction>(AigModel_read_aig),
-   METH_VARARGS | METH_STATIC,
+   METH_VARARGS | METH_KEYWORDS | METH_STATIC,
    PyDoc_STR("read 'aig' file")},
+  {"read_many", reinterpret_cast<PyCFunction>(AigModel_read_many),
+   METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+   PyDoc_STR("read multiple 'aag'/'aig' files in parallel")},
   {"input", AigModel_input,
    METH_VARARGS,
    PyDoc_STR("return input's information")},
@@ -224,6 +487,9 @@ PyMethodDef AigModel_methods[] = {
   {"print", reinterpret_cast<PyCFunction>(AigModel_print),
    METH_VARARGS | METH_KEYWORDS,
    PyDoc_STR("write contents")},
+  {"estimate_activity", reinterpret_cast<PyCFunction>(AigModel_estimate_activity),
+   METH_VARARGS | METH_KEYWORDS,
+   PyDoc_STR("return signal probabilities and toggle rates as float buffers")},
   {nullptr, nullptr, 0, nullptr}
 };
 
@@ -0,0 +1,206 @@
+
+/// @file activity.cc
+/// @brief AigModel::estimate_activity() のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigModel.h"
+#include "test_util.h"
+#include <cmath>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 入力の確率が 0 か 1 の場合は全てのパタンが同じ系列となるので，
+// スカラーの順序シミュレーションで厳密な値が求まる．
+void
+check_exact(
+  const AigModel& aig,
+  SizeType warmup_num,
+  SizeType cycle_num,
+  std::uint64_t seed,
+  const string& label
+)
+{
+  std::mt19937_64 rng{seed};
+  AigActivityOpt opt;
+  opt.word_num = 2;
+  opt.cycle_num = cycle_num;
+  opt.warmup_num = warmup_num;
+  opt.thread_num = 2;
+  for ( SizeType i = 0; i < aig.I(); ++ i ) {
+    opt.input_prob.push_back((rng() % 2) ? 1.0 : 0.0);
+  }
+  auto act = aig.estimate_activity(opt);
+  check(act.var_num() == aig.M() + 1, label + ": var_num() mismatch");
+  check(act.pattern_num() == 128, label + ": pattern_num() mismatch");
+  check(act.cycle_num() == cycle_num, label + ": cycle_num() mismatch");
+
+  RefSim sim{aig};
+  vector<std::uint64_t> input_vals(aig.I());
+  for ( SizeType i = 0; i < aig.I(); ++ i ) {
+    input_vals[i] = opt.input_prob[i] == 1.0 ? ~0ULL : 0ULL;
+  }
+  vector<std::uint64_t> latch_vals(aig.L(), 0ULL);
+  auto var_num = aig.M() + 1;
+  vector<SizeType> one_count(var_num, 0);
+  vector<SizeType> toggle_count(var_num, 0);
+  vector<std::uint64_t> prev(var_num, 0);
+  for ( SizeType c = 0; c < warmup_num + cycle_num; ++ c ) {
+    sim.eval(input_vals, latch_vals);
+    if ( c >= warmup_num ) {
+      for ( SizeType var = 1; var < var_num; ++ var ) {
+	auto val = sim.lit_val(var * 2);
+	if ( val ) {
+	  ++ one_count[var];
+	}
+	if ( c > warmup_num && val != prev[var] ) {
+	  ++ toggle_count[var];
+	}
+	prev[var] = val;
+      }
+    }
+    for ( SizeType i = 0; i < aig.L(); ++ i ) {
+      latch_vals[i] = sim.latch_next(i);
+    }
+  }
+  bool ok = true;
+  for ( SizeType var = 0; var < var_num; ++ var ) {
+    double one_prob = static_cast<double>(one_count[var]) / cycle_num;
+    double toggle_rate = cycle_num > 1 ? static_cast<double>(toggle_count[var]) / (cycle_num - 1) : 0.0;
+    if ( std::abs(act.one_prob(var) - one_prob) > 1e-6 ||
+	 std::abs(act.toggle_rate(var) - toggle_rate) > 1e-6 ) {
+      ok = false;
+    }
+  }
+  check(ok, label + ": the activity differs from the sequential simulation");
+}
+
+// 独立な入力の AND/OR の確率を調べる．
+//
+// 組み合わせ回路では時刻ごとの値が独立なので
+// スイッチング率は 2p(1 - p) となる．
+void
+check_random()
+{
+  // 出力は a & b, ~(~a & ~b), a & ~b
+  istringstream s{"aag 5 2 0 3 3\n"
+		  "2\n4\n6\n9\n10\n"
+		  "6 4 2\n"
+		  "8 5 3\n"
+		  "10 5 2\n"};
+  auto aig = AigModel::read_aag(s);
+  AigActivityOpt opt;
+  opt.word_num = 8;
+  opt.cycle_num = 64;
+  opt.input_prob = {0.3, 0.6};
+  double pa = 0.3;
+  double pb = 0.6;
+  vector<std::pair<SizeType, double>> expected{
+    {1, pa}, {2, pb},
+    {3, pa * pb},
+    {4, (1 - pa) * (1 - pb)},
+    {5, pa * (1 - pb)}
+  };
+  vector<float> one_prob;
+  vector<float> toggle_rate;
+  for ( SizeType thread_num: {1, 4} ) {
+    opt.thread_num = thread_num;
+    auto act = aig.estimate_activity(opt);
+    auto label = "random (thread_num = " + std::to_string(thread_num) + ")";
+    // 標本数は 32768 なので標準偏差は 0.003 以下となる．
+    for ( auto& p: expected ) {
+      auto var = p.first;
+      auto q = p.second;
+      check(std::abs(act.one_prob(var) - q) < 0.02,
+	    label + ": one_prob of var#" + std::to_string(var) + " is " +
+	    std::to_string(act.one_prob(var)) + ", expected " + std::to_string(q));
+      check(std::abs(act.toggle_rate(var) - 2 * q * (1 - q)) < 0.02,
+	    label + ": toggle_rate of var#" + std::to_string(var) + " is " +
+	    std::to_string(act.toggle_rate(var)) + ", expected " +
+	    std::to_string(2 * q * (1 - q)));
+    }
+    check(act.one_prob(0) == 0.0 && act.toggle_rate(0) == 0.0,
+	  label + ": the constant has a nonzero activity");
+    if ( thread_num == 1 ) {
+      one_prob = act.one_prob_array();
+      toggle_rate = act.toggle_rate_array();
+    }
+    else {
+      check(act.one_prob_array() == one_prob && act.toggle_rate_array() == toggle_rate,
+	    label + ": the result depends on the number of threads");
+    }
+  }
+}
+
+// 例外が送出されてメッセージが関数名で始まることを調べる．
+void
+check_error(
+  const AigModel& aig,
+  const vector<double>& input_prob,
+  const string& label
+)
+{
+  AigActivityOpt opt;
+  opt.input_prob = input_prob;
+  try {
+    aig.estimate_activity(opt);
+    check(false, label + " was accepted");
+  }
+  catch ( std::invalid_argument& error ) {
+    string msg = error.what();
+    check(msg.find("estimate_activity: ") == 0, label + ": unexpected message: " + msg);
+  }
+}
+
+END_NONAMESPACE
+
+// 使い方: activity <aag-file>
+//
+// 入力の確率が 0 か 1 の場合の結果を順序シミュレーションと比較し，
+// 独立な入力の論理積などの信号確率とスイッチング率を理論値と比較する．
+int
+activity(
+  int argc,
+  char** argv
+)
+{
+  if ( argc != 2 ) {
+    cerr << "Usage: activity <aag-file>" << endl;
+    return 2;
+  }
+
+  auto aig = AigModel::read_aag(argv[1]);
+  check_exact(aig, 0, 4, 1, argv[1]);
+  for ( std::uint64_t seed = 1; seed <= 4; ++ seed ) {
+    auto label = "random#" + std::to_string(seed);
+    auto aig1 = random_aig(8, 8, 8, 200, seed);
+    check_exact(aig1, 0, 10, seed, label);
+    check_exact(aig1, 3, 10, seed, label + " (warmup)");
+    check_exact(aig1, 0, 1, seed, label + " (1 cycle)");
+  }
+  check_random();
+
+  check_error(aig, vector<double>(aig.I() + 1, 0.5), "a longer input_prob");
+  vector<double> input_prob(aig.I(), 0.5);
+  input_prob.back() = 1.5;
+  check_error(aig, input_prob, "a probability out of range");
+
+  return report("activity");
+}
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::activity(argc, argv);
+}
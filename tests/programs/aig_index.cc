@@ -0,0 +1,163 @@
+
+/// @file aig_index.cc
+/// @brief AigFileIndex のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigModel.h"
+#include "ym/AigFileIndex.h"
+#include "test_util.h"
+#include <cstdio>
+#include <fstream>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 可変長整数を書き出す．
+void
+write_number(
+  ostream& s,
+  SizeType num
+)
+{
+  while ( num >= 0x80 ) {
+    s.put(static_cast<char>((num & 0x7F) | 0x80));
+    num >>= 7;
+  }
+  s.put(static_cast<char>(num));
+}
+
+// 標準形のモデルをバイナリ AIG 形式で書き出す．
+void
+write_aig(
+  const AigModel& aig,
+  const string& filename
+)
+{
+  std::ofstream s{filename, std::ios::binary};
+  s << "aig " << aig.M() << " " << aig.I() << " " << aig.L()
+    << " " << aig.O() << " " << aig.A() << endl;
+  for ( SizeType i = 0; i < aig.L(); ++ i ) {
+    s << aig.latch_src(i) << endl;
+  }
+  for ( SizeType i = 0; i < aig.O(); ++ i ) {
+    s << aig.output_src(i) << endl;
+  }
+  for ( SizeType i = 0; i < aig.A(); ++ i ) {
+    auto lit = aig.and_node(i);
+    auto src1 = aig.and_src1(i);
+    auto src2 = aig.and_src2(i);
+    write_number(s, lit - src1);
+    write_number(s, src1 - src2);
+  }
+}
+
+// 索引を用いた読み込みを調べる．
+void
+check_index(
+  const string& filename,
+  const string& label
+)
+{
+  auto ref = AigModel::read_aig(filename);
+  for ( SizeType interval: {1, 3, 64, 4096} ) {
+    auto suffix = " (interval = " + std::to_string(interval) + ")";
+    std::remove(AigFileIndex::index_filename(filename).c_str());
+    auto index = AigFileIndex::open(filename, interval);
+    check(index.interval() == interval, label + suffix + ": interval mismatch");
+    check(index.A() == ref.A(), label + suffix + ": A() mismatch");
+    // 保存された索引が読み込まれる．
+    auto index2 = AigFileIndex::open(filename, interval + 1);
+    check(index2.interval() == interval, label + suffix + ": the saved index was not used");
+    for ( SizeType thread_num: {1, 4} ) {
+      check(same_model(ref, AigModel::read_aig(index2, thread_num)),
+	    label + suffix + ": the indexed read differs");
+    }
+
+    // 任意の範囲の読み込み
+    std::mt19937_64 rng{interval};
+    for ( SizeType k = 0; k < 50 && ref.A() > 0; ++ k ) {
+      auto pos = rng() % ref.A();
+      auto num = rng() % (ref.A() - pos + 1);
+      auto and_list = index2.read_ands(pos, num);
+      bool ok = and_list.size() == num * 3;
+      for ( SizeType i = 0; ok && i < num; ++ i ) {
+	ok = and_list[i * 3 + 0] == ref.and_node(pos + i)
+	  && and_list[i * 3 + 1] == ref.and_src1(pos + i)
+	  && and_list[i * 3 + 2] == ref.and_src2(pos + i);
+      }
+      check(ok, label + suffix + ": read_ands(" + std::to_string(pos)
+	    + ", " + std::to_string(num) + ") mismatch");
+    }
+  }
+  std::remove(AigFileIndex::index_filename(filename).c_str());
+}
+
+END_NONAMESPACE
+
+// 使い方: aig_index <aig-file> <work-file>
+//
+// 与えられたファイルとランダムなモデルを書き出したファイルについて，
+// 索引を用いた読み込みが通常の読み込みと同じ結果になることを確かめる．
+// 索引ファイルは元のファイルの隣に作られるので，与えられたファイルは
+// <work-file> にコピーしてから用いる．<work-file> は上書きされる．
+int
+aig_index(
+  int argc,
+  char** argv
+)
+{
+  if ( argc != 3 ) {
+    cerr << "Usage: aig_index <aig-file> <work-file>" << endl;
+    return 2;
+  }
+  string work_file = argv[2];
+
+  {
+    std::ifstream src{argv[1], std::ios::binary};
+    std::ofstream dst{work_file, std::ios::binary};
+    dst << src.rdbuf();
+  }
+  check_index(work_file, argv[1]);
+
+  auto aig = random_aig(16, 8, 8, 10000, 1);
+  write_aig(aig, work_file);
+  check(same_model(aig, AigModel::read_aig(work_file)), "random: write_aig() failed");
+  check_index(work_file, "random");
+
+  // 元のファイルが変わったら索引は作り直される．
+  AigFileIndex::open(work_file, 64);
+  write_aig(random_aig(16, 8, 8, 5000, 2), work_file);
+  auto index = AigFileIndex::open(work_file, 32);
+  check(index.interval() == 32 && index.A() == 5000, "a stale index was used");
+
+  // チェックポイントの間隔が 0 の場合はエラーとなる．
+  bool thrown = false;
+  try {
+    AigFileIndex::build(work_file, 0);
+  }
+  catch ( std::invalid_argument& ) {
+    thrown = true;
+  }
+  check(thrown, "build() with interval 0 did not throw std::invalid_argument");
+  std::remove(AigFileIndex::index_filename(work_file).c_str());
+  std::remove(work_file.c_str());
+
+  return report("aig_index");
+}
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::aig_index(argc, argv);
+}
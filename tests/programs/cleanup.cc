@@ -0,0 +1,222 @@
+
+/// @file cleanup.cc
+/// @brief AigModel::cleanup() のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigModel.h"
+#include "test_util.h"
+#include <unordered_set>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 畳み込みの全ての場合と不要なANDノードを含むモデル
+//
+// 8 = a & 0, 10 = b & 1, 12 = a & a, 14 = b & ~b は定数かファンインに
+// 畳み込まれ，16 = 10 & 12 は a & b，18 = 16 & ~8 は 16 となる．
+// 20, 22, 24 はどこからも参照されていない．
+const char* FOLD_AAG =
+  "aag 12 2 1 2 9\n"
+  "2\n"
+  "4\n"
+  "6 12\n"
+  "18\n"
+  "14\n"
+  "8 2 0\n"
+  "10 4 1\n"
+  "12 2 2\n"
+  "14 5 4\n"
+  "16 12 10\n"
+  "18 16 9\n"
+  "20 4 2\n"
+  "22 16 2\n"
+  "24 22 4\n"
+  "i0 a\n"
+  "i1 b\n"
+  "l0 s\n"
+  "o0 f\n"
+  "o1 zero\n";
+
+// 定数や同じファンインを含むランダムなモデルを作る．
+AigModel
+random_dirty_aig(
+  SizeType ni,
+  SizeType no,
+  SizeType na,
+  std::uint64_t seed
+)
+{
+  std::mt19937_64 rng{seed};
+  auto pick = [&](SizeType n) -> SizeType {
+    switch ( rng() % 16 ) {
+    case 0: return 0;
+    case 1: return 1;
+    default: break;
+    }
+    return (rng() % n + 1) * 2 + rng() % 2;
+  };
+  ostringstream buf;
+  buf << "aag " << ni + na << " " << ni << " 0 " << no << " " << na << endl;
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    buf << (i + 1) * 2 << endl;
+  }
+  for ( SizeType i = 0; i < no; ++ i ) {
+    // 後ろの方のノードを出力にする．
+    buf << (ni + na - rng() % (na / 4 + 1)) * 2 + rng() % 2 << endl;
+  }
+  for ( SizeType i = 0; i < na; ++ i ) {
+    auto n = ni + i;
+    auto a = pick(n);
+    auto b = rng() % 8 == 0 ? (a ^ (rng() % 2)) : pick(n);
+    buf << (n + 1) * 2 << " " << a << " " << b << endl;
+  }
+  istringstream s{buf.str()};
+  return AigModel::read_aag(s);
+}
+
+// 出力の値を比較する．
+bool
+same_outputs(
+  const AigModel& aig1,
+  const AigModel& aig2
+)
+{
+  RefSim sim1{aig1};
+  RefSim sim2{aig2};
+  std::mt19937_64 rng{1};
+  for ( SizeType k = 0; k < 4; ++ k ) {
+    auto input_vals = random_words(aig1.I(), rng);
+    auto latch_vals = random_words(aig1.L(), rng);
+    sim1.eval(input_vals, latch_vals);
+    sim2.eval(input_vals, latch_vals);
+    for ( SizeType i = 0; i < aig1.O(); ++ i ) {
+      if ( sim1.output_val(i) != sim2.output_val(i) ) {
+	return false;
+      }
+    }
+    for ( SizeType i = 0; i < aig1.L(); ++ i ) {
+      if ( sim1.latch_next(i) != sim2.latch_next(i) ) {
+	return false;
+      }
+    }
+  }
+  return true;
+}
+
+// cleanup() の結果が満たすべき性質を調べる．
+void
+check_clean(
+  const AigModel& aig,
+  const string& label
+)
+{
+  // 全てのANDノードが出力かラッチから到達可能
+  std::unordered_set<SizeType> reached;
+  vector<SizeType> stack;
+  for ( SizeType i = 0; i < aig.O(); ++ i ) {
+    stack.push_back(aig.output_src(i) / 2);
+  }
+  for ( SizeType i = 0; i < aig.L(); ++ i ) {
+    stack.push_back(aig.latch_src(i) / 2);
+  }
+  auto base = aig.I() + aig.L() + 1;
+  while ( !stack.empty() ) {
+    auto var = stack.back();
+    stack.pop_back();
+    if ( var < base || !reached.insert(var).second ) {
+      continue;
+    }
+    auto pos = var - base;
+    stack.push_back(aig.and_src1(pos) / 2);
+    stack.push_back(aig.and_src2(pos) / 2);
+  }
+  check(reached.size() == aig.A(), label + ": dangling AND nodes remain");
+
+  // 畳み込める組み合わせが残っていない．
+  bool ok = true;
+  for ( SizeType i = 0; i < aig.A(); ++ i ) {
+    auto src1 = aig.and_src1(i);
+    auto src2 = aig.and_src2(i);
+    if ( src1 / 2 == 0 || src2 / 2 == 0 || src1 / 2 == src2 / 2 ) {
+      ok = false;
+    }
+  }
+  check(ok, label + ": foldable AND nodes remain");
+}
+
+END_NONAMESPACE
+
+// 使い方: cleanup <aag-file>
+//
+// 畳み込みの全ての場合を含むモデル，ランダムなモデル，与えられた
+// ファイルについて cleanup() の結果と返り値を調べる．
+int
+cleanup(
+  int argc,
+  char** argv
+)
+{
+  if ( argc != 2 ) {
+    cerr << "Usage: cleanup <aag-file>" << endl;
+    return 2;
+  }
+
+  {
+    istringstream s{FOLD_AAG};
+    auto src = AigModel::read_aag(s);
+    auto aig = src;
+    auto n = aig.cleanup();
+    check(n == 8, "fold: cleanup() returned " + std::to_string(n));
+    check(aig.I() == 2 && aig.L() == 1 && aig.O() == 2 && aig.A() == 1,
+	  "fold: wrong size");
+    check(aig.and_node(0) == 8 && aig.and_src1(0) == 4 && aig.and_src2(0) == 2,
+	  "fold: the remaining AND node is not a & b");
+    check(aig.output_src(0) == 8, "fold: output f is not a & b");
+    check(aig.output_src(1) == 0, "fold: output zero is not constant 0");
+    check(aig.latch_src(0) == 2, "fold: the latch source is not a");
+    check(aig.input_symbol(1) == "b" && aig.latch_symbol(0) == "s" &&
+	  aig.output_symbol(1) == "zero", "fold: symbols were not preserved");
+    check(same_outputs(src, aig), "fold: outputs changed");
+    check(aig.cleanup() == 0, "fold: the second cleanup() removed nodes");
+  }
+
+  for ( std::uint64_t seed = 1; seed <= 10; ++ seed ) {
+    auto label = "random#" + std::to_string(seed);
+    auto src = random_dirty_aig(8, 6, 300, seed);
+    auto aig = src;
+    auto n = aig.cleanup();
+    check(n == src.A() - aig.A(), label + ": wrong return value");
+    check(n > 0, label + ": nothing was removed");
+    check(same_outputs(src, aig), label + ": outputs changed");
+    check_clean(aig, label);
+  }
+
+  // 読み込み時の cleanup オプション
+  {
+    auto aig1 = AigModel::read_aag(argv[1]);
+    aig1.cleanup();
+    AigReadOpt opt;
+    opt.cleanup = true;
+    auto aig2 = AigModel::read_aag(argv[1], opt);
+    check(same_model(aig1, aig2), "read_aag(cleanup = true) differs from cleanup()");
+  }
+
+  return report("cleanup");
+}
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::cleanup(argc, argv);
+}
@@ -0,0 +1,361 @@
+
+/// @file cnf.cc
+/// @brief AigModel::write_cnf() と make_cnf() のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigModel.h"
+#include "test_util.h"
+#include <cstdlib>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// DIMACS 形式の内容
+struct Dimacs
+{
+  SizeType mVarNum{0};
+  SizeType mClauseNum{0};
+  vector<int> mLitBuffer;
+  SizeType mParsedNum{0};
+  std::unordered_map<string, int> mCommentMap;
+  bool mError{false};
+};
+
+// DIMACS 形式を読み込む．
+Dimacs
+parse_dimacs(
+  const string& text
+)
+{
+  Dimacs dimacs;
+  istringstream s{text};
+  string line;
+  bool header = false;
+  while ( getline(s, line) ) {
+    istringstream s1{line};
+    if ( line.size() > 0 && line[0] == 'c' ) {
+      // "c <種類> <番号> <リテラル>"
+      string c, kind;
+      SizeType pos;
+      int lit;
+      s1 >> c >> kind >> pos >> lit;
+      dimacs.mCommentMap[kind + " " + std::to_string(pos)] = lit;
+      continue;
+    }
+    if ( line.size() > 0 && line[0] == 'p' ) {
+      string p, cnf;
+      s1 >> p >> cnf >> dimacs.mVarNum >> dimacs.mClauseNum;
+      header = true;
+      continue;
+    }
+    if ( !header ) {
+      dimacs.mError = true;
+    }
+    int lit;
+    while ( s1 >> lit ) {
+      dimacs.mLitBuffer.push_back(lit);
+      if ( lit == 0 ) {
+	++ dimacs.mParsedNum;
+      }
+    }
+  }
+  return dimacs;
+}
+
+// write_cnf() の出力が make_cnf() の結果と一致することを調べる．
+void
+check_dimacs(
+  const AigModel& aig,
+  const AigCnfOpt& opt,
+  const string& label
+)
+{
+  auto cnf = aig.make_cnf(opt);
+  ostringstream buf;
+  aig.write_cnf(buf, opt);
+  auto dimacs = parse_dimacs(buf.str());
+  check(!dimacs.mError, label + ": a clause appears before the header");
+  check(dimacs.mClauseNum == dimacs.mParsedNum,
+	label + ": the clause count in the header differs from the number of clauses");
+  check(dimacs.mVarNum == cnf.var_num(), label + ": var_num mismatch");
+  check(dimacs.mClauseNum == cnf.clause_num(), label + ": clause_num mismatch");
+  check(dimacs.mLitBuffer == cnf.lit_buffer(), label + ": clauses mismatch");
+  bool ok = true;
+  for ( auto lit: dimacs.mLitBuffer ) {
+    if ( std::abs(lit) > static_cast<int>(dimacs.mVarNum) ) {
+      ok = false;
+    }
+  }
+  check(ok, label + ": a literal is out of range");
+  // 符号化された入力とラッチだけがコメント行に現れる．
+  auto comment_var = [&](const string& key) {
+    auto p = dimacs.mCommentMap.find(key);
+    return p == dimacs.mCommentMap.end() ? 0 : p->second;
+  };
+  for ( SizeType i = 0; i < aig.I(); ++ i ) {
+    auto key = "input " + std::to_string(i);
+    check(comment_var(key) == cnf.cnf_var(aig.input(i) / 2),
+	  label + ": " + key + " comment mismatch");
+  }
+  for ( SizeType i = 0; i < aig.L(); ++ i ) {
+    auto key = "latch " + std::to_string(i);
+    check(comment_var(key) == cnf.cnf_var(aig.latch(i) / 2),
+	  label + ": " + key + " comment mismatch");
+  }
+
+  // lit_buffer() の節の数
+  SizeType n = 0;
+  for ( auto lit: cnf.lit_buffer() ) {
+    if ( lit == 0 ) {
+      ++ n;
+    }
+  }
+  check(n == cnf.clause_num(), label + ": clause_num() differs from the number of clauses");
+}
+
+// 全ての割り当てを列挙して CNF の意味を調べる．
+//
+// - 完全な Tseitin 符号化では，充足する割り当ては符号化された
+//   全てのノードの値が入力とラッチの値と無矛盾な割り当てに一致する．
+// - Plaisted-Greenbaum 符号化では，入力とラッチの値ごとに
+//   充足可能性が対象の出力の値と一致する．
+void
+check_brute_force(
+  const AigModel& aig,
+  const AigCnfOpt& opt,
+  const string& label
+)
+{
+  auto cnf = aig.make_cnf(opt);
+  auto nv = cnf.var_num();
+  ASSERT_COND( nv <= 22 );
+  auto& lit_buffer = cnf.lit_buffer();
+
+  // 符号化された入力とラッチ
+  vector<int> leaf_list;
+  vector<SizeType> leaf_var_list;
+  for ( SizeType i = 0; i < aig.I(); ++ i ) {
+    leaf_list.push_back(cnf.cnf_var(aig.input(i) / 2));
+  }
+  for ( SizeType i = 0; i < aig.L(); ++ i ) {
+    leaf_list.push_back(cnf.cnf_var(aig.latch(i) / 2));
+  }
+  auto nleaf = leaf_list.size();
+  ASSERT_COND( nleaf <= 16 );
+
+  // 入力とラッチの値ごとのシミュレーション結果
+  RefSim sim{aig};
+  vector<std::uint64_t> val_list;
+  {
+    vector<std::uint64_t> input_vals(aig.I());
+    vector<std::uint64_t> latch_vals(aig.L());
+    SizeType np = 1 << nleaf;
+    for ( SizeType p = 0; p < np; ++ p ) {
+      for ( SizeType i = 0; i < nleaf; ++ i ) {
+	auto v = ((p >> i) & 1) ? ~0ULL : 0ULL;
+	if ( i < aig.I() ) {
+	  input_vals[i] = v;
+	}
+	else {
+	  latch_vals[i - aig.I()] = v;
+	}
+      }
+      sim.eval(input_vals, latch_vals);
+      // 全ての変数の値をビット位置 p に詰める．
+      if ( p == 0 ) {
+	val_list.assign(aig.M() + 1, 0);
+      }
+      for ( SizeType var = 1; var <= aig.M(); ++ var ) {
+	if ( cnf.cnf_var(var) != 0 && (sim.lit_val(var * 2) & 1) ) {
+	  val_list[var] |= 1ULL << p;
+	}
+      }
+    }
+  }
+  auto opt_outputs = opt.output_list;
+  if ( opt.output_list.empty() && opt.latch_list.empty() ) {
+    for ( SizeType i = 0; i < aig.O(); ++ i ) {
+      opt_outputs.push_back(i);
+    }
+  }
+
+  vector<bool> sat_found(1 << nleaf, false);
+  SizeType na = 1 << nv;
+  bool ok = true;
+  for ( SizeType a = 0; a < na; ++ a ) {
+    auto cnf_val = [&](int lit) {
+      bool v = (a >> (std::abs(lit) - 1)) & 1;
+      return lit > 0 ? v : !v;
+    };
+    bool sat = true;
+    bool clause_sat = false;
+    for ( auto lit: lit_buffer ) {
+      if ( lit == 0 ) {
+	if ( !clause_sat ) {
+	  sat = false;
+	  break;
+	}
+	clause_sat = false;
+      }
+      else if ( cnf_val(lit) ) {
+	clause_sat = true;
+      }
+    }
+    // 入力とラッチの値
+    SizeType p = 0;
+    for ( SizeType i = 0; i < nleaf; ++ i ) {
+      if ( leaf_list[i] != 0 && cnf_val(leaf_list[i]) ) {
+	p |= 1 << i;
+      }
+    }
+    if ( sat ) {
+      sat_found[p] = true;
+    }
+    if ( !opt.polarity ) {
+      // 全ての符号化された変数がシミュレーション値と一致する時だけ充足する．
+      bool consistent = true;
+      for ( SizeType var = 0; var <= aig.M(); ++ var ) {
+	auto cvar = cnf.cnf_var(var);
+	if ( cvar != 0 && cnf_val(cvar) != static_cast<bool>((val_list[var] >> p) & 1) ) {
+	  consistent = false;
+	}
+      }
+      if ( opt.assert_outputs ) {
+	for ( SizeType i = 0; i < opt_outputs.size(); ++ i ) {
+	  if ( !cnf_val(cnf.output_lit(i)) ) {
+	    consistent = false;
+	  }
+	}
+      }
+      if ( sat != consistent ) {
+	ok = false;
+      }
+    }
+  }
+  check(ok, label + ": the satisfying assignments differ from the AIG");
+
+  // 入力とラッチの値ごとの充足可能性
+  bool ok2 = true;
+  for ( SizeType p = 0; p < sat_found.size(); ++ p ) {
+    bool expected = true;
+    if ( opt.assert_outputs ) {
+      for ( auto pos: opt_outputs ) {
+	auto lit = aig.output_src(pos);
+	auto v = static_cast<bool>((val_list[lit / 2] >> p) & 1) ^ (lit % 2);
+	if ( !v ) {
+	  expected = false;
+	}
+      }
+    }
+    // 符号化されていない入力とラッチの値は 0 とみなしている．
+    bool used = true;
+    for ( SizeType i = 0; i < nleaf; ++ i ) {
+      if ( leaf_list[i] == 0 && ((p >> i) & 1) ) {
+	used = false;
+      }
+    }
+    if ( used && sat_found[p] != expected ) {
+      ok2 = false;
+    }
+  }
+  check(ok2, label + ": the satisfiability differs from the AIG");
+}
+
+// 全ての組み合わせのオプションで調べる．
+void
+check_all(
+  const AigModel& aig,
+  bool brute_force,
+  const string& label
+)
+{
+  for ( auto coi: {false, true} ) {
+    for ( auto polarity: {false, true} ) {
+      for ( auto assert_outputs: {false, true} ) {
+	AigCnfOpt opt;
+	opt.coi = coi;
+	opt.polarity = polarity;
+	opt.assert_outputs = assert_outputs;
+	auto label1 = label + " (coi = " + std::to_string(coi) +
+	  ", polarity = " + std::to_string(polarity) +
+	  ", assert_outputs = " + std::to_string(assert_outputs) + ")";
+	check_dimacs(aig, opt, label1);
+	if ( brute_force ) {
+	  check_brute_force(aig, opt, label1);
+	}
+	if ( aig.O() > 1 ) {
+	  // 一部の出力だけを対象にする．
+	  opt.output_list = {aig.O() - 1};
+	  check_dimacs(aig, opt, label1 + " (the last output)");
+	  if ( brute_force ) {
+	    check_brute_force(aig, opt, label1 + " (the last output)");
+	  }
+	}
+      }
+    }
+  }
+}
+
+END_NONAMESPACE
+
+// 使い方: cnf <aag-file>
+//
+// DIMACS 形式のヘッダの節数が出力された節の数と一致することと，
+// 完全な Tseitin 符号化と Plaisted-Greenbaum 符号化の意味を
+// 全ての割り当ての列挙で調べる．
+int
+cnf(
+  int argc,
+  char** argv
+)
+{
+  if ( argc != 2 ) {
+    cerr << "Usage: cnf <aag-file>" << endl;
+    return 2;
+  }
+
+  auto aig = AigModel::read_aag(argv[1]);
+  check_all(aig, true, argv[1]);
+  for ( std::uint64_t seed = 1; seed <= 3; ++ seed ) {
+    check_all(random_aig(4, 2, 3, 12, seed), true, "random#" + std::to_string(seed));
+  }
+  check_all(random_aig(32, 8, 16, 3000, 4), false, "random#4");
+
+  // 範囲外の出力とラッチはエラーとなる．
+  for ( auto latch: {false, true} ) {
+    AigCnfOpt opt;
+    if ( latch ) {
+      opt.latch_list = {aig.L()};
+    }
+    else {
+      opt.output_list = {aig.O()};
+    }
+    bool thrown = false;
+    try {
+      aig.make_cnf(opt);
+    }
+    catch ( std::invalid_argument& ) {
+      thrown = true;
+    }
+    check(thrown, string{"an out-of-range "} + (latch ? "latch" : "output") + " was accepted");
+  }
+
+  return report("cnf");
+}
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::cnf(argc, argv);
+}
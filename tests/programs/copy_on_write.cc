@@ -0,0 +1,198 @@
+/// @file copy_on_write.cc
+/// @brief AigModel のコピーと copy-on-write のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigModel.h"
+#include "test_util.h"
+#include <functional>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 2つのモデルが ModelImpl を共有している時 true を返す．
+//
+// AigAndIter の等価比較は ModelImpl の同一性を含むので，
+// 先頭の反復子どうしを比較すればよい．
+bool
+is_shared(
+  const AigModel& aig1,
+  const AigModel& aig2
+)
+{
+  return aig1.and_begin() == aig2.and_begin();
+}
+
+// 空のモデルの時 true を返す．
+bool
+is_empty(
+  const AigModel& aig
+)
+{
+  return aig.I() == 0 && aig.L() == 0 && aig.O() == 0 && aig.A() == 0 &&
+    aig.and_begin() == aig.and_end();
+}
+
+// 変更する操作
+struct Mutator
+{
+  const char* mName;
+  std::function<void(AigModel&)> mFunc;
+};
+
+const vector<Mutator> mutator_list{
+  {"pack_ands", [](AigModel& aig) { aig.pack_ands(4); }},
+  {"cleanup", [](AigModel& aig) { aig.cleanup(); }},
+  {"strash", [](AigModel& aig) { aig.strash(); }},
+  {"reorder", [](AigModel& aig) { aig.reorder(true); }},
+};
+
+// コピーとその変更を検査する．
+//
+// ref は aig と同じ内容で ModelImpl を共有しないモデル
+void
+check_copy(
+  const AigModel& aig,
+  const AigModel& ref,
+  const string& label
+)
+{
+  for ( auto& mutator: mutator_list ) {
+    auto label1 = label + ", " + mutator.mName;
+
+    // コピーは変更されるまで ModelImpl を共有する．
+    AigModel copy{aig};
+    check(is_shared(copy, aig), label1 + ": copy does not share the impl");
+    AigModel assigned = ref;
+    assigned = aig;
+    check(is_shared(assigned, aig), label1 + ": assigned copy does not share the impl");
+
+    // コピーを変更しても元のモデルは変わらない．
+    mutator.mFunc(copy);
+    check(!is_shared(copy, aig), label1 + ": mutated copy still shares the impl");
+    check(same_model(aig, ref), label1 + ": original was modified");
+    check(is_shared(assigned, aig), label1 + ": other copy was unshared");
+
+    // 変更の前に得た反復子と展開器は古い内容を参照し続ける．
+    AigModel target{aig};
+    auto p = target.and_begin();
+    auto end = target.and_end();
+    AigUnrollOpt opt;
+    opt.frame_num = 1;
+    opt.strash = false;
+    auto unroller = target.make_unroller(opt);
+    mutator.mFunc(target);
+    SizeType pos = 0;
+    bool same = true;
+    for ( ; p != end && pos < ref.A(); ++ p, ++ pos ) {
+      if ( p.pos() != pos || p.node() != ref.and_node(pos) ||
+	   p.src1() != ref.and_src1(pos) || p.src2() != ref.and_src2(pos) ) {
+	same = false;
+      }
+    }
+    check(same && p == end && pos == ref.A(),
+	  label1 + ": iterator does not see the old data");
+    unroller.extend(2);
+    auto expected = ref.make_unroller(opt);
+    expected.extend(2);
+    check(same_model(unroller.model(), expected.model()),
+	  label1 + ": unroller does not see the old data");
+    check(same_model(aig, ref), label1 + ": original was modified");
+  }
+
+  // 圧縮表現のコピーを展開しても元のモデルは圧縮表現のまま
+  AigModel packed{aig};
+  packed.pack_ands(4);
+  AigModel unpacked{packed};
+  check(is_shared(unpacked, packed), label + ": packed copy does not share the impl");
+  unpacked.unpack_ands();
+  check(!unpacked.is_packed(), label + ": unpack_ands() failed");
+  check(packed.is_packed(), label + ": packed original was unpacked");
+  check(same_model(packed, ref), label + ": packed original was modified");
+  check(same_model(unpacked, ref), label + ": unpacked copy differs");
+}
+
+// ムーブを検査する．
+void
+check_move(
+  const AigModel& aig,
+  const AigModel& ref,
+  const string& label
+)
+{
+  // ムーブ先は元の内容となり，ムーブ元は空のモデルとなる．
+  AigModel src1{aig};
+  AigModel dst1{std::move(src1)};
+  check(same_model(dst1, ref), label + ": move constructed model differs");
+  check(is_empty(src1), label + ": moved-from model is not empty");
+
+  AigModel src2{aig};
+  AigModel dst2 = ref;
+  dst2 = std::move(src2);
+  check(same_model(dst2, ref), label + ": move assigned model differs");
+  check(is_empty(src2), label + ": moved-from model is not empty");
+
+  // 空のモデルを変更しても他の空のモデルには影響しない．
+  src1.pack_ands(4);
+  src1.cleanup();
+  src1.reorder();
+  check(is_empty(src1), label + ": mutated moved-from model is not empty");
+  check(is_empty(src2), label + ": other moved-from model was modified");
+
+  // ムーブ元には再び代入できる．
+  src1 = aig;
+  check(is_shared(src1, aig), label + ": reassigned model does not share the impl");
+  src2 = AigModel{aig};
+  check(same_model(src2, ref), label + ": reassigned model differs");
+}
+
+END_NONAMESPACE
+
+// 使い方: copy_on_write <aag-file>
+//
+// コピーが変更されるまで内容を共有し，変更しても他のコピーや
+// それ以前に得た反復子や展開器に影響しないことを確かめる．
+int
+copy_on_write(
+  int argc,
+  char** argv
+)
+{
+  if ( argc != 2 ) {
+    cerr << "Usage: copy_on_write <aag-file>" << endl;
+    return 2;
+  }
+
+  {
+    auto aig = AigModel::read_aag(argv[1]);
+    auto ref = AigModel::read_aag(argv[1]);
+    check(!is_shared(aig, ref), string{argv[1]} + ": separately read models share the impl");
+    check_copy(aig, ref, argv[1]);
+    check_move(aig, ref, argv[1]);
+  }
+  for ( std::uint64_t seed = 1; seed <= 3; ++ seed ) {
+    auto label = "random#" + std::to_string(seed);
+    auto aig = random_aig(10, 4, 6, 200, seed);
+    auto ref = random_aig(10, 4, 6, 200, seed);
+    check_copy(aig, ref, label);
+    check_move(aig, ref, label);
+  }
+
+  return report("copy_on_write");
+}
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::copy_on_write(argc, argv);
+}
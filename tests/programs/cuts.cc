@@ -0,0 +1,345 @@
+
+/// @file cuts.cc
+/// @brief AigModel::enumerate_cuts() のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigModel.h"
+#include "ym/AigCuts.h"
+#include "test_util.h"
+#include <algorithm>
+#include <map>
+#include <set>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 葉の集合
+using LeafSet = vector<SizeType>;
+
+// 素朴な方法で求めた参照用の情報
+class RefCuts
+{
+public:
+
+  // コンストラクタ
+  RefCuts(
+    const AigModel& aig,
+    SizeType cut_size
+  ) : mAig{aig},
+      mCutSize{cut_size}
+  {
+    for ( SizeType i = 0; i < aig.A(); ++ i ) {
+      mAndMap.emplace(aig.and_node(i) / 2, i);
+    }
+  }
+
+  // ANDノードの時 true を返す．
+  bool
+  is_and(
+    SizeType var
+  ) const
+  {
+    return mAndMap.count(var) > 0;
+  }
+
+  // レベルを返す．
+  SizeType
+  level(
+    SizeType var
+  )
+  {
+    if ( !is_and(var) ) {
+      return 0;
+    }
+    auto p = mLevel.find(var);
+    if ( p != mLevel.end() ) {
+      return p->second;
+    }
+    auto pos = mAndMap.at(var);
+    auto l = std::max(level(mAig.and_src1(pos) / 2),
+		      level(mAig.and_src2(pos) / 2)) + 1;
+    mLevel.emplace(var, l);
+    return l;
+  }
+
+  // 全ての(支配されない)カットを返す．
+  const std::set<LeafSet>&
+  all_cuts(
+    SizeType var
+  )
+  {
+    auto p = mCuts.find(var);
+    if ( p != mCuts.end() ) {
+      return p->second;
+    }
+    std::set<LeafSet> cut_set;
+    if ( var == 0 ) {
+      cut_set.insert(LeafSet{});
+    }
+    else {
+      cut_set.insert(LeafSet{var});
+    }
+    if ( is_and(var) ) {
+      auto pos = mAndMap.at(var);
+      auto& cuts1 = all_cuts(mAig.and_src1(pos) / 2);
+      auto& cuts2 = all_cuts(mAig.and_src2(pos) / 2);
+      for ( auto& c1: cuts1 ) {
+	for ( auto& c2: cuts2 ) {
+	  LeafSet c;
+	  std::set_union(c1.begin(), c1.end(), c2.begin(), c2.end(),
+			 std::back_inserter(c));
+	  if ( c.size() <= mCutSize ) {
+	    cut_set.insert(c);
+	  }
+	}
+      }
+    }
+    // 他のカットを真に含むカットを除く．
+    std::set<LeafSet> ans;
+    for ( auto& c: cut_set ) {
+      bool dominated = false;
+      for ( auto& d: cut_set ) {
+	if ( d.size() < c.size() &&
+	     std::includes(c.begin(), c.end(), d.begin(), d.end()) ) {
+	  dominated = true;
+	  break;
+	}
+      }
+      if ( !dominated ) {
+	ans.insert(c);
+      }
+    }
+    return mCuts.emplace(var, ans).first->second;
+  }
+
+  // 葉に値を与えて var の値を求める．
+  // 葉で区切られない経路がある場合は false を返す．
+  bool
+  eval(
+    SizeType var,
+    const LeafSet& leaves,
+    SizeType minterm,
+    std::map<SizeType, int>& memo,
+    int& val
+  )
+  {
+    auto p = std::lower_bound(leaves.begin(), leaves.end(), var);
+    if ( p != leaves.end() && *p == var ) {
+      val = (minterm >> (p - leaves.begin())) & 1;
+      return true;
+    }
+    if ( var == 0 ) {
+      val = 0;
+      return true;
+    }
+    if ( !is_and(var) ) {
+      return false;
+    }
+    auto q = memo.find(var);
+    if ( q != memo.end() ) {
+      val = q->second;
+      return true;
+    }
+    auto pos = mAndMap.at(var);
+    auto lit1 = mAig.and_src1(pos);
+    auto lit2 = mAig.and_src2(pos);
+    int val1;
+    int val2;
+    if ( !eval(lit1 / 2, leaves, minterm, memo, val1) ||
+	 !eval(lit2 / 2, leaves, minterm, memo, val2) ) {
+      return false;
+    }
+    val = (val1 ^ (lit1 % 2)) & (val2 ^ (lit2 % 2));
+    memo.emplace(var, val);
+    return true;
+  }
+
+private:
+
+  const AigModel& mAig;
+  SizeType mCutSize;
+  std::map<SizeType, SizeType> mAndMap;
+  std::map<SizeType, SizeType> mLevel;
+  std::map<SizeType, std::set<LeafSet>> mCuts;
+
+};
+
+// カットの列挙結果を調べる．
+//
+// exact が true の時は全てのカットが列挙されていることも調べる．
+void
+check_cuts(
+  const AigModel& aig,
+  const AigCutOpt& opt,
+  bool exact,
+  const string& label
+)
+{
+  auto cuts = aig.enumerate_cuts(opt);
+  auto opt1 = opt;
+  opt1.thread_num = 1;
+  auto cuts1 = aig.enumerate_cuts(opt1);
+  RefCuts ref{aig, opt.cut_size};
+
+  SizeType n_bad_leaf = 0;
+  SizeType n_bad_level = 0;
+  SizeType n_bad_truth = 0;
+  SizeType n_bad_sig = 0;
+  SizeType n_diff = 0;
+  SizeType n_missing = 0;
+  SizeType n_thread = 0;
+  for ( SizeType var = 0; var < cuts.var_num(); ++ var ) {
+    if ( cuts.level(var) != ref.level(var) ) {
+      ++ n_bad_level;
+    }
+    if ( cuts.cut_num(var) != cuts1.cut_num(var) ) {
+      ++ n_thread;
+      continue;
+    }
+    // 0 番目は自明なカット
+    if ( var > 0 && cuts.leaf_list(var, 0) != LeafSet{var} ) {
+      ++ n_bad_leaf;
+    }
+    if ( cuts.cut_num(var) > opt.cut_limit + 1 ) {
+      ++ n_bad_leaf;
+    }
+    std::set<LeafSet> cut_set;
+    for ( SizeType k = 0; k < cuts.cut_num(var); ++ k ) {
+      auto leaves = cuts.leaf_list(var, k);
+      if ( leaves != cuts1.leaf_list(var, k) ||
+	   cuts.truth_table(var, k) != cuts1.truth_table(var, k) ) {
+	++ n_thread;
+      }
+      if ( leaves.size() > opt.cut_size ||
+	   !std::is_sorted(leaves.begin(), leaves.end()) ||
+	   std::adjacent_find(leaves.begin(), leaves.end()) != leaves.end() ) {
+	++ n_bad_leaf;
+	continue;
+      }
+      cut_set.insert(leaves);
+      std::uint64_t sig = 0;
+      for ( auto leaf: leaves ) {
+	sig |= 1ULL << (leaf % 64);
+      }
+      if ( cuts.signature(var, k) != sig ) {
+	++ n_bad_sig;
+      }
+      // 全ての最小項で真理値表とシミュレーション結果を比べる．
+      auto tv = cuts.truth_ptr(var, k);
+      for ( SizeType m = 0; m < (1U << opt.cut_size); ++ m ) {
+	std::map<SizeType, int> memo;
+	int val;
+	if ( !ref.eval(var, leaves, m, memo, val) ) {
+	  ++ n_bad_leaf;
+	  break;
+	}
+	if ( opt.truth_table && ((tv[m / 64] >> (m % 64)) & 1) != static_cast<std::uint64_t>(val) ) {
+	  ++ n_bad_truth;
+	  break;
+	}
+      }
+    }
+    if ( cut_set.size() != cuts.cut_num(var) ) {
+      ++ n_bad_leaf;
+    }
+    // 他のカットに支配されるカットは残らない．
+    for ( auto& c: cut_set ) {
+      for ( auto& d: cut_set ) {
+	if ( d.size() < c.size() &&
+	     std::includes(c.begin(), c.end(), d.begin(), d.end()) ) {
+	  ++ n_diff;
+	}
+      }
+    }
+    if ( exact && cut_set != ref.all_cuts(var) ) {
+      ++ n_missing;
+    }
+  }
+  check(n_bad_leaf == 0, label + ": illegal cuts");
+  check(n_bad_level == 0, label + ": level mismatch");
+  check(n_bad_truth == 0, label + ": truth table mismatch");
+  check(n_bad_sig == 0, label + ": signature mismatch");
+  check(n_diff == 0, label + ": dominated cuts remain");
+  check(n_missing == 0, label + ": the cut sets differ from the exhaustive enumeration");
+  check(n_thread == 0, label + ": the results depend on the number of threads");
+}
+
+END_NONAMESPACE
+
+// 使い方: cuts <aag-file>
+//
+// 与えられたファイルとランダムなモデルについて，列挙されたカットが
+// 正しいカットであること，真理値表がシミュレーション結果と一致する
+// ことを調べる．カット数の上限が十分大きい場合は全てのカットを
+// 素朴な方法で列挙した結果と比較する．
+int
+cuts(
+  int argc,
+  char** argv
+)
+{
+  if ( argc != 2 ) {
+    cerr << "Usage: cuts <aag-file>" << endl;
+    return 2;
+  }
+
+  vector<std::pair<string, AigModel>> model_list;
+  model_list.push_back({argv[1], AigModel::read_aag(argv[1])});
+  model_list.push_back({"random#1", random_aig(8, 2, 4, 200, 1)});
+  model_list.push_back({"random#2", random_aig(16, 0, 8, 400, 2)});
+  for ( auto& p: model_list ) {
+    auto& label = p.first;
+    auto& aig = p.second;
+    for ( SizeType cut_size: {3, 4, 6, 8} ) {
+      AigCutOpt opt;
+      opt.cut_size = cut_size;
+      opt.truth_table = true;
+      opt.thread_num = 4;
+      auto suffix = " (cut_size = " + std::to_string(cut_size) + ")";
+      // 上限のある場合
+      opt.cut_limit = 4;
+      check_cuts(aig, opt, false, label + suffix);
+      // 全てのカットを残す場合
+      if ( cut_size <= 4 ) {
+	opt.cut_limit = 10000;
+	check_cuts(aig, opt, true, label + suffix + " (all cuts)");
+      }
+    }
+  }
+
+  {
+    // 範囲外の cut_size
+    auto& aig = model_list[0].second;
+    for ( SizeType cut_size: {0, 9} ) {
+      AigCutOpt opt;
+      opt.cut_size = cut_size;
+      bool thrown = false;
+      try {
+	aig.enumerate_cuts(opt);
+      }
+      catch ( std::invalid_argument& ) {
+	thrown = true;
+      }
+      check(thrown, "cut_size = " + std::to_string(cut_size) + " was accepted");
+    }
+  }
+
+  return report("cuts");
+}
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::cuts(argc, argv);
+}
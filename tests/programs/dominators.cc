@@ -0,0 +1,239 @@
+
+/// @file dominators.cc
+/// @brief AigModel::compute_dominators() のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigModel.h"
+#include "test_util.h"
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 参照回数を用いて MFFC の大きさを求める．
+//
+// ノードを削除したとして参照回数を減らし(deref)，0 になった
+// ANDノードを数えてから参照回数を元に戻す(reref)．
+class RefMffc
+{
+public:
+
+  // コンストラクタ
+  explicit
+  RefMffc(
+    const AigModel& aig
+  ) : mAig{aig},
+      mRefCount(aig.M() + 1, 0)
+  {
+    for ( SizeType i = 0; i < aig.A(); ++ i ) {
+      mAndMap.emplace(aig.and_node(i) / 2, i);
+      ++ mRefCount[aig.and_src1(i) / 2];
+      ++ mRefCount[aig.and_src2(i) / 2];
+    }
+    for ( SizeType i = 0; i < aig.O(); ++ i ) {
+      ++ mRefCount[aig.output_src(i) / 2];
+    }
+    for ( SizeType i = 0; i < aig.L(); ++ i ) {
+      ++ mRefCount[aig.latch_src(i) / 2];
+    }
+  }
+
+  // MFFC の大きさを返す．
+  SizeType
+  mffc_size(
+    SizeType var
+  )
+  {
+    auto before = mRefCount;
+    auto n = deref(var);
+    auto n2 = reref(var);
+    check(n == n2 && mRefCount == before, "reref() does not restore the reference counts");
+    return n;
+  }
+
+private:
+
+  // 参照回数を減らして削除されるANDノード数を返す．
+  SizeType
+  deref(
+    SizeType var
+  )
+  {
+    auto p = mAndMap.find(var);
+    if ( p == mAndMap.end() ) {
+      return 0;
+    }
+    SizeType n = 1;
+    for ( auto lit: {mAig.and_src1(p->second), mAig.and_src2(p->second)} ) {
+      if ( -- mRefCount[lit / 2] == 0 ) {
+	n += deref(lit / 2);
+      }
+    }
+    return n;
+  }
+
+  // 参照回数を元に戻して復元されるANDノード数を返す．
+  SizeType
+  reref(
+    SizeType var
+  )
+  {
+    auto p = mAndMap.find(var);
+    if ( p == mAndMap.end() ) {
+      return 0;
+    }
+    SizeType n = 1;
+    for ( auto lit: {mAig.and_src1(p->second), mAig.and_src2(p->second)} ) {
+      if ( mRefCount[lit / 2] ++ == 0 ) {
+	n += reref(lit / 2);
+      }
+    }
+    return n;
+  }
+
+  const AigModel& mAig;
+  std::unordered_map<SizeType, SizeType> mAndMap;
+  vector<SizeType> mRefCount;
+
+};
+
+// 支配木と MFFC の大きさを素朴な方法と比較する．
+void
+check_dominators(
+  const AigModel& aig,
+  const string& label
+)
+{
+  auto dom = aig.compute_dominators();
+  auto var_num = aig.M() + 1;
+  check(dom.var_num() == var_num, label + ": var_num() mismatch");
+
+  // MFFC の大きさ
+  RefMffc ref{aig};
+  bool ok = true;
+  for ( SizeType var = 0; var < var_num; ++ var ) {
+    if ( dom.mffc_size(var) != ref.mffc_size(var) ) {
+      ok = false;
+    }
+  }
+  check(ok, label + ": MFFC sizes differ from the deref/reref procedure");
+
+  // ファンアウトの表(var_num は仮想的な根を表す)
+  auto root = var_num;
+  vector<vector<SizeType>> fanout_list(var_num);
+  for ( SizeType i = 0; i < aig.A(); ++ i ) {
+    auto var = aig.and_node(i) / 2;
+    fanout_list[aig.and_src1(i) / 2].push_back(var);
+    fanout_list[aig.and_src2(i) / 2].push_back(var);
+  }
+  for ( SizeType var = 0; var < var_num; ++ var ) {
+    if ( fanout_list[var].empty() ) {
+      fanout_list[var].push_back(root);
+    }
+  }
+  for ( SizeType i = 0; i < aig.O(); ++ i ) {
+    fanout_list[aig.output_src(i) / 2].push_back(root);
+  }
+  for ( SizeType i = 0; i < aig.L(); ++ i ) {
+    fanout_list[aig.latch_src(i) / 2].push_back(root);
+  }
+
+  // v を除くと u から根に到達できない時 v は u を支配する．
+  // 全ての組み合わせを調べるので小さいモデルのみを対象とする．
+  bool ok_dom = true;
+  for ( SizeType v = 0; v < var_num; ++ v ) {
+    for ( SizeType u = 0; u < var_num; ++ u ) {
+      bool dominated = true;
+      if ( u != v ) {
+	vector<bool> mark(var_num + 1, false);
+	vector<SizeType> stack{u};
+	mark[u] = true;
+	while ( !stack.empty() && dominated ) {
+	  auto x = stack.back();
+	  stack.pop_back();
+	  for ( auto y: fanout_list[x] ) {
+	    if ( y == root ) {
+	      dominated = false;
+	      break;
+	    }
+	    if ( y != v && !mark[y] ) {
+	      mark[y] = true;
+	      stack.push_back(y);
+	    }
+	  }
+	}
+      }
+      if ( dom.dominates(v, u) != dominated ) {
+	ok_dom = false;
+      }
+    }
+  }
+  check(ok_dom, label + ": dominates() differs from the reachability");
+
+  // 直接支配ノードと深さ
+  bool ok_idom = true;
+  for ( SizeType var = 0; var < var_num; ++ var ) {
+    auto idom = dom.idom(var);
+    if ( idom == root ) {
+      if ( dom.depth(var) != 1 ) {
+	ok_idom = false;
+      }
+      continue;
+    }
+    if ( idom == var || !dom.dominates(idom, var) ||
+	 dom.depth(var) != dom.depth(idom) + 1 ) {
+      ok_idom = false;
+    }
+  }
+  check(ok_idom, label + ": idom() or depth() is inconsistent");
+}
+
+END_NONAMESPACE
+
+// 使い方: dominators <aag-file>
+//
+// MFFC の大きさが参照回数を用いた deref/reref の手続きで求めた値と
+// 一致することと，支配関係が到達可能性から求めたものと一致することを調べる．
+int
+dominators(
+  int argc,
+  char** argv
+)
+{
+  if ( argc != 2 ) {
+    cerr << "Usage: dominators <aag-file>" << endl;
+    return 2;
+  }
+
+  auto aig = AigModel::read_aag(argv[1]);
+  check_dominators(aig, argv[1]);
+  if ( aig.M() == 5 && aig.A() == 2 && aig.O() == 1 ) {
+    // test1.aag では出力の ANDノード(変数 5)がもう一方の
+    // ANDノード(変数 4)を支配する．
+    auto dom = aig.compute_dominators();
+    vector<SizeType> expected{0, 0, 0, 0, 1, 2};
+    check(dom.mffc_size_array() == expected, string{argv[1]} + ": MFFC sizes mismatch");
+  }
+  for ( std::uint64_t seed = 1; seed <= 4; ++ seed ) {
+    auto label = "random#" + std::to_string(seed);
+    check_dominators(random_aig(8, 4, 6, 150, seed), label);
+  }
+
+  return report("dominators");
+}
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::dominators(argc, argv);
+}
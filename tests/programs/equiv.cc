@@ -0,0 +1,195 @@
+
+/// @file equiv.cc
+/// @brief AigModel::find_equiv_classes() のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigModel.h"
+#include "test_util.h"
+#include <map>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 全ての入力とラッチの値の組み合わせでシミュレーションして
+// 厳密な等価クラスを求める．
+//
+// 標準形のモデルを対象とし，変数番号をキーにして
+// 最小の変数番号を持つ代表のリテラルを返す．
+vector<SizeType>
+exact_classes(
+  const AigModel& aig
+)
+{
+  auto nleaf = aig.I() + aig.L();
+  ASSERT_COND( nleaf <= 12 );
+  SizeType np = 1 << nleaf;
+  SizeType nw = (np + 63) / 64;
+  auto var_num = aig.M() + 1;
+  vector<vector<std::uint64_t>> sig_list(var_num, vector<std::uint64_t>(nw, 0));
+  RefSim sim{aig};
+  for ( SizeType w = 0; w < nw; ++ w ) {
+    vector<std::uint64_t> input_vals(aig.I(), 0);
+    vector<std::uint64_t> latch_vals(aig.L(), 0);
+    for ( SizeType b = 0; b < 64; ++ b ) {
+      // パタン数が 64 未満の時は繰り返す．
+      auto p = (w * 64 + b) % np;
+      for ( SizeType i = 0; i < nleaf; ++ i ) {
+	std::uint64_t bit = ((p >> i) & 1) << b;
+	if ( i < aig.I() ) {
+	  input_vals[i] |= bit;
+	}
+	else {
+	  latch_vals[i - aig.I()] |= bit;
+	}
+      }
+    }
+    sim.eval(input_vals, latch_vals);
+    for ( SizeType var = 0; var < var_num; ++ var ) {
+      sig_list[var][w] = sim.lit_val(var * 2);
+    }
+  }
+
+  // 最初のパタンの値が 0 となるように正規化したシグネチャで分類する．
+  std::map<vector<std::uint64_t>, SizeType> rep_map;
+  vector<SizeType> rep_list(var_num);
+  for ( SizeType var = 0; var < var_num; ++ var ) {
+    auto sig = sig_list[var];
+    SizeType inv = sig[0] & 1;
+    if ( inv ) {
+      for ( auto& word: sig ) {
+	word = ~word;
+      }
+    }
+    auto p = rep_map.emplace(sig, var * 2 + inv).first;
+    rep_list[var] = p->second ^ inv;
+  }
+  return rep_list;
+}
+
+// クラスのリストと併合表が整合していることを調べる．
+void
+check_consistency(
+  const AigModel& aig,
+  const AigEquivClasses& classes,
+  const string& label
+)
+{
+  check(classes.var_num() == aig.M() + 1, label + ": var_num() mismatch");
+  bool ok = true;
+  SizeType nmember = 0;
+  for ( SizeType id = 0; id < classes.class_num(); ++ id ) {
+    if ( classes.class_size(id) < 2 ) {
+      ok = false;
+    }
+    auto rep = classes.class_lit(id, 0);
+    if ( rep % 2 != 0 || classes.merge_lit(rep / 2) != rep ) {
+      ok = false;
+    }
+    for ( auto lit: classes.class_lit_list(id) ) {
+      // 標準形のモデルでは代表は最小の変数番号を持つ．
+      if ( lit / 2 < rep / 2 || classes.merge_lit(lit / 2) != (rep ^ (lit % 2)) ) {
+	ok = false;
+      }
+    }
+    nmember += classes.class_size(id);
+  }
+  check(ok, label + ": the classes are inconsistent with the merge map");
+  check(classes.merge_num() == nmember - classes.class_num(),
+	label + ": merge_num() mismatch");
+  SizeType nmerged = 0;
+  for ( SizeType var = 0; var < classes.var_num(); ++ var ) {
+    if ( classes.merge_lit(var) != var * 2 ) {
+      ++ nmerged;
+    }
+  }
+  check(nmerged == classes.merge_num(),
+	label + ": merge_num() differs from the merge map");
+}
+
+// 等価クラスを調べる．
+void
+check_classes(
+  const AigModel& aig,
+  const string& label
+)
+{
+  auto exact = exact_classes(aig);
+
+  // 少ないラウンド数でも真に等価なノードは常に同じクラスに入る．
+  AigEquivOpt opt;
+  opt.word_num = 1;
+  opt.round_num = 2;
+  opt.thread_num = 1;
+  auto coarse = aig.find_equiv_classes(opt);
+  check_consistency(aig, coarse, label + " (2 rounds)");
+  bool ok = true;
+  for ( SizeType var = 0; var < exact.size(); ++ var ) {
+    auto lit = exact[var];
+    auto m1 = coarse.merge_lit(var);
+    auto m2 = coarse.merge_lit(lit / 2) ^ (lit % 2);
+    if ( m1 != m2 ) {
+      ok = false;
+    }
+  }
+  check(ok, label + " (2 rounds): equivalent nodes are separated");
+
+  // 十分なラウンド数では厳密な等価クラスと一致する．
+  opt.word_num = 2;
+  opt.round_num = 64;
+  for ( SizeType thread_num: {1, 4} ) {
+    opt.thread_num = thread_num;
+    auto classes = aig.find_equiv_classes(opt);
+    auto label1 = label + " (thread_num = " + std::to_string(thread_num) + ")";
+    check_consistency(aig, classes, label1);
+    vector<SizeType> merge_map(classes.merge_map().begin(), classes.merge_map().end());
+    check(merge_map == exact, label1 + ": the classes differ from the exact ones");
+  }
+}
+
+END_NONAMESPACE
+
+// 使い方: equiv <aag-file>
+//
+// ランダムシミュレーションで求めた等価候補のクラスを，全ての
+// パタンのスカラーシミュレーションで求めた厳密な等価クラスと比較する．
+int
+equiv(
+  int argc,
+  char** argv
+)
+{
+  if ( argc != 2 ) {
+    cerr << "Usage: equiv <aag-file>" << endl;
+    return 2;
+  }
+
+  // 標準形に並べ替える．
+  auto aig = AigModel::read_aag(argv[1]);
+  aig.reorder();
+  check_classes(aig, argv[1]);
+  // 大きい方は定数に縮退するノードが多く，小さい方は多くのクラスを持つ．
+  for ( std::uint64_t seed = 1; seed <= 4; ++ seed ) {
+    auto label = "random#" + std::to_string(seed);
+    check_classes(random_aig(6, 2, 4, 200, seed), label);
+    check_classes(random_aig(8, 2, 8, 60, seed), label + " (small)");
+  }
+
+  return report("equiv");
+}
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::equiv(argc, argv);
+}
@@ -0,0 +1,153 @@
+
+/// @file incr_sim.cc
+/// @brief AigIncrSim のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigModel.h"
+#include "test_util.h"
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 入力とラッチの値をランダムに変えながら結果を RefSim と比較する．
+void
+check_incr_sim(
+  const AigModel& aig,
+  std::uint64_t seed,
+  const string& label
+)
+{
+  auto sim = aig.make_incr_sim();
+  check(sim.input_num() == aig.I(), label + ": input_num() mismatch");
+  check(sim.latch_num() == aig.L(), label + ": latch_num() mismatch");
+  check(sim.output_num() == aig.O(), label + ": output_num() mismatch");
+
+  RefSim ref{aig};
+  vector<std::uint64_t> input_vals(aig.I(), 0);
+  vector<std::uint64_t> latch_vals(aig.L(), 0);
+  vector<std::uint64_t> prev_vals(aig.O());
+  ref.eval(input_vals, latch_vals);
+  for ( SizeType i = 0; i < aig.O(); ++ i ) {
+    prev_vals[i] = ref.output_val(i);
+  }
+
+  std::mt19937_64 rng{seed};
+  bool ok_val = true;
+  bool ok_changed = true;
+  bool ok_eval = true;
+  for ( SizeType k = 0; k < 200; ++ k ) {
+    const vector<SizeType>* changed;
+    auto op = rng() % 8;
+    if ( op == 0 && aig.L() > 0 ) {
+      // 次状態に進める．
+      for ( SizeType i = 0; i < aig.L(); ++ i ) {
+	latch_vals[i] = ref.latch_next(i);
+      }
+      changed = &sim.step();
+    }
+    else {
+      // 一部の入力とラッチの値を変える．
+      auto n = rng() % 3;
+      for ( SizeType j = 0; j < n; ++ j ) {
+	auto r = rng() % (aig.I() + aig.L());
+	if ( r < aig.I() ) {
+	  if ( rng() % 2 ) {
+	    auto mask = rng() & rng();
+	    input_vals[r] ^= mask;
+	    sim.flip_input(r, mask);
+	  }
+	  else {
+	    input_vals[r] = rng();
+	    sim.set_input(r, input_vals[r]);
+	  }
+	}
+	else {
+	  auto pos = r - aig.I();
+	  latch_vals[pos] = rng();
+	  sim.set_latch(pos, latch_vals[pos]);
+	}
+      }
+      changed = &sim.update();
+      if ( n == 0 && sim.eval_num() != 0 ) {
+	// 何も変えていなければ何も計算しない．
+	ok_eval = false;
+      }
+    }
+    if ( sim.eval_num() > aig.A() ) {
+      ok_eval = false;
+    }
+
+    ref.eval(input_vals, latch_vals);
+    for ( SizeType i = 0; i < aig.I(); ++ i ) {
+      if ( sim.input_value(i) != input_vals[i] ) {
+	ok_val = false;
+      }
+    }
+    for ( SizeType i = 0; i < aig.L(); ++ i ) {
+      if ( sim.latch_value(i) != latch_vals[i] ||
+	   sim.latch_next_value(i) != ref.latch_next(i) ) {
+	ok_val = false;
+      }
+    }
+    vector<SizeType> expected;
+    for ( SizeType i = 0; i < aig.O(); ++ i ) {
+      auto val = ref.output_val(i);
+      if ( sim.output_value(i) != val ) {
+	ok_val = false;
+      }
+      if ( val != prev_vals[i] ) {
+	expected.push_back(i);
+      }
+      prev_vals[i] = val;
+    }
+    if ( *changed != expected ) {
+      ok_changed = false;
+    }
+  }
+  check(ok_val, label + ": the values differ from the reference simulation");
+  check(ok_changed, label + ": the list of changed outputs is wrong");
+  check(ok_eval, label + ": eval_num() is out of range");
+}
+
+END_NONAMESPACE
+
+// 使い方: incr_sim <aag-file>
+//
+// 入力とラッチの値の変更と状態遷移を繰り返し，差分シミュレーションの
+// 結果と値の変わった出力のリストを全体の再計算の結果と比較する．
+int
+incr_sim(
+  int argc,
+  char** argv
+)
+{
+  if ( argc != 2 ) {
+    cerr << "Usage: incr_sim <aag-file>" << endl;
+    return 2;
+  }
+
+  check_incr_sim(AigModel::read_aag(argv[1]), 1, argv[1]);
+  for ( std::uint64_t seed = 1; seed <= 3; ++ seed ) {
+    auto label = "random#" + std::to_string(seed);
+    check_incr_sim(random_aig(16, 8, 16, 500, seed), seed, label);
+  }
+
+  return report("incr_sim");
+}
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::incr_sim(argc, argv);
+}
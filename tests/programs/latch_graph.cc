@@ -0,0 +1,245 @@
+
+/// @file latch_graph.cc
+/// @brief AigModel::compute_latch_graph() のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigModel.h"
+#include "test_util.h"
+#include <algorithm>
+#include <set>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 強連結成分が分かっているモデル
+//
+// - L0 と L1 はループを作る．
+// - L2 は自己ループを持ち，L0 をファンインに持つ．
+// - L3 は入力だけに依存する．
+// - L4 と L5 はループを作り，L3 をファンインに持つ．
+const char* SCC_AAG =
+  "aag 10 1 6 1 3\n"
+  "2\n"
+  "4 16\n"
+  "6 4\n"
+  "8 18\n"
+  "10 2\n"
+  "12 20\n"
+  "14 13\n"
+  "16\n"
+  "16 6 2\n"
+  "18 8 4\n"
+  "20 14 10\n";
+
+// ラッチごとのファンインのラッチ番号の集合を素朴に求める．
+vector<std::set<SizeType>>
+ref_fanins(
+  const AigModel& aig
+)
+{
+  std::unordered_map<SizeType, SizeType> and_map;
+  std::unordered_map<SizeType, SizeType> latch_map;
+  for ( SizeType i = 0; i < aig.A(); ++ i ) {
+    and_map.emplace(aig.and_node(i) / 2, i);
+  }
+  for ( SizeType i = 0; i < aig.L(); ++ i ) {
+    latch_map.emplace(aig.latch(i) / 2, i);
+  }
+  vector<std::set<SizeType>> fanin_list(aig.L());
+  for ( SizeType i = 0; i < aig.L(); ++ i ) {
+    std::set<SizeType> mark;
+    vector<SizeType> stack{aig.latch_src(i) / 2};
+    while ( !stack.empty() ) {
+      auto var = stack.back();
+      stack.pop_back();
+      if ( !mark.insert(var).second ) {
+	continue;
+      }
+      auto p = and_map.find(var);
+      if ( p != and_map.end() ) {
+	stack.push_back(aig.and_src1(p->second) / 2);
+	stack.push_back(aig.and_src2(p->second) / 2);
+      }
+      auto q = latch_map.find(var);
+      if ( q != latch_map.end() ) {
+	fanin_list[i].insert(q->second);
+      }
+    }
+  }
+  return fanin_list;
+}
+
+// グラフと強連結成分を素朴な到達可能性の計算と比較する．
+void
+check_graph(
+  const AigModel& aig,
+  const AigLatchGraph& graph,
+  const string& label
+)
+{
+  auto L = aig.L();
+  check(graph.latch_num() == L, label + ": latch_num() mismatch");
+  auto fanin_list = ref_fanins(aig);
+  bool ok = true;
+  SizeType nedge = 0;
+  vector<vector<SizeType>> fanout_list(L);
+  for ( SizeType v = 0; v < L; ++ v ) {
+    vector<SizeType> expected(fanin_list[v].begin(), fanin_list[v].end());
+    if ( graph.fanin_list(v) != expected ) {
+      ok = false;
+    }
+    for ( auto u: expected ) {
+      fanout_list[u].push_back(v);
+    }
+    nedge += expected.size();
+  }
+  check(ok, label + ": the fanins differ from the structural traversal");
+  check(graph.edge_num() == nedge, label + ": edge_num() mismatch");
+  bool ok2 = true;
+  for ( SizeType u = 0; u < L; ++ u ) {
+    if ( graph.fanout_list(u) != fanout_list[u] ) {
+      ok2 = false;
+    }
+  }
+  check(ok2, label + ": the fanouts are not the reverse of the fanins");
+
+  // 到達可能性(推移閉包)
+  vector<vector<bool>> reach(L, vector<bool>(L, false));
+  for ( SizeType u = 0; u < L; ++ u ) {
+    vector<SizeType> stack{u};
+    while ( !stack.empty() ) {
+      auto x = stack.back();
+      stack.pop_back();
+      for ( auto y: fanout_list[x] ) {
+	if ( !reach[u][y] ) {
+	  reach[u][y] = true;
+	  stack.push_back(y);
+	}
+      }
+    }
+  }
+  bool ok3 = true;
+  for ( SizeType u = 0; u < L; ++ u ) {
+    for ( SizeType v = 0; v < L; ++ v ) {
+      bool same = u == v || (reach[u][v] && reach[v][u]);
+      if ( (graph.scc_id(u) == graph.scc_id(v)) != same ) {
+	ok3 = false;
+      }
+      if ( reach[u][v] && graph.scc_id(u) > graph.scc_id(v) ) {
+	ok3 = false;
+      }
+    }
+  }
+  check(ok3, label + ": the SCCs differ from the mutual reachability");
+  bool ok4 = true;
+  SizeType nmember = 0;
+  for ( SizeType id = 0; id < graph.scc_num(); ++ id ) {
+    auto latch_list = graph.scc_latch_list(id);
+    if ( latch_list.empty() || !std::is_sorted(latch_list.begin(), latch_list.end()) ) {
+      ok4 = false;
+    }
+    for ( auto l: latch_list ) {
+      if ( graph.scc_id(l) != id ) {
+	ok4 = false;
+      }
+    }
+    auto l0 = latch_list.front();
+    bool cyclic = latch_list.size() > 1 || reach[l0][l0];
+    if ( graph.is_cyclic(id) != cyclic ) {
+      ok4 = false;
+    }
+    nmember += latch_list.size();
+  }
+  check(ok4 && nmember == L, label + ": the SCC lists are inconsistent");
+}
+
+// 既知の強連結成分と比較する．
+void
+check_known()
+{
+  istringstream s{SCC_AAG};
+  auto aig = AigModel::read_aag(s);
+  auto graph = aig.compute_latch_graph();
+  check_graph(aig, graph, "known");
+  vector<vector<SizeType>> fanin_list{{1}, {0}, {0, 2}, {}, {3, 5}, {4}};
+  bool ok = true;
+  for ( SizeType i = 0; i < fanin_list.size(); ++ i ) {
+    if ( graph.fanin_list(i) != fanin_list[i] ) {
+      ok = false;
+    }
+  }
+  check(ok, "known: fanin mismatch");
+  check(graph.scc_num() == 4, "known: scc_num() is not 4");
+  vector<vector<SizeType>> scc_list{{0, 1}, {2}, {3}, {4, 5}};
+  vector<bool> cyclic_list{true, true, false, true};
+  for ( SizeType k = 0; k < scc_list.size(); ++ k ) {
+    auto id = graph.scc_id(scc_list[k][0]);
+    check(graph.scc_latch_list(id) == scc_list[k],
+	  "known: SCC of L" + std::to_string(scc_list[k][0]) + " mismatch");
+    check(graph.is_cyclic(id) == cyclic_list[k],
+	  "known: is_cyclic() of L" + std::to_string(scc_list[k][0]) + " mismatch");
+  }
+  check(graph.scc_id(0) < graph.scc_id(2), "known: {L0, L1} is not before {L2}");
+  check(graph.scc_id(3) < graph.scc_id(4), "known: {L3} is not before {L4, L5}");
+}
+
+END_NONAMESPACE
+
+// 使い方: latch_graph <aag-file>
+//
+// 強連結成分が分かっているモデルとランダムなモデルについて，
+// ラッチ間の依存グラフと強連結成分を素朴な到達可能性の計算と比較する．
+int
+latch_graph(
+  int argc,
+  char** argv
+)
+{
+  if ( argc != 2 ) {
+    cerr << "Usage: latch_graph <aag-file>" << endl;
+    return 2;
+  }
+
+  {
+    auto aig = AigModel::read_aag(argv[1]);
+    check_graph(aig, aig.compute_latch_graph(), argv[1]);
+  }
+  check_known();
+  for ( std::uint64_t seed = 1; seed <= 4; ++ seed ) {
+    auto label = "random#" + std::to_string(seed);
+    auto aig = random_aig(4, 40, 4, 100, seed);
+    AigLatchGraphOpt opt;
+    opt.thread_num = 1;
+    auto graph1 = aig.compute_latch_graph(opt);
+    check_graph(aig, graph1, label);
+    opt.thread_num = 4;
+    auto graph4 = aig.compute_latch_graph(opt);
+    bool same = graph1.scc_num() == graph4.scc_num();
+    for ( SizeType i = 0; same && i < aig.L(); ++ i ) {
+      if ( graph1.fanin_list(i) != graph4.fanin_list(i) ||
+	   graph1.scc_id(i) != graph4.scc_id(i) ) {
+	same = false;
+      }
+    }
+    check(same, label + ": the result depends on the number of threads");
+  }
+
+  return report("latch_graph");
+}
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::latch_graph(argc, argv);
+}
@@ -0,0 +1,325 @@
+
+/// @file luts.cc
+/// @brief AigModel::map_luts() のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigModel.h"
+#include "ym/AigLutNetwork.h"
+#include "test_util.h"
+#include <algorithm>
+#include <map>
+#include <set>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 全てのカットを用いた場合の最小の段数を求める．
+class RefDepth
+{
+public:
+
+  // コンストラクタ
+  RefDepth(
+    const AigModel& aig,
+    SizeType lut_size
+  ) : mAig{aig},
+      mLutSize{lut_size}
+  {
+    for ( SizeType i = 0; i < aig.A(); ++ i ) {
+      mAndMap.emplace(aig.and_node(i) / 2, i);
+    }
+  }
+
+  // 出力とラッチのソースの段数の最大値を返す．
+  SizeType
+  depth()
+  {
+    SizeType ans = 0;
+    for ( SizeType i = 0; i < mAig.O(); ++ i ) {
+      ans = std::max(ans, label(mAig.output_src(i) / 2));
+    }
+    for ( SizeType i = 0; i < mAig.L(); ++ i ) {
+      ans = std::max(ans, label(mAig.latch_src(i) / 2));
+    }
+    return ans;
+  }
+
+private:
+
+  using Cut = vector<SizeType>;
+
+  // 変数の段数を返す．
+  SizeType
+  label(
+    SizeType var
+  )
+  {
+    if ( mAndMap.count(var) == 0 ) {
+      return 0;
+    }
+    auto p = mLabel.find(var);
+    if ( p != mLabel.end() ) {
+      return p->second;
+    }
+    SizeType ans = static_cast<SizeType>(-1);
+    for ( auto& cut: cuts(var) ) {
+      if ( cut.size() == 1 && cut[0] == var ) {
+	continue;
+      }
+      SizeType l = 0;
+      for ( auto leaf: cut ) {
+	l = std::max(l, label(leaf));
+      }
+      ans = std::min(ans, l + 1);
+    }
+    mLabel.emplace(var, ans);
+    return ans;
+  }
+
+  // 全てのカットを返す．
+  const std::set<Cut>&
+  cuts(
+    SizeType var
+  )
+  {
+    auto p = mCuts.find(var);
+    if ( p != mCuts.end() ) {
+      return p->second;
+    }
+    std::set<Cut> cut_set;
+    if ( var > 0 ) {
+      cut_set.insert(Cut{var});
+    }
+    else {
+      cut_set.insert(Cut{});
+    }
+    auto q = mAndMap.find(var);
+    if ( q != mAndMap.end() ) {
+      auto pos = q->second;
+      auto& cuts1 = cuts(mAig.and_src1(pos) / 2);
+      auto& cuts2 = cuts(mAig.and_src2(pos) / 2);
+      for ( auto& c1: cuts1 ) {
+	for ( auto& c2: cuts2 ) {
+	  Cut c;
+	  std::set_union(c1.begin(), c1.end(), c2.begin(), c2.end(),
+			 std::back_inserter(c));
+	  if ( c.size() <= mLutSize ) {
+	    cut_set.insert(c);
+	  }
+	}
+      }
+    }
+    return mCuts.emplace(var, cut_set).first->second;
+  }
+
+  const AigModel& mAig;
+  SizeType mLutSize;
+  std::map<SizeType, SizeType> mAndMap;
+  std::map<SizeType, SizeType> mLabel;
+  std::map<SizeType, std::set<Cut>> mCuts;
+
+};
+
+// LUT ネットワークの出力とラッチのソースが元の AigModel と
+// 同じ値になることを調べる．
+bool
+same_function(
+  const AigModel& aig,
+  const AigLutNetwork& network
+)
+{
+  RefSim sim{aig};
+  std::mt19937_64 rng{1};
+  auto node_num = network.I() + network.L() + network.lut_num() + 1;
+  for ( SizeType k = 0; k < 4; ++ k ) {
+    auto input_vals = random_words(aig.I(), rng);
+    auto latch_vals = random_words(aig.L(), rng);
+    sim.eval(input_vals, latch_vals);
+    vector<std::uint64_t> val(node_num, 0);
+    for ( SizeType i = 0; i < aig.I(); ++ i ) {
+      val[i + 1] = input_vals[i];
+    }
+    for ( SizeType i = 0; i < aig.L(); ++ i ) {
+      val[aig.I() + i + 1] = latch_vals[i];
+    }
+    for ( SizeType pos = 0; pos < network.lut_num(); ++ pos ) {
+      auto tv = network.lut_truth_ptr(pos);
+      auto ni = network.lut_fanin_num(pos);
+      std::uint64_t ans = 0;
+      for ( SizeType b = 0; b < 64; ++ b ) {
+	SizeType m = 0;
+	for ( SizeType i = 0; i < ni; ++ i ) {
+	  auto id = network.lut_fanin(pos, i);
+	  if ( id >= network.lut_id(pos) ) {
+	    // トポロジカル順になっていない．
+	    return false;
+	  }
+	  m |= ((val[id] >> b) & 1) << i;
+	}
+	ans |= ((tv[m / 64] >> (m % 64)) & 1) << b;
+      }
+      val[network.lut_id(pos)] = ans;
+    }
+    auto lit_val = [&](SizeType lit) {
+      auto v = val[lit / 2];
+      return (lit % 2) ? ~v : v;
+    };
+    for ( SizeType i = 0; i < aig.O(); ++ i ) {
+      if ( lit_val(network.output_src(i)) != sim.output_val(i) ) {
+	return false;
+      }
+    }
+    for ( SizeType i = 0; i < aig.L(); ++ i ) {
+      if ( lit_val(network.latch_src(i)) != sim.latch_next(i) ) {
+	return false;
+      }
+    }
+  }
+  return true;
+}
+
+// LUT ネットワークの段数を数える．
+SizeType
+count_depth(
+  const AigLutNetwork& network
+)
+{
+  auto node_num = network.I() + network.L() + network.lut_num() + 1;
+  vector<SizeType> level(node_num, 0);
+  for ( SizeType pos = 0; pos < network.lut_num(); ++ pos ) {
+    SizeType l = 0;
+    for ( SizeType i = 0; i < network.lut_fanin_num(pos); ++ i ) {
+      l = std::max(l, level[network.lut_fanin(pos, i)]);
+    }
+    level[network.lut_id(pos)] = l + 1;
+  }
+  SizeType ans = 0;
+  for ( SizeType i = 0; i < network.O(); ++ i ) {
+    ans = std::max(ans, level[network.output_src(i) / 2]);
+  }
+  for ( SizeType i = 0; i < network.L(); ++ i ) {
+    ans = std::max(ans, level[network.latch_src(i) / 2]);
+  }
+  return ans;
+}
+
+// マッピング結果を調べる．
+void
+check_map(
+  const AigModel& aig,
+  SizeType lut_size,
+  const string& label
+)
+{
+  AigLutOpt opt;
+  opt.lut_size = lut_size;
+  opt.thread_num = 2;
+
+  // 面積回復を行わない段数最小のマッピング
+  opt.area_flow_iter = 0;
+  opt.exact_area_iter = 0;
+  auto opt_depth = aig.map_luts(opt).depth();
+
+  // 十分な数のカットを残せば厳密な最小段数となる．
+  if ( lut_size <= 4 ) {
+    opt.cut_limit = 10000;
+    RefDepth ref{aig, lut_size};
+    auto ref_depth = ref.depth();
+    check(aig.map_luts(opt).depth() == ref_depth,
+	  label + ": the depth is not optimal with all cuts");
+    opt.cut_limit = AigLutOpt{}.cut_limit;
+  }
+
+  opt.area_flow_iter = 1;
+  SizeType prev_num = 0;
+  for ( SizeType n = 0; n <= 3; ++ n ) {
+    opt.exact_area_iter = n;
+    auto network = aig.map_luts(opt);
+    auto suffix = " (exact_area_iter = " + std::to_string(n) + ")";
+    check(network.lut_size() == lut_size, label + suffix + ": lut_size mismatch");
+    check(network.depth() <= opt_depth,
+	  label + suffix + ": the area recovery increased the depth");
+    check(network.depth() == count_depth(network),
+	  label + suffix + ": depth() does not match the network");
+    bool ok = true;
+    for ( SizeType pos = 0; pos < network.lut_num(); ++ pos ) {
+      if ( network.lut_fanin_num(pos) > lut_size ) {
+	ok = false;
+      }
+    }
+    check(ok, label + suffix + ": a LUT has too many fanins");
+    check(same_function(aig, network), label + suffix + ": the function changed");
+    if ( n > 0 ) {
+      check(network.lut_num() <= prev_num,
+	    label + suffix + ": the exact area recovery increased the LUT count");
+    }
+    prev_num = network.lut_num();
+  }
+}
+
+END_NONAMESPACE
+
+// 使い方: luts <aag-file>
+//
+// 与えられたファイルとランダムなモデルについて，面積回復の後も
+// 段数が最小のままであること，LUT の真理値表がシミュレーション結果と
+// 一致すること，厳密な面積回復の繰り返しで LUT 数が増えないことを調べる．
+int
+luts(
+  int argc,
+  char** argv
+)
+{
+  if ( argc != 2 ) {
+    cerr << "Usage: luts <aag-file>" << endl;
+    return 2;
+  }
+
+  vector<std::pair<string, AigModel>> model_list;
+  model_list.push_back({argv[1], AigModel::read_aag(argv[1])});
+  model_list.push_back({"random#1", random_aig(8, 4, 8, 300, 1)});
+  model_list.push_back({"random#2", random_aig(24, 0, 16, 2000, 2)});
+  for ( auto& p: model_list ) {
+    for ( SizeType lut_size: {3, 4, 6} ) {
+      if ( lut_size <= 4 && p.second.A() > 500 ) {
+	// 全てのカットの列挙が大きくなりすぎる．
+	continue;
+      }
+      check_map(p.second, lut_size,
+		p.first + " (lut_size = " + std::to_string(lut_size) + ")");
+    }
+  }
+
+  // 範囲外の LUT サイズはエラーとなる．
+  for ( SizeType lut_size: {1, 9} ) {
+    AigLutOpt opt;
+    opt.lut_size = lut_size;
+    bool thrown = false;
+    try {
+      model_list[0].second.map_luts(opt);
+    }
+    catch ( std::invalid_argument& ) {
+      thrown = true;
+    }
+    check(thrown, "lut_size = " + std::to_string(lut_size) + " was accepted");
+  }
+
+  return report("luts");
+}
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::luts(argc, argv);
+}
@@ -0,0 +1,418 @@
+/// @file miter.cc
+/// @brief AigModel::make_miter() と AigModel::falsify() のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigModel.h"
+#include "test_util.h"
+#include <algorithm>
+#include <functional>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// シンボルを付け直したモデルを作る．
+//
+// 名前のリストが空の場合はシンボルを付けない．
+AigModel
+set_symbols(
+  const AigModel& aig,
+  const vector<string>& input_names,
+  const vector<string>& latch_names,
+  const vector<string>& output_names
+)
+{
+  ostringstream buf;
+  buf << "aag " << aig.M() << " " << aig.I() << " " << aig.L()
+      << " " << aig.O() << " " << aig.A() << endl;
+  for ( SizeType i = 0; i < aig.I(); ++ i ) {
+    buf << aig.input(i) << endl;
+  }
+  for ( SizeType i = 0; i < aig.L(); ++ i ) {
+    buf << aig.latch(i) << " " << aig.latch_src(i) << endl;
+  }
+  for ( SizeType i = 0; i < aig.O(); ++ i ) {
+    buf << aig.output_src(i) << endl;
+  }
+  for ( SizeType i = 0; i < aig.A(); ++ i ) {
+    buf << aig.and_node(i) << " " << aig.and_src1(i) << " " << aig.and_src2(i) << endl;
+  }
+  for ( SizeType i = 0; i < input_names.size(); ++ i ) {
+    buf << "i" << i << " " << input_names[i] << endl;
+  }
+  for ( SizeType i = 0; i < latch_names.size(); ++ i ) {
+    buf << "l" << i << " " << latch_names[i] << endl;
+  }
+  for ( SizeType i = 0; i < output_names.size(); ++ i ) {
+    buf << "o" << i << " " << output_names[i] << endl;
+  }
+  istringstream s{buf.str()};
+  return AigModel::read_aag(s);
+}
+
+// 接頭辞と番号からなる名前のリストを作る．
+//
+// perm が空でない時は i 番目の名前の番号を perm[i] とする．
+vector<string>
+make_names(
+  const string& prefix,
+  SizeType n,
+  const vector<SizeType>& perm = {}
+)
+{
+  vector<string> names(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto pos = perm.empty() ? i : perm[i];
+    names[i] = prefix + std::to_string(pos);
+  }
+  return names;
+}
+
+// ランダムな順列を作る．
+vector<SizeType>
+random_perm(
+  SizeType n,
+  std::mt19937_64& rng
+)
+{
+  vector<SizeType> perm(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    perm[i] = i;
+  }
+  std::shuffle(perm.begin(), perm.end(), rng);
+  return perm;
+}
+
+// マイタの出力とラッチを2つのモデルの値と比較する．
+//
+// input_perm[i] は model2 の入力 i に対応する model1 の入力番号，
+// output_perm[i] は model2 の出力 i に対応する model1 の出力番号を表す．
+void
+check_miter(
+  const AigModel& model1,
+  const AigModel& model2,
+  const vector<SizeType>& input_perm,
+  const vector<SizeType>& output_perm,
+  bool match_by_name,
+  const string& label
+)
+{
+  auto I = model1.I();
+  auto L1 = model1.L();
+  auto L2 = model2.L();
+  auto O = model1.O();
+  // model1 の出力番号から model2 の出力番号への対応表
+  vector<SizeType> output_map(O);
+  for ( SizeType i = 0; i < O; ++ i ) {
+    output_map[output_perm[i]] = i;
+  }
+  for ( bool single_output: {false, true} ) {
+    auto label1 = label + (single_output ? " (single)" : " (multi)");
+    AigMiterOpt opt;
+    opt.match_by_name = match_by_name;
+    opt.single_output = single_output;
+    auto miter = AigModel::make_miter(model1, model2, opt);
+    check(miter.I() == I, label1 + ": I() mismatch");
+    check(miter.L() == L1 + L2, label1 + ": L() mismatch");
+    check(miter.O() == (single_output ? 1 : O), label1 + ": O() mismatch");
+    if ( miter.I() != I || miter.L() != L1 + L2 ||
+	 miter.O() != (single_output ? 1 : O) ) {
+      return;
+    }
+
+    // 入力の順番とシンボルは model1 のもの
+    for ( SizeType i = 0; i < I; ++ i ) {
+      check(miter.input_symbol(i) == model1.input_symbol(i),
+	    label1 + ": input_symbol(" + std::to_string(i) + ") mismatch");
+    }
+    // ラッチは model1 のラッチの後に model2 のラッチが並ぶ．
+    for ( SizeType i = 0; i < L1; ++ i ) {
+      check(miter.latch_symbol(i) == model1.latch_symbol(i),
+	    label1 + ": latch_symbol(" + std::to_string(i) + ") mismatch");
+    }
+    for ( SizeType i = 0; i < L2; ++ i ) {
+      check(miter.latch_symbol(L1 + i) == model2.latch_symbol(i),
+	    label1 + ": latch_symbol(" + std::to_string(L1 + i) + ") mismatch");
+    }
+    if ( single_output ) {
+      check(miter.output_symbol(0) == "miter",
+	    label1 + ": output_symbol(0) mismatch");
+    }
+    else {
+      for ( SizeType i = 0; i < O; ++ i ) {
+	check(miter.output_symbol(i) == model1.output_symbol(i),
+	      label1 + ": output_symbol(" + std::to_string(i) + ") mismatch");
+      }
+    }
+
+    std::mt19937_64 rng{1};
+    RefSim sim{miter};
+    RefSim sim1{model1};
+    RefSim sim2{model2};
+    for ( SizeType k = 0; k < 16; ++ k ) {
+      auto input_vals = random_words(I, rng);
+      auto latch_vals1 = random_words(L1, rng);
+      auto latch_vals2 = random_words(L2, rng);
+      vector<std::uint64_t> input_vals2(I);
+      for ( SizeType i = 0; i < I; ++ i ) {
+	input_vals2[i] = input_vals[input_perm[i]];
+      }
+      auto latch_vals = latch_vals1;
+      latch_vals.insert(latch_vals.end(), latch_vals2.begin(), latch_vals2.end());
+      sim.eval(input_vals, latch_vals);
+      sim1.eval(input_vals, latch_vals1);
+      sim2.eval(input_vals2, latch_vals2);
+      std::uint64_t or_val = 0;
+      for ( SizeType i = 0; i < O; ++ i ) {
+	auto xor_val = sim1.output_val(i) ^ sim2.output_val(output_map[i]);
+	or_val |= xor_val;
+	if ( !single_output && sim.output_val(i) != xor_val ) {
+	  check(false, label1 + ": output(" + std::to_string(i) + ") mismatch");
+	  return;
+	}
+      }
+      if ( single_output && sim.output_val(0) != or_val ) {
+	check(false, label1 + ": output(0) mismatch");
+	return;
+      }
+      for ( SizeType i = 0; i < L1; ++ i ) {
+	if ( sim.latch_next(i) != sim1.latch_next(i) ) {
+	  check(false, label1 + ": latch_next(" + std::to_string(i) + ") mismatch");
+	  return;
+	}
+      }
+      for ( SizeType i = 0; i < L2; ++ i ) {
+	if ( sim.latch_next(L1 + i) != sim2.latch_next(i) ) {
+	  check(false, label1 + ": latch_next(" + std::to_string(L1 + i) + ") mismatch");
+	  return;
+	}
+      }
+    }
+  }
+}
+
+// 反例をシミュレーションで再現する．
+//
+// ラッチの初期値を 0 として，cex.cycle 時刻目に出力 cex.output が
+// 1 となる時 true を返す．
+bool
+replay_cex(
+  const AigModel& aig,
+  const AigCex& cex
+)
+{
+  if ( !cex.found || cex.output >= aig.O() ||
+       cex.input_list.size() != cex.cycle + 1 ) {
+    return false;
+  }
+  RefSim sim{aig};
+  vector<std::uint64_t> latch_vals(aig.L(), 0ULL);
+  for ( SizeType c = 0; c <= cex.cycle; ++ c ) {
+    auto& inputs = cex.input_list[c];
+    if ( inputs.size() != aig.I() ) {
+      return false;
+    }
+    vector<std::uint64_t> input_vals(aig.I());
+    for ( SizeType i = 0; i < aig.I(); ++ i ) {
+      input_vals[i] = inputs[i] ? 1ULL : 0ULL;
+    }
+    sim.eval(input_vals, latch_vals);
+    if ( c == cex.cycle ) {
+      return (sim.output_val(cex.output) & 1ULL) != 0;
+    }
+    for ( SizeType i = 0; i < aig.L(); ++ i ) {
+      latch_vals[i] = sim.latch_next(i) & 1ULL;
+    }
+  }
+  return false;
+}
+
+// 2つの反例が等しい時 true を返す．
+bool
+same_cex(
+  const AigCex& cex1,
+  const AigCex& cex2
+)
+{
+  return cex1.found == cex2.found &&
+    cex1.output == cex2.output &&
+    cex1.cycle == cex2.cycle &&
+    cex1.input_list == cex2.input_list;
+}
+
+// falsify() の結果を検査する．
+void
+check_falsify(
+  const AigModel& miter,
+  SizeType cycle_num,
+  bool expect_found,
+  const string& label
+)
+{
+  AigFalsifyOpt opt;
+  opt.word_num = 1;
+  opt.round_num = 32;
+  opt.cycle_num = cycle_num;
+  opt.seed = 7;
+  opt.thread_num = 1;
+  auto cex1 = miter.falsify(opt);
+  check(cex1.found == expect_found, label + ": found mismatch");
+  if ( cex1.found ) {
+    check(replay_cex(miter, cex1), label + ": counterexample does not replay");
+  }
+  // 結果はスレッド数によらない．
+  for ( SizeType thread_num: {2, 4, 8} ) {
+    opt.thread_num = thread_num;
+    auto cex2 = miter.falsify(opt);
+    check(same_cex(cex1, cex2),
+	  label + ": result differs with " + std::to_string(thread_num) + " threads");
+  }
+}
+
+// 例外が送出されることを確かめる．
+void
+expect_error(
+  const std::function<void()>& f,
+  const string& message,
+  const string& label
+)
+{
+  bool thrown = false;
+  try {
+    f();
+  }
+  catch ( const std::invalid_argument& error ) {
+    thrown = true;
+    check(string{error.what()} == message,
+	  label + ": unexpected message '" + error.what() + "'");
+  }
+  check(thrown, label + ": std::invalid_argument was not thrown");
+}
+
+END_NONAMESPACE
+
+// 使い方: miter <aag-file>
+//
+// マイタの出力とラッチの次状態を2つのモデルのシミュレーション結果と比較し，
+// falsify() で得られた反例がマイタ上で再現できることを確かめる．
+int
+miter(
+  int argc,
+  char** argv
+)
+{
+  if ( argc != 2 ) {
+    cerr << "Usage: miter <aag-file>" << endl;
+    return 2;
+  }
+
+  auto aig = AigModel::read_aag(argv[1]);
+  {
+    // 同じモデルどうしのマイタの出力は定数 0 となる．
+    auto miter = AigModel::make_miter(aig, aig);
+    check(miter.O() == 1 && miter.output_src(0) == 0,
+	  string{argv[1]} + ": self miter is not constant 0");
+  }
+
+  std::mt19937_64 rng{1};
+  for ( std::uint64_t seed = 1; seed <= 4; ++ seed ) {
+    auto label = "random#" + std::to_string(seed);
+    SizeType I = 12;
+    SizeType O = 10;
+    auto aig1 = random_aig(I, 4, O, 300, seed);
+    auto aig2 = random_aig(I, 6, O, 300, seed + 100);
+
+    // 番号による対応付け
+    vector<SizeType> id_perm(I);
+    vector<SizeType> id_operm(O);
+    for ( SizeType i = 0; i < I; ++ i ) {
+      id_perm[i] = i;
+    }
+    for ( SizeType i = 0; i < O; ++ i ) {
+      id_operm[i] = i;
+    }
+    check_miter(aig1, aig2, id_perm, id_operm, false, label + " (by position)");
+
+    // シンボル名による対応付け
+    auto input_perm = random_perm(I, rng);
+    auto output_perm = random_perm(O, rng);
+    auto model1 = set_symbols(aig1, make_names("x", I),
+			      make_names("p", aig1.L()),
+			      make_names("y", O));
+    auto model2 = set_symbols(aig2, make_names("x", I, input_perm),
+			      make_names("q", aig2.L()),
+			      make_names("y", O, output_perm));
+    check_miter(model1, model2, input_perm, output_perm, true, label + " (by name)");
+
+    // 異なるモデルのマイタには反例が見つかる．
+    auto miter1 = AigModel::make_miter(aig1, aig2);
+    check_falsify(miter1, 4, true, label + " (falsify)");
+
+    // 構造的ハッシュを行ったコピーとのマイタには反例が無い．
+    auto aig3 = aig1;
+    aig3.strash();
+    auto miter2 = AigModel::make_miter(aig1, aig3);
+    check_falsify(miter2, 4, false, label + " (falsify strash)");
+  }
+
+  // シンボル名で対応がとれない場合はエラーとなる．
+  SizeType I = 4;
+  SizeType O = 3;
+  auto base = random_aig(I, 0, O, 20, 1);
+  auto good = set_symbols(base, make_names("x", I), {}, make_names("y", O));
+  AigMiterOpt opt;
+  opt.match_by_name = true;
+  expect_error([&]() {
+    auto bad = set_symbols(base, {"x0", "x1", "x2", "z"}, {}, make_names("y", O));
+    AigModel::make_miter(good, bad, opt);
+  }, "make_miter: Input 'z' is not found.", "missing input");
+  expect_error([&]() {
+    auto bad = set_symbols(base, make_names("x", I), {}, {"y0", "y1", "z"});
+    AigModel::make_miter(bad, good, opt);
+  }, "make_miter: Output 'z' is not found.", "missing output");
+  expect_error([&]() {
+    auto bad = set_symbols(base, {"x0", "x1", "x0", "x3"}, {}, make_names("y", O));
+    AigModel::make_miter(bad, good, opt);
+  }, "make_miter: Input symbol 'x0' is duplicated.", "duplicated input of model1");
+  expect_error([&]() {
+    auto bad = set_symbols(base, {"x0", "x1", "x0", "x3"}, {}, make_names("y", O));
+    AigModel::make_miter(good, bad, opt);
+  }, "make_miter: src2 has duplicated input symbols.", "duplicated input of model2");
+  expect_error([&]() {
+    auto bad = set_symbols(base, make_names("x", I), {}, {"y0", "y1", "y1"});
+    AigModel::make_miter(good, bad, opt);
+  }, "make_miter: Output symbol 'y1' is duplicated.", "duplicated output of model2");
+  expect_error([&]() {
+    auto bad = set_symbols(base, make_names("x", I), {}, {"y0", "y1", "y1"});
+    AigModel::make_miter(bad, good, opt);
+  }, "make_miter: src1 has duplicated output symbols.", "duplicated output of model1");
+  expect_error([&]() {
+    AigModel::make_miter(base, good, opt);
+  }, "make_miter: Input#0 has no symbol.", "no symbol");
+  expect_error([&]() {
+    auto other = random_aig(I + 1, 0, O, 20, 1);
+    AigModel::make_miter(base, other);
+  }, "make_miter: the numbers of inputs differ (4 vs 5).", "input number");
+  expect_error([&]() {
+    auto other = random_aig(I, 0, O + 1, 20, 1);
+    AigModel::make_miter(base, other);
+  }, "make_miter: the numbers of outputs differ (3 vs 4).", "output number");
+
+  return report("miter");
+}
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::miter(argc, argv);
+}
@@ -0,0 +1,141 @@
+
+/// @file packed_ands.cc
+/// @brief ANDノードの圧縮表現のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigModel.h"
+#include "test_util.h"
+#include <thread>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// ランダムな位置のANDノードを元のモデルと比較する．
+bool
+random_access(
+  const AigModel& packed,
+  const AigModel& ref,
+  std::uint64_t seed
+)
+{
+  std::mt19937_64 rng{seed};
+  for ( SizeType k = 0; k < 20000; ++ k ) {
+    auto pos = rng() % ref.A();
+    if ( packed.and_node(pos) != ref.and_node(pos) ||
+	 packed.and_src1(pos) != ref.and_src1(pos) ||
+	 packed.and_src2(pos) != ref.and_src2(pos) ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// 圧縮表現にしたモデルが元と同じ内容を返すか調べる．
+void
+check_packed(
+  const AigModel& ref,
+  SizeType interval,
+  const string& label
+)
+{
+  auto aig = ref;
+  aig.pack_ands(interval);
+  check(aig.is_packed(), label + ": is_packed() is false");
+  check(!ref.is_packed(), label + ": the original was packed");
+  check(same_model(ref, aig), label + ": the packed model differs");
+
+  // 反復子による順次参照
+  SizeType pos = 0;
+  bool ok = true;
+  for ( auto p = aig.and_begin(); p != aig.and_end(); ++ p, ++ pos ) {
+    if ( p.pos() != pos || p.node() != ref.and_node(pos) ||
+	 p.src1() != ref.and_src1(pos) || p.src2() != ref.and_src2(pos) ) {
+      ok = false;
+    }
+  }
+  check(ok && pos == ref.A(), label + ": iterator mismatch");
+
+  // 複数のスレッドからのランダムな参照
+  if ( ref.A() > 0 ) {
+    check(random_access(aig, ref, 1), label + ": random access mismatch");
+    const SizeType nt = 4;
+    vector<char> result(nt, 0);
+    vector<std::thread> thread_list;
+    for ( SizeType t = 0; t < nt; ++ t ) {
+      thread_list.emplace_back([&, t]() {
+	result[t] = random_access(aig, ref, t + 2);
+      });
+    }
+    for ( auto& th: thread_list ) {
+      th.join();
+    }
+    for ( auto r: result ) {
+      check(r, label + ": random access mismatch (multi-thread)");
+    }
+  }
+
+  aig.unpack_ands();
+  check(!aig.is_packed(), label + ": is_packed() is true after unpack");
+  check(same_model(ref, aig), label + ": the unpacked model differs");
+}
+
+END_NONAMESPACE
+
+// 使い方: packed_ands <aag-file>
+//
+// 読み込んだモデルとランダムなモデルを圧縮表現にして，
+// 順次参照とランダムな参照の結果が元と同じになることを確かめる．
+int
+packed_ands(
+  int argc,
+  char** argv
+)
+{
+  if ( argc != 2 ) {
+    cerr << "Usage: packed_ands <aag-file>" << endl;
+    return 2;
+  }
+
+  auto aig = AigModel::read_aag(argv[1]);
+  auto aig2 = random_aig(32, 8, 16, 20000, 1);
+  for ( SizeType interval: {1, 7, 64} ) {
+    auto suffix = " (interval = " + std::to_string(interval) + ")";
+    check_packed(aig, interval, argv[1] + suffix);
+    check_packed(aig2, interval, "random" + suffix);
+  }
+
+  auto packed = aig2;
+  packed.pack_ands();
+  check(packed.and_memory_size() < aig2.and_memory_size(),
+	"the packed list is not smaller than the original");
+
+  // チェックポイントの間隔が 0 の場合はエラーとなる．
+  bool thrown = false;
+  try {
+    auto tmp = aig;
+    tmp.pack_ands(0);
+  }
+  catch ( std::invalid_argument& ) {
+    thrown = true;
+  }
+  check(thrown, "pack_ands(0) did not throw std::invalid_argument");
+
+  return report("packed_ands");
+}
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::packed_ands(argc, argv);
+}
@@ -0,0 +1,242 @@
+
+/// @file partition.cc
+/// @brief AigModel::partition_outputs() のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigModel.h"
+#include "test_util.h"
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 入力，ラッチ，出力に名前を付けたモデルを作る．
+AigModel
+add_symbols(
+  const AigModel& aig
+)
+{
+  ostringstream buf;
+  buf << "aag " << aig.M() << " " << aig.I() << " " << aig.L()
+      << " " << aig.O() << " " << aig.A() << endl;
+  for ( SizeType i = 0; i < aig.I(); ++ i ) {
+    buf << aig.input(i) << endl;
+  }
+  for ( SizeType i = 0; i < aig.L(); ++ i ) {
+    buf << aig.latch(i) << " " << aig.latch_src(i) << endl;
+  }
+  for ( SizeType i = 0; i < aig.O(); ++ i ) {
+    buf << aig.output_src(i) << endl;
+  }
+  for ( SizeType i = 0; i < aig.A(); ++ i ) {
+    buf << aig.and_node(i) << " " << aig.and_src1(i) << " " << aig.and_src2(i) << endl;
+  }
+  for ( SizeType i = 0; i < aig.I(); ++ i ) {
+    buf << "i" << i << " i" << i << endl;
+  }
+  for ( SizeType i = 0; i < aig.L(); ++ i ) {
+    buf << "l" << i << " l" << i << endl;
+  }
+  for ( SizeType i = 0; i < aig.O(); ++ i ) {
+    buf << "o" << i << " o" << i << endl;
+  }
+  istringstream s{buf.str()};
+  return AigModel::read_aag(s);
+}
+
+// 名前の末尾の番号を返す．
+SizeType
+symbol_pos(
+  const string& name
+)
+{
+  return std::stoul(name.substr(1));
+}
+
+// 部分回路の出力とラッチの次状態が元のモデルと一致することを調べる．
+bool
+same_function(
+  const AigModel& aig,
+  const AigModel& part,
+  std::mt19937_64& rng
+)
+{
+  auto input_vals = random_words(aig.I(), rng);
+  auto latch_vals = random_words(aig.L(), rng);
+  RefSim sim{aig};
+  sim.eval(input_vals, latch_vals);
+  vector<std::uint64_t> part_input_vals(part.I());
+  vector<std::uint64_t> part_latch_vals(part.L());
+  for ( SizeType i = 0; i < part.I(); ++ i ) {
+    part_input_vals[i] = input_vals[symbol_pos(part.input_symbol(i))];
+  }
+  for ( SizeType i = 0; i < part.L(); ++ i ) {
+    part_latch_vals[i] = latch_vals[symbol_pos(part.latch_symbol(i))];
+  }
+  RefSim part_sim{part};
+  part_sim.eval(part_input_vals, part_latch_vals);
+  for ( SizeType i = 0; i < part.O(); ++ i ) {
+    auto pos = symbol_pos(part.output_symbol(i));
+    if ( part_sim.output_val(i) != sim.output_val(pos) ) {
+      return false;
+    }
+  }
+  for ( SizeType i = 0; i < part.L(); ++ i ) {
+    auto pos = symbol_pos(part.latch_symbol(i));
+    if ( part_sim.latch_next(i) != sim.latch_next(pos) ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// 分割が全ての出力をちょうど一度ずつ覆うことと，
+// 分割ごとの部分回路が正しいことを調べる．
+void
+check_partition(
+  const AigModel& aig,
+  SizeType partition_num,
+  const string& tmp_prefix,
+  const string& label
+)
+{
+  AigPartitionOpt opt;
+  opt.partition_num = partition_num;
+  auto partition = aig.partition_outputs(opt);
+  auto label1 = label + " (partition_num = " + std::to_string(partition_num) + ")";
+  auto n = partition.partition_num();
+  check(n <= partition_num, label1 + ": too many partitions");
+  check(partition.output_num() == aig.O(), label1 + ": output_num() mismatch");
+
+  // 全ての出力がちょうど1つの分割に含まれる．
+  vector<SizeType> count(aig.O(), 0);
+  bool ok = true;
+  for ( SizeType id = 0; id < n; ++ id ) {
+    auto output_list = partition.output_list(id);
+    if ( output_list.size() != partition.output_num(id) ||
+	 !std::is_sorted(output_list.begin(), output_list.end()) ) {
+      ok = false;
+    }
+    for ( auto pos: output_list ) {
+      ++ count[pos];
+      if ( partition.partition_id(pos) != id ) {
+	ok = false;
+      }
+    }
+  }
+  for ( auto c: count ) {
+    if ( c != 1 ) {
+      ok = false;
+    }
+  }
+  check(ok, label1 + ": the partitions do not cover every output exactly once");
+
+  // 分割ごとのANDノード数は extract_cone() の結果と一致する．
+  SizeType total = 0;
+  bool ok_and = true;
+  bool ok_func = true;
+  std::mt19937_64 rng{partition_num};
+  auto model_list1 = aig.extract_partitions(partition, 1);
+  auto model_list4 = aig.extract_partitions(partition, 4);
+  check(model_list1.size() == n && model_list4.size() == n,
+	label1 + ": extract_partitions() returned a wrong number of models");
+  vector<string> filename_list;
+  for ( SizeType id = 0; id < n; ++ id ) {
+    filename_list.push_back(tmp_prefix + "_" + std::to_string(id) + ".snap");
+  }
+  aig.save_partitions(partition, filename_list, 2);
+  for ( SizeType id = 0; id < n && id < model_list1.size() && id < model_list4.size(); ++ id ) {
+    auto cone = aig.extract_cone(partition.output_list(id));
+    if ( partition.and_num(id) != cone.A() ) {
+      ok_and = false;
+    }
+    total += partition.and_num(id);
+    check(same_model(model_list1[id], cone) && same_model(model_list4[id], cone),
+	  label1 + ": extract_partitions() differs from extract_cone() for partition#"
+	  + std::to_string(id));
+    check(same_model(AigModel::open_snapshot(filename_list[id], true), cone),
+	  label1 + ": save_partitions() differs from extract_cone() for partition#"
+	  + std::to_string(id));
+    std::remove(filename_list[id].c_str());
+    if ( !same_function(aig, cone, rng) ) {
+      ok_func = false;
+    }
+  }
+  check(ok_and, label1 + ": and_num() differs from the extracted cone");
+  check(total == partition.total_and_num(), label1 + ": total_and_num() mismatch");
+  check(ok_func, label1 + ": a partition differs from the original model");
+}
+
+END_NONAMESPACE
+
+// 使い方: partition <aag-file> <一時ファイルの接頭辞>
+//
+// 出力の分割が全ての出力をちょうど一度ずつ覆い，分割ごとの
+// 部分回路(extract_partitions() と save_partitions() の結果)が
+// extract_cone() の結果と元のモデルの関数に一致することを調べる．
+int
+partition(
+  int argc,
+  char** argv
+)
+{
+  if ( argc != 3 ) {
+    cerr << "Usage: partition <aag-file> <tmp-prefix>" << endl;
+    return 2;
+  }
+  string tmp_prefix = argv[2];
+
+  auto aig = add_symbols(AigModel::read_aag(argv[1]));
+  for ( SizeType partition_num: {1, 2} ) {
+    check_partition(aig, partition_num, tmp_prefix, argv[1]);
+  }
+  for ( std::uint64_t seed = 1; seed <= 3; ++ seed ) {
+    auto label = "random#" + std::to_string(seed);
+    auto aig1 = add_symbols(random_aig(32, 16, 24, 1500, seed));
+    for ( SizeType partition_num: {1, 3, 8, 30} ) {
+      check_partition(aig1, partition_num, tmp_prefix, label);
+    }
+  }
+
+  // 引数が不正な場合はエラーとなる．
+  auto other = random_aig(4, 0, aig.O() + 1, 10, 1);
+  auto other_partition = other.partition_outputs();
+  auto expect_error = [&](const std::function<void()>& f, const string& label) {
+    bool thrown = false;
+    try {
+      f();
+    }
+    catch ( std::invalid_argument& ) {
+      thrown = true;
+    }
+    check(thrown, label + " was accepted");
+  };
+  expect_error([&]() { aig.extract_partitions(other_partition); },
+	       "a partition of another model");
+  expect_error([&]() { aig.save_partitions(aig.partition_outputs(), {}); },
+	       "a short filename_list");
+  AigPartitionOpt opt;
+  opt.balance = 0.5;
+  expect_error([&]() { aig.partition_outputs(opt); }, "balance = 0.5");
+
+  return report("partition");
+}
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::partition(argc, argv);
+}
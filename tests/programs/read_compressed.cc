@@ -0,0 +1,64 @@
+
+/// @file read_compressed.cc
+/// @brief 圧縮ファイルの読み込みのテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigModel.h"
+#include "test_util.h"
+
+
+BEGIN_NAMESPACE_YM
+
+// 使い方: read_compressed <plain.aig> <compressed.aig.*> ...
+//
+// 非圧縮のファイルを非同期に読み込んだ場合と，圧縮ファイルを
+// 同期/非同期の両方で読み込んだ場合に同じ内容になることを確かめる．
+int
+read_compressed(
+  int argc,
+  char** argv
+)
+{
+  if ( argc < 3 ) {
+    cerr << "Usage: read_compressed <plain.aig> <compressed.aig.*> ..." << endl;
+    return 2;
+  }
+  auto ref = AigModel::read_aig(argv[1]);
+  check(ref.A() > 0, "the reference file has no AND nodes");
+  // 非圧縮のファイルの非同期読み込み
+  AigReadOpt async_opt;
+  async_opt.async_io = true;
+  check(same_model(ref, AigModel::read_aig(argv[1], async_opt)),
+	string{argv[1]} + " (async) differs from the synchronous read");
+  for ( SizeType i = 2; i < argc; ++ i ) {
+    string filename = argv[i];
+    for ( auto async_io: {false, true} ) {
+      try {
+	AigReadOpt opt;
+	opt.async_io = async_io;
+	auto aig = AigModel::read_aig(filename, opt);
+	check(same_model(ref, aig),
+	      filename + (async_io ? " (async)" : "") + " differs from " + argv[1]);
+      }
+      catch ( std::invalid_argument& error ) {
+	check(false, filename + ": " + error.what());
+      }
+    }
+  }
+  return report("read_compressed");
+}
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::read_compressed(argc, argv);
+}
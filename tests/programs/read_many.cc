@@ -0,0 +1,203 @@
+/// @file read_many.cc
+/// @brief AigModel::read_many() のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigModel.h"
+#include "test_util.h"
+#include <cstdio>
+#include <fstream>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// AIG を aag 形式でファイルに書き出す．
+void
+write_aag(
+  const AigModel& aig,
+  const string& filename
+)
+{
+  std::ofstream s{filename};
+  s << "aag " << aig.M() << " " << aig.I() << " " << aig.L()
+    << " " << aig.O() << " " << aig.A() << endl;
+  for ( SizeType i = 0; i < aig.I(); ++ i ) {
+    s << aig.input(i) << endl;
+  }
+  for ( SizeType i = 0; i < aig.L(); ++ i ) {
+    s << aig.latch(i) << " " << aig.latch_src(i) << endl;
+  }
+  for ( SizeType i = 0; i < aig.O(); ++ i ) {
+    s << aig.output_src(i) << endl;
+  }
+  for ( SizeType i = 0; i < aig.A(); ++ i ) {
+    s << aig.and_node(i) << " " << aig.and_src1(i) << " " << aig.and_src2(i) << endl;
+  }
+}
+
+// 文字列をファイルに書き出す．
+void
+write_text(
+  const string& text,
+  const string& filename
+)
+{
+  std::ofstream s{filename};
+  s << text;
+}
+
+// 空の AigModel の時 true を返す．
+bool
+is_empty(
+  const AigModel& aig
+)
+{
+  return aig.I() == 0 && aig.L() == 0 && aig.O() == 0 && aig.A() == 0;
+}
+
+END_NONAMESPACE
+
+// 使い方: read_many <aag-file> <aig-file> <compressed.aig.*> <tmp-prefix>
+//
+// 形式の異なるファイルと読み込めないファイルを混ぜて read_many() で読み込み，
+// 1つずつ読み込んだ結果と比較する．
+// 結果はスレッド数や mem_limit によらないことも確かめる．
+// tmp-prefix で始まる一時ファイルを作る．
+int
+read_many(
+  int argc,
+  char** argv
+)
+{
+  if ( argc < 4 ) {
+    cerr << "Usage: read_many <aag-file> <aig-file> <compressed.aig.*> ... <tmp-prefix>" << endl;
+    return 2;
+  }
+
+  string aag_file = argv[1];
+  string aig_file = argv[2];
+  string tmp_prefix = argv[argc - 1];
+
+  auto ref_aag = AigModel::read_aag(aag_file);
+  auto ref_aig = AigModel::read_aig(aig_file);
+
+  // 期待値が null の要素は読み込みに失敗するファイル
+  vector<string> filename_list;
+  vector<const AigModel*> expected_list;
+  auto add_file = [&](const string& filename, const AigModel* expected) {
+    filename_list.push_back(filename);
+    expected_list.push_back(expected);
+  };
+
+  add_file(aag_file, &ref_aag);
+  add_file(aig_file, &ref_aig);
+  for ( int i = 3; i < argc - 1; ++ i ) {
+    add_file(argv[i], &ref_aig);
+  }
+  add_file(tmp_prefix + "_missing.aag", nullptr);
+
+  // 拡張子で判別できない場合はヘッダで判別する．
+  auto noext_file = tmp_prefix + "_noext";
+  write_aag(ref_aag, noext_file);
+  add_file(noext_file, &ref_aag);
+
+  // 壊れたファイル
+  auto corrupt_file = tmp_prefix + "_corrupt.aag";
+  write_text("aag 5 3 0 1 2\n2\n4\n", corrupt_file);
+  add_file(corrupt_file, nullptr);
+  auto unknown_file = tmp_prefix + "_unknown";
+  write_text("not an aig file\n", unknown_file);
+  add_file(unknown_file, nullptr);
+
+  // 大きさの異なるファイル
+  vector<string> tmp_list{noext_file, corrupt_file, unknown_file};
+  vector<AigModel> random_list;
+  for ( std::uint64_t seed = 1; seed <= 12; ++ seed ) {
+    random_list.push_back(random_aig(8 + seed, seed % 3, 4, 100 * seed, seed));
+  }
+  for ( SizeType k = 0; k < random_list.size(); ++ k ) {
+    auto filename = tmp_prefix + "_random" + std::to_string(k) + ".aag";
+    write_aag(random_list[k], filename);
+    tmp_list.push_back(filename);
+    add_file(filename, &random_list[k]);
+  }
+
+  auto n = filename_list.size();
+  for ( SizeType mem_limit: {0, 1, 4096} ) {
+    for ( SizeType thread_num: {1, 2, 4, 8} ) {
+      auto label = "thread_num = " + std::to_string(thread_num) +
+	", mem_limit = " + std::to_string(mem_limit);
+      AigReadOpt opt;
+      opt.thread_num = thread_num;
+      opt.mem_limit = mem_limit;
+      vector<string> error_list{"garbage"};
+      auto model_list = AigModel::read_many(filename_list, error_list, opt);
+      check(model_list.size() == n, label + ": size of the result mismatch");
+      check(error_list.size() == n, label + ": size of error_list mismatch");
+      if ( model_list.size() != n || error_list.size() != n ) {
+	continue;
+      }
+      for ( SizeType i = 0; i < n; ++ i ) {
+	auto label1 = label + ", " + filename_list[i];
+	if ( expected_list[i] != nullptr ) {
+	  check(error_list[i] == string{},
+		label1 + ": unexpected error '" + error_list[i] + "'");
+	  check(same_model(model_list[i], *expected_list[i]),
+		label1 + ": differs from the single read");
+	}
+	else {
+	  check(error_list[i] != string{}, label1 + ": no error message");
+	  check(is_empty(model_list[i]), label1 + ": model is not empty");
+	}
+      }
+    }
+  }
+
+  // 読み込み直後に cleanup() を行う．
+  {
+    AigReadOpt opt;
+    opt.thread_num = 4;
+    opt.cleanup = true;
+    opt.async_io = true;
+    vector<string> error_list;
+    auto model_list = AigModel::read_many(filename_list, error_list, opt);
+    for ( SizeType i = 0; i < n && i < model_list.size(); ++ i ) {
+      if ( expected_list[i] == nullptr ) {
+	continue;
+      }
+      auto expected = *expected_list[i];
+      expected.cleanup();
+      check(same_model(model_list[i], expected),
+	    filename_list[i] + " (cleanup, async): differs from the single read");
+    }
+  }
+
+  // 空のリスト
+  {
+    vector<string> error_list{"garbage"};
+    auto model_list = AigModel::read_many({}, error_list);
+    check(model_list.empty() && error_list.empty(), "empty list: result is not empty");
+  }
+
+  for ( auto& filename: tmp_list ) {
+    std::remove(filename.c_str());
+  }
+
+  return report("read_many");
+}
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::read_many(argc, argv);
+}
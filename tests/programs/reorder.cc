@@ -0,0 +1,262 @@
+/// @file reorder.cc
+/// @brief AigModel::reorder() のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigModel.h"
+#include "test_util.h"
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// シンボルを付けたモデルを作る．
+AigModel
+add_symbols(
+  const AigModel& aig
+)
+{
+  ostringstream buf;
+  buf << "aag " << aig.M() << " " << aig.I() << " " << aig.L()
+      << " " << aig.O() << " " << aig.A() << endl;
+  for ( SizeType i = 0; i < aig.I(); ++ i ) {
+    buf << aig.input(i) << endl;
+  }
+  for ( SizeType i = 0; i < aig.L(); ++ i ) {
+    buf << aig.latch(i) << " " << aig.latch_src(i) << endl;
+  }
+  for ( SizeType i = 0; i < aig.O(); ++ i ) {
+    buf << aig.output_src(i) << endl;
+  }
+  for ( SizeType i = 0; i < aig.A(); ++ i ) {
+    buf << aig.and_node(i) << " " << aig.and_src1(i) << " " << aig.and_src2(i) << endl;
+  }
+  for ( SizeType i = 0; i < aig.I(); ++ i ) {
+    buf << "i" << i << " in" << i << endl;
+  }
+  for ( SizeType i = 0; i < aig.L(); ++ i ) {
+    buf << "l" << i << " reg" << i << endl;
+  }
+  for ( SizeType i = 0; i < aig.O(); ++ i ) {
+    buf << "o" << i << " out" << i << endl;
+  }
+  istringstream s{buf.str()};
+  return AigModel::read_aag(s);
+}
+
+// 標準形でトポロジカル順になっていることを確かめる．
+void
+check_canonical(
+  const AigModel& aig,
+  const string& label
+)
+{
+  auto I = aig.I();
+  auto L = aig.L();
+  check(aig.M() == I + L + aig.A(), label + ": M() mismatch");
+  for ( SizeType i = 0; i < I; ++ i ) {
+    if ( aig.input(i) != (i + 1) * 2 ) {
+      check(false, label + ": input(" + std::to_string(i) + ") is not canonical");
+      return;
+    }
+  }
+  for ( SizeType i = 0; i < L; ++ i ) {
+    if ( aig.latch(i) != (I + i + 1) * 2 ) {
+      check(false, label + ": latch(" + std::to_string(i) + ") is not canonical");
+      return;
+    }
+  }
+  for ( SizeType i = 0; i < aig.A(); ++ i ) {
+    auto lit = aig.and_node(i);
+    if ( lit != (I + L + i + 1) * 2 ) {
+      check(false, label + ": and_node(" + std::to_string(i) + ") is not canonical");
+      return;
+    }
+    if ( aig.and_src1(i) < aig.and_src2(i) || aig.and_src1(i) >= lit ) {
+      check(false, label + ": AND#" + std::to_string(i) + " is not in topological order");
+      return;
+    }
+  }
+}
+
+// ANDノードのレベル(入力とラッチは 0)のリストを返す．
+//
+// 標準形でトポロジカル順になっていることを仮定する．
+vector<SizeType>
+and_levels(
+  const AigModel& aig
+)
+{
+  auto base = aig.I() + aig.L() + 1;
+  vector<SizeType> level_list(aig.A(), 0);
+  auto level = [&](SizeType lit) -> SizeType {
+    auto var = lit / 2;
+    return var < base ? 0 : level_list[var - base];
+  };
+  for ( SizeType i = 0; i < aig.A(); ++ i ) {
+    level_list[i] = std::max(level(aig.and_src1(i)), level(aig.and_src2(i))) + 1;
+  }
+  return level_list;
+}
+
+// 出力とラッチから到達できるANDノードの印を返す．
+//
+// 標準形でトポロジカル順になっていることを仮定する．
+vector<bool>
+reachable_ands(
+  const AigModel& aig
+)
+{
+  auto base = aig.I() + aig.L() + 1;
+  vector<bool> mark(aig.A(), false);
+  auto set_mark = [&](SizeType lit) {
+    auto var = lit / 2;
+    if ( var >= base ) {
+      mark[var - base] = true;
+    }
+  };
+  for ( SizeType i = 0; i < aig.O(); ++ i ) {
+    set_mark(aig.output_src(i));
+  }
+  for ( SizeType i = 0; i < aig.L(); ++ i ) {
+    set_mark(aig.latch_src(i));
+  }
+  for ( SizeType i = aig.A(); i -- > 0; ) {
+    if ( mark[i] ) {
+      set_mark(aig.and_src1(i));
+      set_mark(aig.and_src2(i));
+    }
+  }
+  return mark;
+}
+
+// 出力とラッチの次状態が等しいことを確かめる．
+void
+check_function(
+  const AigModel& aig,
+  const AigModel& ref,
+  const string& label
+)
+{
+  std::mt19937_64 rng{1};
+  RefSim sim{aig};
+  RefSim ref_sim{ref};
+  for ( SizeType k = 0; k < 16; ++ k ) {
+    auto input_vals = random_words(ref.I(), rng);
+    auto latch_vals = random_words(ref.L(), rng);
+    sim.eval(input_vals, latch_vals);
+    ref_sim.eval(input_vals, latch_vals);
+    for ( SizeType i = 0; i < ref.O(); ++ i ) {
+      if ( sim.output_val(i) != ref_sim.output_val(i) ) {
+	check(false, label + ": output(" + std::to_string(i) + ") mismatch");
+	return;
+      }
+    }
+    for ( SizeType i = 0; i < ref.L(); ++ i ) {
+      if ( sim.latch_next(i) != ref_sim.latch_next(i) ) {
+	check(false, label + ": latch_next(" + std::to_string(i) + ") mismatch");
+	return;
+      }
+    }
+  }
+}
+
+// reorder() の結果を検査する．
+void
+check_reorder(
+  const AigModel& src,
+  const string& label
+)
+{
+  for ( bool level_major: {false, true} ) {
+    auto label1 = label + (level_major ? " (level major)" : " (depth first)");
+    auto aig = src;
+    aig.reorder(level_major);
+    check(aig.I() == src.I() && aig.L() == src.L() &&
+	  aig.O() == src.O() && aig.A() == src.A(),
+	  label1 + ": size mismatch");
+    if ( aig.A() != src.A() ) {
+      continue;
+    }
+    check_canonical(aig, label1);
+    check_function(aig, src, label1);
+
+    // シンボルは変わらない．
+    for ( SizeType i = 0; i < src.I(); ++ i ) {
+      check(aig.input_symbol(i) == src.input_symbol(i),
+	    label1 + ": input_symbol(" + std::to_string(i) + ") mismatch");
+    }
+    for ( SizeType i = 0; i < src.L(); ++ i ) {
+      check(aig.latch_symbol(i) == src.latch_symbol(i),
+	    label1 + ": latch_symbol(" + std::to_string(i) + ") mismatch");
+    }
+    for ( SizeType i = 0; i < src.O(); ++ i ) {
+      check(aig.output_symbol(i) == src.output_symbol(i),
+	    label1 + ": output_symbol(" + std::to_string(i) + ") mismatch");
+    }
+
+    if ( level_major ) {
+      // レベルの小さい順に並ぶ．
+      auto level_list = and_levels(aig);
+      check(std::is_sorted(level_list.begin(), level_list.end()),
+	    label1 + ": not sorted by level");
+    }
+    else {
+      // 到達できないANDノードは末尾に置かれる．
+      auto mark = reachable_ands(aig);
+      auto p = std::find(mark.begin(), mark.end(), false);
+      check(std::find(p, mark.end(), true) == mark.end(),
+	    label1 + ": unreachable AND nodes are not at the end");
+    }
+
+    // 2回目の reorder() は何も変えない．
+    auto aig2 = aig;
+    aig2.reorder(level_major);
+    check(same_model(aig2, aig), label1 + ": second reorder() changed the model");
+  }
+}
+
+END_NONAMESPACE
+
+// 使い方: reorder <aag-file>
+//
+// ランダムな AIG を reorder() で並べ替えて，標準形でトポロジカル順に
+// なっていること，論理とシンボルが変わらないこと，2回目の reorder() が
+// 何も変えないことを確かめる．
+int
+reorder(
+  int argc,
+  char** argv
+)
+{
+  if ( argc != 2 ) {
+    cerr << "Usage: reorder <aag-file>" << endl;
+    return 2;
+  }
+
+  check_reorder(AigModel::read_aag(argv[1]), argv[1]);
+  for ( std::uint64_t seed = 1; seed <= 6; ++ seed ) {
+    auto label = "random#" + std::to_string(seed);
+    auto aig = random_aig(16, seed % 4 * 3, 8, 500, seed);
+    check_reorder(aig, label);
+    check_reorder(add_symbols(aig), label + " (with symbols)");
+  }
+
+  return report("reorder");
+}
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::reorder(argc, argv);
+}
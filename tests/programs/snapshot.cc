@@ -0,0 +1,160 @@
+
+/// @file snapshot.cc
+/// @brief スナップショットのテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigModel.h"
+#include "test_util.h"
+#include <cstdint>
+#include <fstream>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// ヘッダ中の mSymbolSize の位置
+const SizeType SYMBOL_SIZE_POS = 88;
+
+// ヘッダ中の mFlags の位置
+const SizeType FLAGS_POS = 112;
+
+// ファイルの内容を読み込む．
+string
+read_file(
+  const string& filename
+)
+{
+  std::ifstream s{filename, std::ios::binary};
+  ostringstream buf;
+  buf << s.rdbuf();
+  return buf.str();
+}
+
+// ファイルに書き込む．
+void
+write_file(
+  const string& filename,
+  const string& contents
+)
+{
+  std::ofstream s{filename, std::ios::binary};
+  s.write(contents.data(), contents.size());
+}
+
+// 書き出して読み戻した結果が元と等しいか調べる．
+void
+check_round_trip(
+  const AigModel& aig,
+  const string& snap_file,
+  const string& label
+)
+{
+  aig.save_snapshot(snap_file);
+  for ( auto verify: {false, true} ) {
+    auto aig2 = AigModel::open_snapshot(snap_file, verify);
+    check(same_model(aig, aig2), label + ": the snapshot differs from the original");
+    check(aig.comment() == aig2.comment(), label + ": comment mismatch");
+  }
+}
+
+// 壊れたファイルを開くと例外が送出されることを確かめる．
+void
+check_broken(
+  const string& contents,
+  const string& snap_file,
+  bool verify,
+  const string& label
+)
+{
+  write_file(snap_file, contents);
+  bool thrown = false;
+  try {
+    AigModel::open_snapshot(snap_file, verify);
+  }
+  catch ( std::invalid_argument& ) {
+    thrown = true;
+  }
+  check(thrown, label + ": no exception was thrown");
+}
+
+END_NONAMESPACE
+
+// 使い方: snapshot <aag-file> <snapshot-file>
+//
+// 読み込んだモデルとランダムなモデルについて，スナップショットに
+// 書き出して開いた結果が元と同じになることを確かめる．
+// また，壊れたスナップショットが例外になることを確かめる．
+// <snapshot-file> は作業用のファイル名で，上書きされる．
+int
+snapshot(
+  int argc,
+  char** argv
+)
+{
+  if ( argc != 3 ) {
+    cerr << "Usage: snapshot <aag-file> <snapshot-file>" << endl;
+    return 2;
+  }
+  string snap_file = argv[2];
+
+  auto aig = AigModel::read_aag(argv[1]);
+  check_round_trip(aig, snap_file, argv[1]);
+  {
+    auto aig2 = random_aig(20, 8, 10, 2000, 1);
+    check_round_trip(aig2, snap_file, "random");
+    // ANDノードのリストが圧縮表現の場合
+    aig2.pack_ands();
+    check_round_trip(aig2, snap_file, "random (packed)");
+  }
+
+  aig.save_snapshot(snap_file);
+  auto orig = read_file(snap_file);
+  {
+    auto contents = orig;
+    contents[0] ^= 1;
+    check_broken(contents, snap_file, false, "wrong signature");
+  }
+  {
+    auto contents = orig.substr(0, orig.size() - 1);
+    check_broken(contents, snap_file, false, "truncated");
+  }
+  {
+    // シンボルセクションがオフセットの表よりも短い．
+    auto contents = orig;
+    std::uint64_t symbol_size = 8;
+    contents.replace(SYMBOL_SIZE_POS, sizeof(symbol_size),
+		     reinterpret_cast<const char*>(&symbol_size),
+		     sizeof(symbol_size));
+    check_broken(contents, snap_file, false, "short symbol section");
+  }
+  {
+    // ヘッダ以降の内容の破損はチェックサムで検出する．
+    auto contents = orig;
+    contents[contents.size() / 2] ^= 1;
+    check_broken(contents, snap_file, true, "checksum");
+  }
+  {
+    // 標準形の記録の誤りは verify が true の時に検出する．
+    auto contents = orig;
+    contents[FLAGS_POS] ^= 1;
+    check_broken(contents, snap_file, true, "canonical flag");
+  }
+
+  return report("snapshot");
+}
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::snapshot(argc, argv);
+}
@@ -0,0 +1,193 @@
+
+/// @file strash.cc
+/// @brief AigModel::strash() のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigModel.h"
+#include "test_util.h"
+#include <set>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 重複したANDノードを含むモデル
+//
+// 10 と 12 は 8 と同じで，10 はファンインの順番が逆になっている．
+// 16 は 10 を 8 に併合すると 14 と同じになり，20 も同様に 18 と同じになる．
+const char* DUP_AAG =
+  "aag 10 3 0 3 7\n"
+  "2\n"
+  "4\n"
+  "6\n"
+  "18\n"
+  "20\n"
+  "12\n"
+  "8 4 2\n"
+  "10 2 4\n"
+  "12 4 2\n"
+  "14 8 6\n"
+  "16 6 10\n"
+  "18 14 3\n"
+  "20 3 16\n";
+
+// 全てのANDノードを複製したモデルを作る．
+//
+// 複製はファンインの順番を逆にし，後続のノードや出力は
+// 元と複製のどちらかをランダムに参照する．
+AigModel
+duplicate(
+  const AigModel& src,
+  std::uint64_t seed
+)
+{
+  std::mt19937_64 rng{seed};
+  auto base = src.I() + src.L() + 1;
+  // 元の変数番号から複製の変数番号への写像
+  auto map_lit = [&](SizeType lit) {
+    auto var = lit / 2;
+    if ( var < base || rng() % 2 == 0 ) {
+      return lit;
+    }
+    return (var + src.A()) * 2 + lit % 2;
+  };
+  ostringstream buf;
+  buf << "aag " << src.M() + src.A() << " " << src.I() << " " << src.L()
+      << " " << src.O() << " " << src.A() * 2 << endl;
+  for ( SizeType i = 0; i < src.I(); ++ i ) {
+    buf << src.input(i) << endl;
+  }
+  for ( SizeType i = 0; i < src.L(); ++ i ) {
+    buf << src.latch(i) << " " << map_lit(src.latch_src(i)) << endl;
+  }
+  for ( SizeType i = 0; i < src.O(); ++ i ) {
+    buf << map_lit(src.output_src(i)) << endl;
+  }
+  for ( SizeType i = 0; i < src.A(); ++ i ) {
+    buf << src.and_node(i) << " " << map_lit(src.and_src1(i))
+	<< " " << map_lit(src.and_src2(i)) << endl;
+  }
+  for ( SizeType i = 0; i < src.A(); ++ i ) {
+    buf << src.and_node(i) + src.A() * 2 << " " << map_lit(src.and_src2(i))
+	<< " " << map_lit(src.and_src1(i)) << endl;
+  }
+  istringstream s{buf.str()};
+  return AigModel::read_aag(s);
+}
+
+// 出力とラッチの次状態の値を比較する．
+bool
+same_outputs(
+  const AigModel& aig1,
+  const AigModel& aig2
+)
+{
+  RefSim sim1{aig1};
+  RefSim sim2{aig2};
+  std::mt19937_64 rng{1};
+  for ( SizeType k = 0; k < 4; ++ k ) {
+    auto input_vals = random_words(aig1.I(), rng);
+    auto latch_vals = random_words(aig1.L(), rng);
+    sim1.eval(input_vals, latch_vals);
+    sim2.eval(input_vals, latch_vals);
+    for ( SizeType i = 0; i < aig1.O(); ++ i ) {
+      if ( sim1.output_val(i) != sim2.output_val(i) ) {
+	return false;
+      }
+    }
+    for ( SizeType i = 0; i < aig1.L(); ++ i ) {
+      if ( sim1.latch_next(i) != sim2.latch_next(i) ) {
+	return false;
+      }
+    }
+  }
+  return true;
+}
+
+// 同じファンインの組を持つANDノードが無いことを調べる．
+bool
+no_duplicates(
+  const AigModel& aig
+)
+{
+  std::set<std::pair<SizeType, SizeType>> fanin_set;
+  for ( SizeType i = 0; i < aig.A(); ++ i ) {
+    auto src1 = aig.and_src1(i);
+    auto src2 = aig.and_src2(i);
+    if ( src1 < src2 ) {
+      std::swap(src1, src2);
+    }
+    if ( !fanin_set.insert({src1, src2}).second ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+END_NONAMESPACE
+
+// 使い方: strash <aag-file>
+//
+// 重複したANDノードを含むモデルと，ランダムなモデルや与えられた
+// ファイルの全てのANDノードを複製したモデルについて，strash() の
+// 結果のノード数と出力の値を調べる．
+int
+strash(
+  int argc,
+  char** argv
+)
+{
+  if ( argc != 2 ) {
+    cerr << "Usage: strash <aag-file>" << endl;
+    return 2;
+  }
+
+  {
+    istringstream s{DUP_AAG};
+    auto src = AigModel::read_aag(s);
+    auto aig = src;
+    auto n = aig.strash();
+    check(n == 4, "dup: strash() returned " + std::to_string(n));
+    check(aig.A() == 3, "dup: wrong number of AND nodes");
+    check(aig.output_src(0) == aig.output_src(1), "dup: outputs 0 and 1 were not merged");
+    check(same_outputs(src, aig), "dup: outputs changed");
+    check(aig.strash() == 0, "dup: the second strash() merged nodes");
+  }
+
+  vector<std::pair<string, AigModel>> model_list;
+  model_list.push_back({argv[1], AigModel::read_aag(argv[1])});
+  for ( std::uint64_t seed = 1; seed <= 5; ++ seed ) {
+    model_list.push_back({"random#" + std::to_string(seed),
+			  random_aig(8, 4, 8, 500, seed)});
+  }
+  for ( auto& p: model_list ) {
+    auto& label = p.first;
+    auto ref = p.second;
+    ref.strash();
+    auto src = duplicate(p.second, 1);
+    auto aig = src;
+    auto n = aig.strash();
+    check(aig.A() == ref.A(), label + ": the duplicated model has a different size");
+    check(n == src.A() - aig.A(), label + ": wrong return value");
+    check(no_duplicates(aig), label + ": duplicated AND nodes remain");
+    check(same_outputs(src, aig), label + ": outputs changed");
+  }
+
+  return report("strash");
+}
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::strash(argc, argv);
+}
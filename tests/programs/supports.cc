@@ -0,0 +1,202 @@
+
+/// @file supports.cc
+/// @brief AigModel::compute_supports() のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigModel.h"
+#include "test_util.h"
+#include <map>
+#include <set>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 組み合わせ回路のループを持つモデル
+const char* LOOP_AAG =
+  "aag 3 1 0 1 2\n"
+  "2\n"
+  "4\n"
+  "4 6 2\n"
+  "6 4 2\n";
+
+// リテラルの構造的なサポートを素朴に求める．
+vector<SizeType>
+ref_support(
+  const AigModel& aig,
+  const std::unordered_map<SizeType, SizeType>& and_map,
+  const std::unordered_map<SizeType, SizeType>& leaf_map,
+  SizeType lit
+)
+{
+  std::set<SizeType> mark;
+  std::set<SizeType> support;
+  vector<SizeType> stack{lit / 2};
+  while ( !stack.empty() ) {
+    auto var = stack.back();
+    stack.pop_back();
+    if ( !mark.insert(var).second ) {
+      continue;
+    }
+    auto p = and_map.find(var);
+    if ( p != and_map.end() ) {
+      stack.push_back(aig.and_src1(p->second) / 2);
+      stack.push_back(aig.and_src2(p->second) / 2);
+    }
+    auto q = leaf_map.find(var);
+    if ( q != leaf_map.end() ) {
+      support.insert(q->second);
+    }
+  }
+  return vector<SizeType>(support.begin(), support.end());
+}
+
+// サポートを素朴な探索の結果と比較する．
+void
+check_supports(
+  const AigModel& aig,
+  const string& label
+)
+{
+  std::unordered_map<SizeType, SizeType> and_map;
+  std::unordered_map<SizeType, SizeType> leaf_map;
+  for ( SizeType i = 0; i < aig.A(); ++ i ) {
+    and_map.emplace(aig.and_node(i) / 2, i);
+  }
+  for ( SizeType i = 0; i < aig.I(); ++ i ) {
+    leaf_map.emplace(aig.input(i) / 2, i);
+  }
+  for ( SizeType i = 0; i < aig.L(); ++ i ) {
+    leaf_map.emplace(aig.latch(i) / 2, aig.I() + i);
+  }
+
+  AigSupportOpt opt;
+  opt.thread_num = 1;
+  auto supports = aig.compute_supports(opt);
+  check(supports.input_num() == aig.I(), label + ": input_num() mismatch");
+  check(supports.latch_num() == aig.L(), label + ": latch_num() mismatch");
+  check(supports.output_num() == aig.O(), label + ": output_num() mismatch");
+
+  // サポートの内容とサポート番号の対応
+  std::map<vector<SizeType>, SizeType> id_map;
+  bool ok = true;
+  bool ok_id = true;
+  auto check_one = [&](SizeType lit, SizeType id) {
+    auto expected = ref_support(aig, and_map, leaf_map, lit);
+    if ( id >= supports.support_num() || supports.support_list(id) != expected ) {
+      ok = false;
+      return;
+    }
+    auto p = id_map.emplace(expected, id).first;
+    if ( p->second != id ) {
+      // 同じ内容のサポートが別の番号を持っている．
+      ok_id = false;
+    }
+  };
+  for ( SizeType i = 0; i < aig.O(); ++ i ) {
+    check_one(aig.output_src(i), supports.output_support(i));
+  }
+  for ( SizeType i = 0; i < aig.L(); ++ i ) {
+    check_one(aig.latch_src(i), supports.latch_support(i));
+  }
+  check(ok, label + ": the supports differ from the structural traversal");
+  check(ok_id, label + ": equal supports have different ids");
+
+  // 異なる番号のサポートは内容も異なる．
+  std::set<vector<SizeType>> list_set;
+  for ( SizeType id = 0; id < supports.support_num(); ++ id ) {
+    list_set.insert(supports.support_list(id));
+  }
+  check(list_set.size() == supports.support_num(),
+	label + ": different ids have equal supports");
+
+  // CSR 形式の配列と個別のアクセス関数が一致する．
+  auto& begin_array = supports.begin_array();
+  auto& elem_array = supports.elem_array();
+  bool ok_csr = begin_array.size() == supports.support_num() + 1 &&
+    begin_array.back() == elem_array.size();
+  for ( SizeType id = 0; ok_csr && id < supports.support_num(); ++ id ) {
+    if ( supports.support_size(id) != begin_array[id + 1] - begin_array[id] ) {
+      ok_csr = false;
+    }
+    for ( SizeType pos = 0; pos < supports.support_size(id); ++ pos ) {
+      if ( supports.support_elem(id, pos) != elem_array[begin_array[id] + pos] ) {
+	ok_csr = false;
+      }
+    }
+  }
+  check(ok_csr, label + ": the arrays are inconsistent with the accessors");
+
+  // スレッド数によらない．
+  opt.thread_num = 4;
+  auto supports4 = aig.compute_supports(opt);
+  bool same = supports4.begin_array() == begin_array &&
+    supports4.elem_array() == elem_array;
+  for ( SizeType i = 0; same && i < aig.O(); ++ i ) {
+    if ( supports4.output_support(i) != supports.output_support(i) ) {
+      same = false;
+    }
+  }
+  for ( SizeType i = 0; same && i < aig.L(); ++ i ) {
+    if ( supports4.latch_support(i) != supports.latch_support(i) ) {
+      same = false;
+    }
+  }
+  check(same, label + ": the result depends on the number of threads");
+}
+
+END_NONAMESPACE
+
+// 使い方: supports <aag-file>
+//
+// 出力とラッチのソースの構造的なサポートを素朴な探索の結果と比較し，
+// 同じ内容のサポートが1つにまとめられていることを調べる．
+int
+supports(
+  int argc,
+  char** argv
+)
+{
+  if ( argc != 2 ) {
+    cerr << "Usage: supports <aag-file>" << endl;
+    return 2;
+  }
+
+  check_supports(AigModel::read_aag(argv[1]), argv[1]);
+  for ( std::uint64_t seed = 1; seed <= 3; ++ seed ) {
+    auto label = "random#" + std::to_string(seed);
+    check_supports(random_aig(8, 8, 32, 200, seed), label);
+    // 要素数の多いサポートも作る．
+    check_supports(random_aig(300, 30, 40, 5000, seed), label + " (large)");
+  }
+
+  // 組み合わせ回路のループはエラーとなる．
+  bool thrown = false;
+  try {
+    istringstream s{LOOP_AAG};
+    auto aig = AigModel::read_aag(s);
+    aig.compute_supports();
+  }
+  catch ( std::invalid_argument& ) {
+    thrown = true;
+  }
+  check(thrown, "a combinational loop was accepted");
+
+  return report("supports");
+}
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::supports(argc, argv);
+}
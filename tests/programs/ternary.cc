@@ -0,0 +1,259 @@
+
+/// @file ternary.cc
+/// @brief AigModel::ternary_simulate() のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigModel.h"
+#include "test_util.h"
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 3値の値(X は 2 で表す)
+const int VAL_X = 2;
+
+// 検査用の素朴なスカラーの3値シミュレータ
+class RefTernarySim
+{
+public:
+
+  // コンストラクタ
+  explicit
+  RefTernarySim(
+    const AigModel& aig
+  ) : mAig{aig}
+  {
+    for ( SizeType i = 0; i < aig.A(); ++ i ) {
+      mAndMap.emplace(aig.and_node(i) / 2, i);
+    }
+  }
+
+  // 入力とラッチの値を設定する．
+  void
+  eval(
+    const vector<int>& input_vals,
+    const vector<int>& latch_vals
+  )
+  {
+    mVal.clear();
+    mVal.emplace(0, 0);
+    for ( SizeType i = 0; i < mAig.I(); ++ i ) {
+      mVal[mAig.input(i) / 2] = input_vals[i];
+    }
+    for ( SizeType i = 0; i < mAig.L(); ++ i ) {
+      mVal[mAig.latch(i) / 2] = latch_vals[i];
+    }
+  }
+
+  // リテラルの値を返す．
+  int
+  lit_val(
+    SizeType lit
+  )
+  {
+    auto var = lit / 2;
+    auto p = mVal.find(var);
+    int val;
+    if ( p != mVal.end() ) {
+      val = p->second;
+    }
+    else {
+      auto pos = mAndMap.at(var);
+      auto val1 = lit_val(mAig.and_src1(pos));
+      auto val2 = lit_val(mAig.and_src2(pos));
+      if ( val1 == 0 || val2 == 0 ) {
+	val = 0;
+      }
+      else if ( val1 == 1 && val2 == 1 ) {
+	val = 1;
+      }
+      else {
+	val = VAL_X;
+      }
+      mVal.emplace(var, val);
+    }
+    if ( val == VAL_X ) {
+      return VAL_X;
+    }
+    return (lit & 1) ? 1 - val : val;
+  }
+
+private:
+
+  const AigModel& mAig;
+  std::unordered_map<SizeType, SizeType> mAndMap;
+  std::unordered_map<SizeType, int> mVal;
+
+};
+
+// 0, 1, X のみからなる入力系列で結果を比較する．
+//
+// 全てのパタンが同じ値になるので，X となったパタン数は
+// 0 かパタン数のどちらかとなる．
+void
+check_sequence(
+  const AigModel& aig,
+  const AigTernaryOpt& opt,
+  const string& label
+)
+{
+  auto result = aig.ternary_simulate(opt);
+  auto np = result.pattern_num();
+  check(np == opt.word_num * 64, label + ": pattern_num() mismatch");
+  check(result.cycle_num() == opt.cycle_num, label + ": cycle_num() mismatch");
+
+  RefTernarySim sim{aig};
+  vector<int> latch_vals(aig.L(), opt.latch_x ? VAL_X : 0);
+  bool ok = true;
+  vector<bool> stuck_x(aig.O(), true);
+  for ( SizeType c = 0; c < opt.cycle_num; ++ c ) {
+    vector<int> input_vals(aig.I());
+    for ( SizeType i = 0; i < aig.I(); ++ i ) {
+      auto ch = opt.input_list[c][i];
+      input_vals[i] = ch == '0' ? 0 : ch == '1' ? 1 : VAL_X;
+    }
+    sim.eval(input_vals, latch_vals);
+    for ( SizeType o = 0; o < aig.O(); ++ o ) {
+      bool x = sim.lit_val(aig.output_src(o)) == VAL_X;
+      if ( result.x_count(c, o) != (x ? np : 0) ) {
+	ok = false;
+      }
+      if ( !x ) {
+	stuck_x[o] = false;
+      }
+    }
+    for ( SizeType i = 0; i < aig.L(); ++ i ) {
+      latch_vals[i] = sim.lit_val(aig.latch_src(i));
+    }
+  }
+  check(ok, label + ": the X counts of the outputs differ from the scalar simulation");
+  bool ok2 = true;
+  for ( SizeType i = 0; i < aig.L(); ++ i ) {
+    bool x = latch_vals[i] == VAL_X;
+    if ( result.latch_x_count(i) != (x ? np : 0) ) {
+      ok2 = false;
+    }
+  }
+  check(ok2, label + ": the X counts of the latches differ from the scalar simulation");
+  bool ok3 = true;
+  for ( SizeType o = 0; o < aig.O(); ++ o ) {
+    if ( result.is_stuck_x(o) != stuck_x[o] ) {
+      ok3 = false;
+    }
+  }
+  check(ok3, label + ": is_stuck_x() mismatch");
+}
+
+// 例外が送出されてメッセージが関数名で始まることを調べる．
+void
+check_error(
+  const AigModel& aig,
+  const AigTernaryOpt& opt,
+  const string& label
+)
+{
+  try {
+    aig.ternary_simulate(opt);
+    check(false, label + " was accepted");
+  }
+  catch ( std::invalid_argument& error ) {
+    string msg = error.what();
+    check(msg.find("ternary_simulate: ") == 0 && msg.find("cycle 1") != string::npos,
+	  label + ": unexpected message: " + msg);
+  }
+}
+
+END_NONAMESPACE
+
+// 使い方: ternary <aag-file>
+//
+// 0, 1, X からなる入力系列で3値シミュレーションを行い，
+// 時刻と出力ごとの X の数をスカラーの3値シミュレーションと比較する．
+int
+ternary(
+  int argc,
+  char** argv
+)
+{
+  if ( argc != 2 ) {
+    cerr << "Usage: ternary <aag-file>" << endl;
+    return 2;
+  }
+
+  vector<std::pair<string, AigModel>> model_list;
+  model_list.push_back({argv[1], AigModel::read_aag(argv[1])});
+  for ( std::uint64_t seed = 1; seed <= 3; ++ seed ) {
+    model_list.push_back({"random#" + std::to_string(seed),
+			  random_aig(6, 6, 6, 120, seed)});
+  }
+  std::mt19937_64 rng{1};
+  for ( auto& p: model_list ) {
+    auto& aig = p.second;
+    for ( SizeType k = 0; k < 20; ++ k ) {
+      AigTernaryOpt opt;
+      opt.word_num = 1 + k % 3;
+      opt.cycle_num = 6;
+      opt.latch_x = k % 2 == 0;
+      opt.thread_num = 1 + k % 4;
+      // 後半の系列ほど X を少なくする．
+      for ( SizeType c = 0; c < opt.cycle_num; ++ c ) {
+	string pat;
+	for ( SizeType i = 0; i < aig.I(); ++ i ) {
+	  auto r = rng() % 8;
+	  pat += r < (k % 4) ? 'X' : (r % 2) ? '1' : '0';
+	}
+	opt.input_list.push_back(pat);
+      }
+      check_sequence(aig, opt, p.first + " (sequence#" + std::to_string(k) + ")");
+    }
+
+    // X を含まない場合はどこにも X は現れない．
+    AigTernaryOpt opt;
+    opt.word_num = 2;
+    opt.cycle_num = 4;
+    opt.latch_x = false;
+    auto result = aig.ternary_simulate(opt);
+    bool ok = true;
+    for ( SizeType c = 0; c < opt.cycle_num; ++ c ) {
+      for ( SizeType o = 0; o < aig.O(); ++ o ) {
+	if ( result.x_count(c, o) != 0 ) {
+	  ok = false;
+	}
+      }
+    }
+    for ( SizeType i = 0; i < aig.L(); ++ i ) {
+      if ( result.latch_x_count(i) != 0 ) {
+	ok = false;
+      }
+    }
+    check(ok, p.first + ": X appears with binary random inputs");
+  }
+
+  // 不正な入力系列はエラーとなる．
+  auto& aig = model_list[0].second;
+  AigTernaryOpt opt;
+  opt.cycle_num = 2;
+  opt.input_list = {string(aig.I(), '0'), string(aig.I() + 1, '0')};
+  check_error(aig, opt, "a longer input pattern");
+  opt.input_list = {string(aig.I(), '0'), string(aig.I(), '2')};
+  check_error(aig, opt, "an illegal character");
+
+  return report("ternary");
+}
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::ternary(argc, argv);
+}
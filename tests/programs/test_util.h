@@ -0,0 +1,272 @@
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+/// @file test_util.h
+/// @brief テストプログラム用の共通関数
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigModel.h"
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+
+
+BEGIN_NAMESPACE_YM
+
+//////////////////////////////////////////////////////////////////////
+// 検査用の関数
+//////////////////////////////////////////////////////////////////////
+
+/// @brief 失敗した検査の数
+inline
+SizeType&
+error_count()
+{
+  static SizeType count = 0;
+  return count;
+}
+
+/// @brief 条件を検査する．
+///
+/// 成り立たない場合はメッセージを出力して失敗の数を数える．
+inline
+void
+check(
+  bool cond,
+  const string& msg
+)
+{
+  if ( !cond ) {
+    cout << "NG: " << msg << endl;
+    ++ error_count();
+  }
+}
+
+/// @brief 検査の結果を出力して終了コードを返す．
+inline
+int
+report(
+  const string& name
+)
+{
+  if ( error_count() == 0 ) {
+    cout << name << ": OK" << endl;
+    return 0;
+  }
+  cout << name << ": " << error_count() << " error(s)" << endl;
+  return 1;
+}
+
+/// @brief 2つのモデルの内容が等しい時 true を返す．
+///
+/// ANDノードの順番とシンボルも比較する．
+inline
+bool
+same_model(
+  const AigModel& aig1,
+  const AigModel& aig2
+)
+{
+  if ( aig1.M() != aig2.M() || aig1.I() != aig2.I() ||
+       aig1.L() != aig2.L() || aig1.O() != aig2.O() ||
+       aig1.A() != aig2.A() ) {
+    return false;
+  }
+  for ( SizeType i = 0; i < aig1.I(); ++ i ) {
+    if ( aig1.input(i) != aig2.input(i) ||
+	 aig1.input_symbol(i) != aig2.input_symbol(i) ) {
+      return false;
+    }
+  }
+  for ( SizeType i = 0; i < aig1.L(); ++ i ) {
+    if ( aig1.latch(i) != aig2.latch(i) ||
+	 aig1.latch_src(i) != aig2.latch_src(i) ||
+	 aig1.latch_symbol(i) != aig2.latch_symbol(i) ) {
+      return false;
+    }
+  }
+  for ( SizeType i = 0; i < aig1.O(); ++ i ) {
+    if ( aig1.output_src(i) != aig2.output_src(i) ||
+	 aig1.output_symbol(i) != aig2.output_symbol(i) ) {
+      return false;
+    }
+  }
+  for ( SizeType i = 0; i < aig1.A(); ++ i ) {
+    if ( aig1.and_node(i) != aig2.and_node(i) ||
+	 aig1.and_src1(i) != aig2.and_src1(i) ||
+	 aig1.and_src2(i) != aig2.and_src2(i) ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class RefSim test_util.h "test_util.h"
+/// @brief 検査用の素朴な 64 ビット並列シミュレータ
+///
+/// ANDノードの順番によらずに再帰的に値を求める．
+//////////////////////////////////////////////////////////////////////
+class RefSim
+{
+public:
+
+  /// @brief コンストラクタ
+  explicit
+  RefSim(
+    const AigModel& aig
+  ) : mAig{aig}
+  {
+    for ( SizeType i = 0; i < aig.A(); ++ i ) {
+      mAndMap.emplace(aig.and_node(i) / 2, i);
+    }
+  }
+
+  /// @brief 入力とラッチの値を設定して全体を評価する．
+  void
+  eval(
+    const vector<std::uint64_t>& input_vals,
+    const vector<std::uint64_t>& latch_vals = {}
+  )
+  {
+    mVal.clear();
+    mVal.emplace(0, 0ULL);
+    for ( SizeType i = 0; i < mAig.I(); ++ i ) {
+      mVal[mAig.input(i) / 2] = input_vals[i];
+    }
+    for ( SizeType i = 0; i < mAig.L(); ++ i ) {
+      mVal[mAig.latch(i) / 2] = latch_vals.empty() ? 0ULL : latch_vals[i];
+    }
+  }
+
+  /// @brief リテラルの値を返す．
+  std::uint64_t
+  lit_val(
+    SizeType lit
+  )
+  {
+    auto var = lit / 2;
+    auto p = mVal.find(var);
+    std::uint64_t val;
+    if ( p != mVal.end() ) {
+      val = p->second;
+    }
+    else {
+      auto pos = mAndMap.at(var);
+      val = lit_val(mAig.and_src1(pos)) & lit_val(mAig.and_src2(pos));
+      mVal.emplace(var, val);
+    }
+    return (lit & 1) ? ~val : val;
+  }
+
+  /// @brief 出力の値を返す．
+  std::uint64_t
+  output_val(
+    SizeType pos
+  )
+  {
+    return lit_val(mAig.output_src(pos));
+  }
+
+  /// @brief ラッチの次状態の値を返す．
+  std::uint64_t
+  latch_next(
+    SizeType pos
+  )
+  {
+    return lit_val(mAig.latch_src(pos));
+  }
+
+
+private:
+
+  // 対象のモデル
+  const AigModel& mAig;
+
+  // 変数番号から AND 番号への写像
+  std::unordered_map<SizeType, SizeType> mAndMap;
+
+  // 変数ごとの値
+  std::unordered_map<SizeType, std::uint64_t> mVal;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// 乱数を用いた生成
+//////////////////////////////////////////////////////////////////////
+
+/// @brief ランダムな値のリストを作る．
+inline
+vector<std::uint64_t>
+random_words(
+  SizeType n,
+  std::mt19937_64& rng
+)
+{
+  vector<std::uint64_t> vals(n);
+  for ( auto& v: vals ) {
+    v = rng();
+  }
+  return vals;
+}
+
+/// @brief ランダムな標準形の AIG を作る．
+///
+/// ANDノードのファンインは近くのノードが選ばれやすくしてあり，
+/// ANDノードどうしの共有が生じる．
+inline
+AigModel
+random_aig(
+  SizeType ni,
+  SizeType nl,
+  SizeType no,
+  SizeType na,
+  std::uint64_t seed
+)
+{
+  std::mt19937_64 rng{seed};
+  auto pick = [&](SizeType n) {
+    SizeType base = 0;
+    if ( n > 8 && rng() % 4 != 0 ) {
+      base = n - 8;
+    }
+    auto var = base + rng() % (n - base);
+    return var * 2 + rng() % 2;
+  };
+  ostringstream buf;
+  auto nvar = ni + nl + na;
+  buf << "aag " << nvar << " " << ni << " " << nl << " " << no << " " << na << endl;
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    buf << (i + 1) * 2 << endl;
+  }
+  vector<SizeType> and_src1(na);
+  vector<SizeType> and_src2(na);
+  for ( SizeType i = 0; i < na; ++ i ) {
+    // 変数 0 (定数)は除く．
+    auto n = ni + nl + i;
+    auto a = pick(n) + 2;
+    auto b = pick(n) + 2;
+    and_src1[i] = std::max(a, b);
+    and_src2[i] = std::min(a, b);
+  }
+  for ( SizeType i = 0; i < nl; ++ i ) {
+    buf << (ni + i + 1) * 2 << " " << pick(nvar) + 2 << endl;
+  }
+  for ( SizeType i = 0; i < no; ++ i ) {
+    buf << pick(nvar) + 2 << endl;
+  }
+  for ( SizeType i = 0; i < na; ++ i ) {
+    buf << (ni + nl + i + 1) * 2 << " " << and_src1[i] << " " << and_src2[i] << endl;
+  }
+  istringstream s{buf.str()};
+  return AigModel::read_aag(s);
+}
+
+END_NAMESPACE_YM
+
+#endif // TEST_UTIL_H
@@ -0,0 +1,273 @@
+
+/// @file truth.cc
+/// @brief AigModel::compute_truth_tables() のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigModel.h"
+#include "ym/AigTruthTables.h"
+#include "test_util.h"
+#include <algorithm>
+#include <numeric>
+#include <set>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 出力のファンインコーンに含まれる入力とラッチのリテラルを求める．
+vector<SizeType>
+cone_support(
+  const AigModel& aig,
+  SizeType opos
+)
+{
+  std::unordered_map<SizeType, SizeType> and_map;
+  for ( SizeType i = 0; i < aig.A(); ++ i ) {
+    and_map.emplace(aig.and_node(i) / 2, i);
+  }
+  std::set<SizeType> mark;
+  std::set<SizeType> support;
+  vector<SizeType> stack{aig.output_src(opos) / 2};
+  while ( !stack.empty() ) {
+    auto var = stack.back();
+    stack.pop_back();
+    if ( !mark.insert(var).second || var == 0 ) {
+      continue;
+    }
+    auto p = and_map.find(var);
+    if ( p == and_map.end() ) {
+      support.insert(var * 2);
+    }
+    else {
+      stack.push_back(aig.and_src1(p->second) / 2);
+      stack.push_back(aig.and_src2(p->second) / 2);
+    }
+  }
+  return vector<SizeType>(support.begin(), support.end());
+}
+
+// 真理値表をシミュレーション結果と比較する．
+void
+check_tables(
+  const AigModel& aig,
+  SizeType input_limit,
+  const string& label
+)
+{
+  AigTruthOpt opt;
+  opt.input_limit = input_limit;
+  opt.thread_num = 4;
+  auto tables = aig.compute_truth_tables(opt);
+  check(tables.output_num() == aig.O(), label + ": output_num() mismatch");
+  check(tables.input_limit() == input_limit, label + ": input_limit() mismatch");
+
+  // 入力とラッチのリテラルから位置への写像
+  std::unordered_map<SizeType, SizeType> input_map;
+  std::unordered_map<SizeType, SizeType> latch_map;
+  for ( SizeType i = 0; i < aig.I(); ++ i ) {
+    input_map.emplace(aig.input(i), i);
+  }
+  for ( SizeType i = 0; i < aig.L(); ++ i ) {
+    latch_map.emplace(aig.latch(i), i);
+  }
+
+  RefSim sim{aig};
+  std::mt19937_64 rng{input_limit};
+  for ( SizeType opos = 0; opos < aig.O(); ++ opos ) {
+    auto olabel = label + ": output#" + std::to_string(opos);
+    auto support = cone_support(aig, opos);
+    if ( support.size() > input_limit ) {
+      check(!tables.has_truth_table(opos), olabel + " has a truth table");
+      check(tables.support_num(opos) == 0, olabel + ": support_num() is not 0");
+      check(tables.truth_ptr(opos) == nullptr, olabel + ": truth_ptr() is not null");
+      continue;
+    }
+    check(tables.has_truth_table(opos), olabel + " has no truth table");
+    check(tables.support_list(opos) == support, olabel + ": support mismatch");
+    auto n = support.size();
+    SizeType nw = n <= 6 ? 1 : (1 << (n - 6));
+    auto table = tables.truth_table(opos);
+    if ( table.size() != nw ) {
+      check(false, olabel + ": truth_word_num() mismatch");
+      continue;
+    }
+    bool ok = true;
+    for ( SizeType w = 0; w < nw; ++ w ) {
+      // サポート外の入力とラッチは乱数で埋める．
+      auto input_vals = random_words(aig.I(), rng);
+      auto latch_vals = random_words(aig.L(), rng);
+      for ( SizeType i = 0; i < n; ++ i ) {
+	// ビット b はミンターム w * 64 + b に対応する．
+	std::uint64_t pat = 0;
+	for ( SizeType b = 0; b < 64; ++ b ) {
+	  auto m = w * 64 + b;
+	  pat |= static_cast<std::uint64_t>((m >> i) & 1) << b;
+	}
+	auto p = input_map.find(support[i]);
+	if ( p != input_map.end() ) {
+	  input_vals[p->second] = pat;
+	}
+	else {
+	  latch_vals[latch_map.at(support[i])] = pat;
+	}
+      }
+      sim.eval(input_vals, latch_vals);
+      if ( table[w] != sim.output_val(opos) ) {
+	ok = false;
+      }
+    }
+    check(ok, olabel + ": the truth table differs from the simulation");
+  }
+}
+
+// 1出力のモデルの出力を NPN 変換した出力を持つモデルを作る．
+//
+// 出力 k は perm_list[k] で入力を置換し，neg_list[k] のビット i が
+// 1 の入力 i を反転し，ビット ni が 1 の時は出力を反転する．
+AigModel
+npn_variants(
+  const AigModel& base,
+  const vector<vector<SizeType>>& perm_list,
+  const vector<SizeType>& neg_list
+)
+{
+  auto ni = base.I();
+  auto na = base.A();
+  auto nk = perm_list.size();
+  ostringstream buf;
+  buf << "aag " << ni + na * nk << " " << ni << " 0 " << nk << " " << na * nk << endl;
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    buf << (i + 1) * 2 << endl;
+  }
+  auto map_lit = [&](SizeType k, SizeType lit) {
+    auto var = lit / 2;
+    if ( var == 0 ) {
+      return lit;
+    }
+    if ( var <= ni ) {
+      auto i = var - 1;
+      auto neg = (neg_list[k] >> i) & 1;
+      return ((perm_list[k][i] + 1) * 2) ^ (lit % 2) ^ neg;
+    }
+    // ANDノード(標準形なので変数番号は ni + 1 から連続している)
+    return (var + k * na) * 2 + lit % 2;
+  };
+  for ( SizeType k = 0; k < nk; ++ k ) {
+    auto oneg = (neg_list[k] >> ni) & 1;
+    buf << (map_lit(k, base.output_src(0)) ^ oneg) << endl;
+  }
+  for ( SizeType k = 0; k < nk; ++ k ) {
+    for ( SizeType pos = 0; pos < na; ++ pos ) {
+      buf << map_lit(k, base.and_node(pos)) << " "
+	  << map_lit(k, base.and_src1(pos)) << " "
+	  << map_lit(k, base.and_src2(pos)) << endl;
+    }
+  }
+  istringstream s{buf.str()};
+  return AigModel::read_aag(s);
+}
+
+// NPN 同値な出力のハッシュ値が等しいことを調べる．
+void
+check_npn(
+  SizeType ni,
+  SizeType na,
+  std::uint64_t seed
+)
+{
+  auto label = "npn(" + std::to_string(ni) + ", " + std::to_string(seed) + ")";
+  auto base = random_aig(ni, 0, 1, na, seed);
+  std::mt19937_64 rng{seed};
+  vector<vector<SizeType>> perm_list;
+  vector<SizeType> neg_list;
+  vector<SizeType> id(ni);
+  std::iota(id.begin(), id.end(), 0);
+  perm_list.push_back(id);
+  neg_list.push_back(0);
+  for ( SizeType k = 0; k < 16; ++ k ) {
+    auto perm = id;
+    std::shuffle(perm.begin(), perm.end(), rng);
+    perm_list.push_back(perm);
+    neg_list.push_back(rng() % (1 << (ni + 1)));
+  }
+  auto aig = npn_variants(base, perm_list, neg_list);
+
+  // 入力数以上の上限にすれば全ての出力が真理値表を持つ．
+  check_tables(aig, ni, label);
+  AigTruthOpt opt;
+  opt.input_limit = ni;
+  auto tables = aig.compute_truth_tables(opt);
+  bool ok = true;
+  for ( SizeType k = 1; k < aig.O(); ++ k ) {
+    if ( tables.support_num(k) != tables.support_num(0) ||
+	 tables.npn_hash(k) != tables.npn_hash(0) ) {
+      ok = false;
+    }
+  }
+  check(ok, label + ": NPN-equivalent outputs have different hashes");
+}
+
+END_NONAMESPACE
+
+// 使い方: truth <aag-file>
+//
+// 与えられたファイルとランダムなモデルの真理値表がシミュレーション
+// 結果と一致すること，入力の置換と否定，出力の否定を施した出力の
+// NPN ハッシュ値が等しいことを調べる．
+int
+truth(
+  int argc,
+  char** argv
+)
+{
+  if ( argc != 2 ) {
+    cerr << "Usage: truth <aag-file>" << endl;
+    return 2;
+  }
+
+  auto aig = AigModel::read_aag(argv[1]);
+  for ( SizeType limit: {0, 1, 2, 16} ) {
+    check_tables(aig, limit, string{argv[1]} + " (input_limit = " +
+		 std::to_string(limit) + ")");
+  }
+  auto aig1 = random_aig(12, 4, 32, 400, 1);
+  for ( SizeType limit: {3, 6, 7, 16} ) {
+    check_tables(aig1, limit, "random (input_limit = " +
+		 std::to_string(limit) + ")");
+  }
+
+  // 定数にならない関数を持つ種を選んである．
+  check_npn(4, 20, 2);
+  check_npn(6, 30, 1);
+  check_npn(9, 150, 5);
+
+  // 範囲外の上限はエラーとなる．
+  AigTruthOpt opt;
+  opt.input_limit = 21;
+  bool thrown = false;
+  try {
+    aig.compute_truth_tables(opt);
+  }
+  catch ( std::invalid_argument& ) {
+    thrown = true;
+  }
+  check(thrown, "input_limit = 21 was accepted");
+
+  return report("truth");
+}
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::truth(argc, argv);
+}
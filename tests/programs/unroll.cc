@@ -0,0 +1,203 @@
+
+/// @file unroll.cc
+/// @brief AigUnroller のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/AigModel.h"
+#include "test_util.h"
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// シンボルを持つシフトレジスタ
+const char* SHIFT_AAG =
+  "aag 4 1 2 1 1\n"
+  "2\n"
+  "4 2\n"
+  "6 4\n"
+  "8\n"
+  "8 6 4\n"
+  "i0 en\n"
+  "l0 q0\n"
+  "l1 q1\n"
+  "o0 both\n";
+
+// オプションの内容を表す文字列を返す．
+string
+opt_str(
+  const AigUnrollOpt& opt
+)
+{
+  return " (frame_num = " + std::to_string(opt.frame_num) +
+    ", init_free = " + std::to_string(opt.init_free) +
+    ", strash = " + std::to_string(opt.strash) + ")";
+}
+
+// extend() で延ばした結果が直接展開した結果と一致することを調べる．
+void
+check_extend(
+  const AigModel& aig,
+  const AigUnrollOpt& opt,
+  const string& label
+)
+{
+  auto label1 = label + opt_str(opt);
+  auto unroller = aig.make_unroller(opt);
+  check(unroller.frame_num() == opt.frame_num, label1 + ": frame_num() mismatch");
+  for ( SizeType n: {1, 2} ) {
+    unroller.extend(n);
+    auto opt1 = opt;
+    opt1.frame_num = unroller.frame_num();
+    auto direct = aig.unroll(opt1);
+    auto model = unroller.model();
+    check(unroller.frame_num() == opt1.frame_num,
+	  label1 + ": frame_num() after extend(" + std::to_string(n) + ") mismatch");
+    check(same_model(model, direct),
+	  label1 + ": extend(" + std::to_string(n) + ") differs from unrolling "
+	  + std::to_string(opt1.frame_num) + " frames directly");
+    check(unroller.input_num() == model.I(), label1 + ": input_num() mismatch");
+    check(unroller.and_num() == model.A(), label1 + ": and_num() mismatch");
+  }
+}
+
+// 展開した回路の出力が順序シミュレーションの結果と一致することを調べる．
+void
+check_sim(
+  const AigModel& aig,
+  const AigUnrollOpt& opt,
+  const string& label
+)
+{
+  auto label1 = label + opt_str(opt);
+  auto unroller = aig.make_unroller(opt);
+  auto model = unroller.model();
+  auto nf = opt.frame_num;
+  auto init_num = opt.init_free ? aig.L() : 0;
+  check(model.I() == init_num + aig.I() * nf, label1 + ": the number of inputs mismatch");
+  check(model.O() == aig.O() * nf, label1 + ": the number of outputs mismatch");
+  check(model.L() == 0, label1 + ": the unrolled model has latches");
+
+  std::mt19937_64 rng{nf};
+  vector<std::uint64_t> input_vals(model.I());
+  vector<std::uint64_t> latch_vals(aig.L(), 0ULL);
+  if ( opt.init_free ) {
+    for ( SizeType i = 0; i < aig.L(); ++ i ) {
+      latch_vals[i] = rng();
+      input_vals[unroller.init_input_pos(i)] = latch_vals[i];
+    }
+  }
+  vector<vector<std::uint64_t>> frame_input_list(nf);
+  for ( SizeType f = 0; f < nf; ++ f ) {
+    frame_input_list[f] = random_words(aig.I(), rng);
+    for ( SizeType i = 0; i < aig.I(); ++ i ) {
+      input_vals[unroller.input_pos(f, i)] = frame_input_list[f][i];
+    }
+  }
+  RefSim usim{model};
+  usim.eval(input_vals);
+
+  RefSim sim{aig};
+  bool ok = true;
+  for ( SizeType f = 0; f < nf; ++ f ) {
+    sim.eval(frame_input_list[f], latch_vals);
+    for ( SizeType o = 0; o < aig.O(); ++ o ) {
+      if ( usim.output_val(unroller.output_pos(f, o)) != sim.output_val(o) ) {
+	ok = false;
+      }
+    }
+    for ( SizeType i = 0; i < aig.L(); ++ i ) {
+      latch_vals[i] = sim.latch_next(i);
+    }
+  }
+  check(ok, label1 + ": the outputs differ from the sequential simulation");
+}
+
+// シンボル名を調べる．
+void
+check_symbols()
+{
+  istringstream s{SHIFT_AAG};
+  auto aig = AigModel::read_aag(s);
+  AigUnrollOpt opt;
+  opt.frame_num = 2;
+  opt.init_free = true;
+  auto model = aig.unroll(opt);
+  vector<string> input_names{"q0@init", "q1@init", "en@0", "en@1"};
+  vector<string> output_names{"both@0", "both@1"};
+  bool ok = model.I() == input_names.size() && model.O() == output_names.size();
+  for ( SizeType i = 0; ok && i < input_names.size(); ++ i ) {
+    if ( model.input_symbol(i) != input_names[i] ) {
+      ok = false;
+    }
+  }
+  for ( SizeType i = 0; ok && i < output_names.size(); ++ i ) {
+    if ( model.output_symbol(i) != output_names[i] ) {
+      ok = false;
+    }
+  }
+  check(ok, "the symbols of the unrolled model are wrong");
+}
+
+END_NONAMESPACE
+
+// 使い方: unroll <aag-file>
+//
+// k 時刻分展開してから extend() で延ばした結果が直接展開した結果と
+// 一致することと，展開した回路の出力が元のモデルの順序シミュレーション
+// の結果と一致することを調べる．
+int
+unroll(
+  int argc,
+  char** argv
+)
+{
+  if ( argc != 2 ) {
+    cerr << "Usage: unroll <aag-file>" << endl;
+    return 2;
+  }
+
+  vector<std::pair<string, AigModel>> model_list;
+  model_list.push_back({argv[1], AigModel::read_aag(argv[1])});
+  {
+    istringstream s{SHIFT_AAG};
+    model_list.push_back({"shift", AigModel::read_aag(s)});
+  }
+  for ( std::uint64_t seed = 1; seed <= 3; ++ seed ) {
+    model_list.push_back({"random#" + std::to_string(seed),
+			  random_aig(6, 6, 4, 150, seed)});
+  }
+  for ( auto& p: model_list ) {
+    for ( auto init_free: {false, true} ) {
+      for ( auto strash: {false, true} ) {
+	AigUnrollOpt opt;
+	opt.init_free = init_free;
+	opt.strash = strash;
+	for ( SizeType k = 1; k <= 4; ++ k ) {
+	  opt.frame_num = k;
+	  check_extend(p.second, opt, p.first);
+	  check_sim(p.second, opt, p.first);
+	}
+      }
+    }
+  }
+  check_symbols();
+
+  return report("unroll");
+}
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::unroll(argc, argv);
+}
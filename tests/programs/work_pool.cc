@@ -0,0 +1,118 @@
+/// @file work_pool.cc
+/// @brief WorkPool のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "WorkPool.h"
+#include "test_util.h"
+#include <atomic>
+#include <stdexcept>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+using nsAig::WorkPool;
+
+// 全てのタスクがちょうど1回ずつ実行されることを確かめる．
+void
+check_once(
+  WorkPool& pool,
+  SizeType n,
+  const string& label
+)
+{
+  vector<std::atomic<SizeType>> count_list(n);
+  for ( auto& count: count_list ) {
+    count = 0;
+  }
+  std::atomic<bool> bad_tid{false};
+  pool.run(n, [&](SizeType task, SizeType tid) {
+    if ( tid >= pool.thread_num() ) {
+      bad_tid = true;
+    }
+    ++ count_list[task];
+  });
+  check(!bad_tid, label + ": thread id out of range");
+  for ( SizeType i = 0; i < n; ++ i ) {
+    if ( count_list[i] != 1 ) {
+      check(false, label + ": task#" + std::to_string(i) +
+	    " was run " + std::to_string(count_list[i]) + " time(s)");
+      return;
+    }
+  }
+}
+
+// 例外が run() の呼び出し元に伝わることを確かめる．
+void
+check_error(
+  WorkPool& pool,
+  SizeType n,
+  const string& label
+)
+{
+  bool thrown = false;
+  try {
+    pool.run(n, [&](SizeType task, SizeType) {
+      if ( task == n / 2 ) {
+	throw std::runtime_error{"task failed"};
+      }
+    });
+  }
+  catch ( const std::runtime_error& error ) {
+    thrown = string{error.what()} == "task failed";
+  }
+  check(thrown, label + ": exception was not propagated");
+}
+
+END_NONAMESPACE
+
+// 使い方: work_pool
+//
+// タスク数を減らしながら run() を繰り返し呼び出して，
+// 参加しないワーカースレッドが以前の仕事に触れないことを確かめる．
+// 競合があれば ThreadSanitizer や AddressSanitizer 付きのビルドで検出される．
+int
+work_pool(
+  int argc,
+  char** argv
+)
+{
+  if ( argc != 1 ) {
+    cerr << "Usage: work_pool" << endl;
+    return 2;
+  }
+
+  WorkPool pool{8};
+  for ( SizeType iter = 0; iter < 200; ++ iter ) {
+    auto label = "iteration#" + std::to_string(iter);
+    for ( SizeType n = 64; n > 0; -- n ) {
+      check_once(pool, n, label + ", n = " + std::to_string(n));
+    }
+  }
+  for ( SizeType n = 16; n > 1; -- n ) {
+    auto label = "error, n = " + std::to_string(n);
+    check_error(pool, n, label);
+    // 例外の後でも再利用できることを確かめる．
+    check_once(pool, n, label);
+  }
+  // タスクが無い場合
+  check_once(pool, 0, "n = 0");
+
+  return report("work_pool");
+}
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::work_pool(argc, argv);
+}